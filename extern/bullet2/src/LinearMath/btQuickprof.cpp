@@ -20,6 +20,11 @@
 
 static btClock gProfileClock;
 
+#include <thread>
+
+/// The profile tree isn't thread safe, only the thread loading the library records samples.
+static const std::thread::id gProfileThread = std::this_thread::get_id();
+
 
 #ifdef __CELLOS_LV2__
 #include <sys/sys_time.h>
@@ -455,6 +460,10 @@ unsigned long int			CProfileManager::ResetTime = 0;
  *=============================================================================================*/
 void	CProfileManager::Start_Profile( const char * name )
 {
+	if (std::this_thread::get_id() != gProfileThread) {
+		return;
+	}
+
 	if (name != CurrentNode->Get_Name()) {
 		CurrentNode = CurrentNode->Get_Sub_Node( name );
 	}
@@ -468,6 +477,10 @@ void	CProfileManager::Start_Profile( const char * name )
  *=============================================================================================*/
 void	CProfileManager::Stop_Profile( void )
 {
+	if (std::this_thread::get_id() != gProfileThread) {
+		return;
+	}
+
 	// Return will indicate whether we should back up to our parent (we may
 	// be profiling a recursive function)
 	if (CurrentNode->Return()) {
@@ -52,6 +52,7 @@
 
 #include "MT_Vector3.h"
 #include "MT_Quaternion.h"
+#include "MT_Simd.h"
 
 class MT_Matrix3x3 {
 public:
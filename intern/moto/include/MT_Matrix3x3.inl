@@ -42,9 +42,26 @@ GEN_INLINE MT_Quaternion MT_Matrix3x3::getRotation() const {
 }
 
 GEN_INLINE MT_Matrix3x3& MT_Matrix3x3::operator*=(const MT_Matrix3x3& m) {
+#ifdef MT_SIMD_SSE2
+    // All the rows are loaded before the stores, m can be this matrix.
+    const __m128 b0 = MT_simd_load3(m[0].getValue());
+    const __m128 b1 = MT_simd_load3(m[1].getValue());
+    const __m128 b2 = MT_simd_load3(m[2].getValue());
+    const __m128 a0 = MT_simd_load3(m_el[0].getValue());
+    const __m128 a1 = MT_simd_load3(m_el[1].getValue());
+    const __m128 a2 = MT_simd_load3(m_el[2].getValue());
+
+    MT_simd_store3(m_el[0].getValue(), _mm_add_ps(_mm_add_ps(_mm_mul_ps(MT_SIMD_SPLAT(a0, 0), b0),
+        _mm_mul_ps(MT_SIMD_SPLAT(a0, 1), b1)), _mm_mul_ps(MT_SIMD_SPLAT(a0, 2), b2)));
+    MT_simd_store3(m_el[1].getValue(), _mm_add_ps(_mm_add_ps(_mm_mul_ps(MT_SIMD_SPLAT(a1, 0), b0),
+        _mm_mul_ps(MT_SIMD_SPLAT(a1, 1), b1)), _mm_mul_ps(MT_SIMD_SPLAT(a1, 2), b2)));
+    MT_simd_store3(m_el[2].getValue(), _mm_add_ps(_mm_add_ps(_mm_mul_ps(MT_SIMD_SPLAT(a2, 0), b0),
+        _mm_mul_ps(MT_SIMD_SPLAT(a2, 1), b1)), _mm_mul_ps(MT_SIMD_SPLAT(a2, 2), b2)));
+#else
     setValue(m.tdot(0, m_el[0]), m.tdot(1, m_el[0]), m.tdot(2, m_el[0]),
              m.tdot(0, m_el[1]), m.tdot(1, m_el[1]), m.tdot(2, m_el[1]),
              m.tdot(0, m_el[2]), m.tdot(1, m_el[2]), m.tdot(2, m_el[2]));
+#endif
     return *this;
 }
 
@@ -100,10 +117,27 @@ GEN_INLINE MT_Vector3 operator*(const MT_Vector3& v, const MT_Matrix3x3& m) {
 }
 
 GEN_INLINE MT_Matrix3x3 operator*(const MT_Matrix3x3& m1, const MT_Matrix3x3& m2) {
+#ifdef MT_SIMD_SSE2
+    /* Rows are not padded, load and store exactly three lanes to never
+     * access memory past the matrices. */
+    const __m128 b0 = MT_simd_load3(m2[0].getValue());
+    const __m128 b1 = MT_simd_load3(m2[1].getValue());
+    const __m128 b2 = MT_simd_load3(m2[2].getValue());
+
+    MT_Matrix3x3 result;
+    for (unsigned short i = 0; i < 3; ++i) {
+        const MT_Vector3& a = m1[i];
+        const __m128 res = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(a[0]), b0), _mm_mul_ps(_mm_set1_ps(a[1]), b1)),
+                                      _mm_mul_ps(_mm_set1_ps(a[2]), b2));
+        MT_simd_store3(result[i].getValue(), res);
+    }
+    return result;
+#else
     return 
         MT_Matrix3x3(m2.tdot(0, m1[0]), m2.tdot(1, m1[0]), m2.tdot(2, m1[0]),
                      m2.tdot(0, m1[1]), m2.tdot(1, m1[1]), m2.tdot(2, m1[1]),
                      m2.tdot(0, m1[2]), m2.tdot(1, m1[2]), m2.tdot(2, m1[2]));
+#endif
 }
 
 GEN_INLINE MT_Matrix3x3 MT_multTransposeLeft(const MT_Matrix3x3& m1, const MT_Matrix3x3& m2) {
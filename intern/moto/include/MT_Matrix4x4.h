@@ -213,6 +213,16 @@ public:
 	MT_Matrix4x4 inverse() const;
 	void         invert();
 
+	/**
+	 * Multiply an array of vectors by this matrix, in and out can be the same array.
+	 */
+	void transformVectors(const MT_Vector4 *in, MT_Vector4 *out, unsigned int count) const;
+	/**
+	 * Multiply an array of points (w = 1) by this matrix without perspective
+	 * division, in and out can be the same array.
+	 */
+	void transformPoints(const MT_Vector3 *in, MT_Vector3 *out, unsigned int count) const;
+
 	MT_Transform toTransform() const
 	{
 		return MT_Transform(MT_Vector3(m_el[0][3], m_el[1][3], m_el[2][3]),
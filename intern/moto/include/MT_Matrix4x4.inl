@@ -96,28 +96,97 @@ GEN_INLINE MT_Matrix4x4 MT_Matrix4x4::inverse() const
 
 GEN_INLINE MT_Matrix4x4& MT_Matrix4x4::operator*=(const MT_Matrix4x4& m)
 {
+#ifdef MT_SIMD_SSE2
+	*this = (*this) * m;
+#else
 	setValue(m.tdot(0, m_el[0]), m.tdot(1, m_el[0]), m.tdot(2, m_el[0]), m.tdot(3, m_el[0]),
              m.tdot(0, m_el[1]), m.tdot(1, m_el[1]), m.tdot(2, m_el[1]), m.tdot(3, m_el[1]),
              m.tdot(0, m_el[2]), m.tdot(1, m_el[2]), m.tdot(2, m_el[2]), m.tdot(3, m_el[2]),
              m.tdot(0, m_el[3]), m.tdot(1, m_el[3]), m.tdot(2, m_el[3]), m.tdot(3, m_el[3]));
+#endif
     return *this;
 
 }
 
 GEN_INLINE MT_Vector4 operator*(const MT_Matrix4x4& m, const MT_Vector4& v) {
+#ifdef MT_SIMD_SSE2
+	__m128 r0 = _mm_load_ps(m[0].getValue());
+	__m128 r1 = _mm_load_ps(m[1].getValue());
+	__m128 r2 = _mm_load_ps(m[2].getValue());
+	__m128 r3 = _mm_load_ps(m[3].getValue());
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	const __m128 vec = _mm_load_ps(v.getValue());
+	const __m128 res = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(r0, MT_SIMD_SPLAT(vec, 0)), _mm_mul_ps(r1, MT_SIMD_SPLAT(vec, 1))),
+		_mm_add_ps(_mm_mul_ps(r2, MT_SIMD_SPLAT(vec, 2)), _mm_mul_ps(r3, MT_SIMD_SPLAT(vec, 3))));
+
+	MT_Vector4 result;
+	_mm_store_ps(result.getValue(), res);
+	return result;
+#else
     return MT_Vector4(MT_dot(m[0], v), MT_dot(m[1], v), MT_dot(m[2], v), MT_dot(m[3], v));
+#endif
 }
 
 GEN_INLINE MT_Vector4 operator*(const MT_Vector4& v, const MT_Matrix4x4& m) {
+#ifdef MT_SIMD_SSE2
+	const __m128 vec = _mm_load_ps(v.getValue());
+	const __m128 res = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(_mm_load_ps(m[0].getValue()), MT_SIMD_SPLAT(vec, 0)),
+		           _mm_mul_ps(_mm_load_ps(m[1].getValue()), MT_SIMD_SPLAT(vec, 1))),
+		_mm_add_ps(_mm_mul_ps(_mm_load_ps(m[2].getValue()), MT_SIMD_SPLAT(vec, 2)),
+		           _mm_mul_ps(_mm_load_ps(m[3].getValue()), MT_SIMD_SPLAT(vec, 3))));
+
+	MT_Vector4 result;
+	_mm_store_ps(result.getValue(), res);
+	return result;
+#else
     return MT_Vector4(m.tdot(0, v), m.tdot(1, v), m.tdot(2, v), m.tdot(3, v));
+#endif
 }
 
 GEN_INLINE MT_Matrix4x4 operator*(const MT_Matrix4x4& m1, const MT_Matrix4x4& m2) {
+#if defined(MT_SIMD_AVX)
+	/* Two rows of the result per iteration, each 128 bits lane holds one row
+	 * of m1 and is multiplied by the rows of m2 duplicated in both lanes.
+	 * The matrices are only guaranteed 16 bytes aligned, use unaligned access. */
+	const __m256 b0 = _mm256_broadcast_ps((const __m128 *)m2[0].getValue());
+	const __m256 b1 = _mm256_broadcast_ps((const __m128 *)m2[1].getValue());
+	const __m256 b2 = _mm256_broadcast_ps((const __m128 *)m2[2].getValue());
+	const __m256 b3 = _mm256_broadcast_ps((const __m128 *)m2[3].getValue());
+
+	MT_Matrix4x4 result;
+	for (unsigned short i = 0; i < 4; i += 2) {
+		const __m256 a = _mm256_loadu_ps(m1[i].getValue());
+		const __m256 res = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(a, 0x00), b0), _mm256_mul_ps(_mm256_permute_ps(a, 0x55), b1)),
+			_mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(a, 0xAA), b2), _mm256_mul_ps(_mm256_permute_ps(a, 0xFF), b3)));
+		_mm256_storeu_ps(result[i].getValue(), res);
+	}
+	return result;
+#elif defined(MT_SIMD_SSE2)
+	const __m128 b0 = _mm_load_ps(m2[0].getValue());
+	const __m128 b1 = _mm_load_ps(m2[1].getValue());
+	const __m128 b2 = _mm_load_ps(m2[2].getValue());
+	const __m128 b3 = _mm_load_ps(m2[3].getValue());
+
+	MT_Matrix4x4 result;
+	for (unsigned short i = 0; i < 4; ++i) {
+		const __m128 a = _mm_load_ps(m1[i].getValue());
+		const __m128 res = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(MT_SIMD_SPLAT(a, 0), b0), _mm_mul_ps(MT_SIMD_SPLAT(a, 1), b1)),
+			_mm_add_ps(_mm_mul_ps(MT_SIMD_SPLAT(a, 2), b2), _mm_mul_ps(MT_SIMD_SPLAT(a, 3), b3)));
+		_mm_store_ps(result[i].getValue(), res);
+	}
+	return result;
+#else
 	return 
 		MT_Matrix4x4(m2.tdot(0, m1[0]), m2.tdot(1, m1[0]), m2.tdot(2, m1[0]), m2.tdot(3, m1[0]),
                      m2.tdot(0, m1[1]), m2.tdot(1, m1[1]), m2.tdot(2, m1[1]), m2.tdot(3, m1[1]),
                      m2.tdot(0, m1[2]), m2.tdot(1, m1[2]), m2.tdot(2, m1[2]), m2.tdot(3, m1[2]),
                      m2.tdot(0, m1[3]), m2.tdot(1, m1[3]), m2.tdot(2, m1[3]), m2.tdot(3, m1[3]));
+#endif
 }
 
 
@@ -1,10 +1,14 @@
 #include "MT_Optimize.h"
 
 GEN_INLINE MT_Quaternion& MT_Quaternion::operator*=(const MT_Quaternion& q) {
+#ifdef MT_SIMD_SSE2
+    _mm_store_ps(m_co, MT_simd_quat_mul(_mm_load_ps(m_co), _mm_load_ps(q.getValue())));
+#else
     setValue(m_co[3] * q[0] + m_co[0] * q[3] + m_co[1] * q[2] - m_co[2] * q[1],
              m_co[3] * q[1] + m_co[1] * q[3] + m_co[2] * q[0] - m_co[0] * q[2],
              m_co[3] * q[2] + m_co[2] * q[3] + m_co[0] * q[1] - m_co[1] * q[0],
              m_co[3] * q[3] - m_co[0] * q[0] - m_co[1] * q[1] - m_co[2] * q[2]);
+#endif
     return *this;
 }
 
@@ -38,10 +42,16 @@ GEN_INLINE MT_Quaternion MT_Quaternion::random() {
 
 GEN_INLINE MT_Quaternion operator*(const MT_Quaternion& q1, 
                                    const MT_Quaternion& q2) {
+#ifdef MT_SIMD_SSE2
+    MT_Quaternion result;
+    _mm_store_ps(result.getValue(), MT_simd_quat_mul(_mm_load_ps(q1.getValue()), _mm_load_ps(q2.getValue())));
+    return result;
+#else
     return MT_Quaternion(q1[3] * q2[0] + q1[0] * q2[3] + q1[1] * q2[2] - q1[2] * q2[1],
                          q1[3] * q2[1] + q1[1] * q2[3] + q1[2] * q2[0] - q1[0] * q2[2],
                          q1[3] * q2[2] + q1[2] * q2[3] + q1[0] * q2[1] - q1[1] * q2[0],
                          q1[3] * q2[3] - q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2]); 
+#endif
 }
 
 GEN_INLINE MT_Quaternion operator*(const MT_Quaternion& q, const MT_Vector3& w)
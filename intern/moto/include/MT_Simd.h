@@ -0,0 +1,91 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file moto/include/MT_Simd.h
+ *  \ingroup moto
+ *
+ * Build time selection of the SIMD back-end used by the matrix and batch
+ * functions. WITH_MOTO_SIMD enables SSE2, AVX is used in addition when the
+ * compiler targets it (-mavx or /arch:AVX).
+ */
+
+#ifndef MT_SIMD_H
+#define MT_SIMD_H
+
+#include "MT_Config.h"
+
+#if defined(WITH_MOTO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define MT_SIMD_SSE2
+#  include <emmintrin.h>
+#  if defined(__AVX__)
+#    define MT_SIMD_AVX
+#    include <immintrin.h>
+#  endif
+#endif
+
+/* Alignment of the SIMD friendly types (MT_Vector4, MT_Matrix4x4). */
+#ifdef MT_SIMD_SSE2
+#  define MT_SIMD_ALIGN alignas(16)
+#else
+#  define MT_SIMD_ALIGN
+#endif
+
+#ifdef MT_SIMD_SSE2
+
+/// Load a 3D vector in the three lower lanes, the last lane is set to zero.
+inline __m128 MT_simd_load3(const float *v)
+{
+	const __m128 xy = _mm_castpd_ps(_mm_load_sd((const double *)v));
+	return _mm_movelh_ps(xy, _mm_load_ss(v + 2));
+}
+
+/// Store the three lower lanes of a register, never touches v[3].
+inline void MT_simd_store3(float *v, const __m128 r)
+{
+	_mm_store_sd((double *)v, _mm_castps_pd(r));
+	_mm_store_ss(v + 2, _mm_movehl_ps(r, r));
+}
+
+/// Broadcast the lane i of a register in all lanes.
+#define MT_SIMD_SPLAT(v, i) _mm_shuffle_ps(v, v, _MM_SHUFFLE(i, i, i, i))
+
+/// Hamilton product of two quaternions stored as (x, y, z, w).
+inline __m128 MT_simd_quat_mul(const __m128 a, const __m128 b)
+{
+	// Negate the w lane of the second and third terms.
+	const __m128 sign = _mm_set_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+
+	// (aw * bx, aw * by, aw * bz, aw * bw)
+	const __m128 t0 = _mm_mul_ps(MT_SIMD_SPLAT(a, 3), b);
+	// (ax * bw, ay * bw, az * bw, ax * bx)
+	const __m128 t1 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 2, 1, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 3, 3)));
+	// (ay * bz, az * bx, ax * by, ay * by)
+	const __m128 t2 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 0, 2)));
+	// (az * by, ax * bz, ay * bx, az * bz)
+	const __m128 t3 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 0, 2, 1)));
+
+	return _mm_sub_ps(_mm_add_ps(t0, _mm_xor_ps(_mm_add_ps(t1, t2), sign)), t3);
+}
+
+#endif  // MT_SIMD_SSE2
+
+#endif  // MT_SIMD_H
@@ -143,6 +143,17 @@ public:
     void invert(const MT_Transform& t);
     void mult(const MT_Transform& t1, const MT_Transform& t2);
     void multInverseLeft(const MT_Transform& t1, const MT_Transform& t2); 
+
+	/**
+	 * Transform an array of points, in and out can be the same array.
+	 * @param count The number of points.
+	 */
+	void transformPoints(const MT_Vector3 *in, MT_Vector3 *out, unsigned int count) const;
+	/**
+	 * Transform an array of directions using only the basis, in and out can be the same array.
+	 * @param count The number of directions.
+	 */
+	void transformDirections(const MT_Vector3 *in, MT_Vector3 *out, unsigned int count) const;
     
 private:
     enum { 
@@ -53,8 +53,9 @@
 #include "MT_Scalar.h"
 #include "MT_Stream.h"
 #include "MT_Vector3.h"
+#include "MT_Simd.h"
 
-class MT_Vector4
+class MT_SIMD_ALIGN MT_Vector4
 {
 public:
     explicit MT_Vector4() {}
@@ -41,3 +41,66 @@ const MT_Matrix4x4 MT_Matrix4x4::identity = MT_Matrix4x4(1.0f, 0.0f, 0.0f, 0.0f,
 														 0.0f, 1.0f, 0.0f, 0.0f,
 														 0.0f, 0.0f, 1.0f, 0.0f,
 														 0.0f, 0.0f, 0.0f, 1.0f);
+
+void MT_Matrix4x4::transformVectors(const MT_Vector4 *in, MT_Vector4 *out, unsigned int count) const
+{
+#if defined(MT_SIMD_SSE2)
+	__m128 c0 = _mm_load_ps(m_el[0].getValue());
+	__m128 c1 = _mm_load_ps(m_el[1].getValue());
+	__m128 c2 = _mm_load_ps(m_el[2].getValue());
+	__m128 c3 = _mm_load_ps(m_el[3].getValue());
+	// Rows to columns.
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	unsigned int i = 0;
+#  if defined(MT_SIMD_AVX)
+	// Two vectors per iteration, one in each 128 bits lane.
+	const __m256 wc0 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0), c0, 1);
+	const __m256 wc1 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1), c1, 1);
+	const __m256 wc2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c2), c2, 1);
+	const __m256 wc3 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3), c3, 1);
+	for (; i + 1 < count; i += 2) {
+		const __m256 v = _mm256_loadu_ps(in[i].getValue());
+		const __m256 res = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(wc0, _mm256_permute_ps(v, 0x00)), _mm256_mul_ps(wc1, _mm256_permute_ps(v, 0x55))),
+			_mm256_add_ps(_mm256_mul_ps(wc2, _mm256_permute_ps(v, 0xAA)), _mm256_mul_ps(wc3, _mm256_permute_ps(v, 0xFF))));
+		_mm256_storeu_ps(out[i].getValue(), res);
+	}
+#  endif
+	for (; i < count; ++i) {
+		const __m128 v = _mm_load_ps(in[i].getValue());
+		const __m128 res = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(c0, MT_SIMD_SPLAT(v, 0)), _mm_mul_ps(c1, MT_SIMD_SPLAT(v, 1))),
+			_mm_add_ps(_mm_mul_ps(c2, MT_SIMD_SPLAT(v, 2)), _mm_mul_ps(c3, MT_SIMD_SPLAT(v, 3))));
+		_mm_store_ps(out[i].getValue(), res);
+	}
+#else
+	for (unsigned int i = 0; i < count; ++i) {
+		out[i] = (*this) * in[i];
+	}
+#endif
+}
+
+void MT_Matrix4x4::transformPoints(const MT_Vector3 *in, MT_Vector3 *out, unsigned int count) const
+{
+#ifdef MT_SIMD_SSE2
+	__m128 c0 = _mm_load_ps(m_el[0].getValue());
+	__m128 c1 = _mm_load_ps(m_el[1].getValue());
+	__m128 c2 = _mm_load_ps(m_el[2].getValue());
+	__m128 c3 = _mm_load_ps(m_el[3].getValue());
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Scalar *p = in[i].getValue();
+		const __m128 res = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+		                              _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+		MT_simd_store3(out[i].getValue(), res);
+	}
+#else
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Vector3& p = in[i];
+		// MT_Vector4 dot MT_Vector3 assumes w = 1.
+		out[i].setValue(MT_dot(m_el[0], p), MT_dot(m_el[1], p), MT_dot(m_el[2], p));
+	}
+#endif
+}
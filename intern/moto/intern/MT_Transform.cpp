@@ -151,3 +151,44 @@ void MT_Transform::multInverseLeft(const MT_Transform& t1, const MT_Transform& t
 
 
 
+
+void MT_Transform::transformPoints(const MT_Vector3 *in, MT_Vector3 *out, unsigned int count) const
+{
+#ifdef MT_SIMD_SSE2
+	const __m128 c0 = _mm_setr_ps(m_basis[0][0], m_basis[1][0], m_basis[2][0], 0.0f);
+	const __m128 c1 = _mm_setr_ps(m_basis[0][1], m_basis[1][1], m_basis[2][1], 0.0f);
+	const __m128 c2 = _mm_setr_ps(m_basis[0][2], m_basis[1][2], m_basis[2][2], 0.0f);
+	const __m128 origin = MT_simd_load3(m_origin.getValue());
+
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Scalar *p = in[i].getValue();
+		const __m128 res = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+		                              _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), origin));
+		MT_simd_store3(out[i].getValue(), res);
+	}
+#else
+	for (unsigned int i = 0; i < count; ++i) {
+		out[i] = (*this)(in[i]);
+	}
+#endif
+}
+
+void MT_Transform::transformDirections(const MT_Vector3 *in, MT_Vector3 *out, unsigned int count) const
+{
+#ifdef MT_SIMD_SSE2
+	const __m128 c0 = _mm_setr_ps(m_basis[0][0], m_basis[1][0], m_basis[2][0], 0.0f);
+	const __m128 c1 = _mm_setr_ps(m_basis[0][1], m_basis[1][1], m_basis[2][1], 0.0f);
+	const __m128 c2 = _mm_setr_ps(m_basis[0][2], m_basis[1][2], m_basis[2][2], 0.0f);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Scalar *p = in[i].getValue();
+		const __m128 res = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+		                              _mm_mul_ps(c2, _mm_set1_ps(p[2])));
+		MT_simd_store3(out[i].getValue(), res);
+	}
+#else
+	for (unsigned int i = 0; i < count; ++i) {
+		out[i] = m_basis * in[i];
+	}
+#endif
+}
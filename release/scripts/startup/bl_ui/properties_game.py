@@ -425,6 +425,12 @@ class RENDER_PT_game_system(RenderButtonsPanel, Panel):
         col = row.column()
         col.prop(gs, "use_material_caching")
 
+        row = layout.row()
+        row.prop(gs, "use_pose_cache")
+        sub = row.row()
+        sub.active = gs.use_pose_cache
+        sub.prop(gs, "pose_cache_steps")
+
         row = layout.row()
         row.prop(gs, "vsync")
 
@@ -493,6 +499,13 @@ class SCENE_PT_game_physics(SceneButtonsPanel, Panel):
             sub.prop(gs, "physics_step_max", text="Max")
             sub.prop(gs, "physics_step_sub", text="Substeps")
             col.prop(gs, "fps", text="FPS")
+            col.prop(gs, "physics_threads", text="Threads")
+            col.prop(gs, "physics_broadphase", text="")
+            sub = col.column()
+            sub.active = gs.physics_broadphase == 'AXIS_SWEEP'
+            sub.prop(gs, "physics_world_size", text="World Size")
+            col.prop(gs, "use_physics_shape_cache")
+            col.prop(gs, "use_physics_async")
 
             col = split.column()
             col.label(text="Logic Steps:")
@@ -626,6 +639,14 @@ class SCENE_PT_game_hysteresis(SceneButtonsPanel, Panel):
         row.active = gs.use_scene_hysteresis
         row.prop(gs, "scene_hysteresis_percentage", text="")
 
+        layout.prop(gs, "use_animation_lod")
+        col = layout.column()
+        col.active = gs.use_animation_lod
+        row = col.row()
+        row.prop(gs, "animation_lod_distance")
+        row.prop(gs, "animation_lod_max_interval")
+        col.prop(gs, "use_animation_lod_interpolate")
+
 
 class WorldButtonsPanel:
     bl_space_type = 'PROPERTIES'
@@ -837,6 +858,8 @@ class OBJECT_PT_levels_of_detail(ObjectButtonsPanel, Panel):
             row = row.row(align=True)
             row.prop(level, "use_mesh", text="")
             row.prop(level, "use_material", text="")
+            row.prop(level, "use_physics", text="")
+            row.prop(level, "use_physics_sleep", text="")
 
             row = box.row()
             row.active = gs.use_scene_hysteresis
@@ -849,6 +872,15 @@ class OBJECT_PT_levels_of_detail(ObjectButtonsPanel, Panel):
         row.operator("object.lod_add", text="Add", icon='ZOOMIN')
         row.menu("OBJECT_MT_lod_tools", text="", icon='TRIA_DOWN')
 
+        if ob.type == 'ARMATURE':
+            game = ob.game
+            row = layout.row()
+            row.active = gs.use_animation_lod
+            row.prop(game, "use_animation_lod")
+            sub = row.row()
+            sub.active = gs.use_animation_lod and game.use_animation_lod
+            sub.prop(game, "animation_lod_factor", text="Factor")
+
 
 classes = (
     PHYSICS_PT_game_physics,
@@ -789,6 +789,9 @@ void BKE_scene_init(Scene *sce)
 	sce->gm.ticrate = 60;
 	sce->gm.maxlogicstep = 5;
 	sce->gm.physubstep = 1;
+	sce->gm.physicsThreads = 1;
+	sce->gm.physicsBroadphase = GAME_PHYSICS_BROADPHASE_DBVT;
+	sce->gm.physicsWorldSize = 1000.0f;
 	sce->gm.maxphystep = 5;
 	sce->gm.lineardeactthreshold = 0.8f;
 	sce->gm.angulardeactthreshold = 1.0f;
@@ -816,6 +819,9 @@ void BKE_scene_init(Scene *sce)
 
 	sce->gm.lodflag = SCE_LOD_USE_HYST;
 	sce->gm.scehysteresis = 10;
+	sce->gm.animLodDistance = 20.0f;
+	sce->gm.animLodMaxInterval = 4;
+	sce->gm.poseCacheSteps = 4;
 
 	sce->gm.exitkey = 218; // Blender key code for ESC
 
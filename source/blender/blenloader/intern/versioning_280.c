@@ -983,4 +983,37 @@ void blo_do_versions_280(FileData *fd, Library *lib, Main *main)
 			}
 		}
 	}
+
+	{
+		if (!DNA_struct_elem_find(fd->filesdna, "GameData", "short", "physicsThreads")) {
+			for (Scene *scene = main->scene.first; scene; scene = scene->id.next) {
+				scene->gm.physicsThreads = 1;
+			}
+		}
+
+		if (!DNA_struct_elem_find(fd->filesdna, "GameData", "float", "physicsWorldSize")) {
+			for (Scene *scene = main->scene.first; scene; scene = scene->id.next) {
+				scene->gm.physicsWorldSize = 1000.0f;
+			}
+		}
+
+		if (!DNA_struct_elem_find(fd->filesdna, "GameData", "float", "animLodDistance")) {
+			for (Scene *scene = main->scene.first; scene; scene = scene->id.next) {
+				scene->gm.animLodDistance = 20.0f;
+				scene->gm.animLodMaxInterval = 4;
+			}
+		}
+
+		if (!DNA_struct_elem_find(fd->filesdna, "GameData", "short", "poseCacheSteps")) {
+			for (Scene *scene = main->scene.first; scene; scene = scene->id.next) {
+				scene->gm.poseCacheSteps = 4;
+			}
+		}
+
+		if (!DNA_struct_elem_find(fd->filesdna, "Object", "float", "animLodFactor")) {
+			for (Object *ob = main->object.first; ob; ob = ob->id.next) {
+				ob->animLodFactor = 1.0f;
+			}
+		}
+	}
 }
@@ -27,6 +27,7 @@
 
 #include "BLI_dynstr.h"
 #include "BLI_rect.h"
+#include "BLI_string_utils.h"
 
 #include "BKE_object.h"
 
@@ -37,6 +38,7 @@
 
 static struct {
 	struct GPUShader *shadow_sh;
+	struct GPUShader *shadow_skin_sh;
 	struct GPUShader *shadow_store_cube_sh[SHADOW_METHOD_MAX];
 	struct GPUShader *shadow_store_cascade_sh[SHADOW_METHOD_MAX];
 	struct GPUShader *shadow_copy_cube_sh[SHADOW_METHOD_MAX];
@@ -48,6 +50,7 @@ extern char datatoc_shadow_geom_glsl[];
 extern char datatoc_shadow_frag_glsl[];
 extern char datatoc_shadow_store_frag_glsl[];
 extern char datatoc_shadow_copy_frag_glsl[];
+extern char datatoc_skinning_lib_glsl[];
 extern char datatoc_concentric_samples_lib_glsl[];
 
 /* Prototype */
@@ -395,9 +398,33 @@ void EEVEE_lights_cache_shcaster_add(
 	        &sldata->lamps->shadow_instance_count);
 }
 
+/* Add a shadow caster skinned by the game engine, it uses its own shading group to bind its matrices. */
+void EEVEE_lights_cache_shcaster_skin_add(
+        EEVEE_ViewLayerData *sldata, EEVEE_PassList *psl, struct Gwn_Batch *geom, Object *ob,
+        struct GPUTexture *skin_tex)
+{
+	if (!e_data.shadow_skin_sh) {
+		char *vert_str = BLI_string_joinN(
+		        datatoc_skinning_lib_glsl,
+		        datatoc_shadow_vert_glsl);
+
+		e_data.shadow_skin_sh = DRW_shader_create(
+		        vert_str, datatoc_shadow_geom_glsl, datatoc_shadow_frag_glsl, "#define USE_SKINNING\n");
+
+		MEM_freeN(vert_str);
+	}
+
+	DRWShadingGroup *grp = DRW_shgroup_create(e_data.shadow_skin_sh, psl->shadow_pass);
+	DRW_shgroup_uniform_block(grp, "shadow_render_block", sldata->shadow_render_ubo);
+	DRW_shgroup_uniform_texture(grp, "skinMatrices", skin_tex);
+
+	DRW_shgroup_call_object_instances_add(grp, geom, ob, &sldata->lamps->shadow_instance_count);
+}
+
 void EEVEE_lights_cache_shcaster_material_add(
 	EEVEE_ViewLayerData *sldata, EEVEE_PassList *psl, struct GPUMaterial *gpumat,
-	struct Gwn_Batch *geom, struct Object *ob, float (*obmat)[4], float *alpha_threshold)
+	struct Gwn_Batch *geom, struct Object *ob, float (*obmat)[4], float *alpha_threshold,
+	struct GPUTexture *skin_tex)
 {
 	/* TODO / PERF : reuse the same shading group for objects with the same material */
 	DRWShadingGroup *grp = DRW_shgroup_material_create(gpumat, psl->shadow_pass);
@@ -410,6 +437,9 @@ void EEVEE_lights_cache_shcaster_material_add(
 	if (alpha_threshold != NULL)
 		DRW_shgroup_uniform_float(grp, "alphaThreshold", alpha_threshold, 1);
 
+	if (skin_tex != NULL)
+		DRW_shgroup_uniform_texture(grp, "skinMatrices", skin_tex);
+
 	DRW_shgroup_call_object_instances_add(grp, geom, ob, &sldata->lamps->shadow_instance_count);
 }
 
@@ -1215,6 +1245,7 @@ void EEVEE_draw_shadows(EEVEE_ViewLayerData *sldata, EEVEE_PassList *psl)
 void EEVEE_lights_free(void)
 {
 	DRW_SHADER_FREE_SAFE(e_data.shadow_sh);
+	DRW_SHADER_FREE_SAFE(e_data.shadow_skin_sh);
 	for (int i = 0; i < SHADOW_METHOD_MAX; ++i) {
 		DRW_SHADER_FREE_SAFE(e_data.shadow_store_cube_sh[i]);
 		DRW_SHADER_FREE_SAFE(e_data.shadow_store_cascade_sh[i]);
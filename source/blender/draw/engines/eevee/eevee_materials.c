@@ -35,6 +35,7 @@
 #include "BKE_paint.h"
 #include "BKE_pbvh.h"
 
+#include "DNA_mesh_types.h"
 #include "DNA_world_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_view3d_types.h"
@@ -50,9 +51,14 @@ static struct {
 	char *shadow_shader_lib;
 	char *frag_shader_lib;
 	char *volume_shader_lib;
+	/* Vertex shaders including the game engine skinning. */
+	char *lit_surface_vert;
+	char *shadow_vert;
 
 	struct GPUShader *default_prepass_sh;
 	struct GPUShader *default_prepass_clip_sh;
+	struct GPUShader *default_prepass_skin_sh;
+	struct GPUShader *default_prepass_skin_clip_sh;
 	struct GPUShader *default_lit[VAR_MAT_MAX];
 	struct GPUShader *default_background;
 	struct GPUShader *update_noise_sh;
@@ -91,6 +97,7 @@ extern char datatoc_raytrace_lib_glsl[];
 extern char datatoc_ssr_lib_glsl[];
 extern char datatoc_shadow_vert_glsl[];
 extern char datatoc_shadow_geom_glsl[];
+extern char datatoc_skinning_lib_glsl[];
 extern char datatoc_lightprobe_geom_glsl[];
 extern char datatoc_lightprobe_vert_glsl[];
 extern char datatoc_background_vert_glsl[];
@@ -322,6 +329,9 @@ static char *eevee_get_defines(int options)
 	if (((options & VAR_MAT_VOLUME) != 0) && ((options & VAR_MAT_BLEND) != 0)) {
 		BLI_dynstr_appendf(ds, "#define USE_ALPHA_BLEND_VOLUMETRICS\n");
 	}
+	if ((options & VAR_MAT_SKIN) != 0) {
+		BLI_dynstr_appendf(ds, "#define USE_SKINNING\n");
+	}
 
 	str = BLI_dynstr_get_cstring(ds);
 	BLI_dynstr_free(ds);
@@ -417,12 +427,53 @@ static void create_default_shader(int options)
 
 	char *defines = eevee_get_defines(options);
 
-	e_data.default_lit[options] = DRW_shader_create(datatoc_lit_surface_vert_glsl, NULL, frag_str, defines);
+	e_data.default_lit[options] = DRW_shader_create(e_data.lit_surface_vert, NULL, frag_str, defines);
 
 	MEM_freeN(defines);
 	MEM_freeN(frag_str);
 }
 
+/* Depth prepass shaders of the meshes skinned by the game engine, created on first use. */
+static void eevee_init_prepass_skin_shaders(void)
+{
+	if (e_data.default_prepass_skin_sh) {
+		return;
+	}
+
+	char *vert_str = BLI_string_joinN(
+	        datatoc_skinning_lib_glsl,
+	        datatoc_prepass_vert_glsl);
+
+	e_data.default_prepass_skin_sh = DRW_shader_create(
+	        vert_str, NULL, datatoc_prepass_frag_glsl,
+	        "#define USE_SKINNING\n");
+
+	e_data.default_prepass_skin_clip_sh = DRW_shader_create(
+	        vert_str, NULL, datatoc_prepass_frag_glsl,
+	        "#define CLIP_PLANES\n"
+	        "#define USE_SKINNING\n");
+
+	MEM_freeN(vert_str);
+}
+
+/**
+ * Create the default depth prepass shading groups of an object skinned by the game engine
+ * inside the given passes, the groups are not shared because they bind the object matrices.
+ **/
+static void EEVEE_default_skin_depth_shading_group_create(
+        EEVEE_ViewLayerData *sldata, DRWPass *pass, DRWPass *pass_clip, struct GPUTexture *skin_tex,
+        struct DRWShadingGroup **shgrp_depth, struct DRWShadingGroup **shgrp_depth_clip)
+{
+	eevee_init_prepass_skin_shaders();
+
+	*shgrp_depth = DRW_shgroup_create(e_data.default_prepass_skin_sh, pass);
+	DRW_shgroup_uniform_texture(*shgrp_depth, "skinMatrices", skin_tex);
+
+	*shgrp_depth_clip = DRW_shgroup_create(e_data.default_prepass_skin_clip_sh, pass_clip);
+	DRW_shgroup_uniform_block(*shgrp_depth_clip, "clip_block", sldata->clip_ubo);
+	DRW_shgroup_uniform_texture(*shgrp_depth_clip, "skinMatrices", skin_tex);
+}
+
 static void eevee_init_noise_texture(void)
 {
 	e_data.noise_tex = DRW_texture_create_2D(64, 64, DRW_TEX_RGBA_16, 0, (float *)blue_noise);
@@ -578,6 +629,15 @@ void EEVEE_materials_init(EEVEE_ViewLayerData *sldata, EEVEE_StorageList *stl, E
 		        e_data.frag_shader_lib,
 		        datatoc_default_frag_glsl);
 
+		/* The skinning is only enabled by the USE_SKINNING define. */
+		e_data.lit_surface_vert = BLI_string_joinN(
+		        datatoc_skinning_lib_glsl,
+		        datatoc_lit_surface_vert_glsl);
+
+		e_data.shadow_vert = BLI_string_joinN(
+		        datatoc_skinning_lib_glsl,
+		        datatoc_shadow_vert_glsl);
+
 		e_data.default_background = DRW_shader_create(
 		        datatoc_background_vert_glsl, NULL, datatoc_default_world_frag_glsl,
 		        NULL);
@@ -682,7 +742,8 @@ struct GPUMaterial *EEVEE_material_world_volume_get(struct Scene *scene, World *
 
 struct GPUMaterial *EEVEE_material_mesh_get(
         struct Scene *scene, Material *ma, EEVEE_Data *vedata,
-        bool use_blend, bool use_multiply, bool use_refract, bool use_sss, bool use_translucency, int shadow_method)
+        bool use_blend, bool use_multiply, bool use_refract, bool use_sss, bool use_translucency, bool use_skin,
+        int shadow_method)
 {
 	EEVEE_EffectsInfo *effects = vedata->stl->effects;
 	const void *engine = &DRW_engine_viewport_eevee_type;
@@ -694,6 +755,7 @@ struct GPUMaterial *EEVEE_material_mesh_get(
 	if (use_sss) options |= VAR_MAT_SSS;
 	if (use_sss && effects->sss_separate_albedo) options |= VAR_MAT_SSSALBED;
 	if (use_translucency) options |= VAR_MAT_TRANSLUC;
+	if (use_skin) options |= VAR_MAT_SKIN;
 	if (((effects->enabled_effects & EFFECT_VOLUMETRIC) != 0) && use_blend) options |= VAR_MAT_VOLUME;
 
 	options |= eevee_material_shadow_option(shadow_method);
@@ -707,7 +769,7 @@ struct GPUMaterial *EEVEE_material_mesh_get(
 
 	mat = DRW_shader_create_from_material(
 	        scene, ma, engine, options,
-	        datatoc_lit_surface_vert_glsl, NULL, e_data.frag_shader_lib,
+	        e_data.lit_surface_vert, NULL, e_data.frag_shader_lib,
 	        defines);
 
 	MEM_freeN(defines);
@@ -739,7 +801,7 @@ struct GPUMaterial *EEVEE_material_mesh_volume_get(struct Scene *scene, Material
 
 struct GPUMaterial *EEVEE_material_mesh_depth_get(
         struct Scene *scene, Material *ma,
-        bool use_hashed_alpha, bool is_shadow)
+        bool use_hashed_alpha, bool is_shadow, bool use_skin)
 {
 	const void *engine = &DRW_engine_viewport_eevee_type;
 	int options = VAR_MAT_MESH;
@@ -754,6 +816,9 @@ struct GPUMaterial *EEVEE_material_mesh_depth_get(
 	if (is_shadow)
 		options |= VAR_MAT_SHADOW;
 
+	if (use_skin)
+		options |= VAR_MAT_SKIN;
+
 	GPUMaterial *mat = DRW_shader_find_from_material(ma, engine, options);
 	if (mat) {
 		return mat;
@@ -767,7 +832,7 @@ struct GPUMaterial *EEVEE_material_mesh_depth_get(
 
 	mat = DRW_shader_create_from_material(
 	        scene, ma, engine, options,
-	        (is_shadow) ? datatoc_shadow_vert_glsl : datatoc_lit_surface_vert_glsl,
+	        (is_shadow) ? e_data.shadow_vert : e_data.lit_surface_vert,
 	        (is_shadow) ? datatoc_shadow_geom_glsl : NULL,
 	        frag_str,
 	        defines);
@@ -795,7 +860,7 @@ struct GPUMaterial *EEVEE_material_hair_get(
 
 	mat = DRW_shader_create_from_material(
 	        scene, ma, engine, options,
-	        datatoc_lit_surface_vert_glsl, NULL, e_data.frag_shader_lib,
+	        e_data.lit_surface_vert, NULL, e_data.frag_shader_lib,
 	        defines);
 
 	MEM_freeN(defines);
@@ -808,7 +873,7 @@ struct GPUMaterial *EEVEE_material_hair_get(
  **/
 static struct DRWShadingGroup *EEVEE_default_shading_group_create(
         EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata, DRWPass *pass,
-        bool is_hair, bool is_flat_normal, bool use_blend, bool use_ssr, int shadow_method)
+        bool is_hair, bool is_flat_normal, bool use_blend, bool use_ssr, bool use_skin, int shadow_method)
 {
 	EEVEE_EffectsInfo *effects = vedata->stl->effects;
 	static int ssr_id;
@@ -818,6 +883,7 @@ static struct DRWShadingGroup *EEVEE_default_shading_group_create(
 	if (is_hair) options |= VAR_MAT_HAIR;
 	if (is_flat_normal) options |= VAR_MAT_FLAT;
 	if (use_blend) options |= VAR_MAT_BLEND;
+	if (use_skin) options |= VAR_MAT_SKIN;
 	if (((effects->enabled_effects & EFFECT_VOLUMETRIC) != 0) && use_blend) options |= VAR_MAT_VOLUME;
 
 	options |= eevee_material_shadow_option(shadow_method);
@@ -1016,9 +1082,14 @@ typedef struct EeveeMaterialShadingGroups {
 	struct DRWShadingGroup *depth_clip_grp;
 } EeveeMaterialShadingGroups;
 
+/**
+ * skin_tex is the texture of the matrices of an object skinned by the game engine, its shading
+ * groups are created for this object only. It must be null for the other objects.
+ **/
 static void material_opaque(
         Material *ma, GHash *material_hash, EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
-        bool do_cull, bool use_flat_nor, struct GPUMaterial **gpumat, struct GPUMaterial **gpumat_depth,
+        bool do_cull, bool use_flat_nor, struct GPUTexture *skin_tex,
+        struct GPUMaterial **gpumat, struct GPUMaterial **gpumat_depth,
         struct DRWShadingGroup **shgrp, struct DRWShadingGroup **shgrp_depth, struct DRWShadingGroup **shgrp_depth_clip)
 {
 	EEVEE_EffectsInfo *effects = vedata->stl->effects;
@@ -1039,8 +1110,9 @@ static void material_opaque(
 	const bool use_sss = ((ma->blend_flag & MA_BL_SS_SUBSURFACE) != 0) &&
 	                     ((effects->enabled_effects & EFFECT_SSS) != 0);
 	const bool use_translucency = use_sss && ((ma->blend_flag & MA_BL_TRANSLUCENCY) != 0);
+	const bool use_skin = (skin_tex != NULL);
 
-	EeveeMaterialShadingGroups *emsg = BLI_ghash_lookup(material_hash, (const void *)ma);
+	EeveeMaterialShadingGroups *emsg = (use_skin) ? NULL : BLI_ghash_lookup(material_hash, (const void *)ma);
 
 	if (emsg) {
 		*shgrp = emsg->shading_grp;
@@ -1049,9 +1121,10 @@ static void material_opaque(
 
 		/* This will have been created already, just perform a lookup. */
 		*gpumat = (use_gpumat) ? EEVEE_material_mesh_get(
-		        scene, ma, vedata, false, false, use_refract, use_sss, use_translucency, linfo->shadow_method) : NULL;
+		        scene, ma, vedata, false, false, use_refract, use_sss, use_translucency, false,
+		        linfo->shadow_method) : NULL;
 		*gpumat_depth = (use_gpumat) ? EEVEE_material_mesh_depth_get(
-		        scene, ma, (ma->blend_method == MA_BM_HASHED), false) : NULL;
+		        scene, ma, (ma->blend_method == MA_BM_HASHED), false, false) : NULL;
 		return;
 	}
 
@@ -1062,7 +1135,7 @@ static void material_opaque(
 
 		/* Shading */
 		*gpumat = EEVEE_material_mesh_get(scene, ma, vedata, false, false, use_refract,
-		                                  use_sss, use_translucency, linfo->shadow_method);
+		                                  use_sss, use_translucency, use_skin, linfo->shadow_method);
 
 		GPUMaterialStatus status_mat_surface = GPU_material_status(*gpumat);
 
@@ -1070,7 +1143,7 @@ static void material_opaque(
 		 * fail the depth test for shading. */
 		if (ELEM(ma->blend_method, MA_BM_CLIP, MA_BM_HASHED)) {
 			*gpumat_depth = EEVEE_material_mesh_depth_get(scene, ma,
-			                                              (ma->blend_method == MA_BM_HASHED), false);
+			                                              (ma->blend_method == MA_BM_HASHED), false, use_skin);
 
 			GPUMaterialStatus status_mat_depth = GPU_material_status(*gpumat_depth);
 			if (status_mat_depth != GPU_MAT_SUCCESS) {
@@ -1099,6 +1172,11 @@ static void material_opaque(
 					DRW_shgroup_uniform_float(*shgrp_depth, "hashAlphaOffset", &e_data.alpha_hash_offset, 1);
 					DRW_shgroup_uniform_float(*shgrp_depth_clip, "hashAlphaOffset", &e_data.alpha_hash_offset, 1);
 				}
+
+				if (use_skin) {
+					DRW_shgroup_uniform_texture(*shgrp_depth, "skinMatrices", skin_tex);
+					DRW_shgroup_uniform_texture(*shgrp_depth_clip, "skinMatrices", skin_tex);
+				}
 			}
 		}
 
@@ -1114,6 +1192,10 @@ static void material_opaque(
 				                                     (use_sss) ? psl->sss_pass : psl->material_pass);
 				add_standard_uniforms(*shgrp, sldata, vedata, ssr_id, &ma->refract_depth, use_refract, false);
 
+				if (use_skin) {
+					DRW_shgroup_uniform_texture(*shgrp, "skinMatrices", skin_tex);
+				}
+
 				if (use_sss) {
 					struct GPUTexture *sss_tex_profile = NULL;
 					struct GPUUniformBuffer *sss_profile = GPU_material_sss_profile_get(*gpumat,
@@ -1159,7 +1241,16 @@ static void material_opaque(
 	/* Fallback to default shader */
 	if (*shgrp == NULL) {
 		bool use_ssr = ((effects->enabled_effects & EFFECT_SSR) != 0);
-		*shgrp = EEVEE_default_shading_group_get(sldata, vedata, false, use_flat_nor, use_ssr, linfo->shadow_method);
+		if (use_skin) {
+			/* The material pass uses the same state than the default passes. */
+			*shgrp = EEVEE_default_shading_group_create(
+			        sldata, vedata, psl->material_pass,
+			        false, use_flat_nor, false, use_ssr, true, linfo->shadow_method);
+			DRW_shgroup_uniform_texture(*shgrp, "skinMatrices", skin_tex);
+		}
+		else {
+			*shgrp = EEVEE_default_shading_group_get(sldata, vedata, false, use_flat_nor, use_ssr, linfo->shadow_method);
+		}
 		DRW_shgroup_uniform_vec3(*shgrp, "basecol", color_p, 1);
 		DRW_shgroup_uniform_float(*shgrp, "metallic", metal_p, 1);
 		DRW_shgroup_uniform_float(*shgrp, "specular", spec_p, 1);
@@ -1167,7 +1258,23 @@ static void material_opaque(
 	}
 
 	/* Fallback default depth prepass */
-	if (*shgrp_depth == NULL) {
+	if (*shgrp_depth == NULL && use_skin) {
+		if (use_refract) {
+			EEVEE_default_skin_depth_shading_group_create(
+			        sldata,
+			        (do_cull) ? psl->refract_depth_pass_cull : psl->refract_depth_pass,
+			        (do_cull) ? psl->refract_depth_pass_clip_cull : psl->refract_depth_pass_clip,
+			        skin_tex, shgrp_depth, shgrp_depth_clip);
+		}
+		else {
+			EEVEE_default_skin_depth_shading_group_create(
+			        sldata,
+			        (do_cull) ? psl->depth_pass_cull : psl->depth_pass,
+			        (do_cull) ? psl->depth_pass_clip_cull : psl->depth_pass_clip,
+			        skin_tex, shgrp_depth, shgrp_depth_clip);
+		}
+	}
+	else if (*shgrp_depth == NULL) {
 		if (use_refract) {
 			*shgrp_depth = (do_cull) ? stl->g_data->refract_depth_shgrp_cull : stl->g_data->refract_depth_shgrp;
 			*shgrp_depth_clip = (do_cull) ? stl->g_data->refract_depth_shgrp_clip_cull : stl->g_data->refract_depth_shgrp_clip;
@@ -1178,6 +1285,10 @@ static void material_opaque(
 		}
 	}
 
+	if (use_skin) {
+		return;
+	}
+
 	emsg = MEM_mallocN(sizeof(EeveeMaterialShadingGroups), "EeveeMaterialShadingGroups");
 	emsg->shading_grp = *shgrp;
 	emsg->depth_grp = *shgrp_depth;
@@ -1187,7 +1298,8 @@ static void material_opaque(
 
 static void material_transparent(
         Material *ma, EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata,
-        bool do_cull, bool use_flat_nor, struct GPUMaterial **gpumat, struct DRWShadingGroup **shgrp, struct DRWShadingGroup **shgrp_depth)
+        bool do_cull, bool use_flat_nor, struct GPUTexture *skin_tex,
+        struct GPUMaterial **gpumat, struct DRWShadingGroup **shgrp, struct DRWShadingGroup **shgrp_depth)
 {
 	const DRWContextState *draw_ctx = DRW_context_state_get();
 	Scene *scene = draw_ctx->scene;
@@ -1196,6 +1308,7 @@ static void material_transparent(
 	EEVEE_LampsInfo *linfo = sldata->lamps;
 
 	const bool use_refract = ((ma->blend_flag & MA_BL_SS_REFRACTION) != 0) && ((stl->effects->enabled_effects & EFFECT_REFRACT) != 0);
+	const bool use_skin = (skin_tex != NULL);
 
 	float *color_p = &ma->r;
 	float *metal_p = &ma->ray_mirror;
@@ -1209,7 +1322,7 @@ static void material_transparent(
 
 		/* Shading */
 		*gpumat = EEVEE_material_mesh_get(scene, ma, vedata, true, (ma->blend_method == MA_BM_MULTIPLY), use_refract,
-		                                  false, false, linfo->shadow_method);
+		                                  false, false, use_skin, linfo->shadow_method);
 
 		switch (GPU_material_status(*gpumat)) {
 			case GPU_MAT_SUCCESS:
@@ -1241,7 +1354,7 @@ static void material_transparent(
 	if (*shgrp == NULL) {
 		*shgrp = EEVEE_default_shading_group_create(
 		        sldata, vedata, psl->transparent_pass,
-		        false, use_flat_nor, true, false, linfo->shadow_method);
+		        false, use_flat_nor, true, false, use_skin, linfo->shadow_method);
 		DRW_shgroup_uniform_vec3(*shgrp, "basecol", color_p, 1);
 		DRW_shgroup_uniform_float(*shgrp, "metallic", metal_p, 1);
 		DRW_shgroup_uniform_float(*shgrp, "specular", spec_p, 1);
@@ -1276,9 +1389,20 @@ static void material_transparent(
 	DRW_shgroup_state_disable(*shgrp, all_state);
 	DRW_shgroup_state_enable(*shgrp, cur_state);
 
+	if (use_skin) {
+		DRW_shgroup_uniform_texture(*shgrp, "skinMatrices", skin_tex);
+	}
+
 	/* Depth prepass */
 	if (use_prepass) {
-		*shgrp_depth = DRW_shgroup_create(e_data.default_prepass_clip_sh, psl->transparent_pass);
+		if (use_skin) {
+			eevee_init_prepass_skin_shaders();
+			*shgrp_depth = DRW_shgroup_create(e_data.default_prepass_skin_clip_sh, psl->transparent_pass);
+			DRW_shgroup_uniform_texture(*shgrp_depth, "skinMatrices", skin_tex);
+		}
+		else {
+			*shgrp_depth = DRW_shgroup_create(e_data.default_prepass_clip_sh, psl->transparent_pass);
+		}
 		DRW_shgroup_uniform_block(*shgrp_depth, "clip_block", sldata->clip_ubo);
 
 		cur_state = DRW_STATE_WRITE_DEPTH | DRW_STATE_DEPTH_LESS;
@@ -1289,6 +1413,19 @@ static void material_transparent(
 	}
 }
 
+/* Add a solid shadow caster, skinned by the game engine when skin_tex is not null. */
+static void material_shadow_add(
+        EEVEE_ViewLayerData *sldata, EEVEE_StorageList *stl, EEVEE_PassList *psl,
+        struct Gwn_Batch *geom, Object *ob, struct GPUTexture *skin_tex)
+{
+	if (skin_tex) {
+		EEVEE_lights_cache_shcaster_skin_add(sldata, psl, geom, ob, skin_tex);
+	}
+	else {
+		EEVEE_lights_cache_shcaster_add(sldata, stl, geom, ob);
+	}
+}
+
 void EEVEE_materials_cache_populate(EEVEE_Data *vedata, EEVEE_ViewLayerData *sldata, Object *ob)
 {
 	EEVEE_PassList *psl = vedata->psl;
@@ -1311,6 +1448,12 @@ void EEVEE_materials_cache_populate(EEVEE_Data *vedata, EEVEE_ViewLayerData *sld
 #endif
 	const bool is_default_mode_shader = is_sculpt_mode;
 
+	/* Meshes skinned on the GPU by the game engine. */
+	struct GPUTexture *skin_tex = NULL;
+	if (DRW_state_is_game_engine() && ob->type == OB_MESH && ((Mesh *)ob->data)->dvert) {
+		skin_tex = DRW_game_skin_texture_get(ob);
+	}
+
 	/* First get materials for this mesh. */
 	if (ELEM(ob->type, OB_MESH, OB_CURVE, OB_SURF, OB_FONT)) {
 		const int materials_len = MAX2(1, (is_sculpt_mode_draw ? 1 : ob->totcol));
@@ -1353,14 +1496,14 @@ void EEVEE_materials_cache_populate(EEVEE_Data *vedata, EEVEE_ViewLayerData *sld
 				case MA_BM_SOLID:
 				case MA_BM_CLIP:
 				case MA_BM_HASHED:
-					material_opaque(ma, material_hash, sldata, vedata, do_cull, use_flat_nor,
+					material_opaque(ma, material_hash, sldata, vedata, do_cull, use_flat_nor, skin_tex,
 					        &gpumat_array[i], &gpumat_depth_array[i],
 					        &shgrp_array[i], &shgrp_depth_array[i], &shgrp_depth_clip_array[i]);
 					break;
 				case MA_BM_ADD:
 				case MA_BM_MULTIPLY:
 				case MA_BM_BLEND:
-					material_transparent(ma, sldata, vedata, do_cull, use_flat_nor,
+					material_transparent(ma, sldata, vedata, do_cull, use_flat_nor, skin_tex,
 					        &gpumat_array[i], &shgrp_array[i], &shgrp_depth_array[i]);
 					break;
 				default:
@@ -1379,8 +1522,10 @@ void EEVEE_materials_cache_populate(EEVEE_Data *vedata, EEVEE_ViewLayerData *sld
 		 */
 		bool use_volume_material = (gpumat_array[0] && GPU_material_use_domain_volume(gpumat_array[0]));
 
-		/* Get per-material split surface */
-		struct Gwn_Batch **mat_geom = DRW_cache_object_surface_material_get(ob, gpumat_array, materials_len);
+		/* Get per-material split surface, the skinned surface also contains the vertex groups. */
+		struct Gwn_Batch **mat_geom = (skin_tex) ?
+		        DRW_cache_mesh_surface_skinned_get(ob, gpumat_array, materials_len) :
+		        DRW_cache_object_surface_material_get(ob, gpumat_array, materials_len);
 		if (mat_geom) {
 			for (int i = 0; i < materials_len; ++i) {
 				Material *ma = give_current_material(ob, i + 1);
@@ -1408,15 +1553,17 @@ void EEVEE_materials_cache_populate(EEVEE_Data *vedata, EEVEE_ViewLayerData *sld
 					struct GPUMaterial *gpumat;
 					switch (ma->blend_shadow) {
 						case MA_BS_SOLID:
-							EEVEE_lights_cache_shcaster_add(sldata, stl, mat_geom[i], ob);
+							material_shadow_add(sldata, stl, psl, mat_geom[i], ob, skin_tex);
 							break;
 						case MA_BS_CLIP:
-							gpumat = EEVEE_material_mesh_depth_get(scene, ma, false, true);
-							EEVEE_lights_cache_shcaster_material_add(sldata, psl, gpumat, mat_geom[i], ob, ob->obmat, &ma->alpha_threshold);
+							gpumat = EEVEE_material_mesh_depth_get(scene, ma, false, true, (skin_tex != NULL));
+							EEVEE_lights_cache_shcaster_material_add(
+							        sldata, psl, gpumat, mat_geom[i], ob, ob->obmat, &ma->alpha_threshold, skin_tex);
 							break;
 						case MA_BS_HASHED:
-							gpumat = EEVEE_material_mesh_depth_get(scene, ma, true, true);
-							EEVEE_lights_cache_shcaster_material_add(sldata, psl, gpumat, mat_geom[i], ob, ob->obmat, NULL);
+							gpumat = EEVEE_material_mesh_depth_get(scene, ma, true, true, (skin_tex != NULL));
+							EEVEE_lights_cache_shcaster_material_add(
+							        sldata, psl, gpumat, mat_geom[i], ob, ob->obmat, NULL, skin_tex);
 							break;
 						case MA_BS_NONE:
 						default:
@@ -1424,7 +1571,7 @@ void EEVEE_materials_cache_populate(EEVEE_Data *vedata, EEVEE_ViewLayerData *sld
 					}
 				}
 				else {
-					EEVEE_lights_cache_shcaster_add(sldata, stl, mat_geom[i], ob);
+					material_shadow_add(sldata, stl, psl, mat_geom[i], ob, skin_tex);
 				}
 			}
 		}
@@ -1533,8 +1680,12 @@ void EEVEE_materials_free(void)
 	MEM_SAFE_FREE(e_data.shadow_shader_lib);
 	MEM_SAFE_FREE(e_data.frag_shader_lib);
 	MEM_SAFE_FREE(e_data.volume_shader_lib);
+	MEM_SAFE_FREE(e_data.lit_surface_vert);
+	MEM_SAFE_FREE(e_data.shadow_vert);
 	DRW_SHADER_FREE_SAFE(e_data.default_prepass_sh);
 	DRW_SHADER_FREE_SAFE(e_data.default_prepass_clip_sh);
+	DRW_SHADER_FREE_SAFE(e_data.default_prepass_skin_sh);
+	DRW_SHADER_FREE_SAFE(e_data.default_prepass_skin_clip_sh);
 	DRW_SHADER_FREE_SAFE(e_data.default_background);
 	DRW_SHADER_FREE_SAFE(e_data.update_noise_sh);
 	DRW_TEXTURE_FREE_SAFE(e_data.util_tex);
@@ -111,20 +111,21 @@ enum {
 	VAR_MAT_VSM      = (1 << 5),
 	VAR_MAT_ESM      = (1 << 6),
 	VAR_MAT_VOLUME   = (1 << 7),
+	VAR_MAT_SKIN     = (1 << 8),
 	/* Max number of variation */
 	/* IMPORTANT : Leave it last and set
 	 * it's value accordingly. */
-	VAR_MAT_MAX      = (1 << 8),
+	VAR_MAT_MAX      = (1 << 9),
 	/* These are options that are not counted in VAR_MAT_MAX
 	 * because they are not cumulative with the others above. */
-	VAR_MAT_CLIP     = (1 << 9),
-	VAR_MAT_HASH     = (1 << 10),
-	VAR_MAT_MULT     = (1 << 11),
-	VAR_MAT_SHADOW   = (1 << 12),
-	VAR_MAT_REFRACT  = (1 << 13),
-	VAR_MAT_SSS      = (1 << 14),
-	VAR_MAT_TRANSLUC = (1 << 15),
-	VAR_MAT_SSSALBED = (1 << 16),
+	VAR_MAT_CLIP     = (1 << 10),
+	VAR_MAT_HASH     = (1 << 11),
+	VAR_MAT_MULT     = (1 << 12),
+	VAR_MAT_SHADOW   = (1 << 13),
+	VAR_MAT_REFRACT  = (1 << 14),
+	VAR_MAT_SSS      = (1 << 15),
+	VAR_MAT_TRANSLUC = (1 << 16),
+	VAR_MAT_SSSALBED = (1 << 17),
 };
 
 /* Shadow Technique */
@@ -795,9 +796,11 @@ struct GPUMaterial *EEVEE_material_world_background_get(struct Scene *scene, str
 struct GPUMaterial *EEVEE_material_world_volume_get(struct Scene *scene, struct World *wo);
 struct GPUMaterial *EEVEE_material_mesh_get(
         struct Scene *scene, Material *ma, EEVEE_Data *vedata,
-        bool use_blend, bool use_multiply, bool use_refract, bool use_sss, bool use_translucency, int shadow_method);
+        bool use_blend, bool use_multiply, bool use_refract, bool use_sss, bool use_translucency, bool use_skin,
+        int shadow_method);
 struct GPUMaterial *EEVEE_material_mesh_volume_get(struct Scene *scene, Material *ma);
-struct GPUMaterial *EEVEE_material_mesh_depth_get(struct Scene *scene, Material *ma, bool use_hashed_alpha, bool is_shadow);
+struct GPUMaterial *EEVEE_material_mesh_depth_get(
+        struct Scene *scene, Material *ma, bool use_hashed_alpha, bool is_shadow, bool use_skin);
 struct GPUMaterial *EEVEE_material_hair_get(struct Scene *scene, Material *ma, int shadow_method);
 void EEVEE_materials_free(void);
 void EEVEE_draw_default_passes(EEVEE_PassList *psl);
@@ -809,10 +812,13 @@ void EEVEE_lights_cache_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata);
 void EEVEE_lights_cache_add(EEVEE_ViewLayerData *sldata, struct Object *ob);
 void EEVEE_lights_cache_shcaster_add(
         EEVEE_ViewLayerData *sldata, EEVEE_StorageList *stl, struct Gwn_Batch *geom, Object *ob);
+void EEVEE_lights_cache_shcaster_skin_add(
+        EEVEE_ViewLayerData *sldata, EEVEE_PassList *psl, struct Gwn_Batch *geom, Object *ob,
+        struct GPUTexture *skin_tex);
 void EEVEE_lights_cache_shcaster_material_add(
         EEVEE_ViewLayerData *sldata, EEVEE_PassList *psl,
         struct GPUMaterial *gpumat, struct Gwn_Batch *geom, struct Object *ob,
-        float (*obmat)[4], float *alpha_threshold);
+        float (*obmat)[4], float *alpha_threshold, struct GPUTexture *skin_tex);
 void EEVEE_lights_cache_shcaster_object_add(EEVEE_ViewLayerData *sldata, struct Object *ob);
 void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata);
 void EEVEE_lights_update(EEVEE_ViewLayerData *sldata);
@@ -965,4 +971,8 @@ struct GPUTexture *DRW_game_render_loop(struct Main *bmain, struct Scene *scene,
 void DRW_game_render_loop_finish(void);
 void DRW_game_render_loop_end(void);
 
+void DRW_game_skin_set(struct Object *ob, const float *matrices, int num_matrices);
+void DRW_game_skin_remove(struct Object *ob);
+struct GPUTexture *DRW_game_skin_texture_get(struct Object *ob);
+
 #endif /* __EEVEE_PRIVATE_H__ */
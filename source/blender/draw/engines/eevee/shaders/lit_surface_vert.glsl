@@ -28,11 +28,17 @@ out vec3 viewNormal;
 #endif
 
 void main() {
-	gl_Position = ModelViewProjectionMatrix * vec4(pos, 1.0);
-	viewPosition = (ModelViewMatrix * vec4(pos, 1.0)).xyz;
-	worldPosition = (ModelMatrix * vec4(pos, 1.0)).xyz;
-	viewNormal = normalize(NormalMatrix * nor);
-	worldNormal = normalize(WorldNormalMatrix * nor);
+	vec3 co = pos;
+	vec3 no = nor;
+#ifdef USE_SKINNING
+	skin_vertex(co, no);
+#endif
+
+	gl_Position = ModelViewProjectionMatrix * vec4(co, 1.0);
+	viewPosition = (ModelViewMatrix * vec4(co, 1.0)).xyz;
+	worldPosition = (ModelMatrix * vec4(co, 1.0)).xyz;
+	viewNormal = normalize(NormalMatrix * no);
+	worldNormal = normalize(WorldNormalMatrix * no);
 
 	/* Used for planar reflections */
 	gl_ClipDistance[0] = dot(vec4(worldPosition, 1.0), ClipPlanes[0]);
@@ -11,9 +11,14 @@ in vec3 pos;
 
 void main()
 {
-	gl_Position = ModelViewProjectionMatrix * vec4(pos, 1.0);
+	vec3 co = pos;
+#ifdef USE_SKINNING
+	skin_vertex(co);
+#endif
+
+	gl_Position = ModelViewProjectionMatrix * vec4(co, 1.0);
 #ifdef CLIP_PLANES
-	vec4 worldPosition = (ModelMatrix * vec4(pos, 1.0));
+	vec4 worldPosition = (ModelMatrix * vec4(co, 1.0));
 	gl_ClipDistance[0] = dot(vec4(worldPosition.xyz, 1.0), ClipPlanes[0]);
 #endif
 	/* TODO motion vectors */
@@ -17,11 +17,21 @@ out vec3 vNor;
 flat out int face;
 
 void main() {
-	vPos = ModelMatrix * vec4(pos, 1.0);
+	vec3 co = pos;
+#ifdef MESH_SHADER
+	vec3 no = nor;
+#  ifdef USE_SKINNING
+	skin_vertex(co, no);
+#  endif
+#elif defined(USE_SKINNING)
+	skin_vertex(co);
+#endif
+
+	vPos = ModelMatrix * vec4(co, 1.0);
 	face = gl_InstanceID;
 
 #ifdef MESH_SHADER
-	vNor = WorldNormalMatrix * nor;
+	vNor = WorldNormalMatrix * no;
 #ifdef ATTRIB
 	pass_attrib(pos);
 #endif
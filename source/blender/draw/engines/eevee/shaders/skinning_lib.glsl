@@ -0,0 +1,45 @@
+
+#ifdef USE_SKINNING
+/* Game engine skinning, each row of the texture stores the matrix of a vertex group
+ * in 4 texels. The groups not deforming use a null matrix and are ignored. */
+uniform sampler2D skinMatrices;
+
+in uvec4 skinGroups;
+in vec4 skinWeights;
+
+mat4 skin_matrix(uint group)
+{
+	int row = int(group);
+	return mat4(texelFetch(skinMatrices, ivec2(0, row), 0),
+	            texelFetch(skinMatrices, ivec2(1, row), 0),
+	            texelFetch(skinMatrices, ivec2(2, row), 0),
+	            texelFetch(skinMatrices, ivec2(3, row), 0));
+}
+
+void skin_vertex(inout vec3 co, inout vec3 no)
+{
+	vec4 skin_co = vec4(0.0);
+	vec3 skin_no = vec3(0.0);
+	float total = 0.0;
+
+	for (int i = 0; i < 4; ++i) {
+		mat4 mat = skin_matrix(skinGroups[i]);
+		/* The last component is 1 for the deforming groups and 0 for the others. */
+		float weight = skinWeights[i] * mat[3][3];
+		skin_co += weight * (mat * vec4(co, 1.0));
+		skin_no += weight * (mat3(mat) * no);
+		total += weight;
+	}
+
+	if (total > 0.0) {
+		co = skin_co.xyz / total;
+		no = skin_no / total;
+	}
+}
+
+void skin_vertex(inout vec3 co)
+{
+	vec3 no = vec3(0.0);
+	skin_vertex(co, no);
+}
+#endif
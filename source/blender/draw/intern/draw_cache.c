@@ -24,6 +24,8 @@
  */
 
 
+#include "DNA_action_types.h"
+#include "DNA_armature_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_curve_types.h"
@@ -32,10 +34,16 @@
 #include "DNA_modifier_types.h"
 #include "DNA_lattice_types.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "UI_resources.h"
 
 #include "BLI_utildefines.h"
 #include "BLI_math.h"
+#include "BLI_listbase.h"
+
+#include "BKE_action.h"
+#include "BKE_modifier.h"
 
 #include "GPU_batch.h"
 
@@ -2306,6 +2314,49 @@ Gwn_Batch **DRW_cache_mesh_surface_shaded_get(
 	return DRW_mesh_batch_cache_get_surface_shaded(me, gpumat_array, gpumat_array_len);
 }
 
+/**
+ * Flag the vertex groups deforming the mesh in the game engine skinning: the groups of a bone of
+ * the armature without the no deform flag, like BL_SkinDeformer. Return NULL without armature.
+ */
+static bool *mesh_skin_deform_groups_get(Object *ob, int *r_len)
+{
+	Object *arma = modifiers_isDeformedByArmature(ob);
+	if (!arma && ob->parent && ob->parent->type == OB_ARMATURE) {
+		arma = ob->parent;
+	}
+	if (!arma || !arma->pose) {
+		*r_len = 0;
+		return NULL;
+	}
+
+	const int len = BLI_listbase_count(&ob->defbase);
+	bool *deform_groups = MEM_callocN(sizeof(*deform_groups) * max_ii(len, 1), __func__);
+	int i = 0;
+	for (bDeformGroup *dg = ob->defbase.first; dg; dg = dg->next, i++) {
+		bPoseChannel *pchan = BKE_pose_channel_find_name(arma->pose, dg->name);
+		deform_groups[i] = (pchan && pchan->bone && !(pchan->bone->flag & BONE_NO_DEFORM));
+	}
+
+	*r_len = len;
+	return deform_groups;
+}
+
+/* Return list of batches, same as shaded batches with the vertex groups for the game engine skinning. */
+Gwn_Batch **DRW_cache_mesh_surface_skinned_get(
+        Object *ob, struct GPUMaterial **gpumat_array, uint gpumat_array_len)
+{
+	BLI_assert(ob->type == OB_MESH);
+
+	Mesh *me = ob->data;
+	int deform_groups_len;
+	bool *deform_groups = mesh_skin_deform_groups_get(ob, &deform_groups_len);
+	Gwn_Batch **batches = DRW_mesh_batch_cache_get_surface_skinned(
+	        me, gpumat_array, gpumat_array_len, deform_groups, deform_groups_len);
+	MEM_SAFE_FREE(deform_groups);
+
+	return batches;
+}
+
 /* Return list of batches */
 Gwn_Batch **DRW_cache_mesh_surface_texpaint_get(Object *ob)
 {
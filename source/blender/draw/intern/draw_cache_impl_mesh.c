@@ -1501,6 +1501,10 @@ typedef struct MeshBatchCache {
 	Gwn_IndexBuf **shaded_triangles_in_order;
 	Gwn_Batch **shaded_triangles;
 
+	/* Game engine GPU skinning, shaded triangles with the vertex groups. */
+	Gwn_VertBuf *skin_weights;
+	Gwn_Batch **skinned_triangles;
+
 	/* Texture Paint.*/
 	/* per-texture batch */
 	Gwn_Batch **texpaint_triangles;
@@ -1690,6 +1694,12 @@ static void mesh_batch_cache_clear_selective(Mesh *me, Gwn_VertBuf *vert)
 			}
 		}
 		MEM_SAFE_FREE(cache->shaded_triangles);
+		if (cache->skinned_triangles) {
+			for (int i = 0; i < cache->mat_len; ++i) {
+				GWN_BATCH_DISCARD_SAFE(cache->skinned_triangles[i]);
+			}
+		}
+		MEM_SAFE_FREE(cache->skinned_triangles);
 		if (cache->texpaint_triangles) {
 			for (int i = 0; i < cache->mat_len; ++i) {
 				GWN_BATCH_DISCARD_SAFE(cache->texpaint_triangles[i]);
@@ -1772,6 +1782,14 @@ static void mesh_batch_cache_clear(Mesh *me)
 	MEM_SAFE_FREE(cache->shaded_triangles_in_order);
 	MEM_SAFE_FREE(cache->shaded_triangles);
 
+	GWN_VERTBUF_DISCARD_SAFE(cache->skin_weights);
+	if (cache->skinned_triangles) {
+		for (int i = 0; i < cache->mat_len; ++i) {
+			GWN_BATCH_DISCARD_SAFE(cache->skinned_triangles[i]);
+		}
+	}
+	MEM_SAFE_FREE(cache->skinned_triangles);
+
 	if (cache->texpaint_triangles) {
 		for (int i = 0; i < cache->mat_len; ++i) {
 			GWN_BATCH_DISCARD_SAFE(cache->texpaint_triangles[i]);
@@ -2464,6 +2482,95 @@ static Gwn_VertBuf *mesh_create_verts_select_id(
 	return vbo;
 }
 
+/**
+ * Vertex groups of the game engine GPU skinning, the 4 strongest deforming groups of each vertex
+ * with their normalized weights, as computed by the CPU skinning. The groups not flagged in
+ * deform_groups are skipped, all groups are used when it's NULL.
+ * Return NULL when the mesh has no deform vertices.
+ */
+static Gwn_VertBuf *mesh_batch_cache_get_tri_skin_weights(
+        MeshRenderData *rdata, MeshBatchCache *cache, const bool *deform_groups, int deform_groups_len)
+{
+	BLI_assert(
+	        rdata->types &
+	        (MR_DATATYPE_VERT | MR_DATATYPE_LOOPTRI | MR_DATATYPE_LOOP | MR_DATATYPE_POLY | MR_DATATYPE_DVERT));
+
+	/* The game engine doesn't use edit meshes. */
+	if (rdata->dvert == NULL || rdata->edit_bmesh) {
+		return NULL;
+	}
+
+	if (cache->skin_weights == NULL) {
+		static Gwn_VertFormat format = { 0 };
+		static struct { uint groups, weights; } attr_id;
+		if (format.attrib_ct == 0) {
+			attr_id.groups = GWN_vertformat_attr_add(&format, "skinGroups", GWN_COMP_U16, 4, GWN_FETCH_INT);
+			attr_id.weights = GWN_vertformat_attr_add(&format, "skinWeights", GWN_COMP_F32, 4, GWN_FETCH_FLOAT);
+		}
+
+		const int tri_len = mesh_render_data_looptri_len_get(rdata);
+		const int vert_len = mesh_render_data_verts_len_get(rdata);
+
+		/* Compute the influences once per vertex. */
+		unsigned short (*vert_groups)[4] = MEM_callocN(sizeof(*vert_groups) * vert_len, __func__);
+		float (*vert_weights)[4] = MEM_callocN(sizeof(*vert_weights) * vert_len, __func__);
+
+		for (int i = 0; i < vert_len; i++) {
+			const MDeformVert *dv = &rdata->dvert[i];
+			unsigned short *groups = vert_groups[i];
+			float *weights = vert_weights[i];
+			int count = 0;
+
+			/* Insertion sort of the strongest weights. */
+			for (int j = 0; j < dv->totweight; j++) {
+				const MDeformWeight *dw = &dv->dw[j];
+				if (deform_groups && (dw->def_nr >= deform_groups_len || !deform_groups[dw->def_nr])) {
+					continue;
+				}
+				if (dw->weight <= 0.0f || (count == 4 && dw->weight <= weights[3])) {
+					continue;
+				}
+
+				int k = MIN2(count, 3);
+				for (; k > 0 && weights[k - 1] < dw->weight; k--) {
+					groups[k] = groups[k - 1];
+					weights[k] = weights[k - 1];
+				}
+				groups[k] = (unsigned short)dw->def_nr;
+				weights[k] = dw->weight;
+				count = MIN2(count + 1, 4);
+			}
+
+			const float total = weights[0] + weights[1] + weights[2] + weights[3];
+			if (total > 0.0f) {
+				mul_v4_fl(weights, 1.0f / total);
+			}
+		}
+
+		Gwn_VertBuf *vbo = cache->skin_weights = GWN_vertbuf_create_with_format(&format);
+
+		/* Same layout than the shaded triangles, hidden faces are not skipped. */
+		const int vbo_len_capacity = tri_len * 3;
+		GWN_vertbuf_data_alloc(vbo, vbo_len_capacity);
+
+		uint vidx = 0;
+		for (int i = 0; i < tri_len; i++) {
+			const MLoopTri *mlt = &rdata->mlooptri[i];
+			for (uint t = 0; t < 3; t++) {
+				const uint v_index = rdata->mloop[mlt->tri[t]].v;
+				GWN_vertbuf_attr_set(vbo, attr_id.groups, vidx, vert_groups[v_index]);
+				GWN_vertbuf_attr_set(vbo, attr_id.weights, vidx, vert_weights[v_index]);
+				vidx++;
+			}
+		}
+
+		MEM_freeN(vert_groups);
+		MEM_freeN(vert_weights);
+	}
+
+	return cache->skin_weights;
+}
+
 static Gwn_VertBuf *mesh_create_tri_weights(
         MeshRenderData *rdata, bool use_hide, int defgroup)
 {
@@ -3799,6 +3906,45 @@ Gwn_Batch **DRW_mesh_batch_cache_get_surface_shaded(
 	return cache->shaded_triangles;
 }
 
+Gwn_Batch **DRW_mesh_batch_cache_get_surface_skinned(
+        Mesh *me, struct GPUMaterial **gpumat_array, uint gpumat_array_len,
+        const bool *deform_groups, int deform_groups_len)
+{
+	MeshBatchCache *cache = mesh_batch_cache_get(me);
+
+	if (cache->skinned_triangles == NULL) {
+		/* create batch from DM */
+		const int datatype =
+		        MR_DATATYPE_VERT | MR_DATATYPE_LOOP | MR_DATATYPE_LOOPTRI |
+		        MR_DATATYPE_POLY | MR_DATATYPE_SHADING | MR_DATATYPE_DVERT;
+		MeshRenderData *rdata = mesh_render_data_create_ex(me, datatype, gpumat_array, gpumat_array_len);
+
+		const int mat_len = mesh_render_data_mat_len_get(rdata);
+
+		cache->skinned_triangles = MEM_callocN(sizeof(*cache->skinned_triangles) * mat_len, __func__);
+
+		Gwn_IndexBuf **el = mesh_batch_cache_get_triangles_in_order_split_by_material(rdata, cache);
+
+		Gwn_VertBuf *vbo = mesh_batch_cache_get_tri_pos_and_normals(rdata, cache);
+		Gwn_VertBuf *vbo_shading = mesh_batch_cache_get_tri_shading_data(rdata, cache);
+		Gwn_VertBuf *vbo_skin = mesh_batch_cache_get_tri_skin_weights(rdata, cache, deform_groups, deform_groups_len);
+		for (int i = 0; i < mat_len; ++i) {
+			cache->skinned_triangles[i] = GWN_batch_create(
+			        GWN_PRIM_TRIS, vbo, el[i]);
+			if (vbo_shading) {
+				GWN_batch_vertbuf_add(cache->skinned_triangles[i], vbo_shading);
+			}
+			if (vbo_skin) {
+				GWN_batch_vertbuf_add(cache->skinned_triangles[i], vbo_skin);
+			}
+		}
+
+		mesh_render_data_free(rdata);
+	}
+
+	return cache->skinned_triangles;
+}
+
 Gwn_Batch **DRW_mesh_batch_cache_get_surface_texpaint(Mesh *me)
 {
 	MeshBatchCache *cache = mesh_batch_cache_get(me);
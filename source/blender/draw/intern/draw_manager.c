@@ -26,6 +26,8 @@
 #include <stdio.h>
 
 #include "BLI_listbase.h"
+#include "BLI_ghash.h"
+#include "BLI_linklist.h"
 #include "BLI_mempool.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -2197,6 +2199,108 @@ static void drw_game_eevee_view_layer_data_free(void)
 static Camera *default_cam;
 static RegionView3D game_rv3d;
 
+/* Skinning matrices of the objects deformed on GPU by the game engine. The matrices
+ * are set by the deformers, possibly from the animation threads, and uploaded in
+ * a texture of 4 texels per matrix at the next render. */
+typedef struct GameSkinData {
+	float *matrices;
+	int num_matrices;
+	bool dirty;
+	GPUTexture *tex;
+} GameSkinData;
+
+static GHash *game_skins;
+/* Textures of the removed skins, freed when the OpenGL context is enabled. */
+static LinkNode *game_skins_freed_textures;
+static ThreadMutex game_skins_mutex = BLI_MUTEX_INITIALIZER;
+
+static void drw_game_skin_data_free(void *val)
+{
+	GameSkinData *skin = val;
+	if (skin->tex) {
+		BLI_linklist_prepend(&game_skins_freed_textures, skin->tex);
+	}
+	MEM_SAFE_FREE(skin->matrices);
+	MEM_freeN(skin);
+}
+
+/* Needs the OpenGL context. */
+static void drw_game_skin_textures_free(void)
+{
+	BLI_mutex_lock(&game_skins_mutex);
+	BLI_linklist_free(game_skins_freed_textures, (LinkNodeFreeFP)GPU_texture_free);
+	game_skins_freed_textures = NULL;
+	BLI_mutex_unlock(&game_skins_mutex);
+}
+
+void DRW_game_skin_set(Object *ob, const float *matrices, int num_matrices)
+{
+	if (num_matrices == 0) {
+		return;
+	}
+
+	BLI_mutex_lock(&game_skins_mutex);
+
+	if (!game_skins) {
+		game_skins = BLI_ghash_ptr_new(__func__);
+	}
+
+	void **val;
+	if (!BLI_ghash_ensure_p(game_skins, ob, &val)) {
+		*val = MEM_callocN(sizeof(GameSkinData), __func__);
+	}
+
+	GameSkinData *skin = *val;
+	if (skin->num_matrices != num_matrices) {
+		MEM_SAFE_FREE(skin->matrices);
+		skin->matrices = MEM_mallocN(sizeof(float[16]) * num_matrices, __func__);
+		skin->num_matrices = num_matrices;
+	}
+	memcpy(skin->matrices, matrices, sizeof(float[16]) * num_matrices);
+	skin->dirty = true;
+
+	BLI_mutex_unlock(&game_skins_mutex);
+}
+
+void DRW_game_skin_remove(Object *ob)
+{
+	BLI_mutex_lock(&game_skins_mutex);
+	if (game_skins) {
+		BLI_ghash_remove(game_skins, ob, NULL, drw_game_skin_data_free);
+	}
+	BLI_mutex_unlock(&game_skins_mutex);
+}
+
+/* Return the skinning texture of an object, NULL if the object is not skinned on GPU. */
+GPUTexture *DRW_game_skin_texture_get(Object *ob)
+{
+	BLI_mutex_lock(&game_skins_mutex);
+
+	GameSkinData *skin = game_skins ? BLI_ghash_lookup(game_skins, ob) : NULL;
+	GPUTexture *tex = NULL;
+
+	if (skin) {
+		if (skin->tex && GPU_texture_height(skin->tex) != skin->num_matrices) {
+			BLI_linklist_prepend(&game_skins_freed_textures, skin->tex);
+			skin->tex = NULL;
+		}
+
+		if (!skin->tex) {
+			skin->tex = GPU_texture_create_2D_custom(4, skin->num_matrices, 4, GPU_RGBA32F, skin->matrices, NULL);
+			skin->dirty = false;
+		}
+		else if (skin->dirty) {
+			GPU_texture_update(skin->tex, skin->matrices);
+			skin->dirty = false;
+		}
+		tex = skin->tex;
+	}
+
+	BLI_mutex_unlock(&game_skins_mutex);
+
+	return tex;
+}
+
 GPUTexture *DRW_game_render_loop(Main *bmain, Scene *scene, Object *maincam, EvaluationContext *eval_ctx, int v[4],
 	DRWMatrixState state, bool reset_taa_samples, bool first_run, int viewport_size[2])
 {
@@ -2206,6 +2310,8 @@ GPUTexture *DRW_game_render_loop(Main *bmain, Scene *scene, Object *maincam, Eva
 
 	DRW_opengl_context_enable();
 
+	drw_game_skin_textures_free();
+
 	memset(&DST, 0x0, offsetof(DRWManager, ogl_context));
 
 	use_drw_engine(&draw_engine_eevee_type);
@@ -2357,6 +2463,14 @@ void DRW_game_render_loop_end()
 	draw_engine_eevee_type.engine_free();
 	drw_game_eevee_view_layer_data_free();
 
+	if (game_skins) {
+		BLI_mutex_lock(&game_skins_mutex);
+		BLI_ghash_free(game_skins, NULL, drw_game_skin_data_free);
+		game_skins = NULL;
+		BLI_mutex_unlock(&game_skins_mutex);
+	}
+	drw_game_skin_textures_free();
+
 	memset(&DST, 0xFF, offsetof(DRWManager, ogl_context));
 
 	DRW_opengl_context_disable();
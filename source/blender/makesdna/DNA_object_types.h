@@ -296,7 +296,8 @@ typedef struct Object {
 	/* dynamic properties */
 	float friction, rolling_friction, fh, reflect;
 	float fhdist, xyfrict;
-	short dynamode, pad8[3];
+	short dynamode, pad8;
+	float animLodFactor; /* scale of the scene animation LoD distance */
 	/********End of Game engine***********/
 
 	ListBase constraints;		/* object constraints */
@@ -549,6 +550,8 @@ enum {
 	OB_LOD_USE_MESH		= 1 << 0,
 	OB_LOD_USE_MAT		= 1 << 1,
 	OB_LOD_USE_HYST		= 1 << 2,
+	OB_LOD_USE_PHYS		= 1 << 3,
+	OB_LOD_PHYS_SLEEP	= 1 << 4,
 };
 
 
@@ -634,6 +637,7 @@ enum {
 	OB_LOCK_RIGID_BODY_X_ROT_AXIS   = 1 << 5,
 	OB_LOCK_RIGID_BODY_Y_ROT_AXIS   = 1 << 6,
 	OB_LOCK_RIGID_BODY_Z_ROT_AXIS   = 1 << 7,
+	OB_NEVER_DO_ANIMATION_LOD       = 1 << 8,
 
 /*	OB_LIFE     = OB_PROP | OB_DYNAMIC | OB_ACTOR | OB_MAINACTOR | OB_CHILD, */
 };
@@ -864,7 +864,9 @@ typedef struct GameData {
 	struct GameFraming framing;
 	short playerflag, xplay, yplay, freqplay;
 	short depth, attrib, rt1, rt2;
-	short aasamples, pad4[3];
+	short aasamples;
+	short poseCacheSteps; /* quantization steps per frame of the actions of the shared armature poses */
+	short pad4[2];
 
 	/* stereo/dome mode */
 	struct GameDome dome;
@@ -896,10 +898,15 @@ typedef struct GameData {
 	short raster_storage;
 	float levelHeight;
 	float deactivationtime, lineardeactthreshold, angulardeactthreshold;
+	short physicsThreads; /* number of threads of the physics simulation, 0 for all the processors */
+	short physicsBroadphase;
+	float physicsWorldSize; /* size of the world covered by the sweep and prune broadphase */
 
 	/* Scene LoD */
-	short lodflag, pad2;
-	int scehysteresis, pad5;
+	short lodflag;
+	short animLodMaxInterval; /* maximum number of frames between two pose updates of a distant armature */
+	int scehysteresis;
+	float animLodDistance; /* distance from the camera of each reduction of the armature update rate */
 
 } GameData;
 
@@ -923,6 +930,10 @@ typedef struct GameData {
 #define WOPHY_NONE		0
 #define WOPHY_BULLET	5
 
+/* GameData.physicsBroadphase */
+#define GAME_PHYSICS_BROADPHASE_DBVT		0
+#define GAME_PHYSICS_BROADPHASE_AXIS_SWEEP	1
+
 /* obstacleSimulation */
 #define OBSTSIMULATION_NONE		0
 #define OBSTSIMULATION_TOI_rays		1
@@ -959,6 +970,9 @@ typedef struct GameData {
 #define GAME_SHOW_OBSTACLE_SIMULATION		(1 << 16)
 #define GAME_NO_MATERIAL_CACHING			(1 << 17)
 #define GAME_GLSL_NO_ENV_LIGHTING			(1 << 18)
+#define GAME_PHYSICS_SHAPE_CACHE			(1 << 19)
+#define GAME_PHYSICS_ASYNC					(1 << 20)
+#define GAME_POSE_CACHE						(1 << 21)
 /* Note: GameData.flag is now an int (max 32 flags). A short could only take 16 flags */
 
 /* GameData.playerflag */
@@ -976,6 +990,8 @@ enum {
 
 /* GameData.lodflag */
 #define SCE_LOD_USE_HYST		(1 << 0)
+#define SCE_LOD_USE_ANIMATION	(1 << 1)
+#define SCE_LOD_ANIMATION_INTERPOLATE	(1 << 2)
 
 /* UV Paint */
 /* ToolSettings.uv_sculpt_settings */
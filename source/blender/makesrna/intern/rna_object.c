@@ -2044,6 +2044,18 @@ static void rna_def_object_game_settings(BlenderRNA *brna)
 	RNA_def_property_boolean_sdna(prop, NULL, "gameflag", OB_HASOBSTACLE);
 	RNA_def_property_ui_text(prop, "Create obstacle", "Create representation for obstacle simulation");
 
+	prop = RNA_def_property(srna, "use_animation_lod", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_negative_sdna(prop, NULL, "gameflag2", OB_NEVER_DO_ANIMATION_LOD);
+	RNA_def_property_ui_text(prop, "Animation LoD", "Reduce the pose update rate of the armature with the scene "
+	                         "animation level of detail");
+
+	prop = RNA_def_property(srna, "animation_lod_factor", PROP_FLOAT, PROP_NONE);
+	RNA_def_property_float_sdna(prop, NULL, "animLodFactor");
+	RNA_def_property_range(prop, 0.01f, 100.0f);
+	RNA_def_property_float_default(prop, 1.0f);
+	RNA_def_property_ui_text(prop, "Animation LoD Factor",
+	                         "Scale of the scene animation level of detail distance for the armature");
+
 	prop = RNA_def_property(srna, "obstacle_radius", PROP_FLOAT, PROP_NONE | PROP_UNIT_LENGTH);
 	RNA_def_property_float_sdna(prop, NULL, "obstacleRad");
 	RNA_def_property_range(prop, 0.0, 1000.0);
@@ -2353,6 +2365,20 @@ static void rna_def_object_lodlevel(BlenderRNA *brna)
 	RNA_def_property_ui_icon(prop, ICON_MATERIAL, 0);
 	RNA_def_property_update(prop, NC_OBJECT | ND_LOD, NULL);
 
+	prop = RNA_def_property(srna, "use_physics", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flags", OB_LOD_USE_PHYS);
+	RNA_def_property_ui_text(prop, "Use Physics",
+	                         "Use the mesh of this level of detail for the collision shape, "
+	                         "only for triangle mesh and convex hull bounds");
+	RNA_def_property_ui_icon(prop, ICON_PHYSICS, 0);
+	RNA_def_property_update(prop, NC_OBJECT | ND_LOD, NULL);
+
+	prop = RNA_def_property(srna, "use_physics_sleep", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flags", OB_LOD_PHYS_SLEEP);
+	RNA_def_property_ui_text(prop, "Physics Sleep", "Put the rigid body to sleep at this level of detail");
+	RNA_def_property_ui_icon(prop, ICON_PAUSE, 0);
+	RNA_def_property_update(prop, NC_OBJECT | ND_LOD, NULL);
+
 	prop = RNA_def_property(srna, "use_object_hysteresis", PROP_BOOLEAN, PROP_NONE);
 	RNA_def_property_boolean_sdna(prop, NULL, "flags", OB_LOD_USE_HYST);
 	RNA_def_property_ui_text(prop, "Hysteresis Override", "Override LoD Hysteresis scene setting for this LoD level");
@@ -4277,6 +4277,14 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 		{0, NULL, 0, NULL, NULL}
 	};
 
+	static const EnumPropertyItem physics_broadphase_items[] = {
+		{GAME_PHYSICS_BROADPHASE_DBVT, "DBVT", 0, "Dynamic Tree",
+		 "Bounding volume trees, the static objects are kept in their own tree, suited for large worlds"},
+		{GAME_PHYSICS_BROADPHASE_AXIS_SWEEP, "AXIS_SWEEP", 0, "Sweep and Prune",
+		 "Sorted bounds on the three axes in a limited world, suited for many moving objects (up to 32766 objects)"},
+		{0, NULL, 0, NULL, NULL}
+	};
+
 	static const EnumPropertyItem material_items[] = {
 		{GAME_MAT_MULTITEX, "MULTITEXTURE", 0, "Multitexture", "Multitexture materials"},
 		{GAME_MAT_GLSL, "GLSL", 0, "GLSL", "OpenGL shading language shaders"},
@@ -4515,6 +4523,45 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 	                         "higher value give better physics precision");
 	RNA_def_property_update(prop, NC_SCENE, NULL);
 
+	prop = RNA_def_property(srna, "physics_threads", PROP_INT, PROP_NONE);
+	RNA_def_property_int_sdna(prop, NULL, "physicsThreads");
+	RNA_def_property_range(prop, 0, 64);
+	RNA_def_property_ui_range(prop, 0, 16, 1, 1);
+	RNA_def_property_int_default(prop, 1);
+	RNA_def_property_ui_text(prop, "Physics Threads",
+	                         "Number of threads used by the collision detection and the constraint solver, "
+	                         "0 uses all the processors, the simulation is reproducible for a given number of threads");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "physics_broadphase", PROP_ENUM, PROP_NONE);
+	RNA_def_property_enum_sdna(prop, NULL, "physicsBroadphase");
+	RNA_def_property_enum_items(prop, physics_broadphase_items);
+	RNA_def_property_ui_text(prop, "Physics Broadphase", "Structure finding the pairs of objects which could collide");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "physics_world_size", PROP_FLOAT, PROP_DISTANCE);
+	RNA_def_property_float_sdna(prop, NULL, "physicsWorldSize");
+	RNA_def_property_range(prop, 1.0f, FLT_MAX);
+	RNA_def_property_ui_range(prop, 10.0f, 100000.0f, 100, 0);
+	RNA_def_property_float_default(prop, 1000.0f);
+	RNA_def_property_ui_text(prop, "Physics World Size",
+	                         "Size of the cube centered on the world origin covered by the sweep and prune broadphase");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "use_physics_shape_cache", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PHYSICS_SHAPE_CACHE);
+	RNA_def_property_ui_text(prop, "Shape Cache",
+	                         "Store the BVH of the triangle mesh collision shapes in a file next to the blend file, "
+	                         "the BVH are loaded from this file instead of being built when the game starts");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "use_physics_async", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PHYSICS_ASYNC);
+	RNA_def_property_ui_text(prop, "Asynchronous Physics",
+	                         "Run the physics step on its own thread while the frame is rendered, "
+	                         "the game objects receive the results of the step before the next logic frame");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
 	prop = RNA_def_property(srna, "deactivation_linear_threshold", PROP_FLOAT, PROP_NONE);
 	RNA_def_property_float_sdna(prop, NULL, "lineardeactthreshold");
 	RNA_def_property_ui_range(prop, 0.001, 10000.0, 2, 3);
@@ -4607,6 +4654,22 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 	RNA_def_property_ui_text(prop, "Restrict Animation Updates",
 	                         "Restrict the number of animation updates to the animation FPS (this is "
 	                         "better for performance, but can cause issues with smooth playback)");
+
+	prop = RNA_def_property(srna, "use_pose_cache", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_POSE_CACHE);
+	RNA_def_property_ui_text(prop, "Share Poses",
+	                         "Evaluate once per frame the poses of the armature instances playing the same actions "
+	                         "at the same frames, the armatures using constraints are always evaluated");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "pose_cache_steps", PROP_INT, PROP_NONE);
+	RNA_def_property_int_sdna(prop, NULL, "poseCacheSteps");
+	RNA_def_property_range(prop, 0, 100);
+	RNA_def_property_int_default(prop, 4);
+	RNA_def_property_ui_text(prop, "Pose Steps",
+	                         "Number of steps per frame the action frames are rounded to so that more instances "
+	                         "share their poses, 0 to share only the identical frames");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
 	
 	/* materials */
 	prop = RNA_def_property(srna, "material_mode", PROP_ENUM, PROP_NONE);
@@ -4705,6 +4768,37 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 	RNA_def_property_ui_text(prop, "Hysteresis %",
 	                         "Minimum distance change required to transition to the previous level of detail");
 	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "use_animation_lod", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "lodflag", SCE_LOD_USE_ANIMATION);
+	RNA_def_property_ui_text(prop, "Animation LoD",
+	                         "Reduce the pose update rate of the distant armatures and only advance the actions "
+	                         "of the armatures out of the camera view");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "use_animation_lod_interpolate", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "lodflag", SCE_LOD_ANIMATION_INTERPOLATE);
+	RNA_def_property_ui_text(prop, "Interpolate",
+	                         "Interpolate the last two poses of the distant armatures between their updates, "
+	                         "the pose is delayed by one update");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "animation_lod_distance", PROP_FLOAT, PROP_DISTANCE);
+	RNA_def_property_float_sdna(prop, NULL, "animLodDistance");
+	RNA_def_property_range(prop, 0.01f, FLT_MAX);
+	RNA_def_property_ui_range(prop, 1.0f, 1000.0f, 10, 1);
+	RNA_def_property_float_default(prop, 20.0f);
+	RNA_def_property_ui_text(prop, "Distance",
+	                         "Distance from the camera after which the armatures skip one more frame between "
+	                         "their pose updates");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
+	prop = RNA_def_property(srna, "animation_lod_max_interval", PROP_INT, PROP_NONE);
+	RNA_def_property_int_sdna(prop, NULL, "animLodMaxInterval");
+	RNA_def_property_range(prop, 1, 60);
+	RNA_def_property_int_default(prop, 4);
+	RNA_def_property_ui_text(prop, "Max Interval", "Maximum number of frames between two pose updates");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
 }
 
 static void rna_def_gpu_dof_fx(BlenderRNA *brna)
@@ -0,0 +1,328 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_ActionClip.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "BL_ActionClip.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "BLI_utildefines.h"
+#include "BLI_listbase.h"
+
+extern "C" {
+#  include "DNA_action_types.h"
+#  include "DNA_anim_types.h"
+#  include "DNA_curve_types.h"
+#  include "DNA_key_types.h"
+#  include "BKE_action.h"
+#  include "BKE_fcurve.h"
+#  include "BKE_key.h"
+}
+
+static const std::string poseChannelPrefix = "pose.bones[\"";
+static const std::string keyBlockPrefix = "key_blocks[\"";
+
+/** Split a path like pose.bones["name"].property in the name and the property.
+ * Return false if the path doesn't start with the prefix or the name is not terminated.
+ */
+static bool split_path(const std::string& path, const std::string& prefix, std::string& name, std::string& property)
+{
+	if (path.compare(0, prefix.size(), prefix) != 0) {
+		return false;
+	}
+
+	// The quotes and backslashes of the name are escaped.
+	name.clear();
+	for (size_t i = prefix.size(), size = path.size(); i < size; ++i) {
+		const char c = path[i];
+		if (c == '\\' && i + 1 < size) {
+			name.push_back(path[++i]);
+		}
+		else if (c == '"') {
+			if (path.compare(i, 3, "\"].") != 0) {
+				return false;
+			}
+			property = path.substr(i + 3);
+			return true;
+		}
+		else {
+			name.push_back(c);
+		}
+	}
+
+	return false;
+}
+
+float BL_ActionClip::Channel::Sample(float frame) const
+{
+	if (m_fcurve) {
+		// The evaluation doesn't write in the curve, it's safe with the threaded animations.
+		return evaluate_fcurve(m_fcurve, frame);
+	}
+
+	const unsigned int numKeys = m_times.size();
+	if (frame <= m_times.front()) {
+		if (m_extrapolate && !m_constants.front() && numKeys > 1) {
+			const float duration = m_times[1] - m_times[0];
+			if (duration != 0.0f) {
+				return m_values[0] - (m_values[1] - m_values[0]) / duration * (m_times[0] - frame);
+			}
+		}
+		return m_values.front();
+	}
+	if (frame >= m_times.back()) {
+		if (m_extrapolate && !m_constants.back() && numKeys > 1) {
+			const float duration = m_times[numKeys - 1] - m_times[numKeys - 2];
+			if (duration != 0.0f) {
+				return m_values[numKeys - 1] + (m_values[numKeys - 1] - m_values[numKeys - 2]) / duration *
+				       (frame - m_times[numKeys - 1]);
+			}
+		}
+		return m_values.back();
+	}
+
+	// Index of the key ending the segment containing the frame.
+	const unsigned int next = std::upper_bound(m_times.begin(), m_times.end(), frame) - m_times.begin();
+	const unsigned int prev = next - 1;
+
+	const float duration = m_times[next] - m_times[prev];
+	if (m_constants[prev] || duration == 0.0f) {
+		return m_values[prev];
+	}
+
+	const float fac = (frame - m_times[prev]) / duration;
+	return m_values[prev] + (m_values[next] - m_values[prev]) * fac;
+}
+
+BL_ActionClip::BL_ActionClip(bAction *action)
+	:m_action(action),
+	m_fallback(false)
+{
+	for (FCurve *fcu = (FCurve *)action->curves.first; fcu; fcu = fcu->next) {
+		// Skip the curves skipped by the animation system.
+		if ((fcu->grp && (fcu->grp->flag & AGRP_MUTED)) || (fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) || !fcu->rna_path) {
+			continue;
+		}
+
+		if (!AddChannel(fcu)) {
+			const std::string path = fcu->rna_path;
+			// Other properties than the pose channels and key blocks are converted to interpolators.
+			if (path.compare(0, poseChannelPrefix.size(), poseChannelPrefix) == 0 ||
+			    path.compare(0, keyBlockPrefix.size(), keyBlockPrefix) == 0)
+			{
+				m_fallback = true;
+			}
+		}
+	}
+}
+
+BL_ActionClip::~BL_ActionClip()
+{
+}
+
+bool BL_ActionClip::AddChannel(FCurve *fcu)
+{
+	if (fcu->driver) {
+		return false;
+	}
+
+	// Curves without value are never written.
+	if (fcu->totvert == 0 && !list_has_suitable_fmodifier(&fcu->modifiers, 0, FMI_TYPE_GENERATE_CURVE)) {
+		return true;
+	}
+
+	Channel channel;
+	channel.m_index = fcu->array_index;
+
+	std::string property;
+	if (split_path(fcu->rna_path, poseChannelPrefix, channel.m_name, property)) {
+		if (property == "location" && channel.m_index < 3) {
+			channel.m_type = CHANNEL_LOCATION;
+		}
+		else if (property == "rotation_quaternion" && channel.m_index < 4) {
+			channel.m_type = CHANNEL_ROTATION_QUATERNION;
+		}
+		else if (property == "rotation_euler" && channel.m_index < 3) {
+			channel.m_type = CHANNEL_ROTATION_EULER;
+		}
+		else if (property == "rotation_axis_angle" && channel.m_index < 4) {
+			channel.m_type = CHANNEL_ROTATION_AXIS_ANGLE;
+		}
+		else if (property == "scale" && channel.m_index < 3) {
+			channel.m_type = CHANNEL_SCALE;
+		}
+		else {
+			return false;
+		}
+	}
+	else if (split_path(fcu->rna_path, keyBlockPrefix, channel.m_name, property) && property == "value") {
+		channel.m_type = CHANNEL_SHAPE;
+	}
+	else {
+		return false;
+	}
+
+	// Curves with only constant and linear keys are stored as key arrays.
+	bool useKeys = (fcu->bezt && BLI_listbase_is_empty(&fcu->modifiers) && !(fcu->flag & FCURVE_INT_VALUES));
+	for (unsigned int i = 0; useKeys && i < fcu->totvert; ++i) {
+		useKeys = ELEM(fcu->bezt[i].ipo, BEZT_IPO_CONST, BEZT_IPO_LIN);
+	}
+
+	if (useKeys) {
+		const bool discrete = (fcu->flag & FCURVE_DISCRETE_VALUES);
+		channel.m_fcurve = nullptr;
+		channel.m_extrapolate = (fcu->extend == FCURVE_EXTRAPOLATE_LINEAR && !discrete);
+		for (unsigned int i = 0; i < fcu->totvert; ++i) {
+			const BezTriple& bezt = fcu->bezt[i];
+			channel.m_times.push_back(bezt.vec[1][0]);
+			channel.m_values.push_back(bezt.vec[1][1]);
+			channel.m_constants.push_back(bezt.ipo == BEZT_IPO_CONST || discrete);
+		}
+	}
+	else {
+		channel.m_fcurve = fcu;
+	}
+
+	m_channels.push_back(channel);
+
+	return true;
+}
+
+bAction *BL_ActionClip::GetAction() const
+{
+	return m_action;
+}
+
+bool BL_ActionClip::UseFallback() const
+{
+	return m_fallback;
+}
+
+void BL_ActionClip::GetPoseTargets(bPose *pose, std::vector<Target>& targets) const
+{
+	targets.resize(m_channels.size());
+
+	for (unsigned int i = 0, size = m_channels.size(); i < size; ++i) {
+		const Channel& channel = m_channels[i];
+		Target& target = targets[i];
+		target.m_value = nullptr;
+		target.m_min = nullptr;
+		target.m_max = nullptr;
+
+		bPoseChannel *pchan = (channel.m_type != CHANNEL_SHAPE) ? BKE_pose_channel_find_name(pose, channel.m_name.c_str()) : nullptr;
+		if (!pchan) {
+			continue;
+		}
+
+		switch (channel.m_type) {
+			case CHANNEL_LOCATION:
+			{
+				target.m_value = &pchan->loc[channel.m_index];
+				break;
+			}
+			case CHANNEL_ROTATION_QUATERNION:
+			{
+				target.m_value = &pchan->quat[channel.m_index];
+				break;
+			}
+			case CHANNEL_ROTATION_EULER:
+			{
+				target.m_value = &pchan->eul[channel.m_index];
+				break;
+			}
+			case CHANNEL_ROTATION_AXIS_ANGLE:
+			{
+				// The angle is first, followed by the axis.
+				target.m_value = (channel.m_index == 0) ? &pchan->rotAngle : &pchan->rotAxis[channel.m_index - 1];
+				break;
+			}
+			case CHANNEL_SCALE:
+			{
+				target.m_value = &pchan->size[channel.m_index];
+				break;
+			}
+			case CHANNEL_SHAPE:
+			{
+				break;
+			}
+		}
+	}
+}
+
+void BL_ActionClip::GetPoseChannels(bPose *pose, std::vector<bPoseChannel *>& channels) const
+{
+	channels.clear();
+
+	std::unordered_set<std::string> names;
+	for (const Channel& channel : m_channels) {
+		if (channel.m_type != CHANNEL_SHAPE) {
+			names.insert(channel.m_name);
+		}
+	}
+
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		if (names.find(pchan->name) != names.end()) {
+			channels.push_back(pchan);
+		}
+	}
+}
+
+void BL_ActionClip::GetShapeTargets(Key *key, std::vector<Target>& targets) const
+{
+	targets.resize(m_channels.size());
+
+	for (unsigned int i = 0, size = m_channels.size(); i < size; ++i) {
+		const Channel& channel = m_channels[i];
+		Target& target = targets[i];
+		target.m_value = nullptr;
+		target.m_min = nullptr;
+		target.m_max = nullptr;
+
+		KeyBlock *kb = (channel.m_type == CHANNEL_SHAPE) ? BKE_keyblock_find_name(key, channel.m_name.c_str()) : nullptr;
+		if (kb) {
+			// Like the RNA the value is clamped to the slider range.
+			target.m_value = &kb->curval;
+			target.m_min = &kb->slidermin;
+			target.m_max = &kb->slidermax;
+		}
+	}
+}
+
+void BL_ActionClip::Sample(float frame, const std::vector<Target>& targets) const
+{
+	for (unsigned int i = 0, size = std::min(m_channels.size(), targets.size()); i < size; ++i) {
+		const Target& target = targets[i];
+		if (!target.m_value) {
+			continue;
+		}
+
+		float value = m_channels[i].Sample(frame);
+		if (target.m_min) {
+			CLAMP(value, *target.m_min, *target.m_max);
+		}
+		*target.m_value = value;
+	}
+}
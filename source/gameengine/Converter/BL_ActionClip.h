@@ -0,0 +1,116 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_ActionClip.h
+ *  \ingroup bgeconv
+ */
+
+#ifndef __BL_ACTIONCLIP_H__
+#define __BL_ACTIONCLIP_H__
+
+#include <string>
+#include <vector>
+
+struct bAction;
+struct bPose;
+struct bPoseChannel;
+struct Key;
+struct FCurve;
+
+/** Action compiled for the game engine. The F-Curves animating pose channel transforms
+ * and shape key values are converted to channels naming their target, the targets are
+ * resolved once per object and sampled without RNA path resolution. The curves using only
+ * constant and linear keys are stored as sorted key arrays, the others are evaluated by
+ * the Blender curve evaluation which doesn't modify them.
+ */
+class BL_ActionClip
+{
+public:
+	/// Value written by a channel.
+	struct Target
+	{
+		float *m_value;
+		/// Range of the value, nullptr when unbounded.
+		const float *m_min;
+		const float *m_max;
+	};
+
+private:
+	enum ChannelType {
+		CHANNEL_LOCATION = 0,
+		CHANNEL_ROTATION_QUATERNION,
+		CHANNEL_ROTATION_EULER,
+		CHANNEL_ROTATION_AXIS_ANGLE,
+		CHANNEL_SCALE,
+		CHANNEL_SHAPE
+	};
+
+	struct Channel
+	{
+		ChannelType m_type;
+		/// Name of the pose channel or key block.
+		std::string m_name;
+		int m_index;
+
+		/// Key frames and values of a curve with constant and linear keys.
+		std::vector<float> m_times;
+		std::vector<float> m_values;
+		/// True when the segment starting at the key is constant.
+		std::vector<bool> m_constants;
+		bool m_extrapolate;
+
+		/// Curve evaluated by Blender when it can't be stored as key arrays.
+		FCurve *m_fcurve;
+
+		float Sample(float frame) const;
+	};
+
+	bAction *m_action;
+	std::vector<Channel> m_channels;
+	/// True when some curves have a path not handled by the clip.
+	bool m_fallback;
+
+	bool AddChannel(FCurve *fcu);
+
+public:
+	BL_ActionClip(bAction *action);
+	~BL_ActionClip();
+
+	bAction *GetAction() const;
+
+	/** Return true if the action animates other properties than the pose channel transforms
+	 * and the shape key values, it must be evaluated by the animation system instead.
+	 */
+	bool UseFallback() const;
+
+	/// Resolve the targets of the channels in a pose, unfound channels have a null target.
+	void GetPoseTargets(bPose *pose, std::vector<Target>& targets) const;
+	/// Get the pose channels animated by the clip, each once in the order of the pose.
+	void GetPoseChannels(bPose *pose, std::vector<bPoseChannel *>& channels) const;
+	/// Resolve the targets of the channels in the key blocks of a shape key.
+	void GetShapeTargets(Key *key, std::vector<Target>& targets) const;
+
+	/// Write the values of the channels at a frame into targets from GetPoseTargets or GetShapeTargets.
+	void Sample(float frame, const std::vector<Target>& targets) const;
+};
+
+#endif  // __BL_ACTIONCLIP_H__
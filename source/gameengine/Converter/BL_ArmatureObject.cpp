@@ -50,10 +50,12 @@ extern "C" {
 #include "BL_ArmatureObject.h"
 #include "BL_ActionActuator.h"
 #include "BL_Action.h"
+#include "BL_ActionManager.h"
 #include "KX_BlenderSceneConverter.h"
 #include "KX_BlenderConverter.h"
 #include "KX_Globals.h"
 #include "KX_KetsjiEngine.h"
+#include "KX_Scene.h"
 
 #include "RAS_DebugDraw.h"
 
@@ -141,69 +143,6 @@ static void game_copy_pose(bPose **dst, bPose *src, int copy_constraint)
 	*dst = out;
 }
 
-// Only allowed for Poses with identical channels.
-static void game_blend_poses(bPose *dst, bPose *src, float srcweight, short mode)
-{
-	float dstweight;
-
-	if (mode == BL_Action::ACT_BLEND_BLEND) {
-		dstweight = 1.0f - srcweight;
-	}
-	else if (mode == BL_Action::ACT_BLEND_ADD) {
-		dstweight = 1.0f;
-	}
-	else {
-		dstweight = 1.0f;
-	}
-
-	bPoseChannel *schan = (bPoseChannel *)src->chanbase.first;
-	for (bPoseChannel *dchan = (bPoseChannel *)dst->chanbase.first; dchan; dchan = (bPoseChannel *)dchan->next, schan = (bPoseChannel *)schan->next) {
-		// always blend on all channels since we don't know which one has been set
-		/* quat interpolation done separate */
-		if (schan->rotmode == ROT_MODE_QUAT) {
-			float dquat[4], squat[4];
-
-			copy_qt_qt(dquat, dchan->quat);
-			copy_qt_qt(squat, schan->quat);
-			// Normalize quaternions so that interpolation/multiplication result is correct.
-			normalize_qt(dquat);
-			normalize_qt(squat);
-
-			if (mode == BL_Action::ACT_BLEND_BLEND) {
-				interp_qt_qtqt(dchan->quat, dquat, squat, srcweight);
-			}
-			else {
-				mul_fac_qt_fl(squat, srcweight);
-				mul_qt_qtqt(dchan->quat, dquat, squat);
-			}
-
-			normalize_qt(dchan->quat);
-		}
-
-		for (unsigned short i = 0; i < 3; i++) {
-			/* blending for loc and scale are pretty self-explanatory... */
-			dchan->loc[i] = (dchan->loc[i] * dstweight) + (schan->loc[i] * srcweight);
-			dchan->size[i] = 1.0f + ((dchan->size[i] - 1.0f) * dstweight) + ((schan->size[i] - 1.0f) * srcweight);
-
-			/* euler-rotation interpolation done here instead... */
-			// FIXME: are these results decent?
-			if (schan->rotmode) {
-				dchan->eul[i] = (dchan->eul[i] * dstweight) + (schan->eul[i] * srcweight);
-			}
-		}
-		for (bConstraint *dcon = (bConstraint *)dchan->constraints.first, *scon = (bConstraint *)schan->constraints.first;
-		     dcon && scon;
-		     dcon = dcon->next, scon = scon->next)
-		{
-			/* no 'add' option for constraint blending */
-			dcon->enforce = dcon->enforce * (1.0f - srcweight) + scon->enforce * srcweight;
-		}
-	}
-
-	/* this pose is now in src time */
-	dst->ctime = src->ctime;
-}
-
 BL_ArmatureObject::BL_ArmatureObject(void *sgReplicationInfo,
                                      SG_Callbacks callbacks,
                                      Object *armature,
@@ -215,8 +154,17 @@ BL_ArmatureObject::BL_ArmatureObject(void *sgReplicationInfo,
 	m_timestep(0.040),
 	m_vert_deform_type(vert_deform_type),
 	m_drawDebug(false),
-	m_lastapplyframe(0.0)
+	m_lastapplyframe(0.0),
+	m_ignoreAnimationLod((armature->gameflag2 & OB_NEVER_DO_ANIMATION_LOD) != 0),
+	m_animationLodFactor(armature->animLodFactor),
+	m_poseRebuildCount(0),
+	m_sharePose(true),
+	m_poseCacheKeyValid(false),
+	m_cachedPose(nullptr),
+	m_cachedPoseGeneration(0)
 {
+	InitAnimationLod();
+
 	m_controlledConstraints = new CListValue<BL_ArmatureConstraint>();
 	m_poseChannels = new CListValue<BL_ArmatureChannel>();
 
@@ -230,6 +178,18 @@ BL_ArmatureObject::BL_ArmatureObject(void *sgReplicationInfo,
 	// need this to get iTaSC working ok in the BGE
 	m_pose->flag |= POSE_GAME_ENGINE;
 	memcpy(m_obmat, m_objArma->obmat, sizeof(m_obmat));
+
+	// The constraints depend on the targets of each instance.
+	m_poseShareable = true;
+	for (bPoseChannel *pchan = (bPoseChannel *)m_pose->chanbase.first; pchan; pchan = pchan->next) {
+		if (!BLI_listbase_is_empty(&pchan->constraints)) {
+			m_poseShareable = false;
+			break;
+		}
+	}
+	m_poseCacheKey.m_object = armature;
+
+	m_poseSolver.Init(m_pose);
 }
 
 BL_ArmatureObject::~BL_ArmatureObject()
@@ -393,6 +353,26 @@ void BL_ArmatureObject::ProcessReplica()
 	m_objArma = BKE_object_copy(G.main, m_objArma);
 	m_objArma->data = BKE_armature_copy(G.main, tmp);
 	m_pose = m_objArma->pose;
+
+	InitAnimationLod();
+
+	m_poseCacheKeyValid = false;
+	m_cachedPose = nullptr;
+
+	// The pose copy has the same channels, the rig is shared.
+	m_poseSolver.SetPose(m_pose);
+}
+
+void BL_ArmatureObject::InitAnimationLod()
+{
+	// The armatures are created in the main thread.
+	static unsigned short phase = 0;
+
+	m_animationLodInterval = 0;
+	m_animationLodFrame = 0;
+	m_animationLodPhase = phase++;
+	m_animationLodChannels.clear();
+	m_animationLodReset = true;
 }
 
 int BL_ArmatureObject::GetGameObjectType() const
@@ -434,16 +414,42 @@ void BL_ArmatureObject::ApplyPose()
 	m_pose->ctime = (float)m_timestep;
 	//m_scene->r.cfra++;
 	if (m_lastapplyframe != m_lastframe) {
-		// update the constraint if any, first put them all off so that only the active ones will be updated
-		for (BL_ArmatureConstraint *constraint : m_controlledConstraints) {
-			constraint->UpdateTarget();
+		// Reuse the pose evaluated by another instance playing the same actions.
+		BL_PoseCache *cache = (m_poseCacheKeyValid) ? GetPoseCache() : nullptr;
+		const BL_PoseCache::Pose *cachedPose = (cache) ? cache->FindPose(m_poseCacheKey) : nullptr;
+		if (cachedPose) {
+			BL_PoseCache::LoadPose(cachedPose, m_pose);
 		}
-		// update ourself
-		UpdateBlenderObjectMatrix(m_objArma);
-		EvaluationContext *eval_ctx = KX_GetActiveEngine()->GetEvalContext();
-		BKE_pose_where_is(eval_ctx, m_scene, m_objArma);
-		// restore ourself
-		memcpy(m_objArma->obmat, m_obmat, sizeof(m_obmat));
+		else {
+			// The rigs the game solver can't handle are evaluated by Blender.
+			if (!m_poseSolver.Solve(m_pose, GetArmature())) {
+				const bool rebuild = (m_pose->flag & POSE_RECALC);
+				// update the constraint if any, first put them all off so that only the active ones will be updated
+				for (BL_ArmatureConstraint *constraint : m_controlledConstraints) {
+					constraint->UpdateTarget();
+				}
+				// update ourself
+				UpdateBlenderObjectMatrix(m_objArma);
+				EvaluationContext *eval_ctx = KX_GetActiveEngine()->GetEvalContext();
+				BKE_pose_where_is(eval_ctx, m_scene, m_objArma);
+				// restore ourself
+				memcpy(m_objArma->obmat, m_obmat, sizeof(m_obmat));
+
+				// The channels could be reallocated by the pose rebuild.
+				if (rebuild) {
+					m_poseSolver.Init(m_pose);
+					m_animationLodChannels.clear();
+					++m_poseRebuildCount;
+				}
+			}
+
+			if (cache) {
+				cachedPose = cache->StorePose(m_poseCacheKey, m_pose);
+			}
+		}
+
+		m_cachedPose = cachedPose;
+		m_cachedPoseGeneration = (cache) ? cache->GetGeneration() : 0;
 		m_lastapplyframe = m_lastframe;
 	}
 }
@@ -458,6 +464,7 @@ void BL_ArmatureObject::SetPose(bPose *pose)
 {
 	extract_pose_from_pose(m_pose, pose);
 	m_lastapplyframe = -1.0;
+	m_poseCacheKeyValid = false;
 }
 
 void BL_ArmatureObject::SetPoseByAction(bAction *action, float localtime)
@@ -470,11 +477,6 @@ void BL_ArmatureObject::SetPoseByAction(bAction *action, float localtime)
 	animsys_evaluate_action(&ptrrna, action, nullptr, localtime);
 }
 
-void BL_ArmatureObject::BlendInPose(bPose *blend_pose, float weight, short mode)
-{
-	game_blend_poses(m_pose, blend_pose, weight, mode);
-}
-
 bool BL_ArmatureObject::UpdateTimestep(double curtime)
 {
 	if (curtime != m_lastframe) {
@@ -486,6 +488,109 @@ bool BL_ArmatureObject::UpdateTimestep(double curtime)
 	return false;
 }
 
+unsigned short BL_ArmatureObject::GetAnimationLodInterval(const MT_Vector3& cameraPosition, float lodFactor, float distance,
+                                                          unsigned short maxInterval) const
+{
+	if (m_ignoreAnimationLod || distance <= 0.0f) {
+		return 1;
+	}
+
+	const float objectDistance = NodeGetWorldPosition().distance(cameraPosition) * lodFactor;
+	const unsigned int interval = 1 + (unsigned int)(objectDistance / (distance * m_animationLodFactor));
+	return (unsigned short)std::min(interval, (unsigned int)std::max(maxInterval, (unsigned short)1));
+}
+
+BL_ArmatureObject::AnimationLodUpdate BL_ArmatureObject::NextAnimationLodUpdate(unsigned short interval, bool interpolate)
+{
+	if (interval == 0) {
+		// Update at the first frame back in the view, without interpolating from the old poses.
+		m_animationLodInterval = 0;
+		m_animationLodReset = true;
+		return ANIMATION_LOD_SKIP;
+	}
+
+	const bool resume = (m_animationLodInterval == 0);
+	m_animationLodInterval = interval;
+
+	if (interval == 1) {
+		m_animationLodFrame = 0;
+		m_animationLodReset = true;
+		return ANIMATION_LOD_UPDATE;
+	}
+
+	if (resume) {
+		m_animationLodFrame = m_animationLodPhase % interval;
+		return ANIMATION_LOD_UPDATE;
+	}
+
+	if (++m_animationLodFrame >= interval) {
+		m_animationLodFrame = 0;
+		return ANIMATION_LOD_UPDATE;
+	}
+
+	return (interpolate && !m_animationLodReset) ? ANIMATION_LOD_INTERPOLATE : ANIMATION_LOD_SKIP;
+}
+
+void BL_ArmatureObject::InterpolateAnimationLod(double curtime, bool newPose)
+{
+	if (m_animationLodInterval <= 1) {
+		return;
+	}
+
+	if (m_animationLodChannels.empty()) {
+		BL_PoseTransforms::GetChannels(m_pose, m_animationLodChannels);
+	}
+
+	if (newPose) {
+		std::swap(m_animationLodTransforms[0], m_animationLodTransforms[1]);
+		m_animationLodTransforms[1].Store(m_animationLodChannels);
+		// Start from the new pose when the previous one is outdated.
+		if (m_animationLodReset) {
+			m_animationLodTransforms[0].Store(m_animationLodChannels);
+			m_animationLodReset = false;
+		}
+	}
+
+	// The displayed pose is late of one update to be always between two evaluated poses.
+	const float factor = (float)m_animationLodFrame / (float)m_animationLodInterval;
+	m_animationLodTransforms[0].Load(m_animationLodChannels);
+	m_animationLodTransforms[1].Blend(m_animationLodChannels, factor, BL_Action::ACT_BLEND_BLEND);
+
+	// Force the evaluation of the interpolated pose, which is proper to the armature.
+	UpdateTimestep(curtime);
+	m_lastapplyframe = -1.0;
+	m_poseCacheKeyValid = false;
+}
+
+BL_PoseCache *BL_ArmatureObject::GetPoseCache()
+{
+	if (!m_sharePose || !m_poseShareable) {
+		return nullptr;
+	}
+	KX_Scene *scene = KX_GameObject::GetScene();
+	return (scene) ? scene->GetPoseCache() : nullptr;
+}
+
+void BL_ArmatureObject::UpdatePoseCacheKey(const BL_ActionManager& actionManager)
+{
+	BL_PoseCache *cache = GetPoseCache();
+	m_poseCacheKeyValid = (cache && actionManager.GetPoseCacheLayers(*cache, m_poseCacheKey.m_layers));
+	if (m_poseCacheKeyValid) {
+		// The channels not animated by the actions can differ between the instances.
+		BL_PoseCache::GetTransforms(m_pose, m_poseCacheKey.m_transforms);
+	}
+}
+
+const BL_PoseCache::Pose *BL_ArmatureObject::GetCachedPose()
+{
+	BL_PoseCache *cache = GetPoseCache();
+	// The poses of the previous frames are freed.
+	if (!cache || m_cachedPoseGeneration != cache->GetGeneration()) {
+		return nullptr;
+	}
+	return m_cachedPose;
+}
+
 bArmature *BL_ArmatureObject::GetArmature()
 {
 	return (bArmature *)m_objArma->data;
@@ -541,6 +646,11 @@ bPose *BL_ArmatureObject::GetOrigPose()
 	return m_pose;
 }
 
+unsigned int BL_ArmatureObject::GetPoseRebuildCount() const
+{
+	return m_poseRebuildCount;
+}
+
 double BL_ArmatureObject::GetLastFrame()
 {
 	return m_lastframe;
@@ -624,6 +734,7 @@ PyAttributeDef BL_ArmatureObject::Attributes[] = {
 
 	KX_PYATTRIBUTE_RO_FUNCTION("constraints",       BL_ArmatureObject, pyattr_get_constraints),
 	KX_PYATTRIBUTE_RO_FUNCTION("channels",      BL_ArmatureObject, pyattr_get_channels),
+	KX_PYATTRIBUTE_BOOL_RW("sharePose", BL_ArmatureObject, m_sharePose),
 	KX_PYATTRIBUTE_NULL //Sentinel
 };
 
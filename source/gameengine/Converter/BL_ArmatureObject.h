@@ -35,6 +35,9 @@
 #include "KX_GameObject.h"
 #include "BL_ArmatureConstraint.h"
 #include "BL_ArmatureChannel.h"
+#include "BL_PoseCache.h"
+#include "BL_PoseSolver.h"
+#include "BL_PoseTransforms.h"
 
 struct bArmature;
 struct Bone;
@@ -42,13 +45,26 @@ struct bPose;
 struct bConstraint;
 struct Object;
 class MT_Matrix4x4;
+class MT_Vector3;
 class KX_BlenderSceneConverter;
 class RAS_DebugDraw;
+class BL_ActionManager;
 
 class BL_ArmatureObject : public KX_GameObject
 {
 	Py_Header
 
+public:
+	/// Pose update of a frame with the animation level of detail.
+	enum AnimationLodUpdate {
+		/// Evaluate the actions.
+		ANIMATION_LOD_UPDATE = 0,
+		/// Interpolate the last two evaluated poses.
+		ANIMATION_LOD_INTERPOLATE,
+		/// Keep the pose, the actions only advance their time.
+		ANIMATION_LOD_SKIP
+	};
+
 protected:
 	/// List element: BL_ArmatureConstraint.
 	CListValue<BL_ArmatureConstraint> *m_controlledConstraints;
@@ -73,6 +89,41 @@ protected:
 
 	double m_lastapplyframe;
 
+	/// Evaluator of the pose used instead of BKE_pose_where_is when the rig is supported.
+	BL_PoseSolver m_poseSolver;
+
+	/// Update the pose every frame whatever the animation level of detail.
+	bool m_ignoreAnimationLod;
+	/// Scale of the scene animation level of detail distance.
+	float m_animationLodFactor;
+	/// Frames between two evaluations of the actions, 0 when the armature is culled.
+	unsigned short m_animationLodInterval;
+	/// Frames since the last evaluation of the actions.
+	unsigned short m_animationLodFrame;
+	/// Offset of the updates to spread the armatures of same interval over the frames.
+	unsigned short m_animationLodPhase;
+	/// Transforms of the last two evaluated poses, interpolated between the updates.
+	BL_PoseTransforms m_animationLodTransforms[2];
+	/// Remap table of all the channels of the pose, filled at the first interpolation.
+	std::vector<bPoseChannel *> m_animationLodChannels;
+	/// True when the poses to interpolate are outdated.
+	bool m_animationLodReset;
+	/// Number of rebuilds of the pose channels, the pointers to the channels are resolved again after a change.
+	unsigned int m_poseRebuildCount;
+
+	/// Allow the sharing of the pose with the other instances, set by the user.
+	bool m_sharePose;
+	/// True when the pose doesn't depend on the instance, without constraints.
+	bool m_poseShareable;
+	/// State of the actions applied to the pose, valid when m_poseCacheKeyValid is true.
+	BL_PoseCache::Key m_poseCacheKey;
+	bool m_poseCacheKeyValid;
+	/// Pose of the cache applied in the last evaluation and the generation of the cache it belongs to.
+	const BL_PoseCache::Pose *m_cachedPose;
+	unsigned int m_cachedPoseGeneration;
+
+	void InitAnimationLod();
+
 public:
 	BL_ArmatureObject(void *sgReplicationInfo,
 	                  SG_Callbacks callbacks,
@@ -94,13 +145,36 @@ public:
 	void SetPose(bPose *pose);
 	/// Never edit this, only for accessing names.
 	bPose *GetOrigPose();
+	/// Return the number of rebuilds of the pose channels, the channels of the previous rebuilds are freed.
+	unsigned int GetPoseRebuildCount() const;
 	void ApplyPose();
 	void SetPoseByAction(bAction *action, float localtime);
-	void BlendInPose(bPose *blend_pose, float weight, short mode);
 	void RestorePose();
 
 	bool UpdateTimestep(double curtime);
 
+	/** Return the number of frames between two pose updates for the distance to the camera,
+	 * 1 if the armature ignores the animation level of detail.
+	 */
+	unsigned short GetAnimationLodInterval(const MT_Vector3& cameraPosition, float lodFactor, float distance,
+	                                       unsigned short maxInterval) const;
+	/** Advance the animation level of detail of one frame and return the pose update to do.
+	 * \param interval Frames between two updates, 0 for a culled armature.
+	 * \param interpolate True to interpolate the poses between the updates.
+	 */
+	AnimationLodUpdate NextAnimationLodUpdate(unsigned short interval, bool interpolate);
+	/** Set the pose interpolated between the last two evaluated poses, called after the actions
+	 * update with newPose to true to store the new evaluated pose.
+	 */
+	void InterpolateAnimationLod(double curtime, bool newPose);
+
+	/// Return the cache of the scene if the armature shares its pose, else nullptr.
+	BL_PoseCache *GetPoseCache();
+	/// Update the key of the pose from the actions applied in the last action update.
+	void UpdatePoseCacheKey(const BL_ActionManager& actionManager);
+	/// Return the cached pose of the last evaluation if it is still in the cache, else nullptr.
+	const BL_PoseCache::Pose *GetCachedPose();
+
 	bArmature *GetArmature();
 	const bArmature *GetArmature() const;
 	const Scene *GetScene() const;
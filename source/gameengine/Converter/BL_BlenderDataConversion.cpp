@@ -191,6 +191,8 @@ extern Material defmaterial;	/* material.c */
 
 #include "BL_ArmatureObject.h"
 #include "BL_DeformableGameObject.h"
+#include "BL_ActionClip.h"
+#include "BL_PoseCache.h"
 
 #include "KX_NavMeshObject.h"
 #include "KX_ObstacleSimulation.h"
@@ -860,13 +862,9 @@ static void BL_CreatePhysicsObjectNew(KX_GameObject* gameobj,
 	PHY_ShapeProps* shapeprops =
 			CreateShapePropsFromBlenderObject(blenderobject);
 
-	DerivedMesh* dm = nullptr;
-	if (gameobj->GetDeformer())
-		dm = gameobj->GetDeformer()->GetPhysicsMesh();
-
 	class PHY_IMotionState* motionstate = new KX_MotionState(gameobj->GetSGNode());
 
-	kxscene->GetPhysicsEnvironment()->ConvertObject(converter, gameobj, meshobj, dm, kxscene, shapeprops, motionstate, activeLayerBitInfo, isCompoundChild, hasCompoundChildren);
+	kxscene->GetPhysicsEnvironment()->ConvertObject(converter, gameobj, meshobj, kxscene, shapeprops, motionstate, activeLayerBitInfo, isCompoundChild, hasCompoundChildren);
 
 	bool isActor = (blenderobject->gameflag & OB_ACTOR)!=0;
 	bool isSensor = (blenderobject->gameflag & OB_SENSOR) != 0;
@@ -875,10 +873,6 @@ static void BL_CreatePhysicsObjectNew(KX_GameObject* gameobj,
 		(isActor) ? KX_ClientObjectInfo::ACTOR : KX_ClientObjectInfo::STATIC;
 
 	delete shapeprops;
-	if (dm) {
-		dm->needsFree = 1;
-		dm->release(dm);
-	}
 }
 
 static KX_LodManager *lodmanager_from_blenderobject(Object *ob, KX_Scene *scene, RAS_Rasterizer *rasty, KX_BlenderSceneConverter& converter, bool libloading)
@@ -1411,6 +1405,14 @@ void BL_ConvertBlenderObjects(struct Main* maggie,
 		kxscene->SetLodHysteresisValue(blenderscene->gm.scehysteresis);
 	}
 
+	kxscene->SetAnimationLod((blenderscene->gm.lodflag & SCE_LOD_USE_ANIMATION) != 0,
+	                         (blenderscene->gm.lodflag & SCE_LOD_ANIMATION_INTERPOLATE) != 0,
+	                         blenderscene->gm.animLodDistance, blenderscene->gm.animLodMaxInterval);
+
+	if (blenderscene->gm.flag & GAME_POSE_CACHE) {
+		kxscene->SetPoseCache(new BL_PoseCache(blenderscene->gm.poseCacheSteps));
+	}
+
 	// convert world
 	KX_WorldInfo* worldinfo = new KX_WorldInfo(blenderscene, blenderscene->world);
 	kxscene->SetWorldInfo(worldinfo);
@@ -1431,11 +1433,12 @@ void BL_ConvertBlenderObjects(struct Main* maggie,
 	
 	CListValue<KX_GameObject> *logicbrick_conversionlist = new CListValue<KX_GameObject>();
 
-	// Convert actions to actionmap
+	// Convert actions to actionmap and compile them into clips.
 	bAction *curAct;
 	for (curAct = (bAction*)maggie->action.first; curAct; curAct=(bAction*)curAct->id.next)
 	{
 		logicmgr->RegisterActionName(curAct->id.name + 2, curAct);
+		converter.RegisterActionClip(new BL_ActionClip(curAct));
 	}
 
 	blenderSceneSetBackground(blenderscene);
@@ -36,16 +36,21 @@
 #  pragma warning( disable:4786 )
 #endif
 
+// Eigen3 vectorizes the bounding box computation.
+#include <Eigen/Core>
+
 #include "RAS_IPolygonMaterial.h"
 #include "RAS_DisplayArray.h"
 #include "BL_DeformableGameObject.h"
 #include "BL_MeshDeformer.h"
 #include "RAS_MeshObject.h"
 #include "RAS_Polygon.h"
+#include "KX_CullingNode.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 
 #include <string>
+#include <cfloat>
 #include "BLI_math.h"
 
 bool BL_MeshDeformer::Apply(RAS_MeshMaterial *UNUSED(meshmat), RAS_IDisplayArray *UNUSED(array))
@@ -209,3 +214,104 @@ void BL_MeshDeformer::VerifyStorage()
 	}
 }
 
+void BL_MeshDeformer::BuildGatherIndices()
+{
+	m_gatherIndices.reset(new std::vector<GatherIndices>(m_displayArrayList.size()));
+
+	for (unsigned int i = 0, size = m_displayArrayList.size(); i < size; ++i) {
+		RAS_IDisplayArray *array = m_displayArrayList[i];
+		if (!array) {
+			continue;
+		}
+
+		GatherIndices& indices = (*m_gatherIndices)[i];
+		indices.resize(array->GetVertexCount());
+		for (unsigned int j = 0, numvert = indices.size(); j < numvert; ++j) {
+			indices[j] = array->GetVertexInfo(j).getOrigIndex();
+		}
+	}
+}
+
+void BL_MeshDeformer::WriteTransverts(bool copyNormals, bool normalsModified)
+{
+	if (!m_transverts) {
+		return;
+	}
+
+	// The indices of the replicas are shared as long as they match their display arrays.
+	bool valid = (m_gatherIndices && m_gatherIndices->size() == m_displayArrayList.size());
+	for (unsigned int i = 0, size = m_displayArrayList.size(); valid && i < size; ++i) {
+		RAS_IDisplayArray *array = m_displayArrayList[i];
+		valid = (!array || array->GetVertexCount() == (*m_gatherIndices)[i].size());
+	}
+	if (!valid) {
+		BuildGatherIndices();
+	}
+
+	// The culling bounding box is only replaced by the bounds of the vertices if the user asks for it.
+	const bool updateBounds = m_gameobj->GetAutoUpdateBounds();
+	// The fourth component is unused, it allows Eigen to compute the bounds with SIMD instructions.
+	Eigen::Array4f aabbMin = Eigen::Array4f::Constant(FLT_MAX);
+	Eigen::Array4f aabbMax = Eigen::Array4f::Constant(-FLT_MAX);
+	bool boundsModified = false;
+
+	for (unsigned int i = 0, size = m_displayArrayList.size(); i < size; ++i) {
+		RAS_IDisplayArray *array = m_displayArrayList[i];
+		const GatherIndices& indices = (*m_gatherIndices)[i];
+		if (!array || indices.empty()) {
+			continue;
+		}
+
+		// Write directly in the contiguous vertex memory, as read by the rasterizer.
+		unsigned char *data = reinterpret_cast<unsigned char *>(array->GetVertexPointer());
+		const unsigned int stride = array->GetVertexMemorySize();
+		const intptr_t xyzOffset = array->GetVertexXYZOffset();
+		const intptr_t normalOffset = array->GetVertexNormalOffset();
+
+		bool positionChanged = false;
+		bool normalChanged = false;
+		for (unsigned int j = 0, numvert = indices.size(); j < numvert; ++j, data += stride) {
+			const unsigned int origindex = indices[j];
+			const float *co = m_transverts[origindex];
+			float *xyz = (float *)(data + xyzOffset);
+
+			if (!positionChanged && !equals_v3v3(xyz, co)) {
+				positionChanged = true;
+			}
+			copy_v3_v3(xyz, co);
+
+			if (copyNormals) {
+				const float *no = m_transnors[origindex];
+				float *normal = (float *)(data + normalOffset);
+				if (!normalChanged && !equals_v3v3(normal, no)) {
+					normalChanged = true;
+				}
+				copy_v3_v3(normal, no);
+			}
+
+			if (updateBounds) {
+				const Eigen::Array4f pos(co[0], co[1], co[2], 0.0f);
+				aabbMin = aabbMin.min(pos);
+				aabbMax = aabbMax.max(pos);
+			}
+		}
+
+		unsigned short flag = RAS_IDisplayArray::NONE_MODIFIED;
+		if (positionChanged) {
+			flag |= RAS_IDisplayArray::POSITION_MODIFIED;
+			boundsModified = true;
+		}
+		if (normalChanged || normalsModified) {
+			flag |= RAS_IDisplayArray::NORMAL_MODIFIED;
+		}
+		if (flag != RAS_IDisplayArray::NONE_MODIFIED) {
+			array->AppendModifiedFlag(flag);
+		}
+	}
+
+	// The bounding box is in the object space like the deformed vertices.
+	if (updateBounds && boundsModified) {
+		m_gameobj->GetCullingNode()->GetAabb().Set(MT_Vector3(aabbMin[0], aabbMin[1], aabbMin[2]),
+		                                           MT_Vector3(aabbMax[0], aabbMax[1], aabbMax[2]));
+	}
+}
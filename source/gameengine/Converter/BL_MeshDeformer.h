@@ -38,6 +38,8 @@
 #include "DNA_key_types.h"
 #include "MT_Vector3.h"
 #include <stdlib.h>
+#include <memory>
+#include <vector>
 
 #ifdef _MSC_VER
 #  pragma warning (disable:4786)  /* get rid of stupid stl-visual compiler debug warning */
@@ -89,6 +91,9 @@ public:
 	}
 
 protected:
+	/// Original vertex index of each vertex of a display array.
+	typedef std::vector<unsigned int> GatherIndices;
+
 	Mesh *m_bmesh;
 
 	// this is so m_transverts doesn't need to be converted
@@ -100,6 +105,17 @@ protected:
 	int m_tvtot;
 	BL_DeformableGameObject *m_gameobj;
 	double m_lastDeformUpdate;
+
+	/// Gather indices of the display arrays, built once and shared by the replicas.
+	std::shared_ptr<std::vector<GatherIndices> > m_gatherIndices;
+
+	void BuildGatherIndices();
+	/** Write the deformed positions in the display arrays, and the normals if copyNormals is true.
+	 * Only the arrays whose vertices changed are flagged as modified, the bounding box of the
+	 * object is computed in the same pass when it uses automatic bounds.
+	 * \param normalsModified True if the normals were written in the display arrays, e.g by RecalcNormals.
+	 */
+	void WriteTransverts(bool copyNormals, bool normalsModified);
 };
 
 #endif
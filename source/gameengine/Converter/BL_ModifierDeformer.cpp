@@ -67,17 +67,33 @@ extern "C" {
 #include "KX_Globals.h"
 #include "KX_KetsjiEngine.h"
 
-BL_ModifierDeformer::~BL_ModifierDeformer()
+/// Release a derived mesh of the deformer, deformedOnly is used as a user counter.
+static void release_derived_mesh(DerivedMesh *dm)
 {
-	if (m_dm) {
-		// deformedOnly is used as a user counter
-		if (--m_dm->deformedOnly == 0) {
-			m_dm->needsFree = 1;
-			m_dm->release(m_dm);
-		}
+	if (dm && --dm->deformedOnly == 0) {
+		dm->needsFree = 1;
+		dm->release(dm);
 	}
 }
 
+/// Take the ownership of a newly evaluated derived mesh.
+static void acquire_derived_mesh(DerivedMesh *dm)
+{
+	// get rid of temporary data
+	dm->needsFree = 0;
+	dm->release(dm);
+	// HACK! use deformedOnly as a user counter
+	dm->deformedOnly = 1;
+	// Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
+	DM_ensure_tessface(dm);
+}
+
+BL_ModifierDeformer::~BL_ModifierDeformer()
+{
+	release_derived_mesh(m_dm);
+	release_derived_mesh(m_physicsDm);
+}
+
 RAS_Deformer *BL_ModifierDeformer::GetReplica()
 {
 	BL_ModifierDeformer *result;
@@ -95,6 +111,10 @@ void BL_ModifierDeformer::ProcessReplica()
 		// by default try to reuse mesh, deformedOnly is used as a user count
 		m_dm->deformedOnly++;
 	}
+	if (m_physicsDm) {
+		m_physicsDm->deformedOnly++;
+	}
+	// m_frameDependentModifier is copied, the replicas evaluate the same modifier stack.
 	// this will force an update and if the mesh cannot be reused, a new one will be created
 	m_lastModifierUpdate = -1.0;
 }
@@ -120,6 +140,36 @@ bool BL_ModifierDeformer::HasCompatibleDeformer(Object *ob)
 	return false;
 }
 
+static void object_link_walk(void *userData, Object *UNUSED(ob), Object **obpoin, int UNUSED(cb_flag))
+{
+	if (*obpoin) {
+		*(bool *)userData = true;
+	}
+}
+
+bool BL_ModifierDeformer::HasFrameDependentModifier(Object *ob)
+{
+	for (ModifierData *md = (ModifierData *)ob->modifiers.first; md; md = md->next) {
+		if (!(md->mode & eModifierMode_Realtime))
+			continue;
+		/* armature modifier are handled by SkinDeformer, not ModifierDeformer */
+		if (md->type == eModifierType_Armature)
+			continue;
+		if (modifier_dependsOnTime(md))
+			return true;
+
+		// e.g hook, curve, array with an offset object or boolean.
+		const ModifierTypeInfo *mti = modifierType_getInfo((ModifierType)md->type);
+		bool linked = false;
+		if (mti->foreachObjectLink) {
+			mti->foreachObjectLink(md, ob, object_link_walk, &linked);
+		}
+		if (linked)
+			return true;
+	}
+	return false;
+}
+
 bool BL_ModifierDeformer::HasArmatureDeformer(Object *ob)
 {
 	if (!ob->modifiers.first)
@@ -132,82 +182,79 @@ bool BL_ModifierDeformer::HasArmatureDeformer(Object *ob)
 	return false;
 }
 
+float (*BL_ModifierDeformer::GetModifierVerts())[3]
+{
+	if (!m_transverts) {
+		return nullptr;
+	}
+
+	m_modifierVerts.assign((float *)m_transverts, (float *)(m_transverts + m_tvtot));
+	return (float (*)[3])m_modifierVerts.data();
+}
+
 // return a deformed mesh that supports mapping (with a valid CD_ORIGINDEX layer)
 DerivedMesh *BL_ModifierDeformer::GetPhysicsMesh()
 {
-	/* TODO: This doesn't work currently because of eval_ctx. */
-#if 0
-	/* we need to compute the deformed mesh taking into account the current
-	 * shape and skin deformers, we cannot just call mesh_create_derived_physics()
-	 * because that would use the m_transvers already deformed previously by BL_ModifierDeformer::Update(),
-	 * so restart from scratch by forcing a full update the shape/skin deformers
-	 * (will do nothing if there is no such deformer) */
-	BL_ShapeDeformer::ForceUpdate();
-	BL_ShapeDeformer::Update();
-	// now apply the modifiers but without those that don't support mapping
+	// Make sure m_transverts contains the current shape and skin deformation.
+	Update();
+
+	// The physics mesh is built once per evaluation of the modifiers.
+	if (!m_physicsDm) {
+		Object *blendobj = m_gameobj->GetBlendObject();
+		/* hack: the modifiers require that the mesh is attached to the object
+		 * It may not be the case here because of replace mesh actuator */
+		Mesh *oldmesh = (Mesh *)blendobj->data;
+		blendobj->data = m_bmesh;
+		// now apply the modifiers but without those that don't support mapping
+		m_physicsDm = mesh_create_derived_physics(KX_GetActiveEngine()->GetEvalContext(), m_scene, blendobj,
+		                                          GetModifierVerts(), CD_MASK_MESH);
+		/* restore object data */
+		blendobj->data = oldmesh;
+
+		acquire_derived_mesh(m_physicsDm);
+	}
+
+	return m_physicsDm;
+}
+
+bool BL_ModifierDeformer::Update(void)
+{
+	const bool bShapeUpdate = BL_ShapeDeformer::Update();
 	Object *blendobj = m_gameobj->GetBlendObject();
+
+	/* Static derived mesh are not updated, the others when the shape or skin deformers
+	 * changed the vertices given to the modifiers, or once per frame if a modifier
+	 * depends on the time or on other objects. */
+	if (m_dm && (!m_bDynamic || (!bShapeUpdate && m_lastModifierUpdate != -1.0 &&
+	    (m_lastModifierUpdate == m_gameobj->GetLastFrame() || !m_frameDependentModifier))))
+	{
+		return false;
+	}
+
+	/* execute the modifiers */
 	/* hack: the modifiers require that the mesh is attached to the object
 	 * It may not be the case here because of replace mesh actuator */
 	Mesh *oldmesh = (Mesh *)blendobj->data;
 	blendobj->data = m_bmesh;
-	DerivedMesh *dm = mesh_create_derived_physics(m_scene, blendobj, m_transverts, CD_MASK_MESH);
+	/* execute the modifiers, on a copy of m_transverts as the deform modifiers modify their input */
+	DerivedMesh *dm = mesh_create_derived_no_virtual(KX_GetActiveEngine()->GetEvalContext(), m_scene, blendobj,
+	                                                 GetModifierVerts(), CD_MASK_MESH);
 	/* restore object data */
 	blendobj->data = oldmesh;
 
-	// Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
-	DM_ensure_tessface(dm);
+	/* free the current derived mesh and replace, (dm should never be nullptr) */
+	release_derived_mesh(m_dm);
+	m_dm = dm;
+	acquire_derived_mesh(m_dm);
+	DM_update_materials(m_dm, blendobj);
 
-	/* m_transverts is correct here (takes into account deform only modifiers) */
-	/* the derived mesh returned by this function must be released by the caller !!! */
-	return dm;
-#endif
-	return NULL;
-}
+	// The physics mesh is built again from the new vertices when requested.
+	release_derived_mesh(m_physicsDm);
+	m_physicsDm = nullptr;
 
-bool BL_ModifierDeformer::Update(void)
-{
-	/* TODO: This doesn't work currently because of eval_ctx. */
-	bool bShapeUpdate = BL_ShapeDeformer::Update();
-
-	if (bShapeUpdate || m_lastModifierUpdate != m_gameobj->GetLastFrame()) {
-		// static derived mesh are not updated
-		if (m_dm == nullptr || m_bDynamic) {
-			// Set to true if it's the first time Update() function is called.
-			const bool initialize = (m_dm == nullptr);
-			/* execute the modifiers */
-			Object *blendobj = m_gameobj->GetBlendObject();
-			/* hack: the modifiers require that the mesh is attached to the object
-			 * It may not be the case here because of replace mesh actuator */
-			Mesh *oldmesh = (Mesh *)blendobj->data;
-			blendobj->data = m_bmesh;
-			/* execute the modifiers */
-			DerivedMesh *dm = mesh_create_derived_no_virtual(KX_GetActiveEngine()->GetEvalContext(), m_scene, blendobj, m_transverts, CD_MASK_MESH);
-			/* restore object data */
-			blendobj->data = oldmesh;
-			/* free the current derived mesh and replace, (dm should never be nullptr) */
-			if (m_dm != nullptr) {
-				// HACK! use deformedOnly as a user counter
-				if (--m_dm->deformedOnly == 0) {
-					m_dm->needsFree = 1;
-					m_dm->release(m_dm);
-				}
-			}
-			m_dm = dm;
-			// get rid of temporary data
-			m_dm->needsFree = 0;
-			m_dm->release(m_dm);
-			// HACK! use deformedOnly as a user counter
-			m_dm->deformedOnly = 1;
-			DM_update_materials(m_dm, blendobj);
-
-			// Some meshes with modifiers returns 0 polys, call DM_ensure_tessface avoid this.
-			DM_ensure_tessface(m_dm);
-		}
-		m_lastModifierUpdate = m_gameobj->GetLastFrame();
-		bShapeUpdate = true;
-	}
+	m_lastModifierUpdate = m_gameobj->GetLastFrame();
 
-	return bShapeUpdate;
+	return true;
 }
 
 bool BL_ModifierDeformer::Apply(RAS_MeshMaterial *meshmat, RAS_IDisplayArray *array)
@@ -49,6 +49,8 @@ class BL_ModifierDeformer : public BL_ShapeDeformer
 public:
 	static bool HasCompatibleDeformer(Object *ob);
 	static bool HasArmatureDeformer(Object *ob);
+	/// Return true if a modifier depends on the time or on other objects, it must be evaluated every frame.
+	static bool HasFrameDependentModifier(Object *ob);
 
 	BL_ModifierDeformer(BL_DeformableGameObject *gameobj,
 						Scene *scene,
@@ -56,8 +58,10 @@ public:
 						RAS_MeshObject *mesh)
 		:BL_ShapeDeformer(gameobj, bmeshobj, mesh),
 		m_lastModifierUpdate(-1.0),
+		m_frameDependentModifier(HasFrameDependentModifier(bmeshobj)),
 		m_scene(scene),
-		m_dm(nullptr)
+		m_dm(nullptr),
+		m_physicsDm(nullptr)
 	{
 		m_recalcNormal = false;
 	}
@@ -72,8 +76,10 @@ public:
 						BL_ArmatureObject *arma = nullptr)
 		:BL_ShapeDeformer(gameobj, bmeshobj_old, bmeshobj_new, mesh, release_object, false, arma),
 		m_lastModifierUpdate(-1),
+		m_frameDependentModifier(HasFrameDependentModifier(bmeshobj_new)),
 		m_scene(scene),
-		m_dm(nullptr)
+		m_dm(nullptr),
+		m_physicsDm(nullptr)
 	{
 	}
 
@@ -95,13 +101,26 @@ public:
 	{
 		return m_dm;
 	}
-	// The derived mesh returned by this function must be released!
+	/** Return a deformed mesh that supports mapping. The derived mesh is owned by the deformer
+	 * and reused until the modifiers are evaluated again, it must not be released.
+	 */
 	virtual DerivedMesh *GetPhysicsMesh();
 
 protected:
 	double m_lastModifierUpdate;
+	/// True if the modifiers must be evaluated every frame, the modifier stack doesn't change at runtime.
+	bool m_frameDependentModifier;
 	Scene *m_scene;
 	DerivedMesh *m_dm;
+	/// Mesh returned by GetPhysicsMesh, shared by the replicas like m_dm.
+	DerivedMesh *m_physicsDm;
+	/** Copy of the deformed vertices given to the modifiers, the deform only modifiers
+	 * modify it and m_transverts stays the undeformed input of the modifiers.
+	 */
+	std::vector<float> m_modifierVerts;
+
+	/// Return a copy of m_transverts for the modifiers, nullptr to use the mesh vertices.
+	float (*GetModifierVerts())[3];
 };
 
 #endif  /* __BL_MODIFIERDEFORMER_H__ */
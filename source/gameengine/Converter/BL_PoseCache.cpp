@@ -0,0 +1,249 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_PoseCache.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "BL_PoseCache.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+extern "C" {
+#  include "DNA_action_types.h"
+#  include "BLI_listbase.h"
+}
+
+/// Floats stored per channel: the channel and pose matrices, the pose head and tail.
+static const unsigned int channelSize = 16 + 16 + 3 + 3;
+/** Floats of the key per channel: the location, the quaternion, euler and axis angle rotations,
+ * the scale, the rotation mode and the bendy bone properties.
+ */
+static const unsigned int transformSize = 3 + 4 + 3 + 4 + 3 + 1 + 10;
+
+struct BL_PoseCache::Pose
+{
+	struct Skin
+	{
+		Mesh *m_mesh;
+		float m_obmat[4][4];
+		std::vector<float> m_verts;
+		std::vector<float> m_nors;
+	};
+
+	std::vector<float> m_channels;
+	std::vector<Skin> m_skins;
+};
+
+bool BL_PoseCache::Layer::operator==(const Layer& other) const
+{
+	return (m_action == other.m_action && m_frame == other.m_frame && m_weight == other.m_weight &&
+	        m_blendMode == other.m_blendMode);
+}
+
+bool BL_PoseCache::Key::operator==(const Key& other) const
+{
+	// The transforms are compared bitwise to match the hash.
+	return (m_object == other.m_object && m_layers == other.m_layers &&
+	        m_transforms.size() == other.m_transforms.size() &&
+	        memcmp(m_transforms.data(), other.m_transforms.data(), sizeof(float) * m_transforms.size()) == 0);
+}
+
+size_t BL_PoseCache::KeyHash::operator()(const Key& key) const
+{
+	std::hash<const void *> ptrHash;
+	size_t hash = ptrHash(key.m_object);
+	for (const Layer& layer : key.m_layers) {
+		hash = hash * 31 + ptrHash(layer.m_action);
+		hash = hash * 31 + layer.m_frame;
+		hash = hash * 31 + layer.m_weight;
+		hash = hash * 31 + layer.m_blendMode;
+	}
+	for (float value : key.m_transforms) {
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		hash = hash * 31 + bits;
+	}
+	return hash;
+}
+
+BL_PoseCache::BL_PoseCache(short steps)
+	:m_steps(steps),
+	m_generation(0)
+{
+}
+
+BL_PoseCache::~BL_PoseCache()
+{
+}
+
+float BL_PoseCache::QuantizeFrame(float frame) const
+{
+	if (m_steps <= 0) {
+		return frame;
+	}
+	return (float)GetFrameStep(frame) / (float)m_steps;
+}
+
+int BL_PoseCache::GetFrameStep(float frame) const
+{
+	if (m_steps <= 0) {
+		// Without quantization only the identical frames match.
+		int step;
+		memcpy(&step, &frame, sizeof(step));
+		return step;
+	}
+	return (int)std::floor(frame * m_steps + 0.5f);
+}
+
+void BL_PoseCache::Clear()
+{
+	m_poses.clear();
+	++m_generation;
+}
+
+unsigned int BL_PoseCache::GetGeneration() const
+{
+	return m_generation;
+}
+
+void BL_PoseCache::GetTransforms(bPose *pose, std::vector<float>& transforms)
+{
+	transforms.resize(BLI_listbase_count(&pose->chanbase) * transformSize);
+
+	float *data = transforms.data();
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next, data += transformSize) {
+		memcpy(data, pchan->loc, sizeof(float[3]));
+		memcpy(data + 3, pchan->quat, sizeof(float[4]));
+		memcpy(data + 7, pchan->eul, sizeof(float[3]));
+		memcpy(data + 10, pchan->rotAxis, sizeof(float[3]));
+		data[13] = pchan->rotAngle;
+		memcpy(data + 14, pchan->size, sizeof(float[3]));
+		data[17] = (float)pchan->rotmode;
+		data[18] = pchan->roll1;
+		data[19] = pchan->roll2;
+		data[20] = pchan->curveInX;
+		data[21] = pchan->curveInY;
+		data[22] = pchan->curveOutX;
+		data[23] = pchan->curveOutY;
+		data[24] = pchan->ease1;
+		data[25] = pchan->ease2;
+		data[26] = pchan->scaleIn;
+		data[27] = pchan->scaleOut;
+	}
+}
+
+const BL_PoseCache::Pose *BL_PoseCache::FindPose(const Key& key)
+{
+	m_mutex.Lock();
+	const auto it = m_poses.find(key);
+	const Pose *pose = (it != m_poses.end()) ? it->second.get() : nullptr;
+	m_mutex.Unlock();
+
+	return pose;
+}
+
+const BL_PoseCache::Pose *BL_PoseCache::StorePose(const Key& key, bPose *pose)
+{
+	std::unique_ptr<Pose> cachedPose(new Pose());
+	std::vector<float>& channels = cachedPose->m_channels;
+	channels.resize(BLI_listbase_count(&pose->chanbase) * channelSize);
+
+	float *data = channels.data();
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next, data += channelSize) {
+		memcpy(data, pchan->chan_mat, sizeof(float[16]));
+		memcpy(data + 16, pchan->pose_mat, sizeof(float[16]));
+		memcpy(data + 32, pchan->pose_head, sizeof(float[3]));
+		memcpy(data + 35, pchan->pose_tail, sizeof(float[3]));
+	}
+
+	m_mutex.Lock();
+	// Another armature could have stored the same pose meanwhile, keep the first one.
+	std::unique_ptr<Pose>& entry = m_poses[key];
+	if (!entry) {
+		entry = std::move(cachedPose);
+	}
+	const Pose *result = entry.get();
+	m_mutex.Unlock();
+
+	return result;
+}
+
+void BL_PoseCache::LoadPose(const Pose *cachedPose, bPose *pose)
+{
+	const float *data = cachedPose->m_channels.data();
+	const float *end = data + cachedPose->m_channels.size();
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan && data < end; pchan = pchan->next, data += channelSize) {
+		memcpy(pchan->chan_mat, data, sizeof(float[16]));
+		memcpy(pchan->pose_mat, data + 16, sizeof(float[16]));
+		memcpy(pchan->pose_head, data + 32, sizeof(float[3]));
+		memcpy(pchan->pose_tail, data + 35, sizeof(float[3]));
+	}
+}
+
+bool BL_PoseCache::LoadSkin(const Pose *cachedPose, Mesh *mesh, const float obmat[4][4], float (*verts)[3], float (*nors)[3],
+                           unsigned int numVerts)
+{
+	bool found = false;
+
+	m_mutex.Lock();
+	for (const Pose::Skin& skin : cachedPose->m_skins) {
+		if (skin.m_mesh == mesh && memcmp(skin.m_obmat, obmat, sizeof(skin.m_obmat)) == 0 &&
+		    skin.m_verts.size() == numVerts * 3)
+		{
+			memcpy(verts, skin.m_verts.data(), sizeof(float[3]) * numVerts);
+			memcpy(nors, skin.m_nors.data(), sizeof(float[3]) * numVerts);
+			found = true;
+			break;
+		}
+	}
+	m_mutex.Unlock();
+
+	return found;
+}
+
+void BL_PoseCache::StoreSkin(const Pose *cachedPose, Mesh *mesh, const float obmat[4][4], const float (*verts)[3],
+                             const float (*nors)[3], unsigned int numVerts)
+{
+	Pose::Skin skin;
+	skin.m_mesh = mesh;
+	memcpy(skin.m_obmat, obmat, sizeof(skin.m_obmat));
+	skin.m_verts.assign((const float *)verts, (const float *)(verts + numVerts));
+	skin.m_nors.assign((const float *)nors, (const float *)(nors + numVerts));
+
+	m_mutex.Lock();
+	// The poses are never modified outside of the lock, only their skins.
+	std::vector<Pose::Skin>& skins = const_cast<Pose *>(cachedPose)->m_skins;
+	bool found = false;
+	for (const Pose::Skin& other : skins) {
+		if (other.m_mesh == mesh && memcmp(other.m_obmat, obmat, sizeof(other.m_obmat)) == 0) {
+			found = true;
+			break;
+		}
+	}
+	if (!found) {
+		skins.push_back(std::move(skin));
+	}
+	m_mutex.Unlock();
+}
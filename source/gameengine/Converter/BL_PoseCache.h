@@ -0,0 +1,132 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_PoseCache.h
+ *  \ingroup bgeconv
+ */
+
+#ifndef __BL_POSECACHE_H__
+#define __BL_POSECACHE_H__
+
+#include "CM_Thread.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+struct bAction;
+struct bPose;
+struct Mesh;
+struct Object;
+
+/** Cache of the poses evaluated in a frame by the armatures of a scene. The replicas of an armature
+ * playing the same actions at the same quantized frames share the pose evaluated by the first of
+ * them, and optionally the vertices it skinned. The cache is cleared before the animation update
+ * of each frame and is used concurrently by the animation tasks.
+ */
+class BL_PoseCache
+{
+public:
+	/// State of an action layer applied to the pose.
+	struct Layer
+	{
+		bAction *m_action;
+		/// Frame of the action in quantization steps.
+		int m_frame;
+		/// Layer weight in thousandths, -1 without layer blending.
+		int m_weight;
+		short m_blendMode;
+
+		bool operator==(const Layer& other) const;
+	};
+
+	struct Key
+	{
+		/// Original armature object, shared by the replicas.
+		Object *m_object;
+		/// Action layers in the order they are applied.
+		std::vector<Layer> m_layers;
+		/** Local transforms of all the channels once the actions are applied, the channels not
+		 * animated by the actions keep a state proper to the instance.
+		 */
+		std::vector<float> m_transforms;
+
+		bool operator==(const Key& other) const;
+	};
+
+	/// Evaluated pose of a key.
+	struct Pose;
+
+	/** Constructor.
+	 * \param steps Number of quantization steps in an action frame, 0 to not quantize the frames.
+	 */
+	BL_PoseCache(short steps);
+	~BL_PoseCache();
+
+	/// Return the frame at which an action is evaluated.
+	float QuantizeFrame(float frame) const;
+	/// Return the frame in quantization steps used by the keys.
+	int GetFrameStep(float frame) const;
+
+	/// Remove all the poses, must not be called during the animation update.
+	void Clear();
+	/// Return the number of clears, the poses returned before a clear are freed.
+	unsigned int GetGeneration() const;
+
+	/// Fill the transforms of a key with the local transforms of the channels of a pose.
+	static void GetTransforms(bPose *pose, std::vector<float>& transforms);
+
+	/// Return the pose of a key, nullptr if it was not evaluated in this frame.
+	const Pose *FindPose(const Key& key);
+	/** Store the matrices of an evaluated pose, return the stored pose or the pose already stored
+	 * by another armature.
+	 */
+	const Pose *StorePose(const Key& key, bPose *pose);
+	/// Copy the matrices of a cached pose in a pose with the same channels.
+	static void LoadPose(const Pose *cachedPose, bPose *pose);
+
+	/** Copy the vertices of a mesh skinned in a cached pose, return false if they are not cached.
+	 * \param obmat The reference matrix of the mesh object used by the skinning.
+	 */
+	bool LoadSkin(const Pose *cachedPose, Mesh *mesh, const float obmat[4][4], float (*verts)[3], float (*nors)[3],
+	              unsigned int numVerts);
+	/// Store the vertices of a mesh skinned in a cached pose.
+	void StoreSkin(const Pose *cachedPose, Mesh *mesh, const float obmat[4][4], const float (*verts)[3],
+	               const float (*nors)[3], unsigned int numVerts);
+
+private:
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	/// Number of quantization steps per frame.
+	short m_steps;
+	unsigned int m_generation;
+
+	std::unordered_map<Key, std::unique_ptr<Pose>, KeyHash> m_poses;
+
+	/// The animation tasks share the cache.
+	CM_ThreadMutex m_mutex;
+};
+
+#endif  // __BL_POSECACHE_H__
@@ -0,0 +1,170 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_PoseSolver.cpp
+ *  \ingroup bgeconv
+ */
+
+
+#include "BL_PoseSolver.h"
+
+#include <unordered_map>
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+extern "C" {
+#  include "DNA_action_types.h"
+#  include "DNA_armature_types.h"
+#  include "BKE_armature.h"
+}
+
+/// Bone options changing the transform inherited from the parent, handled by BKE_pose_where_is.
+static const int unsupportedBoneFlags = BONE_HINGE | BONE_NO_SCALE | BONE_NO_LOCAL_LOCATION;
+
+BL_PoseSolver::BL_PoseSolver()
+{
+}
+
+BL_PoseSolver::~BL_PoseSolver()
+{
+}
+
+void BL_PoseSolver::Init(bPose *pose)
+{
+	m_rig.reset();
+	m_channels.clear();
+	m_poseMatrices.clear();
+
+	std::shared_ptr<Rig> rig(new Rig());
+	std::unordered_map<bPoseChannel *, int> indices;
+
+	// The channels are sorted from the roots to the children.
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		Bone *bone = pchan->bone;
+		if (!bone || pchan->constraints.first || (bone->flag & unsupportedBoneFlags)) {
+			return;
+		}
+
+		int parent = -1;
+		if (pchan->parent) {
+			const auto it = indices.find(pchan->parent);
+			if (it == indices.end() || !bone->parent) {
+				return;
+			}
+			parent = it->second;
+		}
+
+		const unsigned int index = rig->m_parents.size();
+		indices[pchan] = index;
+		rig->m_parents.push_back(parent);
+		rig->m_lengths.push_back(bone->length);
+		rig->m_cyclicOffsets.push_back(parent == -1 && !(bone->flag & BONE_NO_CYCLICOFFSET));
+
+		rig->m_restMatrices.resize((index + 1) * 16);
+		rig->m_invArmatureMatrices.resize((index + 1) * 16);
+		Eigen::Map<Eigen::Matrix4f> restMat(&rig->m_restMatrices[index * 16]);
+		const Eigen::Matrix4f armMat = Eigen::Matrix4f::Map((float *)bone->arm_mat);
+		Eigen::Map<Eigen::Matrix4f>(&rig->m_invArmatureMatrices[index * 16]) = armMat.inverse();
+
+		if (parent == -1) {
+			restMat = armMat;
+		}
+		else {
+			// Bone matrix at the root offset along the parent bone, see BKE_pchan_to_pose_mat.
+			restMat.setIdentity();
+			restMat.topLeftCorner<3, 3>() = Eigen::Matrix3f::Map((float *)bone->bone_mat);
+			restMat.col(3).head<3>() = Eigen::Vector3f::Map(bone->head);
+			restMat(1, 3) += bone->parent->length;
+		}
+	}
+
+	m_rig = rig;
+	SetPose(pose);
+}
+
+void BL_PoseSolver::SetPose(bPose *pose)
+{
+	m_channels.clear();
+	if (!m_rig) {
+		return;
+	}
+
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		m_channels.push_back(pchan);
+	}
+
+	if (m_channels.size() != m_rig->m_parents.size()) {
+		m_rig.reset();
+		m_channels.clear();
+		return;
+	}
+
+	m_poseMatrices.resize(m_channels.size() * 16);
+}
+
+bool BL_PoseSolver::IsSupported() const
+{
+	return (m_rig != nullptr);
+}
+
+bool BL_PoseSolver::Solve(bPose *pose, const bArmature *armature)
+{
+	// The channels could be rebuilt and the rest position uses the bone matrices.
+	if (!m_rig || (pose->flag & POSE_RECALC) || (armature->flag & ARM_RESTPOS)) {
+		return false;
+	}
+
+	const Rig& rig = *m_rig;
+	const Eigen::Vector3f cyclicOffset = Eigen::Vector3f::Map(pose->cyclic_offset);
+
+	for (unsigned int i = 0, size = m_channels.size(); i < size; ++i) {
+		bPoseChannel *pchan = m_channels[i];
+
+		// Local transform from the location, rotation and scale.
+		BKE_pchan_to_mat4(pchan, pchan->chan_mat);
+		const Eigen::Matrix4f chanMat = Eigen::Matrix4f::Map((float *)pchan->chan_mat);
+		const Eigen::Map<const Eigen::Matrix4f> restMat(&rig.m_restMatrices[i * 16]);
+
+		Eigen::Map<Eigen::Matrix4f> poseMat(&m_poseMatrices[i * 16]);
+		const int parent = rig.m_parents[i];
+		if (parent == -1) {
+			poseMat.noalias() = restMat * chanMat;
+			if (rig.m_cyclicOffsets[i]) {
+				poseMat.col(3).head<3>() += cyclicOffset;
+			}
+		}
+		else {
+			const Eigen::Map<const Eigen::Matrix4f> parentMat(&m_poseMatrices[parent * 16]);
+			poseMat.noalias() = parentMat * (restMat * chanMat);
+		}
+
+		Eigen::Matrix4f::Map((float *)pchan->pose_mat) = poseMat;
+		Eigen::Vector3f::Map(pchan->pose_head) = poseMat.col(3).head<3>();
+		Eigen::Vector3f::Map(pchan->pose_tail) = poseMat.col(3).head<3>() + poseMat.col(1).head<3>() * rig.m_lengths[i];
+
+		// Deform matrix from the rest pose.
+		Eigen::Matrix4f::Map((float *)pchan->chan_mat) = poseMat * Eigen::Matrix4f::Map(&rig.m_invArmatureMatrices[i * 16]);
+	}
+
+	return true;
+}
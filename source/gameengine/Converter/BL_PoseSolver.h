@@ -0,0 +1,84 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_PoseSolver.h
+ *  \ingroup bgeconv
+ */
+
+
+#ifndef __BL_POSESOLVER_H__
+#define __BL_POSESOLVER_H__
+
+#include <memory>
+#include <vector>
+
+struct bArmature;
+struct bPose;
+struct bPoseChannel;
+
+/** Pose evaluator of the game engine for the armatures without constraints. The channels are
+ * stored in flat arrays in hierarchical order with the index of their parent and their rest
+ * matrices, the pose and deform matrices are computed in one pass over the arrays. The rigs using
+ * constraints, IK or bone options changing the parent transform are left to BKE_pose_where_is.
+ */
+class BL_PoseSolver
+{
+private:
+	/// Rest data of the channels, shared by the replicas of an armature.
+	struct Rig
+	{
+		/// Index of the parent channel, -1 for the roots.
+		std::vector<int> m_parents;
+		/// Rest matrix in armature space for the roots, offset from the parent for the others.
+		std::vector<float> m_restMatrices;
+		/// Inverse of the rest matrices in armature space, to compute the deform matrices.
+		std::vector<float> m_invArmatureMatrices;
+		std::vector<float> m_lengths;
+		/// True for the roots using the cyclic offset of the pose.
+		std::vector<bool> m_cyclicOffsets;
+	};
+
+	std::shared_ptr<Rig> m_rig;
+	/// Channels of the pose in the order of the rig.
+	std::vector<bPoseChannel *> m_channels;
+	/// Pose matrices of the channels, read by the children.
+	std::vector<float> m_poseMatrices;
+
+public:
+	BL_PoseSolver();
+	~BL_PoseSolver();
+
+	/// Build the rig of a pose, the solver is unsupported if the pose is not handled.
+	void Init(bPose *pose);
+	/// Use the channels of a copy of the pose used in Init, the rig is shared.
+	void SetPose(bPose *pose);
+
+	/// Return true if the solver handles the pose of Init.
+	bool IsSupported() const;
+
+	/** Compute the pose, deform matrices, heads and tails of the channels from their transforms.
+	 * Return false if the pose must be evaluated by BKE_pose_where_is instead.
+	 */
+	bool Solve(bPose *pose, const bArmature *armature);
+};
+
+#endif  // __BL_POSESOLVER_H__
@@ -0,0 +1,110 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/BL_PoseTransforms.cpp
+ *  \ingroup bgeconv
+ */
+
+
+#include "BL_PoseTransforms.h"
+#include "BL_Action.h"
+
+#include <algorithm>
+
+#include "BLI_math.h"
+
+extern "C" {
+#  include "DNA_action_types.h"
+}
+
+void BL_PoseTransforms::GetChannels(bPose *pose, std::vector<bPoseChannel *>& channels)
+{
+	channels.clear();
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		channels.push_back(pchan);
+	}
+}
+
+void BL_PoseTransforms::Store(const std::vector<bPoseChannel *>& channels)
+{
+	// The capacity is kept, only the first store of a table allocates.
+	m_transforms.resize(channels.size());
+
+	for (unsigned int i = 0, size = channels.size(); i < size; ++i) {
+		const bPoseChannel *pchan = channels[i];
+		Transform& transform = m_transforms[i];
+		copy_v3_v3(transform.m_loc, pchan->loc);
+		copy_qt_qt(transform.m_quat, pchan->quat);
+		copy_v3_v3(transform.m_eul, pchan->eul);
+		copy_v3_v3(transform.m_size, pchan->size);
+		transform.m_rotmode = pchan->rotmode;
+	}
+}
+
+void BL_PoseTransforms::Load(const std::vector<bPoseChannel *>& channels) const
+{
+	for (unsigned int i = 0, size = std::min(channels.size(), m_transforms.size()); i < size; ++i) {
+		bPoseChannel *pchan = channels[i];
+		const Transform& transform = m_transforms[i];
+		copy_v3_v3(pchan->loc, transform.m_loc);
+		copy_qt_qt(pchan->quat, transform.m_quat);
+		copy_v3_v3(pchan->eul, transform.m_eul);
+		copy_v3_v3(pchan->size, transform.m_size);
+	}
+}
+
+void BL_PoseTransforms::Blend(const std::vector<bPoseChannel *>& channels, float weight, short mode) const
+{
+	const float dstweight = (mode == BL_Action::ACT_BLEND_BLEND) ? 1.0f - weight : 1.0f;
+
+	for (unsigned int i = 0, size = std::min(channels.size(), m_transforms.size()); i < size; ++i) {
+		bPoseChannel *dchan = channels[i];
+		const Transform& transform = m_transforms[i];
+
+		if (transform.m_rotmode == ROT_MODE_QUAT) {
+			float dquat[4], squat[4];
+
+			// Normalize quaternions so that interpolation/multiplication result is correct.
+			normalize_qt_qt(dquat, dchan->quat);
+			normalize_qt_qt(squat, transform.m_quat);
+
+			if (mode == BL_Action::ACT_BLEND_BLEND) {
+				interp_qt_qtqt(dchan->quat, dquat, squat, weight);
+			}
+			else {
+				mul_fac_qt_fl(squat, weight);
+				mul_qt_qtqt(dchan->quat, dquat, squat);
+			}
+
+			normalize_qt(dchan->quat);
+		}
+
+		for (unsigned short j = 0; j < 3; ++j) {
+			dchan->loc[j] = (dchan->loc[j] * dstweight) + (transform.m_loc[j] * weight);
+			dchan->size[j] = 1.0f + ((dchan->size[j] - 1.0f) * dstweight) + ((transform.m_size[j] - 1.0f) * weight);
+
+			if (transform.m_rotmode) {
+				dchan->eul[j] = (dchan->eul[j] * dstweight) + (transform.m_eul[j] * weight);
+			}
+		}
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_PoseTransforms.h
+ *  \ingroup bgeconv
+ */
+
+
+#ifndef __BL_POSETRANSFORMS_H__
+#define __BL_POSETRANSFORMS_H__
+
+#include <vector>
+
+struct bPose;
+struct bPoseChannel;
+
+/** Location, rotation and scale of pose channels stored in a flat array. It replaces the copies
+ * of whole poses to blend the actions, only the channels of a remap table are stored and blended,
+ * and the array is reused by the next stores without allocation.
+ */
+class BL_PoseTransforms
+{
+private:
+	struct Transform
+	{
+		float m_loc[3];
+		float m_quat[4];
+		float m_eul[3];
+		float m_size[3];
+		short m_rotmode;
+	};
+
+	std::vector<Transform> m_transforms;
+
+public:
+	/// Fill a remap table with all the channels of a pose.
+	static void GetChannels(bPose *pose, std::vector<bPoseChannel *>& channels);
+
+	/// Store the transforms of the channels.
+	void Store(const std::vector<bPoseChannel *>& channels);
+	/// Write the stored transforms in the channels, the same used to store.
+	void Load(const std::vector<bPoseChannel *>& channels) const;
+	/** Blend the stored transforms into the channels, the same used to store.
+	 * \param weight The weight of the stored transforms.
+	 * \param mode The blend mode, BL_Action::ACT_BLEND_BLEND or BL_Action::ACT_BLEND_ADD.
+	 */
+	void Blend(const std::vector<bPoseChannel *>& channels, float weight, short mode) const;
+};
+
+#endif  // __BL_POSETRANSFORMS_H__
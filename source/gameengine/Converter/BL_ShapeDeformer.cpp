@@ -62,6 +62,12 @@ extern "C" {
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
+
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
+
+#include <algorithm>
 
 #define __NLA_DEFNORMALS
 //#undef __NLA_DEFNORMALS
@@ -181,16 +187,18 @@ bool BL_ShapeDeformer::Update()
 		/* we will blend the key directly in m_transverts array: it is used by armature as the start position */
 		/* m_key can be nullptr in case of Modifier deformer */
 		if (m_key) {
-			WeightsArrayCache cache = {0, nullptr};
-			float **per_keyblock_weights;
-
 			/* store verts locally */
 			VerifyStorage();
 
-			per_keyblock_weights = BKE_keyblock_get_per_block_weights(blendobj, m_key, &cache);
-			BKE_key_evaluate_relative(0, m_bmesh->totvert, m_bmesh->totvert, (char *)(float *)m_transverts,
-			                          m_key, nullptr, per_keyblock_weights, 0); /* last arg is ignored */
-			BKE_keyblock_free_per_block_weights(m_key, per_keyblock_weights, &cache);
+			if (!BGEBlendShapes(blendobj)) {
+				WeightsArrayCache cache = {0, nullptr};
+				float **per_keyblock_weights;
+
+				per_keyblock_weights = BKE_keyblock_get_per_block_weights(blendobj, m_key, &cache);
+				BKE_key_evaluate_relative(0, m_bmesh->totvert, m_bmesh->totvert, (char *)(float *)m_transverts,
+				                          m_key, nullptr, per_keyblock_weights, 0); /* last arg is ignored */
+				BKE_keyblock_free_per_block_weights(m_key, per_keyblock_weights, &cache);
+			}
 
 			m_bDynamic = true;
 		}
@@ -231,3 +239,40 @@ Key *BL_ShapeDeformer::GetKey()
 {
 	return m_key;
 }
+
+void BL_ShapeDeformer::BlendShapesTask(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+	BL_ShapeDeformer *self = (BL_ShapeDeformer *)BLI_task_pool_userdata(pool);
+	const unsigned int start = GET_INT_FROM_POINTER(taskdata);
+	self->m_shapeKeys->Blend(self->m_activeBlocks, start, std::min(start + ShapeTaskSize, (unsigned int)self->m_bmesh->totvert),
+	                         self->m_transverts);
+}
+
+bool BL_ShapeDeformer::BGEBlendShapes(Object *blendobj)
+{
+	if (!BL_ShapeKeys::IsSupported(m_key, m_bmesh)) {
+		return false;
+	}
+
+	if (!m_shapeKeys) {
+		m_shapeKeys.reset(new BL_ShapeKeys(m_key, blendobj, m_bmesh));
+	}
+
+	m_shapeKeys->GetActiveBlocks(m_key, m_activeBlocks);
+
+	// Large meshes are split in ranges blended in parallel.
+	const unsigned int totvert = m_bmesh->totvert;
+	if (totvert > ShapeTaskSize && !m_activeBlocks.empty()) {
+		TaskPool *pool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), this);
+		for (unsigned int start = 0; start < totvert; start += ShapeTaskSize) {
+			BLI_task_pool_push(pool, BlendShapesTask, SET_INT_IN_POINTER(start), false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+	else {
+		m_shapeKeys->Blend(m_activeBlocks, 0, totvert, m_transverts);
+	}
+
+	return true;
+}
@@ -38,10 +38,13 @@
 
 #include "BL_SkinDeformer.h"
 #include "BL_DeformableGameObject.h"
+#include "BL_ShapeKeys.h"
+#include <memory>
 #include <vector>
 
 struct Object;
 struct Key;
+struct TaskPool;
 class RAS_MeshObject;
 
 class BL_ShapeDeformer : public BL_SkinDeformer
@@ -79,6 +82,18 @@ protected:
 	bool m_useShapeDrivers;
 	double m_lastShapeUpdate;
 	Key *m_key;
+
+	/// Number of vertices blended by a task.
+	static const unsigned int ShapeTaskSize = 4096;
+
+	/// Relative key compiled at the first update, shared by the replicas.
+	std::shared_ptr<BL_ShapeKeys> m_shapeKeys;
+	/// Blocks used in the current update and their value.
+	std::vector<BL_ShapeKeys::ActiveBlock> m_activeBlocks;
+
+	static void BlendShapesTask(TaskPool *__restrict pool, void *taskdata, int threadid);
+	/// Blend the key blocks in the vertex positions, return false if the key is not relative.
+	bool BGEBlendShapes(Object *blendobj);
 };
 
 #endif
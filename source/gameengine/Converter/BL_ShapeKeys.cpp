@@ -0,0 +1,137 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file gameengine/Converter/BL_ShapeKeys.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "BL_ShapeKeys.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#  include "DNA_key_types.h"
+#  include "DNA_mesh_types.h"
+#  include "DNA_meshdata_types.h"
+#  include "BKE_deform.h"
+#  include "BLI_listbase.h"
+#  include "BLI_math.h"
+}
+
+BL_ShapeKeys::BL_ShapeKeys(Key *key, Object *object, Mesh *mesh)
+{
+	const unsigned int totvert = mesh->totvert;
+
+	const float (*basis)[3] = (const float (*)[3])key->refkey->data;
+	m_basis.assign((const float *)basis, (const float *)(basis + totvert));
+
+	unsigned int index = 0;
+	for (KeyBlock *kb = (KeyBlock *)key->block.first; kb; kb = kb->next, ++index) {
+		KeyBlock *refb = (KeyBlock *)BLI_findlink(&key->block, kb->relative);
+		// Same conditions as BKE_key_evaluate_relative, excepted the value and the mute flag checked at each update.
+		if (kb == key->refkey || !refb || kb->totelem != (int)totvert || refb->totelem != (int)totvert) {
+			continue;
+		}
+
+		const int defgroup = (kb->vgroup[0] && mesh->dvert) ? defgroup_name_index(object, kb->vgroup) : -1;
+		const float (*from)[3] = (const float (*)[3])kb->data;
+		const float (*reffrom)[3] = (const float (*)[3])refb->data;
+
+		Block block;
+		block.m_index = index;
+		for (unsigned int v = 0; v < totvert; ++v) {
+			const float weight = (defgroup != -1) ? defvert_find_weight(&mesh->dvert[v], defgroup) : 1.0f;
+			float offset[3];
+			sub_v3_v3v3(offset, from[v], reffrom[v]);
+			mul_v3_fl(offset, weight);
+
+			// Only the vertices moved by the block are stored.
+			if (is_zero_v3(offset)) {
+				continue;
+			}
+
+			block.m_verts.push_back(v);
+			for (unsigned short i = 0; i < 3; ++i) {
+				block.m_offsets[i].push_back(offset[i]);
+			}
+		}
+
+		if (!block.m_verts.empty()) {
+			m_blocks.push_back(block);
+		}
+	}
+}
+
+BL_ShapeKeys::~BL_ShapeKeys()
+{
+}
+
+bool BL_ShapeKeys::IsSupported(Key *key, Mesh *mesh)
+{
+	return (key->type == KEY_RELATIVE && key->refkey && key->refkey->totelem == mesh->totvert);
+}
+
+void BL_ShapeKeys::GetActiveBlocks(Key *key, std::vector<ActiveBlock>& blocks) const
+{
+	blocks.clear();
+
+	// The blocks are sorted by index.
+	std::vector<Block>::const_iterator it = m_blocks.begin();
+	const std::vector<Block>::const_iterator end = m_blocks.end();
+	unsigned int index = 0;
+	for (KeyBlock *kb = (KeyBlock *)key->block.first; kb && it != end; kb = kb->next, ++index) {
+		if (it->m_index != index) {
+			continue;
+		}
+		if (!(kb->flag & KEYBLOCK_MUTE) && kb->curval != 0.0f) {
+			blocks.emplace_back(&*it, kb->curval);
+		}
+		++it;
+	}
+}
+
+void BL_ShapeKeys::Blend(const std::vector<ActiveBlock>& blocks, unsigned int start, unsigned int end, float (*verts)[3]) const
+{
+	memcpy(verts[start], &m_basis[start * 3], sizeof(float[3]) * (end - start));
+
+	for (const ActiveBlock& pair : blocks) {
+		const Block& block = *pair.first;
+		const float weight = pair.second;
+
+		// Range of the sparse vertices in the vertices to blend.
+		const unsigned int *blockVerts = block.m_verts.data();
+		const unsigned int *begin = std::lower_bound(blockVerts, blockVerts + block.m_verts.size(), start);
+		const unsigned int *last = std::lower_bound(begin, blockVerts + block.m_verts.size(), end);
+
+		const float *offsetx = block.m_offsets[0].data();
+		const float *offsety = block.m_offsets[1].data();
+		const float *offsetz = block.m_offsets[2].data();
+		for (unsigned int i = begin - blockVerts, size = last - blockVerts; i < size; ++i) {
+			float *co = verts[blockVerts[i]];
+			co[0] += offsetx[i] * weight;
+			co[1] += offsety[i] * weight;
+			co[2] += offsetz[i] * weight;
+		}
+	}
+}
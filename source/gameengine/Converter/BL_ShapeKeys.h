@@ -0,0 +1,83 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file BL_ShapeKeys.h
+ *  \ingroup bgeconv
+ */
+
+#ifndef __BL_SHAPEKEYS_H__
+#define __BL_SHAPEKEYS_H__
+
+#include <utility>
+#include <vector>
+
+struct Key;
+struct Mesh;
+struct Object;
+
+/** Relative shape key compiled to sparse arrays. The blocks only store the vertices they move,
+ * the positions are the basis plus the offsets of the blocks with a non null value scaled by
+ * this value, as computed by BKE_key_evaluate_relative. It is built at the first update of a
+ * deformer and shared by the replicas.
+ */
+class BL_ShapeKeys
+{
+public:
+	/// Offsets of the vertices moved by a relative key block from its reference block.
+	struct Block
+	{
+		/// Index of the block in the key.
+		unsigned int m_index;
+		/// Vertices moved by the block, sorted.
+		std::vector<unsigned int> m_verts;
+		/// Offsets of the vertices premultiplied by the vertex group weight, one array per axis.
+		std::vector<float> m_offsets[3];
+	};
+
+	/// Block used in an update and its value.
+	typedef std::pair<const Block *, float> ActiveBlock;
+
+private:
+	/// Positions of the reference block.
+	std::vector<float> m_basis;
+	std::vector<Block> m_blocks;
+
+public:
+	/** Compile a relative key.
+	 * \param object The object owning the vertex groups of the blocks.
+	 * \param mesh The mesh owning the key.
+	 */
+	BL_ShapeKeys(Key *key, Object *object, Mesh *mesh);
+	~BL_ShapeKeys();
+
+	/// Return true if the key can be compiled, the absolute keys are evaluated by Blender.
+	static bool IsSupported(Key *key, Mesh *mesh);
+
+	/// Gather the blocks with a value and not muted.
+	void GetActiveBlocks(Key *key, std::vector<ActiveBlock>& blocks) const;
+
+	/// Write the positions of a range of vertices blended from the active blocks.
+	void Blend(const std::vector<ActiveBlock>& blocks, unsigned int start, unsigned int end, float (*verts)[3]) const;
+};
+
+#endif  // __BL_SHAPEKEYS_H__
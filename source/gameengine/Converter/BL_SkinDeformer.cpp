@@ -58,11 +58,16 @@
 extern "C" {
 	#include "BKE_lattice.h"
 	#include "BKE_deform.h"
+	#include "eevee_private.h"
 }
 
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
+
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 
 #define __NLA_DEFNORMALS
 //#undef __NLA_DEFNORMALS
@@ -92,8 +97,7 @@ BL_SkinDeformer::BL_SkinDeformer(BL_DeformableGameObject *gameobj,
 	m_releaseobject(false),
 	m_poseApplied(false),
 	m_recalcNormal(true),
-	m_copyNormals(false),
-	m_dfnrToPC(nullptr)
+	m_copyNormals(false)
 {
 	copy_m4_m4(m_obmat, bmeshobj->obmat);
 	m_deformflags = get_deformflags(bmeshobj);
@@ -112,8 +116,7 @@ BL_SkinDeformer::BL_SkinDeformer(
 	m_lastArmaUpdate(-1),
 	m_releaseobject(release_object),
 	m_recalcNormal(recalc_normal),
-	m_copyNormals(false),
-	m_dfnrToPC(nullptr)
+	m_copyNormals(false)
 {
 	// this is needed to ensure correct deformation of mesh:
 	// the deformation is done with Blender's armature_deform_verts() function
@@ -126,10 +129,12 @@ BL_SkinDeformer::BL_SkinDeformer(
 
 BL_SkinDeformer::~BL_SkinDeformer()
 {
+	if (m_armobj && m_armobj->GetVertDeformType() == ARM_VDEF_BGE_GPU) {
+		DRW_game_skin_remove(m_gameobj->GetBlenderObject());
+	}
+
 	if (m_releaseobject && m_armobj)
 		m_armobj->Release();
-	if (m_dfnrToPC)
-		delete [] m_dfnrToPC;
 }
 
 void BL_SkinDeformer::Relink(std::map<SCA_IObject *, SCA_IObject *>& map)
@@ -184,7 +189,8 @@ void BL_SkinDeformer::ProcessReplica()
 	BL_MeshDeformer::ProcessReplica();
 	m_lastArmaUpdate = -1.0;
 	m_releaseobject = false;
-	m_dfnrToPC = nullptr;
+	// The influences are shared, the pose channels belong to the armature of the replica.
+	m_groupChannels.clear();
 }
 
 void BL_SkinDeformer::BlenderDeformVerts()
@@ -208,151 +214,199 @@ void BL_SkinDeformer::BlenderDeformVerts()
 #endif
 }
 
-void BL_SkinDeformer::BGEDeformVerts()
+void BL_SkinDeformer::BuildSkinInfluences()
 {
-	Object *par_arma = m_armobj->GetArmatureObject();
-	MDeformVert *dverts = m_bmesh->dvert;
-	bDeformGroup *dg;
-	int defbase_tot;
-	Eigen::Matrix4f pre_mat, post_mat, chan_mat, norm_chan_mat;
-
-	if (!dverts)
-		return;
-
-	defbase_tot = BLI_listbase_count(&m_objMesh->defbase);
+	m_influences.reset(new SkinInfluences());
+	std::vector<unsigned short>& groups = m_influences->m_groups;
+	std::vector<float>& weights = m_influences->m_weights;
+	std::vector<unsigned char>& counts = m_influences->m_counts;
+
+	const unsigned int totvert = m_bmesh->totvert;
+	groups.resize(totvert * MaxInfluences, 0);
+	weights.resize(totvert * MaxInfluences, 0.0f);
+	counts.resize(totvert, 0);
+
+	const unsigned int numGroups = m_groupChannels.size();
+	MDeformVert *dv = m_bmesh->dvert;
+	for (unsigned int i = 0; i < totvert; ++i, ++dv) {
+		unsigned short *vgroups = &groups[i * MaxInfluences];
+		float *vweights = &weights[i * MaxInfluences];
+		unsigned short count = 0;
+
+		// Insertion sort of the strongest influences of deforming groups.
+		for (unsigned int j = 0; j < dv->totweight; ++j) {
+			const MDeformWeight& dw = dv->dw[j];
+			if ((unsigned int)dw.def_nr >= numGroups || !m_groupChannels[dw.def_nr] || dw.weight <= 0.0f) {
+				continue;
+			}
 
-	if (m_dfnrToPC == nullptr) {
-		m_dfnrToPC = new bPoseChannel *[defbase_tot];
-		int i;
-		for (i = 0, dg = (bDeformGroup *)m_objMesh->defbase.first;
-		     dg;
-		     ++i, dg = dg->next)
-		{
-			m_dfnrToPC[i] = BKE_pose_channel_find_name(par_arma->pose, dg->name);
+			unsigned short k = std::min(count, (unsigned short)(MaxInfluences - 1));
+			if (count == MaxInfluences && dw.weight <= vweights[k]) {
+				continue;
+			}
+			for (; k > 0 && vweights[k - 1] < dw.weight; --k) {
+				vgroups[k] = vgroups[k - 1];
+				vweights[k] = vweights[k - 1];
+			}
+			vgroups[k] = dw.def_nr;
+			vweights[k] = dw.weight;
+			count = std::min(count + 1, (int)MaxInfluences);
+		}
 
-			if (m_dfnrToPC[i] && m_dfnrToPC[i]->bone->flag & BONE_NO_DEFORM)
-				m_dfnrToPC[i] = nullptr;
+		float total = 0.0f;
+		for (unsigned short k = 0; k < count; ++k) {
+			total += vweights[k];
 		}
+		for (unsigned short k = 0; k < count; ++k) {
+			vweights[k] /= total;
+		}
+		counts[i] = count;
 	}
+}
 
-	post_mat = Eigen::Matrix4f::Map((float *)m_obmat).inverse() * Eigen::Matrix4f::Map((float *)m_armobj->GetArmatureObject()->obmat);
-	pre_mat = post_mat.inverse();
-
-	MDeformVert *dv = dverts;
-	MDeformWeight *dw;
-
-	for (int i = 0; i < m_bmesh->totvert; ++i, dv++) {
-		float contrib = 0.0f, weight, max_weight = -1.0f;
-		bPoseChannel *pchan = nullptr;
-		Eigen::Vector3f normorg(m_bmesh->mvert[i].no[0], m_bmesh->mvert[i].no[1], m_bmesh->mvert[i].no[2]);
-		Eigen::Map<Eigen::Vector3f> norm = Eigen::Vector3f::Map(m_transnors[i]);
-		Eigen::Vector4f vec(0.0f, 0.0f, 0.0f, 1.0f);
-		Eigen::Vector4f co(m_transverts[i][0],
-		                   m_transverts[i][1],
-		                   m_transverts[i][2],
-		                   1.0f);
+void BL_SkinDeformer::SkinVertsTask(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+	BL_SkinDeformer *self = (BL_SkinDeformer *)BLI_task_pool_userdata(pool);
+	const unsigned int start = GET_INT_FROM_POINTER(taskdata);
+	self->SkinVerts(start, std::min(start + SkinTaskSize, (unsigned int)self->m_bmesh->totvert));
+}
 
-		if (!dv->totweight)
+void BL_SkinDeformer::SkinVerts(unsigned int start, unsigned int end)
+{
+	const unsigned short *groups = m_influences->m_groups.data();
+	const float *weights = m_influences->m_weights.data();
+	const unsigned char *counts = m_influences->m_counts.data();
+	const float *skinMatrices = m_skinMatrices.data();
+	const float *normalMatrices = m_normalMatrices.data();
+
+	for (unsigned int i = start; i < end; ++i) {
+		const unsigned short count = counts[i];
+		if (count == 0) {
 			continue;
+		}
 
-		co = pre_mat * co;
-
-		dw = dv->dw;
+		const unsigned int offset = i * MaxInfluences;
+		const Eigen::Vector4f co(m_transverts[i][0], m_transverts[i][1], m_transverts[i][2], 1.0f);
 
-		for (unsigned int j = dv->totweight; j != 0; j--, dw++) {
-			const int index = dw->def_nr;
+		// Linear blend of the positions transformed by the skinning matrices, vectorized by Eigen.
+		Eigen::Vector4f vec = Eigen::Matrix4f::Map(skinMatrices + groups[offset] * 16) * co * weights[offset];
+		for (unsigned short k = 1; k < count; ++k) {
+			vec.noalias() += Eigen::Matrix4f::Map(skinMatrices + groups[offset + k] * 16) * co * weights[offset + k];
+		}
 
-			if (index < defbase_tot && (pchan = m_dfnrToPC[index])) {
-				weight = dw->weight;
+		// The normal uses the most influential group.
+		Eigen::Vector3f::Map(m_transnors[i]) = Eigen::Matrix3f::Map(normalMatrices + groups[offset] * 9) *
+		                                       Eigen::Vector3f::Map(m_transnors[i]);
 
-				if (weight) {
-					chan_mat = Eigen::Matrix4f::Map((float *)pchan->chan_mat);
+		m_transverts[i][0] = vec[0];
+		m_transverts[i][1] = vec[1];
+		m_transverts[i][2] = vec[2];
+	}
+}
 
-					// Update Vertex Position
-					vec.noalias() += (chan_mat * co - co) * weight;
+void BL_SkinDeformer::UpdateSkinMatrices(bool nullUnused)
+{
+	Object *par_arma = m_armobj->GetArmatureObject();
 
-					// Save the most influential channel so we can use it to update the vertex normal
-					if (weight > max_weight)
-					{
-						max_weight = weight;
-						norm_chan_mat = chan_mat;
-					}
+	if (m_groupChannels.empty()) {
+		for (bDeformGroup *dg = (bDeformGroup *)m_objMesh->defbase.first; dg; dg = dg->next) {
+			bPoseChannel *pchan = BKE_pose_channel_find_name(par_arma->pose, dg->name);
+			m_groupChannels.push_back((pchan && !(pchan->bone->flag & BONE_NO_DEFORM)) ? pchan : nullptr);
+		}
+	}
 
-					contrib += weight;
-				}
-			}
+	const Eigen::Matrix4f post_mat = Eigen::Matrix4f::Map((float *)m_obmat).inverse() * Eigen::Matrix4f::Map((float *)par_arma->obmat);
+	const Eigen::Matrix4f pre_mat = post_mat.inverse();
+
+	// Skinning matrices of the groups including the transitions from and to the armature space.
+	const unsigned int numGroups = m_groupChannels.size();
+	m_skinMatrices.resize(numGroups * 16);
+	m_normalMatrices.resize(numGroups * 9);
+	for (unsigned int i = 0; i < numGroups; ++i) {
+		bPoseChannel *pchan = m_groupChannels[i];
+		Eigen::Map<Eigen::Matrix4f> skinMat(&m_skinMatrices[i * 16]);
+		Eigen::Map<Eigen::Matrix3f> normalMat(&m_normalMatrices[i * 9]);
+		if (pchan) {
+			const Eigen::Matrix4f chan_mat = Eigen::Matrix4f::Map((float *)pchan->chan_mat);
+			skinMat = post_mat * chan_mat * pre_mat;
+			normalMat = chan_mat.topLeftCorner<3, 3>();
+		}
+		else if (nullUnused) {
+			skinMat.setZero();
+			normalMat.setZero();
 		}
+		else {
+			skinMat.setIdentity();
+			normalMat.setIdentity();
+		}
+	}
+}
 
-		// Update Vertex Normal
-		norm = norm_chan_mat.topLeftCorner<3, 3>() * normorg;
+void BL_SkinDeformer::BGEDeformVerts()
+{
+	if (!m_bmesh->dvert)
+		return;
 
-		co.noalias() += vec / contrib;
-		co[3] = 1.0f; // Make sure we have a 1 for the w component!
+	UpdateSkinMatrices(false);
 
-		co = post_mat * co;
+	if (!m_influences) {
+		BuildSkinInfluences();
+	}
 
-		m_transverts[i][0] = co[0];
-		m_transverts[i][1] = co[1];
-		m_transverts[i][2] = co[2];
+	// Large meshes are split in ranges skinned in parallel.
+	const unsigned int totvert = m_bmesh->totvert;
+	if (totvert > SkinTaskSize) {
+		TaskPool *pool = BLI_task_pool_create(KX_GetActiveEngine()->GetTaskScheduler(), this);
+		for (unsigned int start = 0; start < totvert; start += SkinTaskSize) {
+			BLI_task_pool_push(pool, SkinVertsTask, SET_INT_IN_POINTER(start), false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
 	}
+	else {
+		SkinVerts(0, totvert);
+	}
+
 	m_copyNormals = true;
 }
 
-void BL_SkinDeformer::UpdateTransverts()
+void BL_SkinDeformer::GPUDeformVerts()
 {
-	// if we don't use a vertex array we does nothing.
-	if (!UseVertexArray()) {
+	if (!m_bmesh->dvert) {
 		return;
 	}
 
-	bool first = true;
-	if (m_transverts) {
-		// AABB Box : min/max.
-		MT_Vector3 aabbMin;
-		MT_Vector3 aabbMax;
-
-		// the vertex cache is unique to this deformer, no need to update it
-		// if it wasn't updated! We must update all the materials at once
-		// because we will not get here again for the other material
-		for (RAS_IDisplayArray *array: m_displayArrayList) {
-			// for each vertex
-			// copy the untransformed data from the original mvert
-			for (unsigned int i = 0, size = array->GetVertexCount(); i < size; ++i) {
-				RAS_ITexVert *v = array->GetVertex(i);
-				const RAS_TexVertInfo& vinfo = array->GetVertexInfo(i);
-				v->SetXYZ(m_transverts[vinfo.getOrigIndex()]);
-				if (m_copyNormals)
-					v->SetNormal(MT_Vector3(m_transnors[vinfo.getOrigIndex()]));
-
-				MT_Vector3 vertpos = v->xyz();
-
-				// For the first vertex of the mesh, only initialize AABB.
-				if (first) {
-					aabbMin = aabbMax = vertpos;
-					first = false;
-				}
-				else {
-					aabbMin.x() = std::min(aabbMin.x(), vertpos.x());
-					aabbMin.y() = std::min(aabbMin.y(), vertpos.y());
-					aabbMin.z() = std::min(aabbMin.z(), vertpos.z());
-					aabbMax.x() = std::max(aabbMax.x(), vertpos.x());
-					aabbMax.y() = std::max(aabbMax.y(), vertpos.y());
-					aabbMax.z() = std::max(aabbMax.z(), vertpos.z());
-				}
-			}
+	m_armobj->ApplyPose();
+	// The vertex shaders ignore the groups with a null matrix.
+	UpdateSkinMatrices(true);
+	m_armobj->RestorePose();
 
-			array->SetModifiedFlag(RAS_IDisplayArray::POSITION_MODIFIED | RAS_IDisplayArray::NORMAL_MODIFIED);
-		}
+	DRW_game_skin_set(m_gameobj->GetBlenderObject(), m_skinMatrices.data(), m_groupChannels.size());
+
+	m_lastArmaUpdate = m_armobj->GetLastFrame();
+}
 
-		if (m_copyNormals)
-			m_copyNormals = false;
+void BL_SkinDeformer::UpdateTransverts()
+{
+	// if we don't use a vertex array we does nothing.
+	if (!UseVertexArray()) {
+		return;
 	}
+
+	// Without copy the normals were recalculated in the display arrays by RecalcNormals.
+	WriteTransverts(m_copyNormals, !m_copyNormals && m_recalcNormal);
+	m_copyNormals = false;
 }
 
 bool BL_SkinDeformer::UpdateInternal(bool shape_applied)
 {
 	/* See if the armature has been updated for this frame */
 	if (PoseUpdated()) {
+		if (m_armobj->GetVertDeformType() == ARM_VDEF_BGE_GPU) {
+			GPUDeformVerts();
+			return false;
+		}
+
 		if (!shape_applied) {
 			/* store verts locally */
 			VerifyStorage();
@@ -360,8 +414,20 @@ bool BL_SkinDeformer::UpdateInternal(bool shape_applied)
 
 		m_armobj->ApplyPose();
 
-		if (m_armobj->GetVertDeformType() == ARM_VDEF_BGE_CPU)
-			BGEDeformVerts();
+		if (m_armobj->GetVertDeformType() == ARM_VDEF_BGE_CPU) {
+			// The instances sharing the pose share the skinned vertices too, without shape keys.
+			BL_PoseCache *cache = (!shape_applied && m_bmesh->dvert) ? m_armobj->GetPoseCache() : nullptr;
+			const BL_PoseCache::Pose *pose = (cache) ? m_armobj->GetCachedPose() : nullptr;
+			if (pose && cache->LoadSkin(pose, m_bmesh, m_obmat, m_transverts, m_transnors, m_bmesh->totvert)) {
+				m_copyNormals = true;
+			}
+			else {
+				BGEDeformVerts();
+				if (pose) {
+					cache->StoreSkin(pose, m_bmesh, m_obmat, m_transverts, m_transnors, m_bmesh->totvert);
+				}
+			}
+		}
 		else
 			BlenderDeformVerts();
 
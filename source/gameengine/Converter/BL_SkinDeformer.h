@@ -46,8 +46,12 @@
 
 #include "RAS_Deformer.h"
 
+#include <memory>
+#include <vector>
+
 struct Object;
 struct bPoseChannel;
+struct TaskPool;
 class RAS_MeshObject;
 class RAS_IPolyMaterial;
 
@@ -105,11 +109,42 @@ protected:
 	bool m_poseApplied;
 	bool m_recalcNormal;
 	bool m_copyNormals; // dirty flag so we know if Apply() needs to copy normal information (used for BGEDeformVerts())
-	bPoseChannel **m_dfnrToPC;
 	short m_deformflags;
 
+	/// Maximum number of deform groups influencing a vertex in BGEDeformVerts.
+	static const unsigned short MaxInfluences = 4;
+	/// Number of vertices skinned by a task.
+	static const unsigned int SkinTaskSize = 2048;
+
+	/** Influences of the deform groups on the mesh vertices, built from the deform vertices
+	 * and shared by the replicas. Each vertex uses MaxInfluences slots, the strongest first.
+	 */
+	struct SkinInfluences
+	{
+		std::vector<unsigned short> m_groups;
+		/// Weights normalized per vertex.
+		std::vector<float> m_weights;
+		std::vector<unsigned char> m_counts;
+	};
+
+	std::shared_ptr<SkinInfluences> m_influences;
+	/// Pose channel of each deform group, nullptr for the groups not deforming.
+	std::vector<bPoseChannel *> m_groupChannels;
+	/// Position (4x4) and normal (3x3) matrices of each deform group for the current pose.
+	std::vector<float> m_skinMatrices;
+	std::vector<float> m_normalMatrices;
+
 	void BlenderDeformVerts();
+	/** Compute the skinning matrices of the deform groups for the applied pose,
+	 * the groups not deforming use a null matrix if nullUnused is true, identity otherwise.
+	 */
+	void UpdateSkinMatrices(bool nullUnused);
+	void BuildSkinInfluences();
+	static void SkinVertsTask(TaskPool *__restrict pool, void *taskdata, int threadid);
+	void SkinVerts(unsigned int start, unsigned int end);
 	void BGEDeformVerts();
+	/// Send the skinning matrices to the vertex shaders of the render, the vertices are not deformed.
+	void GPUDeformVerts();
 
 	void UpdateTransverts();
 };
@@ -44,6 +44,7 @@
 #include "KX_LibLoadStatus.h"
 #include "KX_BlenderScalarInterpolator.h"
 #include "KX_BlenderConverter.h"
+#include "BL_ActionClip.h"
 #include "KX_BlenderSceneConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "BL_ActionActuator.h"
@@ -106,7 +107,11 @@ void KX_BlenderConverter::SceneSlot::Merge(KX_BlenderConverter::SceneSlot& other
 	m_meshobjects.insert(m_meshobjects.begin(),
 						 std::make_move_iterator(other.m_meshobjects.begin()),
 						 std::make_move_iterator(other.m_meshobjects.end()));
+	m_actionClips.insert(m_actionClips.begin(),
+						 std::make_move_iterator(other.m_actionClips.begin()),
+						 std::make_move_iterator(other.m_actionClips.end()));
 	m_actionToInterp.insert(other.m_actionToInterp.begin(), other.m_actionToInterp.end());
+	m_actionToClip.insert(other.m_actionToClip.begin(), other.m_actionToClip.end());
 }
 
 void KX_BlenderConverter::SceneSlot::Merge(const KX_BlenderSceneConverter& converter)
@@ -117,6 +122,10 @@ void KX_BlenderConverter::SceneSlot::Merge(const KX_BlenderSceneConverter& conve
 	for (RAS_MeshObject *meshobj : converter.m_meshobjects) {
 		m_meshobjects.emplace_back(meshobj);
 	}
+	for (BL_ActionClip *clip : converter.m_actionClips) {
+		m_actionClips.emplace_back(clip);
+		m_actionToClip[clip->GetAction()] = clip;
+	}
 }
 
 KX_BlenderConverter::KX_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine)
@@ -201,7 +210,9 @@ void KX_BlenderConverter::ConvertScene(KX_Scene *destinationscene, RAS_Rasterize
 			SYS_SystemHandle syshandle = SYS_GetSystem(); /*unused*/
 			int visualizePhysics = SYS_GetCommandLineInt(syshandle, "show_physics", 0);
 
-			phy_env = CcdPhysicsEnvironment::Create(blenderscene, visualizePhysics);
+			// Linked scenes use the cache of their library.
+			const char *blendpath = (blenderscene->id.lib) ? blenderscene->id.lib->filepath : m_maggie->name;
+			phy_env = CcdPhysicsEnvironment::Create(blenderscene, visualizePhysics, blendpath);
 			physics_engine = UseBullet;
 			break;
 		}
@@ -280,6 +291,18 @@ BL_InterpolatorList *KX_BlenderConverter::FindInterpolatorList(KX_Scene *scene,
 	return m_sceneSlots[scene].m_actionToInterp[for_act];
 }
 
+void KX_BlenderConverter::RegisterActionClip(KX_Scene *scene, BL_ActionClip *clip)
+{
+	SceneSlot& sceneSlot = m_sceneSlots[scene];
+	sceneSlot.m_actionClips.emplace_back(clip);
+	sceneSlot.m_actionToClip[clip->GetAction()] = clip;
+}
+
+BL_ActionClip *KX_BlenderConverter::FindActionClip(KX_Scene *scene, bAction *for_act)
+{
+	return m_sceneSlots[scene].m_actionToClip[for_act];
+}
+
 Main *KX_BlenderConverter::CreateMainDynamic(const std::string& path)
 {
 	Main *maggie = BKE_main_new();
@@ -705,6 +728,17 @@ bool KX_BlenderConverter::FreeBlendFile(Main *maggie)
 			}
 		}
 
+		for (UniquePtrList<BL_ActionClip>::iterator it = sceneSlot.m_actionClips.begin(); it != sceneSlot.m_actionClips.end(); ) {
+			bAction *action = (*it)->GetAction();
+			if (IS_TAGGED(action)) {
+				sceneSlot.m_actionToClip.erase(action);
+				it = sceneSlot.m_actionClips.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+
 		for (UniquePtrList<RAS_MeshObject>::iterator it =  sceneSlot.m_meshobjects.begin(); it !=  sceneSlot.m_meshobjects.end(); ) {
 			RAS_MeshObject *mesh = (*it).get();
 			if (IS_TAGGED(mesh->GetMesh())) {
@@ -54,6 +54,7 @@ class KX_KetsjiEngine;
 class KX_LibLoadStatus;
 class KX_BlenderMaterial;
 class BL_InterpolatorList;
+class BL_ActionClip;
 class SCA_IActuator;
 class SCA_IController;
 class RAS_MeshObject;
@@ -81,8 +82,10 @@ private:
 		UniquePtrList<KX_BlenderMaterial> m_materials;
 		UniquePtrList<RAS_MeshObject> m_meshobjects;
 		UniquePtrList<BL_InterpolatorList> m_interpolators;
+		UniquePtrList<BL_ActionClip> m_actionClips;
 
 		std::map<bAction *, BL_InterpolatorList *> m_actionToInterp;
+		std::map<bAction *, BL_ActionClip *> m_actionToClip;
 
 		SceneSlot();
 		SceneSlot(const KX_BlenderSceneConverter& converter);
@@ -125,6 +128,9 @@ public:
 	void RegisterInterpolatorList(KX_Scene *scene, BL_InterpolatorList *interpolator, bAction *for_act);
 	BL_InterpolatorList *FindInterpolatorList(KX_Scene *scene, bAction *for_act);
 
+	void RegisterActionClip(KX_Scene *scene, BL_ActionClip *clip);
+	BL_ActionClip *FindActionClip(KX_Scene *scene, bAction *for_act);
+
 	Scene *GetBlenderSceneForName(const std::string& name);
 	CListValue<CStringValue> *GetInactiveSceneNames();
 
@@ -85,6 +85,11 @@ KX_BlenderMaterial *KX_BlenderSceneConverter::FindMaterial(Material *mat)
 	return m_map_mesh_to_polyaterial[mat];
 }
 
+void KX_BlenderSceneConverter::RegisterActionClip(BL_ActionClip *clip)
+{
+	m_actionClips.push_back(clip);
+}
+
 void KX_BlenderSceneConverter::RegisterGameActuator(SCA_IActuator *act, bActuator *for_actuator)
 {
 	m_map_blender_to_gameactuator[for_actuator] = act;
@@ -41,6 +41,7 @@ class SCA_IActuator;
 class SCA_IController;
 class RAS_MeshObject;
 class KX_BlenderMaterial;
+class BL_ActionClip;
 class KX_BlenderConverter;
 class KX_GameObject;
 class KX_Scene;
@@ -61,6 +62,7 @@ class KX_BlenderSceneConverter
 private:
 	std::vector<KX_BlenderMaterial *> m_materials;
 	std::vector<RAS_MeshObject *> m_meshobjects;
+	std::vector<BL_ActionClip *> m_actionClips;
 
 	std::map<Object *, KX_GameObject *> m_map_blender_to_gameobject;
 	std::map<Mesh *, RAS_MeshObject *> m_map_mesh_to_gamemesh;
@@ -85,6 +87,8 @@ public:
 	void RegisterMaterial(KX_BlenderMaterial *blmat, Material *mat);
 	KX_BlenderMaterial *FindMaterial(Material *mat);
 
+	void RegisterActionClip(BL_ActionClip *clip);
+
 	void RegisterGameActuator(SCA_IActuator *act, bActuator *for_actuator);
 	SCA_IActuator *FindGameActuator(bActuator *for_actuator);
 
@@ -30,7 +30,12 @@
 
 #include <iostream>
 
+#include "CM_Message.h"
+
 DEV_InputDevice::DEV_InputDevice()
+	:m_streamFrame(0),
+	m_replayIndex(0),
+	m_replaying(false)
 {
 	m_reverseKeyTranslateTable[GHOST_kKeyA] = AKEY;
 	m_reverseKeyTranslateTable[GHOST_kKeyB] = BKEY;
@@ -184,6 +189,126 @@ void DEV_InputDevice::ConvertWindowEvent(int incode)
 }
 
 void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type, int val, unsigned int unicode)
+{
+	if (m_replaying) {
+		return;
+	}
+	if (m_recordStream.is_open()) {
+		m_recordStream << m_streamFrame << " " << RecordedEvent::EVENT << " " << type << " " << val << " " << unicode << "\n";
+	}
+
+	ProcessEvent(type, val, unicode);
+}
+
+void DEV_InputDevice::ConvertMoveEvent(int x, int y)
+{
+	if (m_replaying) {
+		return;
+	}
+	if (m_recordStream.is_open()) {
+		m_recordStream << m_streamFrame << " " << RecordedEvent::MOVE << " " << x << " " << y << " 0\n";
+	}
+
+	ProcessMoveEvent(x, y);
+}
+
+void DEV_InputDevice::ConvertWheelEvent(int z)
+{
+	if (m_replaying) {
+		return;
+	}
+	if (m_recordStream.is_open()) {
+		m_recordStream << m_streamFrame << " " << RecordedEvent::WHEEL << " " << z << " 0 0\n";
+	}
+
+	ProcessWheelEvent(z);
+}
+
+bool DEV_InputDevice::StartRecording(const std::string& filepath)
+{
+	StopRecordingReplay();
+
+	m_recordStream.open(filepath);
+	if (!m_recordStream.is_open()) {
+		CM_Error("failed to open input recording file: " << filepath);
+		return false;
+	}
+
+	m_streamFrame = 0;
+	return true;
+}
+
+bool DEV_InputDevice::StartReplay(const std::string& filepath)
+{
+	StopRecordingReplay();
+
+	std::ifstream stream(filepath);
+	if (!stream.is_open()) {
+		CM_Error("failed to open input replay file: " << filepath);
+		return false;
+	}
+
+	RecordedEvent event;
+	int kind;
+	while (stream >> event.m_frame >> kind >> event.m_a >> event.m_b >> event.m_unicode) {
+		event.m_kind = (RecordedEvent::Kind)kind;
+		m_replayEvents.push_back(event);
+	}
+
+	m_streamFrame = 0;
+	m_replayIndex = 0;
+	m_replaying = true;
+	return true;
+}
+
+void DEV_InputDevice::StopRecordingReplay()
+{
+	if (m_recordStream.is_open()) {
+		m_recordStream.close();
+	}
+	m_replayEvents.clear();
+	m_replaying = false;
+}
+
+bool DEV_InputDevice::IsReplaying() const
+{
+	return m_replaying;
+}
+
+void DEV_InputDevice::NextStreamFrame()
+{
+	if (m_replaying) {
+		// Events are sorted by frame.
+		for (unsigned int size = m_replayEvents.size(); m_replayIndex < size; ++m_replayIndex) {
+			const RecordedEvent& event = m_replayEvents[m_replayIndex];
+			if (event.m_frame > m_streamFrame) {
+				break;
+			}
+
+			switch (event.m_kind) {
+				case RecordedEvent::EVENT:
+				{
+					ProcessEvent((SCA_EnumInputs)event.m_a, event.m_b, event.m_unicode);
+					break;
+				}
+				case RecordedEvent::MOVE:
+				{
+					ProcessMoveEvent(event.m_a, event.m_b);
+					break;
+				}
+				case RecordedEvent::WHEEL:
+				{
+					ProcessWheelEvent(event.m_a);
+					break;
+				}
+			}
+		}
+	}
+
+	++m_streamFrame;
+}
+
+void DEV_InputDevice::ProcessEvent(SCA_IInputDevice::SCA_EnumInputs type, int val, unsigned int unicode)
 {
 	SCA_InputEvent &event = m_inputsTable[type];
 
@@ -201,7 +326,7 @@ void DEV_InputDevice::ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type, int va
 	}
 }
 
-void DEV_InputDevice::ConvertMoveEvent(int x, int y)
+void DEV_InputDevice::ProcessMoveEvent(int x, int y)
 {
 	SCA_InputEvent &xevent = m_inputsTable[MOUSEX];
 	xevent.m_values.push_back(x);
@@ -218,7 +343,7 @@ void DEV_InputDevice::ConvertMoveEvent(int x, int y)
 	}
 }
 
-void DEV_InputDevice::ConvertWheelEvent(int z)
+void DEV_InputDevice::ProcessWheelEvent(int z)
 {
 	SCA_InputEvent &event = m_inputsTable[(z > 0) ? WHEELUPMOUSE : WHEELDOWNMOUSE];
 	event.m_values.push_back(z);
@@ -30,6 +30,8 @@
 #include "SCA_IInputDevice.h"
 
 #include <map>
+#include <vector>
+#include <fstream>
 
 class DEV_InputDevice : public SCA_IInputDevice
 {
@@ -39,6 +41,36 @@ protected:
 	std::map<int, SCA_EnumInputs> m_reverseButtonTranslateTable;
 	std::map<int, SCA_EnumInputs> m_reverseWindowTranslateTable;
 
+	/// A converted event stored in an input stream.
+	struct RecordedEvent
+	{
+		enum Kind {
+			EVENT = 0,
+			MOVE,
+			WHEEL
+		};
+
+		unsigned int m_frame;
+		Kind m_kind;
+		/// Input type and value for EVENT, position for MOVE, wheel delta in m_a for WHEEL.
+		int m_a;
+		int m_b;
+		unsigned int m_unicode;
+	};
+
+	/// Frame index of the recording or the replay.
+	unsigned int m_streamFrame;
+	/// File receiving the converted events when recording.
+	std::ofstream m_recordStream;
+	/// Events to replay and index of the next one, the device events are ignored during the replay.
+	std::vector<RecordedEvent> m_replayEvents;
+	unsigned int m_replayIndex;
+	bool m_replaying;
+
+	void ProcessEvent(SCA_IInputDevice::SCA_EnumInputs type, int val, unsigned int unicode);
+	void ProcessMoveEvent(int x, int y);
+	void ProcessWheelEvent(int z);
+
 public:
 	DEV_InputDevice();
 	virtual ~DEV_InputDevice();
@@ -49,6 +81,24 @@ public:
 	void ConvertMoveEvent(int x, int y);
 	void ConvertWheelEvent(int z);
 	void ConvertEvent(SCA_IInputDevice::SCA_EnumInputs type, int val, unsigned int unicode);
+
+	/** Write all the converted events to a text file to replay them later.
+	 * \return False if the file can't be opened.
+	 */
+	bool StartRecording(const std::string& filepath);
+	/** Replay the events of a file written by StartRecording(), the events from the
+	 * system are ignored until StopRecordingReplay() is called.
+	 * \return False if the file can't be read.
+	 */
+	bool StartReplay(const std::string& filepath);
+	/// Stop the recording or the replay.
+	void StopRecordingReplay();
+	bool IsReplaying() const;
+
+	/** Go to the next frame of the recording or the replay, called once per engine frame
+	 * after the system events are processed. The replayed events of the frame are converted.
+	 */
+	void NextStreamFrame();
 };
 
 #endif  // __DEV_INPUTDEVICE_H__
@@ -35,6 +35,7 @@
 #include "EXP_Value.h"
 #include "SCA_IObject.h"
 #include "EXP_BoolValue.h"
+#include "SCA_LogicProfile.h"
 
 class KX_NetworkMessageScene;
 class SCA_IScene;
@@ -53,6 +54,9 @@ protected:
 	CValue*				m_eventval;
 	std::string			m_text;
 	std::string			m_name;
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	SCA_LogicProfile	m_logicProfile;
+#endif
 	//unsigned long		m_drawcolor;
 	void RemoveEvent();
 
@@ -121,6 +125,14 @@ public:
 	virtual void SetLogicManager(SCA_LogicManager *logicmgr);
 	SCA_LogicManager *GetLogicManager();
 
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	/// Time spent in the sensor evaluation, controller trigger or actuator update.
+	SCA_LogicProfile& GetLogicProfile()
+	{
+		return m_logicProfile;
+	}
+#endif
+
 	/* for moving logic bricks between scenes */
 	virtual void		Replace_IScene(SCA_IScene *val) {}
 	virtual void		Replace_NetworkScene(KX_NetworkMessageScene *val) {}
@@ -307,6 +307,22 @@ void SCA_IObject::SetState(unsigned int state)
 	}
 }
 
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+void SCA_IObject::ResetLogicProfile()
+{
+	m_logicProfile.Reset();
+	for (SCA_ISensor *sensor : m_sensors) {
+		sensor->GetLogicProfile().Reset();
+	}
+	for (SCA_IController *controller : m_controllers) {
+		controller->GetLogicProfile().Reset();
+	}
+	for (SCA_IActuator *actuator : m_actuators) {
+		actuator->GetLogicProfile().Reset();
+	}
+}
+#endif  // WITH_GAMEENGINE_LOGIC_PROFILE
+
 #ifdef WITH_PYTHON
 
 /* ------------------------------------------------------------------------- */
@@ -37,6 +37,7 @@
 #include "EXP_Value.h"
 
 #include "SG_QList.h"
+#include "SCA_LogicProfile.h"
 #include <vector>
 
 class SCA_IObject;
@@ -111,6 +112,11 @@ protected:
 	 */
 	SG_QList*				m_firstState;
 
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	/// Sum of the time spent in the logic bricks of this object.
+	SCA_LogicProfile		m_logicProfile;
+#endif
+
 public:
 	
 	SCA_IObject();
@@ -203,6 +209,16 @@ public:
 	 */
 	unsigned int GetState(void)	{ return m_state; }
 
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	SCA_LogicProfile& GetLogicProfile()
+	{
+		return m_logicProfile;
+	}
+
+	/// Reset the profile of the object and its logic bricks.
+	void ResetLogicProfile();
+#endif
+
 	virtual int GetGameObjectType() const {return -1;}
 	
 	typedef enum ObjectTypes {
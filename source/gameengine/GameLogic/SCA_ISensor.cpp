@@ -257,7 +257,11 @@ void SCA_ISensor::Activate(class SCA_LogicManager *logicmgr)
 	 * don't evaluate a sensor that is not connected to any controller
 	 */
 	if (m_links && !m_suspended) {
-		bool result = this->Evaluate();
+		bool result;
+		{
+			SCA_LOGIC_PROFILE_BRICK(this);
+			result = this->Evaluate();
+		}
 		// store the state for the rest of the logic system
 		m_prev_state = m_state;
 		m_state = this->IsPositiveTrigger();
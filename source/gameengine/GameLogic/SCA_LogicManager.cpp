@@ -160,6 +160,8 @@ void SCA_LogicManager::RegisterToActuator(SCA_IController* controller,SCA_IActua
 
 void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 {
+	SCA_LOGIC_PROFILE_SCOPE(m_beginFrameProfile);
+
 	for (std::vector<SCA_EventManager*>::const_iterator ie=m_eventmanagers.begin(); !(ie==m_eventmanagers.end()); ie++)
 		(*ie)->NextFrame(curtime, fixedtime);
 
@@ -171,7 +173,10 @@ void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 			contr != nullptr;
 			contr = (SCA_IController*)obj->QRemove())
 		{
-			contr->Trigger(this);
+			{
+				SCA_LOGIC_PROFILE_BRICK(contr);
+				contr->Trigger(this);
+			}
 			contr->ClrJustActivated();
 		}
 	}
@@ -181,6 +186,8 @@ void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 
 void SCA_LogicManager::UpdateFrame(double curtime)
 {
+	SCA_LOGIC_PROFILE_SCOPE(m_updateFrameProfile);
+
 	for (std::vector<SCA_EventManager*>::const_iterator ie=m_eventmanagers.begin(); !(ie==m_eventmanagers.end()); ie++)
 		(*ie)->UpdateFrame();
 
@@ -196,7 +203,12 @@ void SCA_LogicManager::UpdateFrame(double curtime)
 			SCA_IActuator* actua = *ia;
 			// increment first to allow removal of inactive actuators.
 			++ia;
-			if (!actua->Update(curtime))
+			bool active;
+			{
+				SCA_LOGIC_PROFILE_BRICK(actua);
+				active = actua->Update(curtime);
+			}
+			if (!active)
 			{
 				// this actuator is not active anymore, remove
 				actua->QDelink(); 
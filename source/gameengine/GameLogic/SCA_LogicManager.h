@@ -62,6 +62,7 @@ typedef std::map<class SCA_ISensor*,controllerlist > sensormap_t;
 #include "SCA_ILogicBrick.h"
 #include "SCA_IActuator.h"
 #include "SCA_EventManager.h"
+#include "SCA_LogicProfile.h"
 
 
 class SCA_LogicManager
@@ -83,6 +84,13 @@ class SCA_LogicManager
 
 	std::map<std::string, void *>		m_map_gamemeshname_to_blendobj;
 	std::map<void *, CValue *>			m_map_blendobj_to_gameobj;
+
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	/// Time spent in BeginFrame and UpdateFrame, including the logic bricks.
+	SCA_LogicProfile m_beginFrameProfile;
+	SCA_LogicProfile m_updateFrameProfile;
+#endif
+
 public:
 	SCA_LogicManager();
 	virtual ~SCA_LogicManager();
@@ -105,6 +113,23 @@ public:
 	}
 
 	void	AddTriggeredController(SCA_IController* controller, SCA_ISensor* sensor);
+
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	const SCA_LogicProfile& GetBeginFrameProfile() const
+	{
+		return m_beginFrameProfile;
+	}
+	const SCA_LogicProfile& GetUpdateFrameProfile() const
+	{
+		return m_updateFrameProfile;
+	}
+	void ResetLogicProfile()
+	{
+		m_beginFrameProfile.Reset();
+		m_updateFrameProfile.Reset();
+	}
+#endif
+
 	SCA_EventManager*	FindEventManager(int eventmgrtype);
 	std::vector<class SCA_EventManager*>	GetEventManagers() { return m_eventmanagers; }
 
@@ -0,0 +1,58 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GameLogic/SCA_LogicProfile.cpp
+ *  \ingroup gamelogic
+ */
+
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+
+#include "SCA_LogicProfile.h"
+#include "SCA_ILogicBrick.h"
+
+#include "PIL_time.h"
+
+SCA_LogicProfileScope::SCA_LogicProfileScope(SCA_LogicProfile& profile)
+	:m_profile(profile),
+	m_start(PIL_check_seconds_timer())
+{
+}
+
+SCA_LogicProfileScope::~SCA_LogicProfileScope()
+{
+	m_profile.Add(PIL_check_seconds_timer() - m_start);
+}
+
+SCA_LogicBrickProfileScope::SCA_LogicBrickProfileScope(SCA_ILogicBrick *brick)
+	:m_brick(brick),
+	m_start(PIL_check_seconds_timer())
+{
+}
+
+SCA_LogicBrickProfileScope::~SCA_LogicBrickProfileScope()
+{
+	const double time = PIL_check_seconds_timer() - m_start;
+	m_brick->GetLogicProfile().Add(time);
+	m_brick->GetParent()->GetLogicProfile().Add(time);
+}
+
+#endif  // WITH_GAMEENGINE_LOGIC_PROFILE
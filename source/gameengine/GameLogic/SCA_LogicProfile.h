@@ -0,0 +1,110 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SCA_LogicProfile.h
+ *  \ingroup gamelogic
+ *
+ * Time accounting of the logic bricks, only compiled with WITH_GAMEENGINE_LOGIC_PROFILE.
+ * The SCA_LOGIC_PROFILE_* macros expand to nothing otherwise.
+ */
+
+#ifndef __SCA_LOGICPROFILE_H__
+#define __SCA_LOGICPROFILE_H__
+
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+
+class SCA_ILogicBrick;
+
+/// Inclusive time and number of calls accumulated by a logic brick, an object or the logic manager.
+class SCA_LogicProfile
+{
+public:
+	/// Accumulated time in seconds.
+	double m_time;
+	unsigned int m_calls;
+
+	SCA_LogicProfile()
+		:m_time(0.0),
+		m_calls(0)
+	{
+	}
+
+	/// Replicas start with an empty profile.
+	SCA_LogicProfile(const SCA_LogicProfile&)
+		:m_time(0.0),
+		m_calls(0)
+	{
+	}
+
+	SCA_LogicProfile& operator=(const SCA_LogicProfile&)
+	{
+		return *this;
+	}
+
+	void Add(double time)
+	{
+		m_time += time;
+		++m_calls;
+	}
+
+	void Reset()
+	{
+		m_time = 0.0;
+		m_calls = 0;
+	}
+};
+
+/// Measure the time of a scope and add it to a profile.
+class SCA_LogicProfileScope
+{
+public:
+	SCA_LogicProfileScope(SCA_LogicProfile& profile);
+	~SCA_LogicProfileScope();
+
+private:
+	SCA_LogicProfile& m_profile;
+	double m_start;
+};
+
+/// Measure the time of a scope and add it to a logic brick and its object.
+class SCA_LogicBrickProfileScope
+{
+public:
+	SCA_LogicBrickProfileScope(SCA_ILogicBrick *brick);
+	~SCA_LogicBrickProfileScope();
+
+private:
+	SCA_ILogicBrick *m_brick;
+	double m_start;
+};
+
+#  define SCA_LOGIC_PROFILE_SCOPE(profile) SCA_LogicProfileScope _logicProfileScope(profile)
+#  define SCA_LOGIC_PROFILE_BRICK(brick) SCA_LogicBrickProfileScope _logicBrickProfileScope(brick)
+
+#else
+
+#  define SCA_LOGIC_PROFILE_SCOPE(profile)
+#  define SCA_LOGIC_PROFILE_BRICK(brick)
+
+#endif  // WITH_GAMEENGINE_LOGIC_PROFILE
+
+#endif  // __SCA_LOGICPROFILE_H__
@@ -42,6 +42,8 @@
 #include "PHY_IPhysicsController.h"
 #include "PHY_IMotionState.h"
 
+#include <algorithm>
+
 SCA_NearSensor::SCA_NearSensor(SCA_EventManager* eventmgr,
 							 KX_GameObject* gameobj,
 							 float margin,
@@ -59,7 +61,8 @@ SCA_NearSensor::SCA_NearSensor(SCA_EventManager* eventmgr,
 
 {
 
-	gameobj->getClientInfo()->m_sensors.remove(this);
+	std::vector<SCA_ISensor *>& sensors = gameobj->getClientInfo()->m_sensors;
+	sensors.erase(std::remove(sensors.begin(), sensors.end(), this), sensors.end());
 	m_client_info = new KX_ClientObjectInfo(gameobj, KX_ClientObjectInfo::SENSOR);
 	m_client_info->m_sensors.push_back(this);
 	
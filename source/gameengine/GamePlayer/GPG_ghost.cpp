@@ -505,13 +505,22 @@ static void usage(const std::string& program, bool isBlenderPlayer)
 	CM_Message("       show_armatures                 0         Show debug armatures");
 	CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
 	CM_Message("       show_shadow_frustum            0         Show debug light shadow frustum volume");
-	CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings" << std::endl);
+	CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings");
+	CM_Message("       spike_threshold                0         Capture the profile of the first frame slower than this time (ms)");
+	CM_Message("       trace_file                               Write a Chrome trace (JSON) of the profiling events to the file");
+	CM_Message("       input_record                             Record the input events to the file");
+	CM_Message("       input_replay                             Replay the input events recorded in the file, ignore the devices");
+	CM_Message("       benchmark_frames               0         Run a fixed number of frames with a fixed time step and exit");
+	CM_Message("       benchmark_timestep         1/ticrate     Game time of a benchmark frame (s)");
+	CM_Message("       benchmark_render               0         Render the benchmark frames");
+	CM_Message("       benchmark_report                         Write the benchmark report (JSON) to the file instead of the console" << std::endl);
 	CM_Message("  -p: override python main loop script");
 	CM_Message(std::endl);
 	CM_Message("  - : all arguments after this are ignored, allowing python to access them from sys.argv");
 	CM_Message(std::endl);
 	CM_Message("example: " << program << " -w 320 200 10 10 -g noaudio " << example_pathname << example_filename);
 	CM_Message("example: " << program << " -g show_framerate = 0 " << example_pathname << example_filename);
+	CM_Message("example: " << program << " -g benchmark_frames = 600 -g benchmark_report = report.json " << example_pathname << example_filename);
 	CM_Message("example: " << program << " -i 232421 -m 16 " << example_pathname << example_filename);
 }
 
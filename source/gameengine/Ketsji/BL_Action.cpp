@@ -63,8 +63,8 @@ BL_Action::BL_Action(class KX_GameObject* gameobj)
 :
 	m_action(nullptr),
 	m_tmpaction(nullptr),
-	m_blendpose(nullptr),
-	m_blendinpose(nullptr),
+	m_clip(nullptr),
+	m_poseRebuildCount(0),
 	m_obj(gameobj),
 	m_startframe(0.f),
 	m_endframe(0.f),
@@ -87,10 +87,6 @@ BL_Action::BL_Action(class KX_GameObject* gameobj)
 
 BL_Action::~BL_Action()
 {
-	if (m_blendpose)
-		BKE_pose_free(m_blendpose);
-	if (m_blendinpose)
-		BKE_pose_free(m_blendinpose);
 	ClearControllerList();
 
 	if (m_tmpaction) {
@@ -152,12 +148,25 @@ bool BL_Action::Play(const std::string& name,
 			&& m_priority == priority && m_speed == playback_speed)
 		return false;
 
-	// Keep a copy of the action for threading purposes
 	if (m_tmpaction) {
 		BKE_libblock_free(G.main, m_tmpaction);
 		m_tmpaction = nullptr;
 	}
-	m_tmpaction = BKE_action_copy(G.main, m_action);
+
+	m_clipTargets.clear();
+
+	KX_BlenderConverter *converter = KX_GetActiveEngine()->GetConverter();
+	m_clip = converter->FindActionClip(kxscene, m_action);
+	// Actions loaded after the scene conversion are compiled when first played.
+	if (!m_clip) {
+		m_clip = new BL_ActionClip(m_action);
+		converter->RegisterActionClip(kxscene, m_clip);
+	}
+
+	// Keep a copy of the action for threading purposes
+	if (m_clip->UseFallback()) {
+		m_tmpaction = BKE_action_copy(G.main, m_action);
+	}
 
 	// First get rid of any old controllers
 	ClearControllerList();
@@ -223,7 +232,9 @@ bool BL_Action::Play(const std::string& name,
 	if (m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE)
 	{
 		BL_ArmatureObject *obj = (BL_ArmatureObject*)m_obj;
-		obj->GetPose(&m_blendinpose);
+		ResolvePoseChannels(obj, blend_mode);
+		// The blend in mixes all the channels with their transforms at the start of the action.
+		m_blendinTransforms.Store(m_blendinChannels);
 	}
 	else
 	{
@@ -233,6 +244,7 @@ bool BL_Action::Play(const std::string& name,
 		if (shape_deformer && shape_deformer->GetKey())
 		{
 			obj->GetShape(m_blendinshape);
+			m_clip->GetShapeTargets(shape_deformer->GetKey(), m_clipTargets);
 
 			// Now that we have the previous blend shape saved, we can clear out the key to avoid any
 			// further interference.
@@ -366,6 +378,39 @@ void BL_Action::BlendShape(Key* key, float srcweight, std::vector<float>& blends
 	}
 }
 
+void BL_Action::ResolvePoseChannels(BL_ArmatureObject *obj, short blendMode)
+{
+	bPose *pose = obj->GetOrigPose();
+	BL_PoseTransforms::GetChannels(pose, m_blendinChannels);
+	m_clip->GetPoseTargets(pose, m_clipTargets);
+
+	/* The layer blending leaves the channels not animated by the action unchanged,
+	 * excepted with the addition, or if the animated channels are unknown. */
+	if (m_clip->UseFallback() || blendMode == ACT_BLEND_ADD) {
+		m_blendChannels = m_blendinChannels;
+	}
+	else {
+		m_clip->GetPoseChannels(pose, m_blendChannels);
+	}
+
+	m_poseRebuildCount = obj->GetPoseRebuildCount();
+}
+
+bool BL_Action::GetPoseCacheLayer(const BL_PoseCache& cache, BL_PoseCache::Layer& layer) const
+{
+	// A finished action is not applied anymore and the blend in mixes the previous action pose.
+	if (m_done || !m_action || (m_blendin && m_blendframe < m_blendin)) {
+		return false;
+	}
+
+	layer.m_action = m_action;
+	layer.m_frame = cache.GetFrameStep(m_localframe);
+	layer.m_weight = (m_layer_weight >= 0.0f) ? (int)(m_layer_weight * 1000.0f + 0.5f) : -1;
+	layer.m_blendMode = m_blendmode;
+
+	return true;
+}
+
 void BL_Action::Update(float curtime, bool applyToObject)
 {
 	/* Don't bother if we're done with the animation and if the animation was already applied to the object.
@@ -424,11 +469,30 @@ void BL_Action::Update(float curtime, bool applyToObject)
 	{
 		BL_ArmatureObject *obj = (BL_ArmatureObject*)m_obj;
 
+		// The channels are reallocated when the pose is rebuilt.
+		if (m_poseRebuildCount != obj->GetPoseRebuildCount()) {
+			const unsigned int numBlendinChannels = m_blendinChannels.size();
+			ResolvePoseChannels(obj, m_blendmode);
+			// The transforms stored for the blend in don't match other channels.
+			if (m_blendinChannels.size() != numBlendinChannels) {
+				m_blendframe = m_blendin;
+			}
+		}
+
 		if (m_layer_weight >= 0)
-			obj->GetPose(&m_blendpose);
+			m_blendTransforms.Store(m_blendChannels);
+
+		// The armatures sharing their poses evaluate the actions at quantized frames.
+		BL_PoseCache *cache = obj->GetPoseCache();
+		const float frame = (cache) ? cache->QuantizeFrame(m_localframe) : m_localframe;
 
 		// Extract the pose from the action
-		obj->SetPoseByAction(m_tmpaction, m_localframe);
+		if (m_tmpaction) {
+			obj->SetPoseByAction(m_tmpaction, frame);
+		}
+		else {
+			m_clip->Sample(frame, m_clipTargets);
+		}
 
 		// Handle blending between armature actions
 		if (m_blendin && m_blendframe<m_blendin)
@@ -439,13 +503,13 @@ void BL_Action::Update(float curtime, bool applyToObject)
 			float weight = 1.f - (m_blendframe/m_blendin);
 
 			// Blend the poses
-			obj->BlendInPose(m_blendinpose, weight, ACT_BLEND_BLEND);
+			m_blendinTransforms.Blend(m_blendinChannels, weight, ACT_BLEND_BLEND);
 		}
 
 
 		// Handle layer blending
 		if (m_layer_weight >= 0)
-			obj->BlendInPose(m_blendpose, m_layer_weight, m_blendmode);
+			m_blendTransforms.Blend(m_blendChannels, m_layer_weight, m_blendmode);
 
 		obj->UpdateTimestep(curtime);
 	}
@@ -459,10 +523,15 @@ void BL_Action::Update(float curtime, bool applyToObject)
 		{
 			Key *key = shape_deformer->GetKey();
 
-			PointerRNA ptrrna;
-			RNA_id_pointer_create(&key->id, &ptrrna);
+			if (m_tmpaction) {
+				PointerRNA ptrrna;
+				RNA_id_pointer_create(&key->id, &ptrrna);
 
-			animsys_evaluate_action(&ptrrna, m_tmpaction, nullptr, m_localframe);
+				animsys_evaluate_action(&ptrrna, m_tmpaction, nullptr, m_localframe);
+			}
+			else {
+				m_clip->Sample(m_localframe, m_clipTargets);
+			}
 
 			// Handle blending between shape actions
 			if (m_blendin && m_blendframe < m_blendin)
@@ -30,13 +30,27 @@
 #include <string>
 #include <vector>
 
+#include "BL_ActionClip.h"
+#include "BL_PoseCache.h"
+#include "BL_PoseTransforms.h"
+
 class BL_Action
 {
 private:
 	struct bAction* m_action;
+	/// Copy of the action evaluated by the animation system when the clip can't be used.
 	struct bAction* m_tmpaction;
-	struct bPose* m_blendpose;
-	struct bPose* m_blendinpose;
+	/// Compiled action and its targets in the pose or shape key of the object.
+	BL_ActionClip *m_clip;
+	std::vector<BL_ActionClip::Target> m_clipTargets;
+	/// Transforms of the pose before the action, for the layer blending and the blend in.
+	BL_PoseTransforms m_blendTransforms;
+	BL_PoseTransforms m_blendinTransforms;
+	/// Remap tables of the pose channels blended with the layer weight and blended in.
+	std::vector<struct bPoseChannel *> m_blendChannels;
+	std::vector<struct bPoseChannel *> m_blendinChannels;
+	/// Pose rebuild count of the armature when the channels were resolved.
+	unsigned int m_poseRebuildCount;
 	std::vector<class SG_Controller*> m_sg_contr_list;
 	class KX_GameObject* m_obj;
 	std::vector<float>	m_blendshape;
@@ -82,6 +96,8 @@ private:
 	void ResetStartTime(float curtime);
 	void IncrementBlending(float curtime);
 	void BlendShape(struct Key* key, float srcweight, std::vector<float>& blendshape);
+	/// Resolve the clip targets and the blended channels in the pose of an armature.
+	void ResolvePoseChannels(class BL_ArmatureObject *obj, short blendMode);
 public:
 	BL_Action(class KX_GameObject* gameobj);
 	~BL_Action();
@@ -115,6 +131,11 @@ public:
 	 */
 	void UpdateIPOs();
 
+	/** Get the state of the action in the last update for the pose cache, return false if the pose
+	 * can't be shared because it depends on the previous poses of the armature.
+	 */
+	bool GetPoseCacheLayer(const BL_PoseCache& cache, BL_PoseCache::Layer& layer) const;
+
 	// Accessors
 	float GetFrame();
 	const std::string GetName();
@@ -26,6 +26,7 @@
 
 #include "BL_Action.h"
 #include "BL_ActionManager.h"
+#include "BL_ArmatureObject.h"
 #include "DNA_ID.h"
 
 #define IS_TAGGED(_id) ((_id) && (((ID *)_id)->tag & LIB_TAG_DOIT))
@@ -149,4 +150,23 @@ void BL_ActionManager::Update(float curtime, bool applyToObject)
 	for (const auto& pair : m_layers) {
 		pair.second->UpdateIPOs();
 	}
+
+	if (applyToObject && m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
+		static_cast<BL_ArmatureObject *>(m_obj)->UpdatePoseCacheKey(*this);
+	}
+}
+
+bool BL_ActionManager::GetPoseCacheLayers(const BL_PoseCache& cache, std::vector<BL_PoseCache::Layer>& layers) const
+{
+	layers.clear();
+	for (const auto& pair : m_layers) {
+		BL_PoseCache::Layer layer;
+		if (!pair.second->GetPoseCacheLayer(cache, layer)) {
+			return false;
+		}
+		layers.push_back(layer);
+	}
+
+	// The lowest layer blended with a weight mixes the pose of the previous frame.
+	return (!layers.empty() && layers.front().m_weight <= 0);
 }
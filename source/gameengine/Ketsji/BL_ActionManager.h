@@ -28,6 +28,9 @@
 #define __BL_ACTIONMANAGER_H__
 
 #include <map>
+#include <vector>
+
+#include "BL_PoseCache.h"
 
 // Currently, we use the max value of a short.
 // We should switch to unsigned short; doesn't make sense to support negative layers.
@@ -118,6 +121,11 @@ public:
 	 * Update object IPOs (note: not thread-safe!)
 	 */
 	void UpdateIPOs();
+
+	/** Get the states of the actions applied to an armature pose in the order of the layers,
+	 * return false if the pose can't be shared with the other instances of the armature.
+	 */
+	bool GetPoseCacheLayers(const BL_PoseCache& cache, std::vector<BL_PoseCache::Layer>& layers) const;
 };
 
 #endif  /* BL_ACTIONMANAGER */
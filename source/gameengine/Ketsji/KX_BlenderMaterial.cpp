@@ -89,7 +89,7 @@ KX_BlenderMaterial::KX_BlenderMaterial(
 		const bool use_blend = (m_material->blend_method & MA_BM_BLEND) != 0;
 		const bool use_translucency = ((m_material->blend_flag & MA_BL_TRANSLUCENCY) != 0) && ((stl->effects->enabled_effects & EFFECT_SSS) != 0);
 		m_gpuMat = EEVEE_material_mesh_get(scene->GetBlenderScene(), m_material, vedata,
-			use_blend, (m_material->blend_method == MA_BM_MULTIPLY), use_refract, use_sss, use_translucency, linfo->shadow_method);
+			use_blend, (m_material->blend_method == MA_BM_MULTIPLY), use_refract, use_sss, use_translucency, false, linfo->shadow_method);
 	}
 	else {
 		m_gpuMat = nullptr;
@@ -34,7 +34,7 @@
 
 /* Note, the way this works with/without sumo is a bit odd */
 
-#include <list>
+#include <vector>
 
 class SCA_ISensor;
 class KX_GameObject;
@@ -52,7 +52,7 @@ struct KX_ClientObjectInfo
 		OBACTORSENSOR
 	}		m_type;
 	KX_GameObject*	m_gameobject;
-	std::list<SCA_ISensor*>	m_sensors;
+	std::vector<SCA_ISensor*>	m_sensors;
 public:
 	KX_ClientObjectInfo(KX_GameObject *gameobject, clienttype type = STATIC) :
 		m_type(type),
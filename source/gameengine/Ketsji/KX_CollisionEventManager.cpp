@@ -57,9 +57,7 @@ KX_CollisionEventManager::~KX_CollisionEventManager()
 
 void KX_CollisionEventManager::RemoveNewCollisions()
 {
-	for (std::set<NewCollision>::iterator it = m_newCollisions.begin(), end = m_newCollisions.end(); it != end; ++it) {
-		delete it->colldata;
-	}
+	// Keep the capacity, the collision data is owned by the physics environment.
 	m_newCollisions.clear();
 }
 
@@ -68,7 +66,7 @@ bool KX_CollisionEventManager::NewHandleCollision(void *object1, void *object2,
 	PHY_IPhysicsController *obj1 = static_cast<PHY_IPhysicsController *>(object1);
 	PHY_IPhysicsController *obj2 = static_cast<PHY_IPhysicsController *>(object2);
 
-	m_newCollisions.insert(NewCollision(obj1, obj2, coll_data));
+	m_newCollisions.push_back({obj1, obj2, coll_data});
 
 	return false;
 }
@@ -129,7 +127,7 @@ bool KX_CollisionEventManager::newBroadphaseResponse(void *client_data,
 		case KX_ClientObjectInfo::OBACTORSENSOR:
 			// this object may have multiple collision sensors,
 			// check is any of them is interested in this object
-			for (std::list<SCA_ISensor *>::iterator it = info1->m_sensors.begin();
+			for (std::vector<SCA_ISensor *>::iterator it = info1->m_sensors.begin();
 			     it != info1->m_sensors.end();
 			     ++it)
 			{
@@ -190,40 +188,31 @@ void KX_CollisionEventManager::NextFrame()
 		(*it)->SynchronizeTransform();
 	}
 
-	for (std::set<NewCollision>::iterator cit = m_newCollisions.begin(); cit != m_newCollisions.end(); ++cit) {
-		// Controllers
-		PHY_IPhysicsController *ctrl1 = (*cit).first;
-		PHY_IPhysicsController *ctrl2 = (*cit).second;
-		// Sensor iterator
-		std::list<SCA_ISensor *>::iterator sit;
-
-		// First client info
-		KX_ClientObjectInfo *client_info = static_cast<KX_ClientObjectInfo *>(ctrl1->GetNewClientInfo());
-		// First gameobject
-		KX_GameObject *kxObj1 = KX_GameObject::GetClientObject(client_info);
-		// Invoke sensor response for each object
-		if (client_info) {
-			for (sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
-				static_cast<SCA_CollisionSensor *>(*sit)->NewHandleCollision(ctrl1, ctrl2, nullptr);
-			}
+	// Invoke sensor response for each object.
+	for (const NewCollision& collision : m_newCollisions) {
+		DispatchToSensors(collision.first, collision.second);
+		DispatchToSensors(collision.second, collision.first);
+	}
+
+#ifdef WITH_PYTHON
+	// Run python callbacks, the contact point lists are only created for objects using callbacks.
+	for (const NewCollision& collision : m_newCollisions) {
+		KX_GameObject *kxObj1 = KX_GameObject::GetClientObject(static_cast<KX_ClientObjectInfo *>(collision.first->GetNewClientInfo()));
+		KX_GameObject *kxObj2 = KX_GameObject::GetClientObject(static_cast<KX_ClientObjectInfo *>(collision.second->GetNewClientInfo()));
+		if (!kxObj1 || !kxObj2) {
+			continue;
 		}
 
-		// Second client info
-		client_info = static_cast<KX_ClientObjectInfo *>(ctrl2->GetNewClientInfo());
-		// Second gameobject
-		KX_GameObject *kxObj2 = KX_GameObject::GetClientObject(client_info);
-		if (client_info) {
-			for (sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
-				static_cast<SCA_CollisionSensor *>(*sit)->NewHandleCollision(ctrl2, ctrl1, nullptr);
-			}
+		if (kxObj1->m_collisionCallbacks) {
+			KX_CollisionContactPointList contactPointList0(collision.colldata, true);
+			kxObj1->RunCollisionCallbacks(kxObj2, contactPointList0);
+		}
+		if (kxObj2->m_collisionCallbacks) {
+			KX_CollisionContactPointList contactPointList1(collision.colldata, false);
+			kxObj2->RunCollisionCallbacks(kxObj1, contactPointList1);
 		}
-		// Run python callbacks
-		const PHY_CollData *colldata = cit->colldata;
-		KX_CollisionContactPointList contactPointList0 = KX_CollisionContactPointList(colldata, true);
-		KX_CollisionContactPointList contactPointList1 = KX_CollisionContactPointList(colldata, false);
-		kxObj1->RunCollisionCallbacks(kxObj2, contactPointList0);
-		kxObj2->RunCollisionCallbacks(kxObj1, contactPointList1);
 	}
+#endif  // WITH_PYTHON
 
 	for (it.begin(); !it.end(); ++it) {
 		(*it)->Activate(m_logicmgr);
@@ -232,30 +221,14 @@ void KX_CollisionEventManager::NextFrame()
 	RemoveNewCollisions();
 }
 
-KX_CollisionEventManager::NewCollision::NewCollision(PHY_IPhysicsController *first,
-                                                     PHY_IPhysicsController *second,
-                                                     const PHY_CollData *colldata)
-	:first(first),
-	second(second),
-	colldata(colldata)
+void KX_CollisionEventManager::DispatchToSensors(PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2)
 {
-}
-
-KX_CollisionEventManager::NewCollision::NewCollision(const NewCollision &to_copy)
-	:first(to_copy.first),
-	second(to_copy.second),
-	colldata(to_copy.colldata)
-{
-}
+	KX_ClientObjectInfo *client_info = static_cast<KX_ClientObjectInfo *>(ctrl1->GetNewClientInfo());
+	if (!client_info) {
+		return;
+	}
 
-bool KX_CollisionEventManager::NewCollision::operator<(const NewCollision &other) const
-{
-	//see strict weak ordering: https://support.microsoft.com/en-us/kb/949171
-	if (first == other.first) {
-		if (second == other.second) {
-			return colldata < other.colldata;
-		}
-		return second < other.second;
+	for (SCA_ISensor *sensor : client_info->m_sensors) {
+		static_cast<SCA_CollisionSensor *>(sensor)->NewHandleCollision(ctrl1, ctrl2, nullptr);
 	}
-	return first < other.first;
 }
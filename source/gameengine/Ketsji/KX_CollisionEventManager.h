@@ -38,7 +38,6 @@
 #include "KX_GameObject.h"
 
 #include <vector>
-#include <set>
 
 class SCA_ISensor;
 class PHY_IPhysicsEnvironment;
@@ -46,32 +45,20 @@ class PHY_IPhysicsEnvironment;
 class KX_CollisionEventManager : public SCA_EventManager
 {
 	/**
-	 * Contains two colliding objects and the first contact point.
+	 * Contains two colliding objects and their contact points.
+	 * The contact points are owned by the physics environment and valid until its next step.
 	 */
-	class NewCollision
+	struct NewCollision
 	{
-	public:
 		PHY_IPhysicsController *first;
 		PHY_IPhysicsController *second;
 		const PHY_CollData *colldata;
-
-		/**
-		 * Creates a copy of the given PHY_CollData; freeing that copy should be done by the owner of
-		 * the NewCollision object.
-		 *
-		 * This allows us to efficiently store NewCollision objects in a std::set without creating more
-		 * copies of colldata, as the NewCollision copy constructor reuses the pointer and doesn't clone
-		 * it again. */
-		NewCollision(PHY_IPhysicsController *first,
-		             PHY_IPhysicsController *second,
-		             const PHY_CollData *colldata);
-		NewCollision(const NewCollision &to_copy);
-		bool operator<(const NewCollision &other) const;
 	};
 
 	PHY_IPhysicsEnvironment *m_physEnv;
 
-	std::set<NewCollision> m_newCollisions;
+	/// Collisions of the last physics step, in the order of the physics manifolds.
+	std::vector<NewCollision> m_newCollisions;
 
 	static bool newCollisionResponse(void *client_data,
 	                                 void *object1,
@@ -87,6 +74,8 @@ class KX_CollisionEventManager : public SCA_EventManager
 									const PHY_CollData *coll_data);
 
 	void RemoveNewCollisions();
+	/// Give a collision to the collision sensors of the first object.
+	void DispatchToSensors(PHY_IPhysicsController *ctrl1, PHY_IPhysicsController *ctrl2);
 
 public:
 	KX_CollisionEventManager(class SCA_LogicManager *logicmgr,
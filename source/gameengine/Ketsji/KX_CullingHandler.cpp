@@ -10,6 +10,16 @@ KX_CullingHandler::KX_CullingHandler(KX_CullingNodeList& nodes, const SG_Frustum
 }
 
 void KX_CullingHandler::Process(KX_CullingNode *node)
+{
+	const bool culled = IsCulled(node, m_frustum);
+
+	node->SetCulled(culled);
+	if (!culled) {
+		m_activeNodes.push_back(node);
+	}
+}
+
+bool KX_CullingHandler::IsCulled(KX_CullingNode *node, const SG_Frustum& frustum)
 {
 	SG_Node *sgnode = node->GetObject()->GetSGNode();
 	const MT_Transform trans = sgnode->GetWorldTransform();
@@ -17,7 +27,7 @@ void KX_CullingHandler::Process(KX_CullingNode *node)
 	const SG_BBox& aabb = node->GetAabb();
 
 	bool culled = true;
-	const SG_Frustum::TestType sphereTest = m_frustum.SphereInsideFrustum(trans(aabb.GetCenter()), fabs(scale[scale.closestAxis()]) * aabb.GetRadius());
+	const SG_Frustum::TestType sphereTest = frustum.SphereInsideFrustum(trans(aabb.GetCenter()), fabs(scale[scale.closestAxis()]) * aabb.GetRadius());
 
 	// First test if the sphere is in the frustum as it is faster to test than box.
 	if (sphereTest == SG_Frustum::INSIDE) {
@@ -26,11 +36,8 @@ void KX_CullingHandler::Process(KX_CullingNode *node)
 	// If the sphere intersects we made a box test because the box could be not homogeneous.
 	else if (sphereTest == SG_Frustum::INTERSECT) {
 		const MT_Matrix4x4 mat = MT_Matrix4x4(trans);
-		culled = (m_frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
+		culled = (frustum.AabbInsideFrustum(aabb.GetMin(), aabb.GetMax(), mat) == SG_Frustum::OUTSIDE);
 	}
 
-	node->SetCulled(culled);
-	if (!culled) {
-		m_activeNodes.push_back(node);
-	}
+	return culled;
 }
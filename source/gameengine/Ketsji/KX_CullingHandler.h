@@ -20,6 +20,9 @@ public:
 	 * node is added in m_activeNodes.
 	 */
 	void Process(KX_CullingNode *node);
+
+	/// Return true if the bounding box of the node is out of the frustum.
+	static bool IsCulled(KX_CullingNode *node, const SG_Frustum& frustum);
 };
 
 #endif  // __KX_CULLING_HANDLER_H__
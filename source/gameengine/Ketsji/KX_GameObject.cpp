@@ -118,6 +118,7 @@ KX_GameObject::KX_GameObject(
       m_layer(0),
       m_lodManager(nullptr),
       m_currentLodLevel(0),
+      m_currentPhysicsLodLevel(0),
       m_pBlenderObject(nullptr),
       m_pBlenderGroupObject(nullptr),
       m_bIsNegativeScaling(false),
@@ -774,6 +775,13 @@ void KX_GameObject::SetLodManager(KX_LodManager *lodManager)
 	// Reset lod level to avoid overflow index in KX_LodManager::GetLevel.
 	m_currentLodLevel = 0;
 
+	// Restore the original physics shape, the levels of the new manager are different.
+	if (m_pPhysicsController && m_currentPhysicsLodLevel != 0) {
+		m_pPhysicsController->SetLodMesh(nullptr);
+		m_pPhysicsController->SetLodSleep(false);
+	}
+	m_currentPhysicsLodLevel = 0;
+
 	// Restore object original mesh.
 	if (!lodManager && m_lodManager && m_lodManager->GetLevelCount() > 0) {
 		KX_Scene *scene = GetScene();
@@ -817,6 +825,25 @@ void KX_GameObject::UpdateLod(const MT_Vector3& cam_pos, float lodfactor)
 	}
 }
 
+void KX_GameObject::UpdatePhysicsLod(const MT_Vector3& cam_pos, float lodfactor)
+{
+	if (!m_lodManager || !m_pPhysicsController || !m_lodManager->UsePhysics()) {
+		return;
+	}
+
+	KX_Scene *scene = GetScene();
+	const float distance2 = NodeGetWorldPosition().distance2(cam_pos) * (lodfactor * lodfactor);
+	KX_LodLevel *lodLevel = m_lodManager->GetLevel(scene, m_currentPhysicsLodLevel, distance2);
+
+	if (lodLevel) {
+		m_currentPhysicsLodLevel = lodLevel->GetLevel();
+
+		KX_LodLevel *physicsLevel = m_lodManager->GetPhysicsLevel(m_currentPhysicsLodLevel);
+		m_pPhysicsController->SetLodMesh(physicsLevel ? physicsLevel->GetMesh() : nullptr);
+		m_pPhysicsController->SetLodSleep(lodLevel->GetFlag() & KX_LodLevel::USE_PHYSICS_SLEEP);
+	}
+}
+
 void KX_GameObject::UpdateTransform()
 {
 	// HACK: saves function call for dynamic object, they are handled differently
@@ -1820,6 +1847,7 @@ PyMethodDef KX_GameObject::Methods[] = {
 
 PyAttributeDef KX_GameObject::Attributes[] = {
 	KX_PYATTRIBUTE_SHORT_RO("currentLodLevel", KX_GameObject, m_currentLodLevel),
+	KX_PYATTRIBUTE_SHORT_RO("currentPhysicsLodLevel", KX_GameObject, m_currentPhysicsLodLevel),
 	KX_PYATTRIBUTE_RW_FUNCTION("lodManager", KX_GameObject, pyattr_get_lodManager, pyattr_set_lodManager),
 	KX_PYATTRIBUTE_RW_FUNCTION("name",		KX_GameObject, pyattr_get_name, pyattr_set_name),
 	KX_PYATTRIBUTE_RO_FUNCTION("parent",	KX_GameObject, pyattr_get_parent),
@@ -1837,6 +1865,7 @@ PyAttributeDef KX_GameObject::Attributes[] = {
 	KX_PYATTRIBUTE_RW_FUNCTION("visible",	KX_GameObject, pyattr_get_visible,	pyattr_set_visible),
 	KX_PYATTRIBUTE_RO_FUNCTION("culled", KX_GameObject, pyattr_get_culled),
 	KX_PYATTRIBUTE_BOOL_RW    ("occlusion", KX_GameObject, m_bOccluder),
+	KX_PYATTRIBUTE_BOOL_RW    ("autoUpdateBounds", KX_GameObject, m_autoUpdateBounds),
 	KX_PYATTRIBUTE_RW_FUNCTION("position",	KX_GameObject, pyattr_get_worldPosition,	pyattr_set_localPosition),
 	KX_PYATTRIBUTE_RO_FUNCTION("localInertia",	KX_GameObject, pyattr_get_localInertia),
 	KX_PYATTRIBUTE_RW_FUNCTION("orientation",KX_GameObject,pyattr_get_worldOrientation,pyattr_set_localOrientation),
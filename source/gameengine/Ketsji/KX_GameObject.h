@@ -96,6 +96,8 @@ protected:
 	std::vector<RAS_MeshObject*>		m_meshes;
 	KX_LodManager						*m_lodManager;
 	short								m_currentLodLevel;
+	/// Level of detail used by the physics shape, updated before the physics step.
+	short								m_currentPhysicsLodLevel;
 	struct Object*						m_pBlenderObject;
 	struct Object*						m_pBlenderGroupObject;
 	
@@ -738,6 +740,12 @@ public:
 	 */
 	void UpdateLod(const MT_Vector3& cam_pos, float lodfactor);
 
+	/**
+	 * Updates the physics lod level based on distance from camera, switching
+	 * the collision shape and the sleeping state of the physics controller.
+	 */
+	void UpdatePhysicsLod(const MT_Vector3& cam_pos, float lodfactor);
+
 	/**
 	 * Pick out a mesh associated with the integer 'num'.
 	 */
@@ -761,6 +769,17 @@ public:
 	/// Return true when the object can be culled.
 	bool UseCulling() const;
 
+	/// Return true when the deformers update the culling bounding box from the deformed vertices.
+	bool GetAutoUpdateBounds() const
+	{
+		return m_autoUpdateBounds;
+	}
+
+	void SetAutoUpdateBounds(bool autoUpdate)
+	{
+		m_autoUpdateBounds = autoUpdate;
+	}
+
 	/**
 	 * Was this object marked visible? (only for the explicit
 	 * visibility system).
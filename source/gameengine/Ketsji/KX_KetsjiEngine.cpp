@@ -166,6 +166,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system)
 	m_cameraZoom(1.0f),
 	m_overrideCamZoom(1.0f),
 	m_logger(KX_TimeCategoryLogger(25)),
+	m_traceRecorder(system),
 	m_average_framerate(0.0),
 	m_showBoundingBox(KX_DebugOption::DISABLE),
 	m_showArmature(KX_DebugOption::DISABLE),
@@ -174,8 +175,11 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system)
 	m_main(nullptr)
 {
 	for (int i = tc_first; i < tc_numCategories; i++) {
-		m_logger.AddCategory((KX_TimeCategory)i);
+		// Trace names are the labels without the colon.
+		const std::string& label = m_profileLabels[i];
+		m_logger.AddCategory((KX_TimeCategory)i, label.substr(0, label.size() - 1));
 	}
+	m_logger.SetTraceRecorder(&m_traceRecorder);
 
 #ifdef WITH_PYTHON
 	m_pyprofiledict = PyDict_New();
@@ -250,6 +254,46 @@ PyObject *KX_KetsjiEngine::GetPyProfileDict()
 	Py_INCREF(m_pyprofiledict);
 	return m_pyprofiledict;
 }
+
+static PyObject *profile_percentiles_tuple(const KX_TimeHistogram& histogram)
+{
+	return Py_BuildValue("(dddd)", histogram.GetPercentile(0.5) * 1000.0, histogram.GetPercentile(0.95) * 1000.0,
+			histogram.GetPercentile(0.99) * 1000.0, histogram.GetMax() * 1000.0);
+}
+
+PyObject *KX_KetsjiEngine::GetPyProfilePercentiles()
+{
+	PyObject *dict = PyDict_New();
+
+	for (int i = tc_first; i < tc_numCategories; ++i) {
+		PyObject *val = profile_percentiles_tuple(m_logger.GetHistogram((KX_TimeCategory)i));
+		PyDict_SetItemString(dict, m_profileLabels[i].c_str(), val);
+		Py_DECREF(val);
+	}
+
+	PyObject *val = profile_percentiles_tuple(m_logger.GetHistogram());
+	PyDict_SetItemString(dict, "Frame:", val);
+	Py_DECREF(val);
+
+	return dict;
+}
+
+PyObject *KX_KetsjiEngine::GetPyProfileSpike()
+{
+	if (!m_logger.IsSpikeCaptured()) {
+		Py_RETURN_NONE;
+	}
+
+	PyObject *categories = PyDict_New();
+	for (int i = tc_first; i < tc_numCategories; ++i) {
+		PyObject *val = PyFloat_FromDouble(m_logger.GetSpikeMeasurement((KX_TimeCategory)i) * 1000.0);
+		PyDict_SetItemString(categories, m_profileLabels[i].c_str(), val);
+		Py_DECREF(val);
+	}
+
+	return Py_BuildValue("{s:d,s:d,s:I,s:N}", "frame", m_logger.GetSpikeTotal() * 1000.0, "time", m_logger.GetSpikeTime(),
+			"count", m_logger.GetNumSpikes(), "categories", categories);
+}
 #endif
 
 void KX_KetsjiEngine::SetConverter(KX_BlenderConverter *converter)
@@ -418,6 +462,10 @@ bool KX_KetsjiEngine::NextFrame()
 			 * update. */
 			m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
 
+			if (m_traceRecorder.GetRecording()) {
+				m_traceRecorder.SetActiveScene(m_traceRecorder.GetSceneIndex(scene->GetName()));
+			}
+
 			scene->UpdateObjectActivity();
 
 			if (!scene->IsSuspended()) {
@@ -430,6 +478,10 @@ bool KX_KetsjiEngine::NextFrame()
 
 				scene->GetPhysicsEnvironment()->EndFrame();
 
+				// The results of an asynchronous physics step are given to the objects by EndFrame.
+				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
+				scene->UpdateParents(m_frameTime);
+
 				// Process sensors, and controllers
 				m_logger.StartLog(tc_logic, m_kxsystem->GetTimeInSeconds());
 				scene->LogicBeginFrame(m_frameTime, framestep);
@@ -452,11 +504,15 @@ bool KX_KetsjiEngine::NextFrame()
 				scene->UpdateParents(m_frameTime);
 
 				m_logger.StartLog(tc_physics, m_kxsystem->GetTimeInSeconds());
+				scene->UpdatePhysicsLods();
 				scene->GetPhysicsEnvironment()->BeginFrame();
 
 				// Perform physics calculations on the scene. This can involve
 				// many iterations of the physics solver.
-				scene->GetPhysicsEnvironment()->ProceedDeltaTime(m_frameTime, timestep, framestep);//m_deltatimerealDeltaTime);
+				{
+					KX_TraceScope traceScope(m_traceRecorder, "Physics Step");
+					scene->GetPhysicsEnvironment()->ProceedDeltaTime(m_frameTime, timestep, framestep);//m_deltatimerealDeltaTime);
+				}
 
 				m_logger.StartLog(tc_scenegraph, m_kxsystem->GetTimeInSeconds());
 				scene->UpdateParents(m_frameTime);
@@ -465,6 +521,8 @@ bool KX_KetsjiEngine::NextFrame()
 			m_logger.StartLog(tc_services, m_kxsystem->GetTimeInSeconds());
 		}
 
+		m_traceRecorder.SetActiveScene(-1);
+
 		m_logger.StartLog(tc_network, m_kxsystem->GetTimeInSeconds());
 		m_networkMessageManager->ClearMessages();
 
@@ -674,6 +732,8 @@ void KX_KetsjiEngine::Render()
 			}
 		}
 	}
+
+	m_traceRecorder.SetActiveScene(-1);
 	//EndFrame();
 }
 
@@ -887,6 +947,10 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene, const CameraRenderData& came
 
 	KX_SetActiveScene(scene);
 
+	if (m_traceRecorder.GetRecording()) {
+		m_traceRecorder.SetActiveScene(m_traceRecorder.GetSceneIndex(scene->GetName()));
+	}
+
 	// set the viewport for this frame and scene
 	const int left = viewport.GetLeft();
 	const int bottom = viewport.GetBottom();
@@ -920,7 +984,10 @@ void KX_KetsjiEngine::RenderCamera(KX_Scene *scene, const CameraRenderData& came
 	scene->RunDrawingCallbacks(KX_Scene::PRE_DRAW, rendercam);
 #endif
 
-	scene->RenderAfterCameraSetup(m_rasterizer, false);
+	{
+		KX_TraceScope traceScope(m_traceRecorder, "Render Scene");
+		scene->RenderAfterCameraSetup(m_rasterizer, false);
+	}
 
 	//if (scene->GetPhysicsEnvironment())
 		//scene->GetPhysicsEnvironment()->DebugDrawWorld();
@@ -1083,6 +1150,32 @@ void KX_KetsjiEngine::RenderDebugProperties()
 			debugDraw.RenderBox2D(MT_Vector2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
 			ycoord += const_ysize;
 		}
+
+		// Frame time percentiles to show the hitches hidden by the averages.
+		const KX_TimeHistogram& histogram = m_logger.GetHistogram();
+		debugDraw.RenderText2D("p95/p99/max:", MT_Vector2(xcoord + const_xindent, ycoord), white);
+		debugtxt = (boost::format("%5.2f | %5.2f | %5.2fms") % (histogram.GetPercentile(0.95) * 1000.0) %
+				(histogram.GetPercentile(0.99) * 1000.0) % (histogram.GetMax() * 1000.0)).str();
+		debugDraw.RenderText2D(debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+		ycoord += const_ysize;
+
+		if (m_logger.IsSpikeCaptured()) {
+			debugDraw.RenderText2D("Spike:", MT_Vector2(xcoord + const_xindent, ycoord), white);
+			debugtxt = (boost::format("%5.2fms (%d frames)") % (m_logger.GetSpikeTotal() * 1000.0) % m_logger.GetNumSpikes()).str();
+			debugDraw.RenderText2D(debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+			ycoord += const_ysize;
+		}
+
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+		// The hottest logic bricks of each scene.
+		ycoord += title_y_top_margin;
+		debugDraw.RenderText2D("Logic Bricks", MT_Vector2(xcoord + const_xindent + title_xmargin, ycoord), white);
+		ycoord += const_ysize + title_y_bottom_margin;
+
+		for (KX_Scene *scene : m_scenes) {
+			scene->RenderDebugLogicProfile(debugDraw, const_xindent, const_ysize, profile_indent, xcoord, ycoord, 5);
+		}
+#endif  // WITH_GAMEENGINE_LOGIC_PROFILE
 	}
 	// Add the ymargin for titles below the other section of debug info
 	ycoord += title_y_top_margin;
@@ -1418,6 +1511,49 @@ double KX_KetsjiEngine::GetRealTime(void) const
 	return m_kxsystem->GetTimeInSeconds();
 }
 
+KX_TraceRecorder& KX_KetsjiEngine::GetTraceRecorder()
+{
+	return m_traceRecorder;
+}
+
+static KX_KetsjiEngine::ProfileStatistics profile_statistics(const std::string& name, const KX_TimeHistogram& histogram)
+{
+	return {name, histogram.GetMean(), histogram.GetPercentile(0.5), histogram.GetPercentile(0.95),
+			histogram.GetPercentile(0.99), histogram.GetMax()};
+}
+
+std::vector<KX_KetsjiEngine::ProfileStatistics> KX_KetsjiEngine::GetProfileStatistics()
+{
+	std::vector<ProfileStatistics> statistics;
+	for (int i = tc_first; i < tc_numCategories; ++i) {
+		const std::string& label = m_profileLabels[i];
+		statistics.push_back(profile_statistics(label.substr(0, label.size() - 1), m_logger.GetHistogram((KX_TimeCategory)i)));
+	}
+	statistics.push_back(profile_statistics("Frame", m_logger.GetHistogram()));
+
+	return statistics;
+}
+
+void KX_KetsjiEngine::SetProfileSpikeThreshold(double threshold)
+{
+	m_logger.SetSpikeThreshold(threshold);
+}
+
+double KX_KetsjiEngine::GetProfileSpikeThreshold() const
+{
+	return m_logger.GetSpikeThreshold();
+}
+
+void KX_KetsjiEngine::ClearProfileSpike()
+{
+	m_logger.ClearSpike();
+}
+
+void KX_KetsjiEngine::ClearProfilePercentiles()
+{
+	m_logger.ClearHistograms();
+}
+
 void KX_KetsjiEngine::SetAnimFrameRate(double framerate)
 {
 	m_anim_framerate = framerate;
@@ -38,6 +38,7 @@
 #include "KX_ISystem.h"
 #include "KX_Scene.h"
 #include "KX_TimeCategoryLogger.h"
+#include "KX_TraceRecorder.h"
 #include "EXP_Python.h"
 #include "KX_WorldInfo.h"
 #include "RAS_CameraData.h"
@@ -224,6 +225,8 @@ private:
 
 	/// Time logger.
 	KX_TimeCategoryLogger m_logger;
+	/// Recorder of the time logger spans and worker tasks.
+	KX_TraceRecorder m_traceRecorder;
 
 	/// Labels for profiling display.
 	static const std::string m_profileLabels[tc_numCategories];
@@ -311,7 +314,32 @@ public:
 	void SetNetworkMessageManager(KX_NetworkMessageManager *manager);
 #ifdef WITH_PYTHON
 	PyObject *GetPyProfileDict();
+	/// Return a dictionary of the p50, p95, p99 and max times of each category.
+	PyObject *GetPyProfilePercentiles();
+	/// Return a dictionary of the captured frame spike or None.
+	PyObject *GetPyProfileSpike();
 #endif
+
+	/// Statistics of a profile category since the start or the last clear of the percentiles, in seconds.
+	struct ProfileStatistics
+	{
+		std::string m_name;
+		double m_mean;
+		double m_p50;
+		double m_p95;
+		double m_p99;
+		double m_max;
+	};
+
+	/// Return the statistics of each profile category followed by the statistics of the frame.
+	std::vector<ProfileStatistics> GetProfileStatistics();
+
+	/// Set the frame time above which the profile of a frame is captured, 0 to disable.
+	void SetProfileSpikeThreshold(double threshold);
+	double GetProfileSpikeThreshold() const;
+	/// Remove the captured frame spike and the measurements of the percentiles.
+	void ClearProfileSpike();
+	void ClearProfilePercentiles();
 	void SetConverter(KX_BlenderConverter *converter);
 	KX_BlenderConverter *GetConverter()
 	{
@@ -401,6 +429,9 @@ public:
 	 */
 	double GetRealTime(void) const;
 
+	/// Returns the recorder used to export profiling traces.
+	KX_TraceRecorder& GetTraceRecorder();
+
 	/**
 	 * Gets the number of logic updates per second.
 	 */
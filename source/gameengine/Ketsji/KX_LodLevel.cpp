@@ -101,6 +101,8 @@ PyAttributeDef KX_LodLevel::Attributes[] = {
 	KX_PYATTRIBUTE_RO_FUNCTION("useHysteresis", KX_LodLevel, pyattr_get_use_hysteresis),
 	KX_PYATTRIBUTE_RO_FUNCTION("useMesh", KX_LodLevel, pyattr_get_use_mesh),
 	KX_PYATTRIBUTE_RO_FUNCTION("useMaterial", KX_LodLevel, pyattr_get_use_material),
+	KX_PYATTRIBUTE_RO_FUNCTION("usePhysics", KX_LodLevel, pyattr_get_use_physics),
+	KX_PYATTRIBUTE_RO_FUNCTION("usePhysicsSleep", KX_LodLevel, pyattr_get_use_physics_sleep),
 	KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -129,4 +131,16 @@ PyObject *KX_LodLevel::pyattr_get_use_material(PyObjectPlus *self_v, const KX_PY
 	return PyBool_FromLong(self->GetFlag() & KX_LodLevel::USE_MATERIAL);
 }
 
+PyObject *KX_LodLevel::pyattr_get_use_physics(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_LodLevel *self = static_cast<KX_LodLevel *>(self_v);
+	return PyBool_FromLong(self->GetFlag() & KX_LodLevel::USE_PHYSICS);
+}
+
+PyObject *KX_LodLevel::pyattr_get_use_physics_sleep(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef)
+{
+	KX_LodLevel *self = static_cast<KX_LodLevel *>(self_v);
+	return PyBool_FromLong(self->GetFlag() & KX_LodLevel::USE_PHYSICS_SLEEP);
+}
+
 #endif //WITH_PYTHON
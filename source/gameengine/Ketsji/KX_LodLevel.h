@@ -56,7 +56,11 @@ public:
 		/// Use a different mesh than original.
 		USE_MESH = (1 << 1),
 		/// Use a different material than original mesh.
-		USE_MATERIAL = (1 << 2)
+		USE_MATERIAL = (1 << 2),
+		/// Use the mesh for the physics shape.
+		USE_PHYSICS = (1 << 3),
+		/// Put the rigid body to sleep.
+		USE_PHYSICS_SLEEP = (1 << 4)
 	};
 
 #ifdef WITH_PYTHON
@@ -70,6 +74,8 @@ public:
 	static PyObject *pyattr_get_use_hysteresis(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 	static PyObject *pyattr_get_use_mesh(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 	static PyObject *pyattr_get_use_material(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+	static PyObject *pyattr_get_use_physics(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+	static PyObject *pyattr_get_use_physics_sleep(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
 
 #endif // WITH_PYTHON
 
@@ -94,7 +94,8 @@ inline bool KX_LodManager::LodLevelIterator::operator>(float distance2) const
 
 KX_LodManager::KX_LodManager(Object *ob, KX_Scene *scene, RAS_Rasterizer *rasty, KX_BlenderSceneConverter& converter, bool libloading)
 	:m_refcount(1),
-	m_distanceFactor(1.0f)
+	m_distanceFactor(1.0f),
+	m_usePhysics(false)
 {
 	if (BLI_listbase_count_at_most(&ob->lodlevels, 2) > 1) {
 		Mesh *lodmesh = (Mesh *)ob->data;
@@ -119,6 +120,17 @@ KX_LodManager::KX_LodManager(Object *ob, KX_Scene *scene, RAS_Rasterizer *rasty,
 				lodmatob = lod->source;
 				flag |= KX_LodLevel::USE_MATERIAL;
 			}
+
+			if (lod->flags & OB_LOD_USE_PHYS) {
+				flag |= KX_LodLevel::USE_PHYSICS;
+				m_usePhysics = true;
+			}
+
+			if (lod->flags & OB_LOD_PHYS_SLEEP) {
+				flag |= KX_LodLevel::USE_PHYSICS_SLEEP;
+				m_usePhysics = true;
+			}
+
 			KX_LodLevel *lodLevel = new KX_LodLevel(lod->distance, lod->obhysteresis, level++,
 				BL_ConvertMesh(lodmesh, lodmatob, scene, rasty, converter, libloading), flag);
 
@@ -171,6 +183,24 @@ KX_LodLevel *KX_LodManager::GetLevel(KX_Scene *scene, short previouslod, float d
 	return (level == previouslod) ? nullptr : m_levels[level];
 }
 
+bool KX_LodManager::UsePhysics() const
+{
+	return m_usePhysics;
+}
+
+KX_LodLevel *KX_LodManager::GetPhysicsLevel(unsigned int index) const
+{
+	// The first level is the original object, its physics shape is the original one.
+	for (unsigned int i = index; i > 0; --i) {
+		KX_LodLevel *level = m_levels[i];
+		if (level->GetFlag() & KX_LodLevel::USE_PHYSICS) {
+			return level;
+		}
+	}
+
+	return nullptr;
+}
+
 #ifdef WITH_PYTHON
 
 PyTypeObject KX_LodManager::Type = {
@@ -78,6 +78,9 @@ private:
 	/// Factor applied to the distance from the camera to the object.
 	float m_distanceFactor;
 
+	/// True when at least one level uses physics.
+	bool m_usePhysics;
+
 public:
 	KX_LodManager(Object *ob, KX_Scene *scene, RAS_Rasterizer *rasty, KX_BlenderSceneConverter& converter, bool libloading);
 	virtual ~KX_LodManager();
@@ -100,6 +103,15 @@ public:
 	 */
 	KX_LodLevel *GetLevel(KX_Scene *scene, short previouslod, float distance);
 
+	/// Return true if the physics shape or the rigid body state changes with the level.
+	bool UsePhysics() const;
+
+	/** Get the level whose mesh is used by the physics shape at a level, the nearest level using physics
+	 * before or at the level. Return nullptr when the original physics shape is used.
+	 * \param index The lod level index.
+	 */
+	KX_LodLevel *GetPhysicsLevel(unsigned int index) const;
+
 #ifdef WITH_PYTHON
 
 	static PyObject *pyattr_get_levels(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
@@ -306,6 +306,216 @@ static PyObject *gPyGetProfileInfo(PyObject *)
 	return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+PyDoc_STRVAR(gPyGetProfilePercentiles_doc,
+"getProfilePercentiles()\n"
+"returns a dictionary with the p50, p95, p99 and max times of each profiling category and of the frame"
+);
+static PyObject *gPyGetProfilePercentiles(PyObject *)
+{
+	return KX_GetActiveEngine()->GetPyProfilePercentiles();
+}
+
+PyDoc_STRVAR(gPyResetProfilePercentiles_doc,
+"resetProfilePercentiles()\n"
+"removes the measurements used by the profiling percentiles"
+);
+static PyObject *gPyResetProfilePercentiles(PyObject *)
+{
+	KX_GetActiveEngine()->ClearProfilePercentiles();
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPySetProfileSpikeThreshold_doc,
+"setProfileSpikeThreshold(threshold)\n"
+"sets the frame time (in ms) above which the frame profile is captured, 0 disables the capture"
+);
+static PyObject *gPySetProfileSpikeThreshold(PyObject *, PyObject *args)
+{
+	float threshold;
+
+	if (!PyArg_ParseTuple(args, "f:setProfileSpikeThreshold", &threshold)) {
+		return nullptr;
+	}
+
+	KX_GetActiveEngine()->SetProfileSpikeThreshold((threshold > 0.0f) ? threshold / 1000.0 : 0.0);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyGetProfileSpikeThreshold_doc,
+"getProfileSpikeThreshold()\n"
+"returns the frame time (in ms) above which the frame profile is captured"
+);
+static PyObject *gPyGetProfileSpikeThreshold(PyObject *)
+{
+	return PyFloat_FromDouble(KX_GetActiveEngine()->GetProfileSpikeThreshold() * 1000.0);
+}
+
+PyDoc_STRVAR(gPyGetProfileSpike_doc,
+"getProfileSpike()\n"
+"returns a dictionary with the profile of the captured frame spike or None"
+);
+static PyObject *gPyGetProfileSpike(PyObject *)
+{
+	return KX_GetActiveEngine()->GetPyProfileSpike();
+}
+
+PyDoc_STRVAR(gPyResetProfileSpike_doc,
+"resetProfileSpike()\n"
+"removes the captured frame spike, the next spike will be captured"
+);
+static PyObject *gPyResetProfileSpike(PyObject *)
+{
+	KX_GetActiveEngine()->ClearProfileSpike();
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyGetLogicProfile_doc,
+"getLogicProfile([count])\n"
+"returns a dictionary with the time spent in the logic bricks of the current scene\n"
+" count = Maximum number of logic bricks and objects returned"
+);
+static PyObject *gPyGetLogicProfile(PyObject *, PyObject *args)
+{
+	int count = 10;
+
+	if (!PyArg_ParseTuple(args, "|i:getLogicProfile", &count)) {
+		return nullptr;
+	}
+
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	if (count < 0) {
+		PyErr_SetString(PyExc_ValueError, "bge.logic.getLogicProfile(count): expected a positive count");
+		return nullptr;
+	}
+
+	KX_Scene *scene = KX_GetActiveScene();
+	SCA_LogicManager *logicmgr = scene->GetLogicManager();
+
+	PyObject *dict = PyDict_New();
+
+	PyObject *item = PyLong_FromLong(logicmgr->GetBeginFrameProfile().m_calls);
+	PyDict_SetItemString(dict, "frames", item);
+	Py_DECREF(item);
+
+	item = PyFloat_FromDouble(logicmgr->GetBeginFrameProfile().m_time * 1000.0);
+	PyDict_SetItemString(dict, "beginFrame", item);
+	Py_DECREF(item);
+
+	item = PyFloat_FromDouble(logicmgr->GetUpdateFrameProfile().m_time * 1000.0);
+	PyDict_SetItemString(dict, "updateFrame", item);
+	Py_DECREF(item);
+
+	const std::vector<SCA_ILogicBrick *> bricks = scene->GetHotLogicBricks(count);
+	item = PyList_New(bricks.size());
+	for (unsigned int i = 0, size = bricks.size(); i < size; ++i) {
+		SCA_ILogicBrick *brick = bricks[i];
+		const SCA_LogicProfile& profile = brick->GetLogicProfile();
+		PyList_SET_ITEM(item, i, Py_BuildValue("(ssdI)", brick->GetParent()->GetName().c_str(), brick->GetName().c_str(),
+				profile.m_time * 1000.0, profile.m_calls));
+	}
+	PyDict_SetItemString(dict, "bricks", item);
+	Py_DECREF(item);
+
+	const std::vector<KX_GameObject *> objects = scene->GetHotLogicObjects(count);
+	item = PyList_New(objects.size());
+	for (unsigned int i = 0, size = objects.size(); i < size; ++i) {
+		KX_GameObject *gameobj = objects[i];
+		const SCA_LogicProfile& profile = gameobj->GetLogicProfile();
+		PyList_SET_ITEM(item, i, Py_BuildValue("(sdI)", gameobj->GetName().c_str(), profile.m_time * 1000.0, profile.m_calls));
+	}
+	PyDict_SetItemString(dict, "objects", item);
+	Py_DECREF(item);
+
+	return dict;
+#else
+	Py_RETURN_NONE;
+#endif  // WITH_GAMEENGINE_LOGIC_PROFILE
+}
+
+PyDoc_STRVAR(gPyResetLogicProfile_doc,
+"resetLogicProfile()\n"
+"resets the time spent in the logic bricks of the current scene"
+);
+static PyObject *gPyResetLogicProfile(PyObject *)
+{
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	KX_GetActiveScene()->ResetLogicProfile();
+#endif  // WITH_GAMEENGINE_LOGIC_PROFILE
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyStartTrace_doc,
+"startTrace([capacity])\n"
+"Clears the recorded trace and starts recording the profiling events.\n"
+" capacity = Maximum number of events kept, the older events are overwritten"
+);
+static PyObject *gPyStartTrace(PyObject *, PyObject *args)
+{
+	int capacity = 0;
+
+	if (!PyArg_ParseTuple(args, "|i:startTrace", &capacity)) {
+		return nullptr;
+	}
+
+	if (capacity < 0) {
+		PyErr_SetString(PyExc_ValueError, "bge.logic.startTrace(capacity): expected a positive capacity");
+		return nullptr;
+	}
+
+	KX_TraceRecorder& recorder = KX_GetActiveEngine()->GetTraceRecorder();
+	if (capacity > 0) {
+		recorder.SetCapacity(capacity);
+	}
+	recorder.Clear();
+	recorder.SetRecording(true);
+
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyStopTrace_doc,
+"stopTrace()\n"
+"Stops recording the profiling events, the recorded events are kept"
+);
+static PyObject *gPyStopTrace(PyObject *)
+{
+	KX_GetActiveEngine()->GetTraceRecorder().SetRecording(false);
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(gPyIsTraceRecording_doc,
+"isTraceRecording()\n"
+"Returns True if the profiling events are recorded"
+);
+static PyObject *gPyIsTraceRecording(PyObject *)
+{
+	return PyBool_FromLong(KX_GetActiveEngine()->GetTraceRecorder().GetRecording());
+}
+
+PyDoc_STRVAR(gPyWriteTrace_doc,
+"writeTrace(filepath)\n"
+"Writes the recorded profiling events in the Chrome trace format (JSON)\n"
+" filepath = The file path, can be relative to the blend file using \"//\""
+);
+static PyObject *gPyWriteTrace(PyObject *, PyObject *args)
+{
+	char *filepath;
+
+	if (!PyArg_ParseTuple(args, "s:writeTrace", &filepath)) {
+		return nullptr;
+	}
+
+	char expanded[FILE_MAX];
+	BLI_strncpy(expanded, filepath, FILE_MAX);
+	BLI_path_abs(expanded, KX_GetMainPath().c_str());
+
+	if (!KX_GetActiveEngine()->GetTraceRecorder().Write(expanded)) {
+		PyErr_Format(PyExc_IOError, "bge.logic.writeTrace(filepath): failed to write \"%s\"", expanded);
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
 "sendMessage(subject, [body, to, from])\n"
 "sends a message in same manner as a message actuator"
@@ -836,6 +1046,18 @@ static struct PyMethodDef game_methods[] = {
 	{"PrintMemInfo", (PyCFunction)pyPrintStats, METH_NOARGS, (const char *)"Print engine statistics"},
 	{"NextFrame", (PyCFunction)gPyNextFrame, METH_NOARGS, (const char *)"Render next frame (if Python has control)"},
 	{"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+	{"getProfilePercentiles", (PyCFunction)gPyGetProfilePercentiles, METH_NOARGS, gPyGetProfilePercentiles_doc},
+	{"resetProfilePercentiles", (PyCFunction)gPyResetProfilePercentiles, METH_NOARGS, gPyResetProfilePercentiles_doc},
+	{"setProfileSpikeThreshold", (PyCFunction)gPySetProfileSpikeThreshold, METH_VARARGS, gPySetProfileSpikeThreshold_doc},
+	{"getProfileSpikeThreshold", (PyCFunction)gPyGetProfileSpikeThreshold, METH_NOARGS, gPyGetProfileSpikeThreshold_doc},
+	{"getProfileSpike", (PyCFunction)gPyGetProfileSpike, METH_NOARGS, gPyGetProfileSpike_doc},
+	{"resetProfileSpike", (PyCFunction)gPyResetProfileSpike, METH_NOARGS, gPyResetProfileSpike_doc},
+	{"getLogicProfile", (PyCFunction)gPyGetLogicProfile, METH_VARARGS, gPyGetLogicProfile_doc},
+	{"resetLogicProfile", (PyCFunction)gPyResetLogicProfile, METH_NOARGS, gPyResetLogicProfile_doc},
+	{"startTrace", (PyCFunction)gPyStartTrace, METH_VARARGS, gPyStartTrace_doc},
+	{"stopTrace", (PyCFunction)gPyStopTrace, METH_NOARGS, gPyStopTrace_doc},
+	{"isTraceRecording", (PyCFunction)gPyIsTraceRecording, METH_NOARGS, gPyIsTraceRecording_doc},
+	{"writeTrace", (PyCFunction)gPyWriteTrace, METH_VARARGS, gPyWriteTrace_doc},
 	/* library functions */
 	{"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS|METH_KEYWORDS, (const char *)""},
 	{"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
@@ -39,6 +39,9 @@
 #include "PHY_IPhysicsEnvironment.h"
 #include "PHY_IPhysicsController.h"
 
+#include "KX_ClientObjectInfo.h"
+#include "KX_GameObject.h"
+
 #include "CM_Message.h"
 
 KX_RayCast::KX_RayCast(PHY_IPhysicsController* ignoreController, bool faceNormal, bool faceUV)
@@ -117,3 +120,24 @@ bool KX_RayCast::RayTest(PHY_IPhysicsEnvironment* physics_environment, const MT_
 	return false;
 }
 
+
+KX_RayCastBatchFilter::KX_RayCastBatchFilter(PHY_IPhysicsController *ignoreController, unsigned short mask)
+	:PHY_IRayCastFilterCallback(ignoreController),
+	m_mask(mask)
+{
+}
+
+bool KX_RayCastBatchFilter::needBroadphaseRayCast(PHY_IPhysicsController *controller)
+{
+	KX_ClientObjectInfo *info = static_cast<KX_ClientObjectInfo *>(controller->GetNewClientInfo());
+	// Sensor objects and objects of unknown type are not hit.
+	if (!info || info->m_type > KX_ClientObjectInfo::ACTOR) {
+		return false;
+	}
+
+	return (info->m_gameobject->GetUserCollisionGroup() & m_mask);
+}
+
+void KX_RayCastBatchFilter::reportHit(PHY_RayCastResult *UNUSED(result))
+{
+}
@@ -136,6 +136,22 @@ public:
 		return self->NeedRayCast(info, data);
 	}
 };
+
+/** Filter of the batched ray casts accepting the game objects of a collision mask.
+ * It is called concurrently by the physics environment and must not modify any object.
+ */
+class KX_RayCastBatchFilter : public PHY_IRayCastFilterCallback
+{
+public:
+	KX_RayCastBatchFilter(PHY_IPhysicsController *ignoreController, unsigned short mask);
+	virtual ~KX_RayCastBatchFilter() {}
+
+	virtual bool needBroadphaseRayCast(PHY_IPhysicsController *controller);
+	virtual void reportHit(PHY_RayCastResult *result);
+
+private:
+	unsigned short m_mask;
+};
 	
 
 #endif
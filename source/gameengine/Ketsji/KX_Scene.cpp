@@ -71,6 +71,7 @@
 #include "GPU_framebuffer.h"
 
 #include "EXP_FloatValue.h"
+#include "SCA_ISensor.h"
 #include "SCA_IController.h"
 #include "SCA_IActuator.h"
 #include "SG_Node.h"
@@ -91,10 +92,13 @@
 #include "PHY_IPhysicsController.h"
 #include "KX_BlenderConverter.h"
 #include "KX_MotionState.h"
+#include "KX_RayCast.h"
 
 #include "BL_ModifierDeformer.h"
 #include "BL_ShapeDeformer.h"
 #include "BL_DeformableGameObject.h"
+#include "BL_ArmatureObject.h"
+#include "BL_PoseCache.h"
 #include "KX_ObstacleSimulation.h"
 
 #ifdef WITH_BULLET
@@ -109,6 +113,7 @@
 
 #include "BLI_math.h"
 #include "BLI_task.h"
+#include "BLI_string.h"
 
 #include "CM_Message.h"
 
@@ -178,7 +183,12 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
 	m_suspendeddelta(0.0),
 	m_blenderScene(scene),
 	m_isActivedHysteresis(false),
-	m_lodHysteresisValue(0)
+	m_lodHysteresisValue(0),
+	m_animationLod(false),
+	m_animationLodInterpolate(false),
+	m_animationLodDistance(20.0f),
+	m_animationLodMaxInterval(4),
+	m_poseCache(nullptr)
 {
 
 	m_dbvt_culling = false;
@@ -270,6 +280,10 @@ KX_Scene::~KX_Scene()
 		BLI_task_pool_free(m_animationPool);
 	}
 
+	if (m_poseCache) {
+		delete m_poseCache;
+	}
+
 	if (m_objectlist)
 		m_objectlist->Release();
 
@@ -1486,9 +1500,82 @@ void KX_Scene::RenderDebugProperties(RAS_DebugDraw& debugDraw, int xindent, int
 	}
 }
 
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+std::vector<SCA_ILogicBrick *> KX_Scene::GetHotLogicBricks(unsigned int count) const
+{
+	std::vector<SCA_ILogicBrick *> bricks;
+	for (KX_GameObject *gameobj : m_objectlist) {
+		if (gameobj->GetLogicProfile().m_calls == 0) {
+			continue;
+		}
+		bricks.insert(bricks.end(), gameobj->GetSensors().begin(), gameobj->GetSensors().end());
+		bricks.insert(bricks.end(), gameobj->GetControllers().begin(), gameobj->GetControllers().end());
+		bricks.insert(bricks.end(), gameobj->GetActuators().begin(), gameobj->GetActuators().end());
+	}
+
+	count = std::min(count, (unsigned int)bricks.size());
+	std::partial_sort(bricks.begin(), bricks.begin() + count, bricks.end(),
+		[](SCA_ILogicBrick *brick1, SCA_ILogicBrick *brick2) { return brick1->GetLogicProfile().m_time > brick2->GetLogicProfile().m_time; });
+	bricks.resize(count);
+
+	return bricks;
+}
+
+std::vector<KX_GameObject *> KX_Scene::GetHotLogicObjects(unsigned int count) const
+{
+	std::vector<KX_GameObject *> objects;
+	for (KX_GameObject *gameobj : m_objectlist) {
+		if (gameobj->GetLogicProfile().m_calls > 0) {
+			objects.push_back(gameobj);
+		}
+	}
+
+	count = std::min(count, (unsigned int)objects.size());
+	std::partial_sort(objects.begin(), objects.begin() + count, objects.end(),
+		[](KX_GameObject *obj1, KX_GameObject *obj2) { return obj1->GetLogicProfile().m_time > obj2->GetLogicProfile().m_time; });
+	objects.resize(count);
+
+	return objects;
+}
+
+void KX_Scene::ResetLogicProfile()
+{
+	m_logicmgr->ResetLogicProfile();
+	for (KX_GameObject *gameobj : m_objectlist) {
+		gameobj->ResetLogicProfile();
+	}
+	for (KX_GameObject *gameobj : m_inactivelist) {
+		gameobj->ResetLogicProfile();
+	}
+}
+
+void KX_Scene::RenderDebugLogicProfile(RAS_DebugDraw& debugDraw, int xindent, int ysize, int profileIndent, int& xcoord, int& ycoord,
+		unsigned short count)
+{
+	static const MT_Vector4 white(1.0f, 1.0f, 1.0f, 1.0f);
+
+	// Average over the logic frames since the last reset.
+	const unsigned int frames = std::max(m_logicmgr->GetBeginFrameProfile().m_calls, 1u);
+
+	for (SCA_ILogicBrick *brick : GetHotLogicBricks(count)) {
+		const SCA_LogicProfile& profile = brick->GetLogicProfile();
+		const std::string name = brick->GetParent()->GetName() + "." + brick->GetName();
+		debugDraw.RenderText2D(name, MT_Vector2(xcoord + xindent, ycoord), white);
+
+		char debugtxt[64];
+		BLI_snprintf(debugtxt, sizeof(debugtxt), "%5.2fms | %u calls", profile.m_time * 1000.0 / frames,
+				profile.m_calls / frames);
+		debugDraw.RenderText2D(debugtxt, MT_Vector2(xcoord + xindent + profileIndent * 2, ycoord), white);
+		ycoord += ysize;
+	}
+}
+#endif  // WITH_GAMEENGINE_LOGIC_PROFILE
+
 // logic stuff
 void KX_Scene::LogicBeginFrame(double curtime, double framestep)
 {
+	KX_TraceScope traceScope(KX_GetActiveEngine()->GetTraceRecorder(), "Logic Begin Frame");
+
 	// have a look at temp objects ...
 	for (std::vector<KX_GameObject *>::iterator it = m_tempObjectList.begin(); it != m_tempObjectList.end();) {
 		KX_GameObject *gameobj = *it;
@@ -1527,6 +1614,55 @@ void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
 	}
 }
 
+/// Update an armature and its deformers at the rate of the animation level of detail.
+static void update_anim_lod(BL_ArmatureObject *armature, const KX_Scene::AnimationPoolData *data)
+{
+	const double curtime = data->curtime;
+	CListValue<KX_GameObject> *children = armature->GetChildren();
+
+	// The armature is culled when none of its visible meshes is in the camera frustum.
+	bool has_mesh = false;
+	bool culled = true;
+	for (KX_GameObject *child : children) {
+		if (child->GetMeshCount() == 0) {
+			continue;
+		}
+		has_mesh = true;
+		if (child->GetVisible() && !KX_CullingHandler::IsCulled(child->GetCullingNode(), *data->lodFrustum)) {
+			culled = false;
+			break;
+		}
+	}
+
+	// Armatures with only non-mesh children are never culled.
+	const unsigned short interval = (culled && has_mesh) ? 0 :
+		armature->GetAnimationLodInterval(data->lodCameraPosition, data->lodCameraFactor, data->lodDistance, data->lodMaxInterval);
+
+	const BL_ArmatureObject::AnimationLodUpdate update = armature->NextAnimationLodUpdate(interval, data->lodInterpolate);
+
+	// The skipped frames only manage the time and end of the animations.
+	armature->UpdateActionManager(curtime, update == BL_ArmatureObject::ANIMATION_LOD_UPDATE);
+
+	if (update != BL_ArmatureObject::ANIMATION_LOD_SKIP) {
+		if (data->lodInterpolate) {
+			armature->InterpolateAnimationLod(curtime, update == BL_ArmatureObject::ANIMATION_LOD_UPDATE);
+		}
+
+		KX_GameObject *parent = armature->GetParent();
+		if (armature->GetDeformer() && (!parent || parent->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE)) {
+			armature->GetDeformer()->Update();
+		}
+
+		for (KX_GameObject *child : children) {
+			if (child->GetDeformer()) {
+				child->GetDeformer()->Update();
+			}
+		}
+	}
+
+	children->Release();
+}
+
 static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
 {
 	KX_GameObject *gameobj, *parent;
@@ -1535,11 +1671,18 @@ static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(t
 	KX_Scene::AnimationPoolData *data = (KX_Scene::AnimationPoolData *)BLI_task_pool_userdata(pool);
 	double curtime = data->curtime;
 
+	KX_TraceScope traceScope(*data->recorder, "Animation", data->traceScene);
+
 	gameobj = (KX_GameObject*)taskdata;
 
 	// Non-armature updates are fast enough, so just update them
 	needs_update = gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE;
 
+	if (!needs_update && data->lodFrustum) {
+		update_anim_lod(static_cast<BL_ArmatureObject *>(gameobj), data);
+		return;
+	}
+
 	if (!needs_update) {
 		// If we got here, we're looking to update an armature, so check its children meshes
 		// to see if we need to bother with a more expensive pose update
@@ -1595,6 +1738,33 @@ void KX_Scene::UpdateAnimations(double curtime)
 {
 	m_animationPoolData.curtime = curtime;
 
+	KX_TraceRecorder& recorder = KX_GetActiveEngine()->GetTraceRecorder();
+	KX_TraceScope traceScope(recorder, "Update Animations");
+	m_animationPoolData.recorder = &recorder;
+	m_animationPoolData.traceScene = recorder.GetRecording() ? recorder.GetSceneIndex(GetName()) : -1;
+
+	// The frustum is extracted here, the animation tasks only read it.
+	KX_Camera *cam = GetActiveCamera();
+	if (m_animationLod && cam) {
+		m_animationPoolData.lodFrustum = &cam->GetFrustum();
+		m_animationPoolData.lodCameraPosition = cam->NodeGetWorldPosition();
+		m_animationPoolData.lodCameraFactor = cam->GetLodDistanceFactor();
+		m_animationPoolData.lodDistance = m_animationLodDistance;
+		m_animationPoolData.lodMaxInterval = m_animationLodMaxInterval;
+		m_animationPoolData.lodInterpolate = m_animationLodInterpolate;
+	}
+	else {
+		m_animationPoolData.lodFrustum = nullptr;
+	}
+
+	// The poses of the previous frame are outdated.
+	if (m_poseCache) {
+		m_poseCache->Clear();
+	}
+
+	// The tasks run by the main thread are nested in this scope.
+	KX_TraceScope tasksTraceScope(recorder, "Animation Tasks");
+
 	for (KX_GameObject *gameobj : m_animatedlist) {
 		BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false, TASK_PRIORITY_LOW);
 	}
@@ -1608,6 +1778,8 @@ void KX_Scene::LogicUpdateFrame(double curtime)
 	 * which will not be modified, indeed components can add objects in theirs initialization.
 	 */
 
+	KX_TraceScope traceScope(KX_GetActiveEngine()->GetTraceRecorder(), "Logic Update Frame");
+
 	std::vector<KX_GameObject *> objects;
 	for (KX_GameObject *gameobj : m_objectlist) {
 		objects.push_back(gameobj);
@@ -1618,6 +1790,8 @@ void KX_Scene::LogicUpdateFrame(double curtime)
 
 void KX_Scene::LogicEndFrame()
 {
+	KX_TraceScope traceScope(KX_GetActiveEngine()->GetTraceRecorder(), "Logic End Frame");
+
 	m_logicmgr->EndFrame();
 
 	for (KX_GameObject *gameobj : m_euthanasyobjects) {
@@ -1641,6 +1815,8 @@ void KX_Scene::LogicEndFrame()
  */
 void KX_Scene::UpdateParents(double curtime)
 {
+	KX_TraceScope traceScope(KX_GetActiveEngine()->GetTraceRecorder(), "Update Parents");
+
 	// we use the SG dynamic list
 	SG_Node* node;
 
@@ -1674,6 +1850,22 @@ void KX_Scene::UpdateObjectLods(KX_Camera *cam, const KX_CullingNodeList& nodes)
 	}
 }
 
+void KX_Scene::UpdatePhysicsLods()
+{
+	KX_Camera *cam = GetActiveCamera();
+	if (!cam) {
+		return;
+	}
+
+	// Unlike the mesh, the physics shape is also used by the objects out of the camera frustum.
+	const MT_Vector3& cam_pos = cam->NodeGetWorldPosition();
+	const float lodfactor = cam->GetLodDistanceFactor();
+
+	for (KX_GameObject *gameobj : *m_objectlist) {
+		gameobj->UpdatePhysicsLod(cam_pos, lodfactor);
+	}
+}
+
 void KX_Scene::SetLodHysteresis(bool active)
 {
 	m_isActivedHysteresis = active;
@@ -1694,6 +1886,27 @@ int KX_Scene::GetLodHysteresisValue(void)
 	return m_lodHysteresisValue;
 }
 
+void KX_Scene::SetAnimationLod(bool active, bool interpolate, float distance, unsigned short maxInterval)
+{
+	m_animationLod = active;
+	m_animationLodInterpolate = interpolate;
+	m_animationLodDistance = distance;
+	m_animationLodMaxInterval = maxInterval;
+}
+
+void KX_Scene::SetPoseCache(BL_PoseCache *cache)
+{
+	if (m_poseCache) {
+		delete m_poseCache;
+	}
+	m_poseCache = cache;
+}
+
+BL_PoseCache *KX_Scene::GetPoseCache() const
+{
+	return m_poseCache;
+}
+
 void KX_Scene::UpdateObjectActivity(void) 
 {
 	if (m_activity_culling) {
@@ -1759,6 +1972,39 @@ void KX_Scene::SetPhysicsEnvironment(class PHY_IPhysicsEnvironment* physEnv)
 		m_logicmgr->RegisterEventManager(collisionmgr);
 	}
 }
+
+void KX_Scene::RayCastBatch(const MT_Vector3 *from, const MT_Vector3 *to, unsigned int numRays, unsigned short mask,
+                            float radius, PHY_RayCastResult *results)
+{
+	if (!m_physicsEnvironment) {
+		for (unsigned int i = 0; i < numRays; ++i) {
+			results[i].m_controller = nullptr;
+		}
+		return;
+	}
+
+	KX_RayCastBatchFilter filter(nullptr, mask);
+	m_physicsEnvironment->RayTestBatch(filter, from, to, numRays, radius, results);
+}
+
+void KX_Scene::SnapshotPhysics(std::vector<char>& state)
+{
+	if (!m_physicsEnvironment) {
+		state.clear();
+		return;
+	}
+
+	m_physicsEnvironment->SaveState(state);
+}
+
+bool KX_Scene::RestorePhysics(const char *state, unsigned int size)
+{
+	if (!m_physicsEnvironment) {
+		return (size == 0);
+	}
+
+	return m_physicsEnvironment->RestoreState(state, size);
+}
  
 void KX_Scene::SetSuspendedDelta(double suspendeddelta)
 {
@@ -1994,6 +2240,11 @@ void KX_Scene::RunDrawingCallbacks(DrawingCallbackType callbackType, KX_Camera *
 		return;
 	}
 
+	// The callbacks can use the physics, it must not be running concurrently.
+	if (m_physicsEnvironment) {
+		m_physicsEnvironment->WaitStep();
+	}
+
 	if (camera) {
 		PyObject *args[1] = {camera->GetProxy()};
 		RunPythonCallBackList(list, args, 0, 1);
@@ -2039,6 +2290,9 @@ PyMethodDef KX_Scene::Methods[] = {
 	KX_PYMETHODTABLE(KX_Scene, suspend),
 	KX_PYMETHODTABLE(KX_Scene, resume),
 	KX_PYMETHODTABLE(KX_Scene, drawObstacleSimulation),
+	KX_PYMETHODTABLE_KEYWORDS(KX_Scene, rayCastBatch),
+	KX_PYMETHODTABLE(KX_Scene, snapshotPhysics),
+	KX_PYMETHODTABLE_O(KX_Scene, restorePhysics),
 
 	
 	/* dict style access */
@@ -2432,6 +2686,223 @@ KX_PYMETHODDEF_DOC(KX_Scene, drawObstacleSimulation,
 	Py_RETURN_NONE;
 }
 
+/// Read a buffer of float or double 3D points.
+static bool kx_scene_points_from_buffer(PyObject *value, std::vector<MT_Vector3>& points, const char *error_prefix)
+{
+	Py_buffer buffer;
+	if (PyObject_GetBuffer(value, &buffer, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) == -1) {
+		PyErr_Format(PyExc_TypeError, "%s, expected an object supporting the buffer protocol", error_prefix);
+		return false;
+	}
+
+	// Skip the native byte order prefix of the format.
+	const char *format = buffer.format ? buffer.format : "B";
+	if (ELEM(format[0], '@', '=', '<') && format[1] != '\0') {
+		++format;
+	}
+
+	const bool isFloat = (STREQ(format, "f") && buffer.itemsize == sizeof(float));
+	const bool isDouble = (STREQ(format, "d") && buffer.itemsize == sizeof(double));
+	if (!isFloat && !isDouble) {
+		PyErr_Format(PyExc_TypeError, "%s, expected a buffer of float or double, not \"%s\"", error_prefix, buffer.format);
+		PyBuffer_Release(&buffer);
+		return false;
+	}
+
+	const Py_ssize_t numValues = buffer.len / buffer.itemsize;
+	if ((numValues % 3) != 0) {
+		PyErr_Format(PyExc_ValueError, "%s, expected a buffer of 3D points, the size %i is not a multiple of 3", error_prefix, (int)numValues);
+		PyBuffer_Release(&buffer);
+		return false;
+	}
+
+	points.resize(numValues / 3);
+	for (Py_ssize_t i = 0, size = points.size(); i < size; ++i) {
+		if (isFloat) {
+			points[i] = MT_Vector3(((float *)buffer.buf) + i * 3);
+		}
+		else {
+			points[i] = MT_Vector3(((double *)buffer.buf) + i * 3);
+		}
+	}
+
+	PyBuffer_Release(&buffer);
+	return true;
+}
+
+/// Return a memoryview of the data, with the shape (size / dimension, dimension) when dimension is not 1.
+static PyObject *kx_scene_memoryview_from_data(const void *data, unsigned int size, const char *format, unsigned int itemsize,
+                                               unsigned int dimension)
+{
+	PyObject *array = PyByteArray_FromStringAndSize((const char *)data, size * itemsize);
+	if (!array) {
+		return nullptr;
+	}
+
+	PyObject *view = PyMemoryView_FromObject(array);
+	Py_DECREF(array);
+	if (!view) {
+		return nullptr;
+	}
+
+	// A memoryview can't be cast to a shape containing zero.
+	PyObject *ret;
+	if (dimension > 1 && size > 0) {
+		ret = PyObject_CallMethod(view, "cast", "s(II)", format, size / dimension, dimension);
+	}
+	else {
+		ret = PyObject_CallMethod(view, "cast", "s", format);
+	}
+	Py_DECREF(view);
+
+	return ret;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene, rayCastBatch,
+"rayCastBatch(fromPoints, toPoints, mask=0xFFFF, radius=0.0)\n"
+"Cast a ray, or sweep a sphere, between each pair of points.\n"
+"Returns a tuple (objects, points, normals, polygons) of the closest hits.\n")
+{
+	PyObject *pyfrom;
+	PyObject *pyto;
+	int mask = (1 << OB_MAX_COL_MASKS) - 1;
+	float radius = 0.0f;
+
+	static const char *kwlist[] = {"fromPoints", "toPoints", "mask", "radius", nullptr};
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|if:rayCastBatch", const_cast<char **>(kwlist),
+	                                 &pyfrom, &pyto, &mask, &radius))
+	{
+		return nullptr;
+	}
+
+	if (mask == 0 || mask & ~((1 << OB_MAX_COL_MASKS) - 1)) {
+		PyErr_Format(PyExc_ValueError, "scene.rayCastBatch(fromPoints, toPoints, mask, radius): KX_Scene, "
+		             "mask argument must be a int bitfield, 0 < mask < %i", (1 << OB_MAX_COL_MASKS));
+		return nullptr;
+	}
+
+	if (radius < 0.0f) {
+		PyErr_SetString(PyExc_ValueError, "scene.rayCastBatch(fromPoints, toPoints, mask, radius): KX_Scene, "
+		                "radius argument must be positive or zero");
+		return nullptr;
+	}
+
+	std::vector<MT_Vector3> fromPoints;
+	std::vector<MT_Vector3> toPoints;
+	if (!kx_scene_points_from_buffer(pyfrom, fromPoints, "scene.rayCastBatch(fromPoints, toPoints, mask, radius): KX_Scene (first argument)") ||
+		!kx_scene_points_from_buffer(pyto, toPoints, "scene.rayCastBatch(fromPoints, toPoints, mask, radius): KX_Scene (second argument)"))
+	{
+		return nullptr;
+	}
+
+	if (fromPoints.size() != toPoints.size()) {
+		PyErr_Format(PyExc_ValueError, "scene.rayCastBatch(fromPoints, toPoints, mask, radius): KX_Scene, "
+		             "expected the same number of points, %i and %i given", (int)fromPoints.size(), (int)toPoints.size());
+		return nullptr;
+	}
+
+	const unsigned int numRays = fromPoints.size();
+	std::vector<PHY_RayCastResult> results(numRays);
+	RayCastBatch(fromPoints.data(), toPoints.data(), numRays, mask, radius, results.data());
+
+	PyObject *objects = PyList_New(numRays);
+	std::vector<float> points(numRays * 3, 0.0f);
+	std::vector<float> normals(numRays * 3, 0.0f);
+	std::vector<int> polygons(numRays, -1);
+
+	for (unsigned int i = 0; i < numRays; ++i) {
+		const PHY_RayCastResult& result = results[i];
+		KX_GameObject *gameobj = nullptr;
+		if (result.m_controller) {
+			gameobj = KX_GameObject::GetClientObject((KX_ClientObjectInfo *)result.m_controller->GetNewClientInfo());
+		}
+
+		if (!gameobj) {
+			Py_INCREF(Py_None);
+			PyList_SET_ITEM(objects, i, Py_None);
+			continue;
+		}
+
+		PyList_SET_ITEM(objects, i, gameobj->GetProxy());
+		result.m_hitPoint.getValue(&points[i * 3]);
+		result.m_hitNormal.getValue(&normals[i * 3]);
+		if (result.m_meshObject) {
+			polygons[i] = result.m_polygon;
+		}
+	}
+
+	PyObject *ret = PyTuple_New(4);
+	PyTuple_SET_ITEM(ret, 0, objects);
+	PyTuple_SET_ITEM(ret, 1, kx_scene_memoryview_from_data(points.data(), points.size(), "f", sizeof(float), 3));
+	PyTuple_SET_ITEM(ret, 2, kx_scene_memoryview_from_data(normals.data(), normals.size(), "f", sizeof(float), 3));
+	PyTuple_SET_ITEM(ret, 3, kx_scene_memoryview_from_data(polygons.data(), polygons.size(), "i", sizeof(int), 1));
+
+	for (unsigned int i = 1; i < 4; ++i) {
+		if (!PyTuple_GET_ITEM(ret, i)) {
+			Py_DECREF(ret);
+			return nullptr;
+		}
+	}
+
+	return ret;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene, snapshotPhysics,
+"snapshotPhysics(buffer=None)\n"
+"Save the dynamic state of the physics simulation.\n"
+"Returns the state in a new bytes object, or in buffer when a bytearray is given.\n")
+{
+	PyObject *pybuffer = Py_None;
+
+	if (!PyArg_ParseTuple(args, "|O:snapshotPhysics", &pybuffer)) {
+		return nullptr;
+	}
+
+	if (pybuffer != Py_None && !PyByteArray_Check(pybuffer)) {
+		PyErr_Format(PyExc_TypeError, "scene.snapshotPhysics(buffer): KX_Scene, expected a bytearray or None, not %.200s",
+		             Py_TYPE(pybuffer)->tp_name);
+		return nullptr;
+	}
+
+	SnapshotPhysics(m_physicsState);
+
+	if (pybuffer == Py_None) {
+		return PyBytes_FromStringAndSize(m_physicsState.data(), m_physicsState.size());
+	}
+
+	// Resizing a bytearray to a size lower than its allocation doesn't reallocate.
+	if (PyByteArray_Resize(pybuffer, m_physicsState.size()) == -1) {
+		return nullptr;
+	}
+	memcpy(PyByteArray_AS_STRING(pybuffer), m_physicsState.data(), m_physicsState.size());
+
+	Py_INCREF(pybuffer);
+	return pybuffer;
+}
+
+KX_PYMETHODDEF_DOC_O(KX_Scene, restorePhysics,
+"restorePhysics(state)\n"
+"Restore a physics state returned by snapshotPhysics.\n")
+{
+	Py_buffer buffer;
+	if (PyObject_GetBuffer(value, &buffer, PyBUF_SIMPLE) == -1) {
+		PyErr_SetString(PyExc_TypeError, "scene.restorePhysics(state): KX_Scene, expected an object supporting the buffer protocol");
+		return nullptr;
+	}
+
+	const bool success = RestorePhysics((const char *)buffer.buf, buffer.len);
+	PyBuffer_Release(&buffer);
+
+	if (!success) {
+		PyErr_SetString(PyExc_ValueError, "scene.restorePhysics(state): KX_Scene, the state was not saved by this scene "
+		                "or objects were added or removed since");
+		return nullptr;
+	}
+
+	Py_RETURN_NONE;
+}
+
 /* Matches python dict.get(key, [default]) */
 KX_PYMETHODDEF_DOC(KX_Scene, get, "")
 {
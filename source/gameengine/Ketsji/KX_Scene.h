@@ -87,11 +87,14 @@ class RAS_FrameBuffer;
 class RAS_2DFilter;
 class RAS_2DFilterManager;
 class KX_2DFilterManager;
+class BL_PoseCache;
 class SCA_JoystickManager;
 class btCollisionShape;
 class KX_BlenderSceneConverter;
 struct KX_ClientObjectInfo;
 class KX_ObstacleSimulation;
+class KX_TraceRecorder;
+class SCA_ILogicBrick;
 struct TaskPool;
 
 /*********EEVEE INTEGRATION************/
@@ -120,6 +123,17 @@ public:
 	struct AnimationPoolData
 	{
 		double curtime;
+		/// Trace recorder and scene index used to trace the worker tasks.
+		KX_TraceRecorder *recorder;
+		int traceScene;
+
+		/// Frustum of the animation level of detail camera, nullptr when the level of detail is disabled.
+		const SG_Frustum *lodFrustum;
+		MT_Vector3 lodCameraPosition;
+		float lodCameraFactor;
+		float lodDistance;
+		unsigned short lodMaxInterval;
+		bool lodInterpolate;
 	};
 
 private:
@@ -192,6 +206,8 @@ protected:
 	 */
 	//e_PhysicsEngine m_physicsEngine; //who needs this ?
 	class PHY_IPhysicsEnvironment*		m_physicsEnvironment;
+	/// Physics state buffer of the python snapshots, kept to avoid an allocation per snapshot.
+	std::vector<char> m_physicsState;
 
 	/**
 	 * The name of the scene
@@ -323,6 +339,17 @@ protected:
 	bool m_isActivedHysteresis;
 	int m_lodHysteresisValue;
 
+	/**
+	 * Animation LOD settings
+	 */
+	bool m_animationLod;
+	bool m_animationLodInterpolate;
+	float m_animationLodDistance;
+	unsigned short m_animationLodMaxInterval;
+
+	/// Poses shared by the armature instances, nullptr when disabled.
+	BL_PoseCache *m_poseCache;
+
 public:
 	KX_Scene(SCA_IInputDevice *inputDevice,
 		const std::string& scenename,
@@ -492,6 +519,19 @@ public:
 	void DrawDebug(RAS_DebugDraw& debugDraw, const KX_CullingNodeList& nodes);
 	void RenderDebugProperties(RAS_DebugDraw& debugDraw, int xindent, int ysize, int& xcoord, int& ycoord, unsigned short propsMax);
 
+#ifdef WITH_GAMEENGINE_LOGIC_PROFILE
+	/// \section Logic profile.
+	/// Return at most count logic bricks of the active objects, sorted by decreasing accumulated time.
+	std::vector<SCA_ILogicBrick *> GetHotLogicBricks(unsigned int count) const;
+	/// Return at most count active objects, sorted by decreasing accumulated time of theirs logic bricks.
+	std::vector<KX_GameObject *> GetHotLogicObjects(unsigned int count) const;
+	/// Reset the accumulated time of the logic manager and all the logic bricks.
+	void ResetLogicProfile();
+	/// Draw the hottest logic bricks with theirs average time per logic frame.
+	void RenderDebugLogicProfile(RAS_DebugDraw& debugDraw, int xindent, int ysize, int profileIndent, int& xcoord, int& ycoord,
+			unsigned short count);
+#endif
+
 	/**
 	 * Replicate the logic bricks associated to this object.
 	 */
@@ -507,12 +547,26 @@ public:
 
 	/// Update the mesh for objects based on level of detail settings
 	void UpdateObjectLods(KX_Camera *cam, const KX_CullingNodeList& nodes);
+	/** Update the physics shape of all the objects based on level of detail settings and the
+	 * distance to the active camera, called before the physics step.
+	 */
+	void UpdatePhysicsLods();
 
 	// LoD Hysteresis functions
 	void SetLodHysteresis(bool active);
 	bool IsActivedLodHysteresis();
 	void SetLodHysteresisValue(int hysteresisvalue);
 	int GetLodHysteresisValue();
+
+	/** Set the animation level of detail, the armatures update their pose every frame until the
+	 * distance to the active camera, then each distance one frame more is skipped. The armatures
+	 * out of the camera frustum only advance the time of their actions.
+	 */
+	void SetAnimationLod(bool active, bool interpolate, float distance, unsigned short maxInterval);
+
+	/// Enable the sharing of the armature poses, the scene takes the ownership of the cache.
+	void SetPoseCache(BL_PoseCache *cache);
+	BL_PoseCache *GetPoseCache() const;
 	
 	// Update the activity box settings for objects in this scene, if needed.
 	void UpdateObjectActivity(void);
@@ -538,6 +592,22 @@ public:
 
 	void SetPhysicsEnvironment(class PHY_IPhysicsEnvironment*	physEnv);
 
+	/** Cast a batch of rays, or sweep a sphere along them when radius is not zero.
+	 * Only the objects of the collision groups in mask are hit, sensors are ignored.
+	 * \param results The closest hit of each ray, m_controller is nullptr when nothing was hit.
+	 */
+	void RayCastBatch(const MT_Vector3 *from, const MT_Vector3 *to, unsigned int numRays, unsigned short mask,
+	                  float radius, struct PHY_RayCastResult *results);
+
+	/** Save the dynamic state of the physics simulation, used to rollback the simulation.
+	 * \param state The buffer receiving the state, reused without allocation when large enough.
+	 */
+	void SnapshotPhysics(std::vector<char>& state);
+	/** Restore a physics state saved by SnapshotPhysics, the objects must be the same as when saved.
+	 * \return False if the state doesn't match the scene.
+	 */
+	bool RestorePhysics(const char *state, unsigned int size);
+
 	void	SetGravity(const MT_Vector3& gravity);
 	MT_Vector3 GetGravity();
 
@@ -570,6 +640,9 @@ public:
 	KX_PYMETHOD_DOC(KX_Scene, resume);
 	KX_PYMETHOD_DOC(KX_Scene, get);
 	KX_PYMETHOD_DOC(KX_Scene, drawObstacleSimulation);
+	KX_PYMETHOD_DOC(KX_Scene, rayCastBatch);
+	KX_PYMETHOD_DOC(KX_Scene, snapshotPhysics);
+	KX_PYMETHOD_DOC_O(KX_Scene, restorePhysics);
 
 
 	/* attributes */
@@ -31,10 +31,21 @@
 
 
 #include "KX_TimeCategoryLogger.h"
+#include "KX_TraceRecorder.h"
+
+#include "CM_Message.h"
 
 KX_TimeCategoryLogger::KX_TimeCategoryLogger(unsigned int maxNumMeasurements)
 	:m_maxNumMeasurements(maxNumMeasurements),
-	m_lastCategory(-1)
+	m_lastCategory(-1),
+	m_lastStart(0.0),
+	m_traceRecorder(nullptr),
+	m_measurementStart(0.0),
+	m_spikeThreshold(0.0),
+	m_numSpikes(0),
+	m_spikeCaptured(false),
+	m_spikeTotal(0.0),
+	m_spikeTime(0.0)
 {
 }
 
@@ -55,39 +66,85 @@ unsigned int KX_TimeCategoryLogger::GetMaxNumMeasurements() const
 	return m_maxNumMeasurements;
 }
 
-void KX_TimeCategoryLogger::AddCategory(TimeCategory tc)
+void KX_TimeCategoryLogger::AddCategory(TimeCategory tc, const std::string& name)
 {
 	// Only add if not already present
 	if (m_loggers.find(tc) == m_loggers.end()) {
 		m_loggers.emplace(TimeLoggerMap::value_type(tc, KX_TimeLogger(m_maxNumMeasurements)));
+		m_names[tc] = name;
 	}
 }
 
+void KX_TimeCategoryLogger::SetTraceRecorder(KX_TraceRecorder *recorder)
+{
+	m_traceRecorder = recorder;
+}
+
 void KX_TimeCategoryLogger::StartLog(TimeCategory tc, double now)
 {
 	if (m_lastCategory != -1) {
 		m_loggers[m_lastCategory].EndLog(now);
+		if (m_traceRecorder) {
+			m_traceRecorder->AddEvent(m_names[m_lastCategory].c_str(), m_lastStart, now);
+		}
 	}
 	m_loggers[tc].StartLog(now);
 	m_lastCategory = tc;
+	m_lastStart = now;
 }
 
 void KX_TimeCategoryLogger::EndLog(TimeCategory tc, double now)
 {
 	m_loggers[tc].EndLog(now);
+	if (m_traceRecorder && tc == m_lastCategory) {
+		m_traceRecorder->AddEvent(m_names[tc].c_str(), m_lastStart, now);
+		m_lastStart = now;
+	}
 }
 
 void KX_TimeCategoryLogger::EndLog(double now)
 {
 	m_loggers[m_lastCategory].EndLog(now);
+	if (m_traceRecorder) {
+		m_traceRecorder->AddEvent(m_names[m_lastCategory].c_str(), m_lastStart, now);
+	}
 	m_lastCategory = -1;
 }
 
 void KX_TimeCategoryLogger::NextMeasurement(double now)
 {
+	double total = 0.0;
 	for (TimeLoggerMap::iterator it = m_loggers.begin(), end = m_loggers.end(); it != end; ++it) {
 		it->second.NextMeasurement(now);
+		total += it->second.GetLastMeasurement();
+	}
+
+	// The first measurement is empty.
+	if (total > 0.0) {
+		m_histogram.Add(total);
+	}
+
+	if (m_spikeThreshold > 0.0 && total > m_spikeThreshold) {
+		++m_numSpikes;
+
+		if (!m_spikeCaptured) {
+			m_spikeCaptured = true;
+			m_spikeTotal = total;
+			m_spikeTime = m_measurementStart;
+			for (TimeLoggerMap::iterator it = m_loggers.begin(), end = m_loggers.end(); it != end; ++it) {
+				m_spikeMeasurements[it->first] = it->second.GetLastMeasurement();
+			}
+
+			// Freeze the trace to keep the events of the spike.
+			if (m_traceRecorder && m_traceRecorder->GetRecording()) {
+				m_traceRecorder->SetRecording(false);
+			}
+
+			CM_Warning("frame time spike captured: " << total * 1000.0 << "ms");
+		}
 	}
+
+	m_measurementStart = now;
 }
 
 double KX_TimeCategoryLogger::GetAverage(TimeCategory tc)
@@ -105,3 +162,62 @@ double KX_TimeCategoryLogger::GetAverage()
 
 	return time;
 }
+
+const KX_TimeHistogram& KX_TimeCategoryLogger::GetHistogram(TimeCategory tc)
+{
+	return m_loggers[tc].GetHistogram();
+}
+
+const KX_TimeHistogram& KX_TimeCategoryLogger::GetHistogram() const
+{
+	return m_histogram;
+}
+
+void KX_TimeCategoryLogger::ClearHistograms()
+{
+	for (TimeLoggerMap::iterator it = m_loggers.begin(), end = m_loggers.end(); it != end; ++it) {
+		it->second.ClearHistogram();
+	}
+	m_histogram.Clear();
+}
+
+void KX_TimeCategoryLogger::SetSpikeThreshold(double threshold)
+{
+	m_spikeThreshold = threshold;
+}
+
+double KX_TimeCategoryLogger::GetSpikeThreshold() const
+{
+	return m_spikeThreshold;
+}
+
+unsigned int KX_TimeCategoryLogger::GetNumSpikes() const
+{
+	return m_numSpikes;
+}
+
+bool KX_TimeCategoryLogger::IsSpikeCaptured() const
+{
+	return m_spikeCaptured;
+}
+
+double KX_TimeCategoryLogger::GetSpikeTotal() const
+{
+	return m_spikeTotal;
+}
+
+double KX_TimeCategoryLogger::GetSpikeTime() const
+{
+	return m_spikeTime;
+}
+
+double KX_TimeCategoryLogger::GetSpikeMeasurement(TimeCategory tc)
+{
+	return m_spikeMeasurements[tc];
+}
+
+void KX_TimeCategoryLogger::ClearSpike()
+{
+	m_spikeCaptured = false;
+	m_spikeMeasurements.clear();
+}
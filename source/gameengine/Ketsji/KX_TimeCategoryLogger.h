@@ -37,9 +37,12 @@
 #endif
 
 #include <map>
+#include <string>
 
 #include "KX_TimeLogger.h"
 
+class KX_TraceRecorder;
+
 /**
  * Stores and manages time measurements by category.
  * Categories can be added dynamically.
@@ -76,8 +79,15 @@ public:
 	/**
 	 * Adds a category.
 	 * \param category	The new category.
+	 * \param name		The name of the category used in traces.
+	 */
+	void AddCategory(TimeCategory tc, const std::string& name = "");
+
+	/**
+	 * Sets the recorder receiving an event for each logged time span.
+	 * \param recorder	The trace recorder or nullptr.
 	 */
-	void AddCategory(TimeCategory tc);
+	void SetTraceRecorder(KX_TraceRecorder *recorder);
 
 	/**
 	 * Starts logging in current measurement for the given category.
@@ -116,6 +126,55 @@ public:
 	 */
 	double GetAverage();
 
+	/**
+	 * Returns the histogram of the measurements for the given category.
+	 */
+	const KX_TimeHistogram& GetHistogram(TimeCategory tc);
+
+	/**
+	 * Returns the histogram of the grand total of each measurement.
+	 */
+	const KX_TimeHistogram& GetHistogram() const;
+
+	/**
+	 * Removes the measurements from all the histograms.
+	 */
+	void ClearHistograms();
+
+	/**
+	 * Sets the grand total above which a measurement is captured as a spike.
+	 * \param threshold	The time threshold, 0 disables the capture.
+	 */
+	void SetSpikeThreshold(double threshold);
+	double GetSpikeThreshold() const;
+
+	/**
+	 * Returns the number of measurements above the spike threshold.
+	 */
+	unsigned int GetNumSpikes() const;
+
+	/**
+	 * Returns true if a spike is captured, the captured measurements are kept
+	 * until ClearSpike() is called.
+	 */
+	bool IsSpikeCaptured() const;
+
+	/**
+	 * Returns the grand total and the start time of the captured spike.
+	 */
+	double GetSpikeTotal() const;
+	double GetSpikeTime() const;
+
+	/**
+	 * Returns the measurement of the captured spike for the given category.
+	 */
+	double GetSpikeMeasurement(TimeCategory tc);
+
+	/**
+	 * Removes the captured spike, the next measurement above the threshold is captured.
+	 */
+	void ClearSpike();
+
 protected:
 	/// Storage for the loggers.
 	TimeLoggerMap m_loggers;
@@ -123,6 +182,25 @@ protected:
 	unsigned int m_maxNumMeasurements;
 
 	TimeCategory m_lastCategory;
+	/// Start time of the last category, used for trace events.
+	double m_lastStart;
+
+	/// Names of the categories in traces.
+	std::map<TimeCategory, std::string> m_names;
+	KX_TraceRecorder *m_traceRecorder;
+
+	/// Histogram of the grand total.
+	KX_TimeHistogram m_histogram;
+	/// Start time of the current measurement.
+	double m_measurementStart;
+
+	double m_spikeThreshold;
+	unsigned int m_numSpikes;
+	bool m_spikeCaptured;
+	double m_spikeTotal;
+	double m_spikeTime;
+	/// Measurements of each category for the captured spike.
+	std::map<TimeCategory, double> m_spikeMeasurements;
 };
 
 #endif  /* __KX_TIMECATEGORYLOGGER_H__ */
@@ -0,0 +1,106 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file gameengine/Ketsji/KX_TimeHistogram.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_TimeHistogram.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+/// Upper bound of the first bin: one micro-second, the last bin covers about 16 seconds.
+static const double minTime = 1.0e-6;
+
+KX_TimeHistogram::KX_TimeHistogram()
+{
+	Clear();
+}
+
+KX_TimeHistogram::~KX_TimeHistogram()
+{
+}
+
+void KX_TimeHistogram::Add(double time)
+{
+	unsigned int bin = 0;
+	if (time > minTime) {
+		bin = std::min((unsigned int)(std::log2(time / minTime) * BINS_PER_OCTAVE) + 1, (unsigned int)NUM_BINS - 1);
+	}
+
+	++m_bins[bin];
+	++m_numMeasurements;
+	m_max = std::max(m_max, time);
+	m_total += time;
+}
+
+void KX_TimeHistogram::Clear()
+{
+	memset(m_bins, 0, sizeof(m_bins));
+	m_numMeasurements = 0;
+	m_max = 0.0;
+	m_total = 0.0;
+}
+
+double KX_TimeHistogram::GetPercentile(double fraction) const
+{
+	if (m_numMeasurements == 0) {
+		return 0.0;
+	}
+
+	// Number of measurements under the percentile.
+	const unsigned int rank = std::max((unsigned int)std::ceil(fraction * m_numMeasurements), 1u);
+
+	unsigned int count = 0;
+	for (unsigned int bin = 0; bin < NUM_BINS; ++bin) {
+		count += m_bins[bin];
+		if (count >= rank) {
+			// The bin bound is never above the real maximum.
+			return std::min(GetBinTime(bin), m_max);
+		}
+	}
+
+	return m_max;
+}
+
+double KX_TimeHistogram::GetMax() const
+{
+	return m_max;
+}
+
+double KX_TimeHistogram::GetMean() const
+{
+	return (m_numMeasurements > 0) ? m_total / m_numMeasurements : 0.0;
+}
+
+unsigned int KX_TimeHistogram::GetNumMeasurements() const
+{
+	return m_numMeasurements;
+}
+
+double KX_TimeHistogram::GetBinTime(unsigned int bin)
+{
+	return minTime * std::exp2((double)bin / BINS_PER_OCTAVE);
+}
@@ -0,0 +1,75 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file KX_TimeHistogram.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_TIMEHISTOGRAM_H__
+#define __KX_TIMEHISTOGRAM_H__
+
+/**
+ * Fixed size histogram of time measurements with logarithmic bins,
+ * used to compute percentiles without storing the measurements.
+ * The relative error of a percentile is bounded by the bin width (~9%).
+ */
+class KX_TimeHistogram
+{
+public:
+	KX_TimeHistogram();
+	~KX_TimeHistogram();
+
+	/// Add a measurement in seconds.
+	void Add(double time);
+	/// Remove all the measurements.
+	void Clear();
+
+	/**
+	 * Return the time under which a fraction of the measurements are.
+	 * \param fraction The fraction of the measurements, e.g 0.95 for the 95th percentile.
+	 */
+	double GetPercentile(double fraction) const;
+	/// Return the biggest measurement.
+	double GetMax() const;
+	/// Return the exact average of the measurements.
+	double GetMean() const;
+	unsigned int GetNumMeasurements() const;
+
+private:
+	enum {
+		BINS_PER_OCTAVE = 8,
+		NUM_OCTAVES = 24,
+		/// The first bin receives the measurements under the minimum time.
+		NUM_BINS = BINS_PER_OCTAVE * NUM_OCTAVES + 1
+	};
+
+	/// Return the upper bound of a bin.
+	static double GetBinTime(unsigned int bin);
+
+	unsigned int m_bins[NUM_BINS];
+	unsigned int m_numMeasurements;
+	double m_max;
+	double m_total;
+};
+
+#endif  // __KX_TIMEHISTOGRAM_H__
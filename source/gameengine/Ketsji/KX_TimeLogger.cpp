@@ -80,6 +80,10 @@ void KX_TimeLogger::NextMeasurement(double now)
 	// End logging to current measurement
 	EndLog(now);
 
+	if (m_measurements.size() > 0) {
+		m_histogram.Add(m_measurements[0]);
+	}
+
 	// Add a new measurement at the front
 	double m = 0.0;
 	m_measurements.push_front(m);
@@ -106,3 +110,18 @@ double KX_TimeLogger::GetAverage() const
 
 	return avg;
 }
+
+double KX_TimeLogger::GetLastMeasurement() const
+{
+	return (m_measurements.size() > 1) ? m_measurements[1] : 0.0;
+}
+
+const KX_TimeHistogram& KX_TimeLogger::GetHistogram() const
+{
+	return m_histogram;
+}
+
+void KX_TimeLogger::ClearHistogram()
+{
+	m_histogram.Clear();
+}
@@ -38,6 +38,8 @@
 
 #include <deque>
 
+#include "KX_TimeHistogram.h"
+
 /**
  * Stores and manages time measurements.
  */
@@ -89,10 +91,28 @@ public:
 	 */
 	double GetAverage() const;
 
+	/**
+	 * Returns the last complete measurement.
+	 */
+	double GetLastMeasurement() const;
+
+	/**
+	 * Returns the histogram of all the complete measurements.
+	 */
+	const KX_TimeHistogram& GetHistogram() const;
+
+	/**
+	 * Removes the measurements from the histogram.
+	 */
+	void ClearHistogram();
+
 protected:
 	/// Storage for the measurements.
 	std::deque<double> m_measurements;
 
+	/// Histogram of the measurements since the last clear.
+	KX_TimeHistogram m_histogram;
+
 	/// Maximum number of measurements.
 	unsigned int m_maxNumMeasurements;
 
@@ -0,0 +1,257 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_TraceRecorder.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_TraceRecorder.h"
+#include "KX_ISystem.h"
+
+#include "CM_Message.h"
+
+#include "atomic_ops.h"
+
+#include <stdio.h>
+
+static uint32_t numThreads = 0;
+
+/// Write a JSON string with escaped characters.
+static void write_json_string(FILE *file, const char *str)
+{
+	fputc('"', file);
+	for (const char *c = str; *c; ++c) {
+		switch (*c) {
+			case '"':
+			case '\\':
+			{
+				fputc('\\', file);
+				fputc(*c, file);
+				break;
+			}
+			case '\n':
+			{
+				fputs("\\n", file);
+				break;
+			}
+			default:
+			{
+				if ((unsigned char)*c < 0x20) {
+					fprintf(file, "\\u%04x", (unsigned char)*c);
+				}
+				else {
+					fputc(*c, file);
+				}
+			}
+		}
+	}
+	fputc('"', file);
+}
+
+KX_TraceRecorder::KX_TraceRecorder(KX_ISystem *system, unsigned int capacity)
+	:m_system(system),
+	m_events(capacity),
+	m_numEvents(0),
+	m_activeScene(-1),
+	m_mainThread(GetThreadIndex()),
+	m_recording(false)
+{
+}
+
+KX_TraceRecorder::~KX_TraceRecorder()
+{
+}
+
+void KX_TraceRecorder::SetCapacity(unsigned int capacity)
+{
+	if (capacity == 0) {
+		return;
+	}
+
+	m_events.clear();
+	m_events.resize(capacity);
+	m_numEvents = 0;
+}
+
+unsigned int KX_TraceRecorder::GetCapacity() const
+{
+	return m_events.size();
+}
+
+void KX_TraceRecorder::SetRecording(bool recording)
+{
+	m_recording = recording;
+}
+
+void KX_TraceRecorder::Clear()
+{
+	m_numEvents = 0;
+}
+
+double KX_TraceRecorder::GetTime() const
+{
+	return m_system->GetTimeInSeconds();
+}
+
+int KX_TraceRecorder::GetSceneIndex(const std::string& name)
+{
+	for (unsigned int i = 0, size = m_sceneNames.size(); i < size; ++i) {
+		if (m_sceneNames[i] == name) {
+			return i;
+		}
+	}
+
+	m_sceneNames.push_back(name);
+	return m_sceneNames.size() - 1;
+}
+
+void KX_TraceRecorder::SetActiveScene(int scene)
+{
+	m_activeScene = scene;
+}
+
+int KX_TraceRecorder::GetActiveScene() const
+{
+	return m_activeScene;
+}
+
+void KX_TraceRecorder::PushEvent(const char *name, EventPhase phase, int scene, double start, double end)
+{
+	// Reserve a slot, concurrent threads never write in the same slot unless the buffer wraps during the call.
+	const uint64_t index = atomic_fetch_and_add_uint64(&m_numEvents, 1);
+	Event& event = m_events[index % m_events.size()];
+	event.m_name = name;
+	event.m_phase = phase;
+	event.m_scene = scene;
+	event.m_thread = GetThreadIndex();
+	event.m_start = start;
+	event.m_end = end;
+}
+
+bool KX_TraceRecorder::Write(const std::string& filepath) const
+{
+	FILE *file = fopen(filepath.c_str(), "w");
+	if (!file) {
+		CM_Error("failed to open trace file: " << filepath);
+		return false;
+	}
+
+	const uint64_t capacity = m_events.size();
+	const uint64_t numEvents = (m_numEvents < capacity) ? m_numEvents : capacity;
+	const uint64_t first = m_numEvents - numEvents;
+
+	fputs("{\"traceEvents\":[\n", file);
+
+	// Name the threads, workers are named by their index.
+	std::vector<bool> usedThreads;
+	for (uint64_t i = first; i < m_numEvents; ++i) {
+		const Event& event = m_events[i % capacity];
+		if (event.m_thread >= usedThreads.size()) {
+			usedThreads.resize(event.m_thread + 1, false);
+		}
+		usedThreads[event.m_thread] = true;
+	}
+
+	bool firstEvent = true;
+	for (unsigned int i = 0, size = usedThreads.size(); i < size; ++i) {
+		if (!usedThreads[i]) {
+			continue;
+		}
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":",
+				firstEvent ? "" : ",\n", i);
+		if (i == m_mainThread) {
+			fputs("\"Main\"", file);
+		}
+		else {
+			fprintf(file, "\"Worker %u\"", i);
+		}
+		fputs("}}", file);
+		firstEvent = false;
+	}
+
+	for (uint64_t i = first; i < m_numEvents; ++i) {
+		const Event& event = m_events[i % capacity];
+
+		fputs(firstEvent ? "{\"name\":" : ",\n{\"name\":", file);
+		write_json_string(file, event.m_name);
+		// Time stamps are in micro-seconds.
+		switch (event.m_phase) {
+			case PHASE_COMPLETE:
+			{
+				fprintf(file, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+						event.m_thread, event.m_start * 1.0e6, (event.m_end - event.m_start) * 1.0e6);
+				break;
+			}
+			case PHASE_BEGIN:
+			case PHASE_END:
+			{
+				fprintf(file, ",\"ph\":\"%c\",\"pid\":0,\"tid\":%u,\"ts\":%.3f",
+						(event.m_phase == PHASE_BEGIN) ? 'B' : 'E', event.m_thread, event.m_start * 1.0e6);
+				break;
+			}
+		}
+		if (event.m_scene != -1) {
+			fputs(",\"cat\":", file);
+			write_json_string(file, m_sceneNames[event.m_scene].c_str());
+			fputs(",\"args\":{\"scene\":", file);
+			write_json_string(file, m_sceneNames[event.m_scene].c_str());
+			fputs("}", file);
+		}
+		fputs("}", file);
+		firstEvent = false;
+	}
+
+	fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+	fclose(file);
+
+	return true;
+}
+
+unsigned int KX_TraceRecorder::GetThreadIndex()
+{
+	static thread_local unsigned int index = atomic_fetch_and_add_uint32(&numThreads, 1);
+	return index;
+}
+
+KX_TraceScope::KX_TraceScope(KX_TraceRecorder& recorder, const char *name, int scene)
+	:m_recorder(recorder),
+	m_name(name),
+	m_scene(scene),
+	m_open(recorder.GetRecording())
+{
+	if (m_open) {
+		m_recorder.BeginScope(m_name, m_scene, m_recorder.GetTime());
+	}
+}
+
+KX_TraceScope::KX_TraceScope(KX_TraceRecorder& recorder, const char *name)
+	:KX_TraceScope(recorder, name, recorder.GetActiveScene())
+{
+}
+
+KX_TraceScope::~KX_TraceScope()
+{
+	// Only the scopes opened while recording are closed.
+	if (m_open) {
+		m_recorder.EndScope(m_name, m_scene, m_recorder.GetTime());
+	}
+}
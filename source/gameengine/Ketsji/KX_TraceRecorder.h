@@ -0,0 +1,170 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_TraceRecorder.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_TRACERECORDER_H__
+#define __KX_TRACERECORDER_H__
+
+#include <string>
+#include <vector>
+
+#include "BLI_sys_types.h"
+
+class KX_ISystem;
+
+/** Records timestamped events of the engine into a ring buffer of fixed size
+ * and writes them using the Chrome trace event format (chrome://tracing, Perfetto).
+ * The events are either complete spans or begin and end events of nested scopes,
+ * the scopes of a thread must be closed in the reverse order they are opened.
+ * Events can be added from any thread, the scene and trace management functions
+ * are only called from the main thread.
+ */
+class KX_TraceRecorder
+{
+public:
+	enum EventPhase {
+		/// Span with a start and an end time.
+		PHASE_COMPLETE = 0,
+		/// Opening of a scope at the start time.
+		PHASE_BEGIN,
+		/// Closing of the last opened scope of the thread at the start time.
+		PHASE_END
+	};
+
+	struct Event
+	{
+		/// Name of the event, must be a static string.
+		const char *m_name;
+		EventPhase m_phase;
+		/// Index of the scene name or -1.
+		int m_scene;
+		/// Index of the thread which recorded the event.
+		unsigned int m_thread;
+		double m_start;
+		double m_end;
+	};
+
+	/**
+	 * Constructor.
+	 * \param system The system used as clock for the scoped events.
+	 * \param capacity Maximum number of events stored, older events are overwritten.
+	 */
+	KX_TraceRecorder(KX_ISystem *system, unsigned int capacity = 65536);
+	~KX_TraceRecorder();
+
+	/// Changes the maximum number of events and clear the recorded events.
+	void SetCapacity(unsigned int capacity);
+	unsigned int GetCapacity() const;
+
+	void SetRecording(bool recording);
+	bool GetRecording() const
+	{
+		return m_recording;
+	}
+
+	/// Remove all the recorded events.
+	void Clear();
+
+	/// Return the current time of the recorder clock, thread safe.
+	double GetTime() const;
+
+	/// Return the index of a scene name used in the events.
+	int GetSceneIndex(const std::string& name);
+	/// Set the scene used by the events added without explicit scene.
+	void SetActiveScene(int scene);
+	int GetActiveScene() const;
+
+	/// Add an event for the active scene.
+	void AddEvent(const char *name, double start, double end)
+	{
+		if (m_recording) {
+			PushEvent(name, PHASE_COMPLETE, m_activeScene, start, end);
+		}
+	}
+
+	/// Add an event for the given scene.
+	void AddEvent(const char *name, int scene, double start, double end)
+	{
+		if (m_recording) {
+			PushEvent(name, PHASE_COMPLETE, scene, start, end);
+		}
+	}
+
+	/// Open a scope of the calling thread, the events added until its closing are nested in it.
+	void BeginScope(const char *name, int scene, double time)
+	{
+		if (m_recording) {
+			PushEvent(name, PHASE_BEGIN, scene, time, time);
+		}
+	}
+
+	/** Close the last scope opened by the calling thread. The event is added even when the recording
+	 * was stopped since the opening, to keep the scopes balanced.
+	 */
+	void EndScope(const char *name, int scene, double time)
+	{
+		PushEvent(name, PHASE_END, scene, time, time);
+	}
+
+	/** Write the recorded events in a JSON file.
+	 * \return False if the file can't be opened.
+	 */
+	bool Write(const std::string& filepath) const;
+
+	/// Return a small index identifying the calling thread.
+	static unsigned int GetThreadIndex();
+
+private:
+	void PushEvent(const char *name, EventPhase phase, int scene, double start, double end);
+
+	KX_ISystem *m_system;
+	std::vector<Event> m_events;
+	/// Total number of added events, the next event index is m_numEvents % capacity.
+	uint64_t m_numEvents;
+	std::vector<std::string> m_sceneNames;
+	int m_activeScene;
+	/// Index of the thread owning the recorder.
+	unsigned int m_mainThread;
+	bool m_recording;
+};
+
+/// Open a trace scope for the life time of the object, the scopes created inside are nested.
+class KX_TraceScope
+{
+public:
+	KX_TraceScope(KX_TraceRecorder& recorder, const char *name, int scene);
+	/// Open a scope for the active scene of the recorder.
+	KX_TraceScope(KX_TraceRecorder& recorder, const char *name);
+	~KX_TraceScope();
+
+private:
+	KX_TraceRecorder& m_recorder;
+	const char *m_name;
+	int m_scene;
+	/// True when the scope was opened while recording.
+	bool m_open;
+};
+
+#endif  // __KX_TRACERECORDER_H__
@@ -0,0 +1,146 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file gameengine/Launcher/LA_Benchmark.cpp
+ *  \ingroup launcher
+ */
+
+#include "LA_Benchmark.h"
+
+#include "KX_KetsjiEngine.h"
+
+#include "CM_Message.h"
+
+extern "C" {
+#  include "MEM_guardedalloc.h"
+}
+
+#include <stdio.h>
+
+#ifdef __linux__
+#  include <sys/resource.h>
+#endif
+
+LA_Benchmark::LA_Benchmark(KX_KetsjiEngine *engine, const std::string& fileName, unsigned int numFrames, double timestep,
+		const std::string& reportPath)
+	:m_engine(engine),
+	m_fileName(fileName),
+	m_numFrames(numFrames),
+	m_frame(0),
+	m_timestep(timestep),
+	m_reportPath(reportPath),
+	m_startClockTime(0.0),
+	m_startTime(0.0),
+	m_endTime(0.0)
+{
+}
+
+LA_Benchmark::~LA_Benchmark()
+{
+}
+
+void LA_Benchmark::Start()
+{
+	/* The game time only depends on the frame index, with a time step matching the
+	 * tic rate each frame proceeds exactly one logic and physics frame. */
+	m_engine->SetFlag((KX_KetsjiEngine::FlagType)(KX_KetsjiEngine::USE_EXTERNAL_CLOCK | KX_KetsjiEngine::FIXED_FRAMERATE), true);
+	m_startClockTime = m_engine->GetClockTime();
+
+	m_engine->ClearProfilePercentiles();
+	MEM_reset_peak_memory();
+
+	m_frame = 0;
+	m_startTime = m_engine->GetRealTime();
+	m_endTime = m_startTime;
+
+	CM_Message("Benchmark: " << m_numFrames << " frames with time step " << m_timestep);
+}
+
+bool LA_Benchmark::NextFrame()
+{
+	if (m_frame == m_numFrames) {
+		m_endTime = m_engine->GetRealTime();
+		return false;
+	}
+
+	++m_frame;
+	m_engine->SetClockTime(m_startClockTime + m_frame * m_timestep);
+
+	return true;
+}
+
+bool LA_Benchmark::WriteReport() const
+{
+	FILE *file = stdout;
+	if (!m_reportPath.empty()) {
+		file = fopen(m_reportPath.c_str(), "w");
+		if (!file) {
+			CM_Error("failed to open benchmark report file: " << m_reportPath);
+			return false;
+		}
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "\t\"file\": \"");
+	// Escape the file name for JSON.
+	for (char c : m_fileName) {
+		if (c == '"' || c == '\\') {
+			fputc('\\', file);
+		}
+		fputc(c, file);
+	}
+	fprintf(file, "\",\n");
+	fprintf(file, "\t\"frames\": %u,\n", m_frame);
+	fprintf(file, "\t\"timestep\": %g,\n", m_timestep);
+	fprintf(file, "\t\"render\": %s,\n", m_engine->GetRender() ? "true" : "false");
+	fprintf(file, "\t\"wall_time\": %.6f,\n", m_endTime - m_startTime);
+
+	// Times in milliseconds.
+	fprintf(file, "\t\"categories\": {\n");
+	const std::vector<KX_KetsjiEngine::ProfileStatistics> statistics = m_engine->GetProfileStatistics();
+	for (unsigned int i = 0, size = statistics.size(); i < size; ++i) {
+		const KX_KetsjiEngine::ProfileStatistics& stat = statistics[i];
+		fprintf(file, "\t\t\"%s\": {\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}%s\n",
+				stat.m_name.c_str(), stat.m_mean * 1000.0, stat.m_p50 * 1000.0, stat.m_p95 * 1000.0, stat.m_p99 * 1000.0,
+				stat.m_max * 1000.0, (i < size - 1) ? "," : "");
+	}
+	fprintf(file, "\t},\n");
+
+	// Memory in bytes, the resident size is only available on Linux.
+	fprintf(file, "\t\"memory\": {\"peak\": %zu, \"in_use\": %zu", MEM_get_peak_memory(), MEM_get_memory_in_use());
+#ifdef __linux__
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		fprintf(file, ", \"peak_resident\": %zu", (size_t)usage.ru_maxrss * 1024);
+	}
+#endif
+	fprintf(file, "}\n");
+	fprintf(file, "}\n");
+
+	if (file != stdout) {
+		fclose(file);
+		CM_Message("Benchmark report written to: " << m_reportPath);
+	}
+
+	return true;
+}
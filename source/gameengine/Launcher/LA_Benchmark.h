@@ -0,0 +1,80 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+
+/** \file LA_Benchmark.h
+ *  \ingroup launcher
+ */
+
+#ifndef __LA_BENCHMARK_H__
+#define __LA_BENCHMARK_H__
+
+#include <string>
+
+class KX_KetsjiEngine;
+
+/** Runs the engine for a fixed number of frames with a fixed time step using
+ * the external clock and writes a JSON report of the profile and memory usage.
+ */
+class LA_Benchmark
+{
+public:
+	/**
+	 * Constructor.
+	 * \param engine The engine to run.
+	 * \param fileName The name of the benchmarked file, written in the report.
+	 * \param numFrames The number of frames to run.
+	 * \param timestep The game time elapsed in each frame.
+	 * \param reportPath The path of the report or an empty string to print it.
+	 */
+	LA_Benchmark(KX_KetsjiEngine *engine, const std::string& fileName, unsigned int numFrames, double timestep,
+			const std::string& reportPath);
+	~LA_Benchmark();
+
+	/// Setup the engine clock and clear the previous measurements, called after the engine is started.
+	void Start();
+
+	/** Advance the engine clock for the next frame.
+	 * \return False when all the frames are done.
+	 */
+	bool NextFrame();
+
+	/// Write the report, return false if the file can't be opened.
+	bool WriteReport() const;
+
+private:
+	KX_KetsjiEngine *m_engine;
+	std::string m_fileName;
+	unsigned int m_numFrames;
+	unsigned int m_frame;
+	double m_timestep;
+	std::string m_reportPath;
+
+	/// Engine clock time at the start of the benchmark.
+	double m_startClockTime;
+
+	/// Real time at the start and end of the benchmark.
+	double m_startTime;
+	double m_endTime;
+};
+
+#endif  // __LA_BENCHMARK_H__
@@ -59,6 +59,8 @@
 
 #include "DEV_Joystick.h"
 
+#include "LA_Benchmark.h"
+
 #include "CM_Message.h"
 
 extern "C" {
@@ -100,6 +102,7 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system, Main *maggie, Scene *scene, Glob
 	m_canvas(nullptr),
 	m_rasterizer(nullptr), 
 	m_converter(nullptr),
+	m_benchmark(nullptr),
 #ifdef WITH_PYTHON
 	m_globalDict(nullptr),
 	m_gameLogic(nullptr),
@@ -236,6 +239,16 @@ void LA_Launcher::InitEngine()
 	m_ketsjiEngine->SetMaxLogicFrame(gm.maxlogicstep);
 	m_ketsjiEngine->SetMaxPhysicsFrame(gm.maxphystep);
 
+	// Record a trace of the whole game when a trace file is requested.
+	const char *traceFile = SYS_GetCommandLineString(syshandle, "trace_file", "");
+	if (traceFile[0] != '\0') {
+		m_ketsjiEngine->GetTraceRecorder().SetRecording(true);
+	}
+
+	// Capture the first frame above the threshold in milliseconds.
+	const float spikeThreshold = SYS_GetCommandLineFloat(syshandle, "spike_threshold", 0.0f);
+	m_ketsjiEngine->SetProfileSpikeThreshold(spikeThreshold / 1000.0);
+
 	// Set the global settings (carried over if restart/load new files).
 	m_ketsjiEngine->SetGlobalSettings(m_globalSettings);
 
@@ -283,6 +296,28 @@ void LA_Launcher::InitEngine()
 	 */
 	Scene *scene = m_kxStartScene->GetBlenderScene(); // needed for macro
 	m_ketsjiEngine->SetAnimFrameRate(FPS);
+
+	// Replay or record the input events, the replay makes the runs deterministic.
+	const char *inputReplay = SYS_GetCommandLineString(syshandle, "input_replay", "");
+	const char *inputRecord = SYS_GetCommandLineString(syshandle, "input_record", "");
+	if (inputReplay[0] != '\0') {
+		m_inputDevice->StartReplay(inputReplay);
+	}
+	else if (inputRecord[0] != '\0') {
+		m_inputDevice->StartRecording(inputRecord);
+	}
+
+	// Run a fixed number of frames and write a report.
+	const int benchmarkFrames = SYS_GetCommandLineInt(syshandle, "benchmark_frames", 0);
+	if (benchmarkFrames > 0) {
+		const double timestep = SYS_GetCommandLineFloat(syshandle, "benchmark_timestep", 1.0f / gm.ticrate);
+		const char *report = SYS_GetCommandLineString(syshandle, "benchmark_report", "");
+		m_benchmark = new LA_Benchmark(m_ketsjiEngine, m_maggie->name, benchmarkFrames, timestep, report);
+
+		// Skip the rendering unless requested.
+		m_ketsjiEngine->SetRender(SYS_GetCommandLineInt(syshandle, "benchmark_render", 0) != 0);
+		m_benchmark->Start();
+	}
 }
 
 
@@ -295,6 +330,21 @@ void LA_Launcher::ExitEngine()
 	DEV_Joystick::Close();
 	m_ketsjiEngine->StopEngine();
 
+	if (m_benchmark) {
+		m_benchmark->WriteReport();
+		delete m_benchmark;
+		m_benchmark = nullptr;
+	}
+
+	m_inputDevice->StopRecordingReplay();
+
+	const char *traceFile = SYS_GetCommandLineString(SYS_GetSystem(), "trace_file", "");
+	if (traceFile[0] != '\0') {
+		if (m_ketsjiEngine->GetTraceRecorder().Write(traceFile)) {
+			CM_Message("Trace written to: " << traceFile);
+		}
+	}
+
 #ifdef WITH_PYTHON
 
 	/* Clears the dictionary by hand:
@@ -460,6 +510,12 @@ bool LA_Launcher::EngineNextFrame()
 		HandlePythonConsole();
 #endif
 
+		// Stop after the last frame of the benchmark.
+		if (m_benchmark && !m_benchmark->NextFrame()) {
+			m_exitRequested = KX_ExitRequest::QUIT_GAME;
+			return false;
+		}
+
 		// Kick the engine.
 		bool renderFrame = m_ketsjiEngine->NextFrame();
 		if (renderFrame) {
@@ -469,6 +525,8 @@ bool LA_Launcher::EngineNextFrame()
 		m_system->processEvents(false);
 		m_system->dispatchEvents();
 
+		m_inputDevice->NextStreamFrame();
+
 		if (m_inputDevice->GetInput((SCA_IInputDevice::SCA_EnumInputs)m_ketsjiEngine->GetExitKey()).Find(SCA_InputEvent::ACTIVE) &&
 			!m_inputDevice->GetHookExitKey())
 		{
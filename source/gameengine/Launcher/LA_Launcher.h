@@ -40,6 +40,7 @@ class KX_Scene;
 class KX_ISystem;
 class KX_BlenderConverter;
 class KX_NetworkMessageManager;
+class LA_Benchmark;
 class RAS_ICanvas;
 class DEV_EventConsumer;
 class DEV_InputDevice;
@@ -79,6 +80,8 @@ protected:
 	KX_BlenderConverter *m_converter;
 	/// Manage messages.
 	KX_NetworkMessageManager *m_networkMessageManager;
+	/// Fixed frames run, nullptr when not benchmarking.
+	LA_Benchmark *m_benchmark;
 
 #ifdef WITH_PYTHON
 	PyObject *m_globalDict;
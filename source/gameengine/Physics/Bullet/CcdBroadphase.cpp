@@ -0,0 +1,233 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Physics/Bullet/CcdBroadphase.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdBroadphase.h"
+
+/// Add the pairs of the traversed leaves with a proxy, like the tree collider of btDbvtBroadphase.
+struct CcdDbvtPairCollider : btDbvt::ICollide
+{
+	btDbvtBroadphase *m_broadphase;
+	btDbvtProxy *m_proxy;
+
+	CcdDbvtPairCollider(btDbvtBroadphase *broadphase, btDbvtProxy *proxy)
+		:m_broadphase(broadphase),
+		m_proxy(proxy)
+	{
+	}
+
+	void Process(const btDbvtNode *na, const btDbvtNode *nb)
+	{
+		if (na != nb) {
+			m_broadphase->m_paircache->addOverlappingPair((btDbvtProxy *)na->data, (btDbvtProxy *)nb->data);
+			++m_broadphase->m_newpairs;
+		}
+	}
+
+	void Process(const btDbvtNode *n)
+	{
+		Process(n, m_proxy->leaf);
+	}
+};
+
+struct CcdDbvtRayTester : btDbvt::ICollide
+{
+	btBroadphaseRayCallback& m_rayCallback;
+
+	CcdDbvtRayTester(btBroadphaseRayCallback& rayCallback)
+		:m_rayCallback(rayCallback)
+	{
+	}
+
+	void Process(const btDbvtNode *leaf)
+	{
+		m_rayCallback.process((btDbvtProxy *)leaf->data);
+	}
+};
+
+struct CcdDbvtAabbTester : btDbvt::ICollide
+{
+	btBroadphaseAabbCallback& m_aabbCallback;
+
+	CcdDbvtAabbTester(btBroadphaseAabbCallback& aabbCallback)
+		:m_aabbCallback(aabbCallback)
+	{
+	}
+
+	void Process(const btDbvtNode *leaf)
+	{
+		m_aabbCallback.process((btDbvtProxy *)leaf->data);
+	}
+};
+
+CcdDbvtBroadphase::CcdDbvtBroadphase()
+	:m_numNewStatic(0)
+{
+}
+
+CcdDbvtBroadphase::~CcdDbvtBroadphase()
+{
+}
+
+bool CcdDbvtBroadphase::IsStaticProxy(short int collisionFilterGroup)
+{
+	return (collisionFilterGroup == btBroadphaseProxy::StaticFilter);
+}
+
+btBroadphaseProxy *CcdDbvtBroadphase::createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType, void *userPtr,
+                                                  short int collisionFilterGroup, short int collisionFilterMask, btDispatcher *dispatcher,
+                                                  void *multiSapProxy)
+{
+	if (!IsStaticProxy(collisionFilterGroup)) {
+		btDbvtProxy *proxy = (btDbvtProxy *)btDbvtBroadphase::createProxy(aabbMin, aabbMax, shapeType, userPtr, collisionFilterGroup,
+		                                                                  collisionFilterMask, dispatcher, multiSapProxy);
+		CcdDbvtPairCollider collider(this, proxy);
+		m_staticSet.collideTV(m_staticSet.m_root, proxy->leaf->volume, collider);
+		return proxy;
+	}
+
+	btDbvtProxy *proxy = new(btAlignedAlloc(sizeof(btDbvtProxy), 16)) btDbvtProxy(aabbMin, aabbMax, userPtr, collisionFilterGroup,
+	                                                                             collisionFilterMask);
+	const ATTRIBUTE_ALIGNED16(btDbvtVolume) aabb = btDbvtVolume::FromMM(aabbMin, aabbMax);
+	proxy->stage = STATIC_STAGE;
+	proxy->m_uniqueId = ++m_gid;
+	proxy->leaf = m_staticSet.insert(aabb, proxy);
+	++m_numNewStatic;
+
+	// The static proxies never collide together, only the two other sets are tested.
+	CcdDbvtPairCollider collider(this, proxy);
+	m_sets[0].collideTV(m_sets[0].m_root, aabb, collider);
+	m_sets[1].collideTV(m_sets[1].m_root, aabb, collider);
+
+	return proxy;
+}
+
+void CcdDbvtBroadphase::destroyProxy(btBroadphaseProxy *absproxy, btDispatcher *dispatcher)
+{
+	btDbvtProxy *proxy = (btDbvtProxy *)absproxy;
+	if (proxy->stage != STATIC_STAGE) {
+		btDbvtBroadphase::destroyProxy(proxy, dispatcher);
+		return;
+	}
+
+	m_staticSet.remove(proxy->leaf);
+	m_paircache->removeOverlappingPairsContainingProxy(proxy, dispatcher);
+	btAlignedFree(proxy);
+	m_needcleanup = true;
+}
+
+void CcdDbvtBroadphase::setAabb(btBroadphaseProxy *absproxy, const btVector3& aabbMin, const btVector3& aabbMax, btDispatcher *dispatcher)
+{
+	btDbvtProxy *proxy = (btDbvtProxy *)absproxy;
+	if (proxy->stage != STATIC_STAGE) {
+		const bool fixed = (proxy->stage == STAGECOUNT);
+		const ATTRIBUTE_ALIGNED16(btDbvtVolume) volume = proxy->leaf->volume;
+
+		btDbvtBroadphase::setAabb(proxy, aabbMin, aabbMax, dispatcher);
+
+		// Like in the base class the pairs are only searched when the tree volume changed.
+		if (fixed || NotEqual(volume, proxy->leaf->volume)) {
+			CcdDbvtPairCollider collider(this, proxy);
+			m_staticSet.collideTV(m_staticSet.m_root, proxy->leaf->volume, collider);
+		}
+		return;
+	}
+
+	// The bounding boxes of all the objects are updated every step, most static objects never move.
+	ATTRIBUTE_ALIGNED16(btDbvtVolume) aabb = btDbvtVolume::FromMM(aabbMin, aabbMax);
+	if (!NotEqual(aabb, proxy->leaf->volume)) {
+		return;
+	}
+
+	m_staticSet.update(proxy->leaf, aabb);
+	proxy->m_aabbMin = aabbMin;
+	proxy->m_aabbMax = aabbMax;
+	m_needcleanup = true;
+
+	CcdDbvtPairCollider collider(this, proxy);
+	m_sets[0].collideTV(m_sets[0].m_root, aabb, collider);
+	m_sets[1].collideTV(m_sets[1].m_root, aabb, collider);
+}
+
+void CcdDbvtBroadphase::rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback,
+                                const btVector3& aabbMin, const btVector3& aabbMax)
+{
+	btDbvtBroadphase::rayTest(rayFrom, rayTo, rayCallback, aabbMin, aabbMax);
+
+	CcdDbvtRayTester tester(rayCallback);
+	m_staticSet.rayTestInternal(m_staticSet.m_root, rayFrom, rayTo, rayCallback.m_rayDirectionInverse, rayCallback.m_signs,
+	                            rayCallback.m_lambda_max, aabbMin, aabbMax, tester);
+}
+
+void CcdDbvtBroadphase::aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback)
+{
+	btDbvtBroadphase::aabbTest(aabbMin, aabbMax, callback);
+
+	CcdDbvtAabbTester tester(callback);
+	const ATTRIBUTE_ALIGNED16(btDbvtVolume) bounds = btDbvtVolume::FromMM(aabbMin, aabbMax);
+	m_staticSet.collideTV(m_staticSet.m_root, bounds, tester);
+}
+
+void CcdDbvtBroadphase::calculateOverlappingPairs(btDispatcher *dispatcher)
+{
+	if (m_numNewStatic > 0) {
+		// A converted scene or a large merged chunk is rebuilt, smaller chunks refine the existing tree.
+		if (m_numNewStatic * 2 >= m_staticSet.m_leaves) {
+			m_staticSet.optimizeTopDown();
+		}
+		else {
+			m_staticSet.optimizeIncremental(m_numNewStatic);
+		}
+		m_numNewStatic = 0;
+	}
+
+	btDbvtBroadphase::calculateOverlappingPairs(dispatcher);
+}
+
+void CcdDbvtBroadphase::getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const
+{
+	btDbvtBroadphase::getBroadphaseAabb(aabbMin, aabbMax);
+
+	if (!m_staticSet.empty()) {
+		const btDbvtVolume& volume = m_staticSet.m_root->volume;
+		if (m_sets[0].empty() && m_sets[1].empty()) {
+			aabbMin = volume.Mins();
+			aabbMax = volume.Maxs();
+		}
+		else {
+			aabbMin.setMin(volume.Mins());
+			aabbMax.setMax(volume.Maxs());
+		}
+	}
+}
+
+CcdAxisSweep3::CcdAxisSweep3(const btVector3& worldAabbMin, const btVector3& worldAabbMax)
+	:btAxisSweep3(worldAabbMin, worldAabbMax, MaxHandles)
+{
+}
+
+CcdAxisSweep3::~CcdAxisSweep3()
+{
+}
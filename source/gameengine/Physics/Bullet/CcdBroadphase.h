@@ -0,0 +1,97 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CcdBroadphase.h
+ *  \ingroup physbullet
+ *
+ * Broadphases selectable per scene. The dynamic tree keeps the static objects in their own
+ * tree, the axis sweep suits bounded worlds with many objects moving at the same time.
+ */
+
+#ifndef __CCDBROADPHASE_H__
+#define __CCDBROADPHASE_H__
+
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+#include "BulletCollision/BroadphaseCollision/btAxisSweep3.h"
+
+enum CcdBroadphaseType
+{
+	CCD_BROADPHASE_DBVT = 0,
+	CCD_BROADPHASE_AXIS_SWEEP
+};
+
+/** Dynamic tree broadphase storing the proxies of the static objects in a separate tree.
+ * The static proxies are never tested against each other, their pairs are only searched
+ * against the other proxies when one of them is created or moved. The static tree is
+ * optimized before the next pair computation when proxies were inserted, it is rebuilt
+ * when the inserted proxies are the majority of the tree and refined incrementally else.
+ */
+class CcdDbvtBroadphase : public btDbvtBroadphase
+{
+public:
+	CcdDbvtBroadphase();
+	virtual ~CcdDbvtBroadphase();
+
+	virtual btBroadphaseProxy *createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType, void *userPtr,
+	                                       short int collisionFilterGroup, short int collisionFilterMask, btDispatcher *dispatcher,
+	                                       void *multiSapProxy);
+	virtual void destroyProxy(btBroadphaseProxy *proxy, btDispatcher *dispatcher);
+	virtual void setAabb(btBroadphaseProxy *proxy, const btVector3& aabbMin, const btVector3& aabbMax, btDispatcher *dispatcher);
+	virtual void rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback,
+	                     const btVector3& aabbMin = btVector3(0.0f, 0.0f, 0.0f), const btVector3& aabbMax = btVector3(0.0f, 0.0f, 0.0f));
+	virtual void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
+	virtual void calculateOverlappingPairs(btDispatcher *dispatcher);
+	virtual void getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax) const;
+
+	/// Tree of the static proxies, traversed directly by the batched ray tests like the sets.
+	btDbvt m_staticSet;
+
+private:
+	/// Stage of the static proxies, they are not part of the stage lists.
+	enum {
+		STATIC_STAGE = STAGECOUNT + 1
+	};
+
+	static bool IsStaticProxy(short int collisionFilterGroup);
+
+	/// Number of static proxies inserted since the last optimization of the static tree.
+	int m_numNewStatic;
+};
+
+/// 16 bits axis sweep broadphase giving access to its ray test tree.
+class CcdAxisSweep3 : public btAxisSweep3
+{
+public:
+	/// Maximum number of proxies, limited by the 16 bits handles.
+	static const unsigned short MaxHandles = 32766;
+
+	CcdAxisSweep3(const btVector3& worldAabbMin, const btVector3& worldAabbMax);
+	virtual ~CcdAxisSweep3();
+
+	/// Return the dynamic tree accelerating the ray tests.
+	btDbvtBroadphase *GetRaycastAccelerator() const
+	{
+		return m_raycastAccelerator;
+	}
+};
+
+#endif  // __CCDBROADPHASE_H__
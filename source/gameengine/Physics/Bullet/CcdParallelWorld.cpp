@@ -0,0 +1,526 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Physics/Bullet/CcdParallelWorld.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdParallelWorld.h"
+
+#include "BulletCollision/CollisionDispatch/btConvexConvexAlgorithm.h"
+#include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btPersistentManifold.h"
+#include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h"
+#include "BulletDynamics/ConstraintSolver/btTypedConstraint.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btQuickprof.h"
+
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+/// Convex-convex algorithm owning its simplex solver.
+ATTRIBUTE_ALIGNED16(class) CcdConvexConvexAlgorithm : public btConvexConvexAlgorithm
+{
+public:
+	CcdConvexConvexAlgorithm(const btCollisionAlgorithmConstructionInfo& ci, const btCollisionObjectWrapper *body0Wrap,
+	                         const btCollisionObjectWrapper *body1Wrap, const btConvexConvexAlgorithm::CreateFunc& func)
+		// Only the address of the simplex solver is used by the base constructor.
+		:btConvexConvexAlgorithm(ci.m_manifold, ci, body0Wrap, body1Wrap, &m_simplexSolver, func.m_pdSolver,
+		                         func.m_numPerturbationIterations, func.m_minimumPointsPerturbationThreshold)
+	{
+	}
+
+	class CreateFunc : public btCollisionAlgorithmCreateFunc
+	{
+	public:
+		/// The default create function is used for the solver and perturbation settings.
+		CreateFunc(btConvexConvexAlgorithm::CreateFunc *defaultFunc)
+			:m_defaultFunc(defaultFunc)
+		{
+		}
+
+		virtual btCollisionAlgorithm *CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+		                                                       const btCollisionObjectWrapper *body0Wrap,
+		                                                       const btCollisionObjectWrapper *body1Wrap)
+		{
+			void *mem = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof(CcdConvexConvexAlgorithm));
+			return new(mem) CcdConvexConvexAlgorithm(ci, body0Wrap, body1Wrap, *m_defaultFunc);
+		}
+
+	private:
+		btConvexConvexAlgorithm::CreateFunc *m_defaultFunc;
+	};
+
+private:
+	btVoronoiSimplexSolver m_simplexSolver;
+};
+
+static btDefaultCollisionConstructionInfo parallelConstructionInfo()
+{
+	btDefaultCollisionConstructionInfo info;
+	info.m_customCollisionAlgorithmMaxElementSize = sizeof(CcdConvexConvexAlgorithm);
+	return info;
+}
+
+CcdParallelCollisionConfiguration::CcdParallelCollisionConfiguration()
+	:btSoftBodyRigidBodyCollisionConfiguration(parallelConstructionInfo())
+{
+	void *mem = btAlignedAlloc(sizeof(CcdConvexConvexAlgorithm::CreateFunc), 16);
+	m_parallelConvexConvexCreateFunc = new(mem) CcdConvexConvexAlgorithm::CreateFunc(
+		static_cast<btConvexConvexAlgorithm::CreateFunc *>(m_convexConvexCreateFunc));
+}
+
+CcdParallelCollisionConfiguration::~CcdParallelCollisionConfiguration()
+{
+	m_parallelConvexConvexCreateFunc->~btCollisionAlgorithmCreateFunc();
+	btAlignedFree(m_parallelConvexConvexCreateFunc);
+}
+
+btCollisionAlgorithmCreateFunc *CcdParallelCollisionConfiguration::getCollisionAlgorithmCreateFunc(int proxyType0, int proxyType1)
+{
+	btCollisionAlgorithmCreateFunc *func = btSoftBodyRigidBodyCollisionConfiguration::getCollisionAlgorithmCreateFunc(proxyType0, proxyType1);
+	if (func == m_convexConvexCreateFunc) {
+		return m_parallelConvexConvexCreateFunc;
+	}
+	return func;
+}
+
+/// Minimum number of pairs processed by a dispatch task.
+static const int minPairsPerTask = 32;
+
+/// Pair processed by the current thread and number of manifolds it created.
+struct PairContext
+{
+	int m_pair;
+	int m_sequence;
+};
+static thread_local PairContext pairContext;
+
+CcdParallelDispatcher::CcdParallelDispatcher(btCollisionConfiguration *collisionConfiguration, TaskScheduler *scheduler)
+	:btCollisionDispatcher(collisionConfiguration),
+	m_scheduler(scheduler),
+	m_numTasks(BLI_task_scheduler_num_threads(scheduler)),
+	m_parallel(false),
+	m_manifoldsChanged(false),
+	m_manifoldStamp(0),
+	m_pairs(nullptr),
+	m_numPairs(0),
+	m_dispatchInfo(nullptr)
+{
+}
+
+CcdParallelDispatcher::~CcdParallelDispatcher()
+{
+}
+
+btPersistentManifold *CcdParallelDispatcher::getNewManifold(const btCollisionObject *b0, const btCollisionObject *b1)
+{
+	if (!m_parallel) {
+		btPersistentManifold *manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+		manifold->m_companionIdA = (int)m_manifoldStamp++;
+		m_manifoldsChanged = true;
+		return manifold;
+	}
+
+	m_lock.Lock();
+	btPersistentManifold *manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+	m_newManifolds.push_back({pairContext.m_pair, pairContext.m_sequence++, manifold});
+	m_manifoldsChanged = true;
+	m_lock.Unlock();
+
+	return manifold;
+}
+
+void CcdParallelDispatcher::releaseManifold(btPersistentManifold *manifold)
+{
+	if (!m_parallel) {
+		btCollisionDispatcher::releaseManifold(manifold);
+		m_manifoldsChanged = true;
+		return;
+	}
+
+	m_lock.Lock();
+	// The memory of the manifold can be reused by an other pair.
+	for (std::vector<NewManifold>::iterator it = m_newManifolds.begin(), end = m_newManifolds.end(); it != end; ++it) {
+		if (it->m_manifold == manifold) {
+			m_newManifolds.erase(it);
+			break;
+		}
+	}
+	btCollisionDispatcher::releaseManifold(manifold);
+	m_manifoldsChanged = true;
+	m_lock.Unlock();
+}
+
+void *CcdParallelDispatcher::allocateCollisionAlgorithm(int size)
+{
+	if (!m_parallel) {
+		return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+	}
+
+	m_lock.Lock();
+	void *mem = btCollisionDispatcher::allocateCollisionAlgorithm(size);
+	m_lock.Unlock();
+
+	return mem;
+}
+
+void CcdParallelDispatcher::freeCollisionAlgorithm(void *ptr)
+{
+	if (!m_parallel) {
+		btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+		return;
+	}
+
+	m_lock.Lock();
+	btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+	m_lock.Unlock();
+}
+
+bool CcdParallelDispatcher::IsSerialPair(const btBroadphasePair& pair)
+{
+	const btCollisionObject *colObj0 = (btCollisionObject *)pair.m_pProxy0->m_clientObject;
+	const btCollisionObject *colObj1 = (btCollisionObject *)pair.m_pProxy1->m_clientObject;
+
+	// Soft bodies store their contacts and GImpact shapes lock their mesh during the collision.
+	return (colObj0->getInternalType() == btCollisionObject::CO_SOFT_BODY ||
+	        colObj1->getInternalType() == btCollisionObject::CO_SOFT_BODY ||
+	        colObj0->getCollisionShape()->getShapeType() == GIMPACT_SHAPE_PROXYTYPE ||
+	        colObj1->getCollisionShape()->getShapeType() == GIMPACT_SHAPE_PROXYTYPE);
+}
+
+void CcdParallelDispatcher::DispatchTask(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+	CcdParallelDispatcher *dispatcher = (CcdParallelDispatcher *)BLI_task_pool_userdata(pool);
+	const int task = GET_INT_FROM_POINTER(taskdata);
+	const int start = (dispatcher->m_numPairs * task) / dispatcher->m_numTasks;
+	const int end = (dispatcher->m_numPairs * (task + 1)) / dispatcher->m_numTasks;
+
+	btNearCallback callback = dispatcher->getNearCallback();
+	for (int i = start; i < end; ++i) {
+		btBroadphasePair& pair = dispatcher->m_pairs[i];
+		if (!IsSerialPair(pair)) {
+			pairContext.m_pair = i;
+			pairContext.m_sequence = 0;
+			callback(pair, *dispatcher, *dispatcher->m_dispatchInfo);
+		}
+	}
+}
+
+void CcdParallelDispatcher::SortManifolds()
+{
+	std::sort(m_newManifolds.begin(), m_newManifolds.end());
+	for (const NewManifold& newManifold : m_newManifolds) {
+		newManifold.m_manifold->m_companionIdA = (int)m_manifoldStamp++;
+	}
+	m_newManifolds.clear();
+
+	if (!m_manifoldsChanged) {
+		return;
+	}
+
+	btPersistentManifold **manifolds = getInternalManifoldPointer();
+	const int numManifolds = getNumManifolds();
+	std::sort(manifolds, manifolds + numManifolds, [](btPersistentManifold *m1, btPersistentManifold *m2) {
+		return ((unsigned int)m1->m_companionIdA < (unsigned int)m2->m_companionIdA);
+	});
+	for (int i = 0; i < numManifolds; ++i) {
+		manifolds[i]->m_index1a = i;
+	}
+
+	m_manifoldsChanged = false;
+}
+
+void CcdParallelDispatcher::dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo& dispatchInfo, btDispatcher *dispatcher)
+{
+	const int numPairs = pairCache->getNumOverlappingPairs();
+
+	// The time of impact is shared between all the pairs in continuous mode.
+	if (numPairs < (m_numTasks * minPairsPerTask) || dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE) {
+		btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+		SortManifolds();
+		return;
+	}
+
+	m_pairs = pairCache->getOverlappingPairArrayPtr();
+	m_numPairs = numPairs;
+	m_dispatchInfo = &dispatchInfo;
+
+	m_parallel = true;
+
+	TaskPool *pool = BLI_task_pool_create(m_scheduler, this);
+	for (int i = 0; i < m_numTasks; ++i) {
+		BLI_task_pool_push(pool, DispatchTask, SET_INT_IN_POINTER(i), false, TASK_PRIORITY_HIGH);
+	}
+	BLI_task_pool_work_and_wait(pool);
+	BLI_task_pool_free(pool);
+
+	m_parallel = false;
+
+	// Stamp the new manifolds before the serial pairs create their own.
+	SortManifolds();
+
+	btNearCallback callback = getNearCallback();
+	for (int i = 0; i < numPairs; ++i) {
+		btBroadphasePair& pair = m_pairs[i];
+		if (IsSerialPair(pair)) {
+			callback(pair, *this, dispatchInfo);
+		}
+	}
+
+	SortManifolds();
+
+	m_pairs = nullptr;
+	m_numPairs = 0;
+	m_dispatchInfo = nullptr;
+}
+
+static int constraintIslandId(const btTypedConstraint *constraint)
+{
+	const btCollisionObject& colObj0 = constraint->getRigidBodyA();
+	const btCollisionObject& colObj1 = constraint->getRigidBodyB();
+	return (colObj0.getIslandTag() >= 0) ? colObj0.getIslandTag() : colObj1.getIslandTag();
+}
+
+/// Copy the islands given by the island manager into the arrays of the world.
+class CcdParallelDynamicsWorld::IslandCollector : public btSimulationIslandManager::IslandCallback
+{
+public:
+	IslandCollector(CcdParallelDynamicsWorld *world, btTypedConstraint **sortedConstraints, int numConstraints)
+		:m_world(world),
+		m_sortedConstraints(sortedConstraints),
+		m_numConstraints(numConstraints)
+	{
+	}
+
+	virtual void processIsland(btCollisionObject **bodies, int numBodies, btPersistentManifold **manifolds, int numManifolds, int islandId)
+	{
+		Group island;
+
+		island.m_firstBody = m_world->m_islandBodies.size();
+		island.m_numBodies = numBodies;
+		m_world->m_islandBodies.insert(m_world->m_islandBodies.end(), bodies, bodies + numBodies);
+
+		island.m_firstManifold = m_world->m_islandManifolds.size();
+		island.m_numManifolds = numManifolds;
+		m_world->m_islandManifolds.insert(m_world->m_islandManifolds.end(), manifolds, manifolds + numManifolds);
+
+		// The constraints are sorted by island.
+		btTypedConstraint **end = m_sortedConstraints + m_numConstraints;
+		btTypedConstraint **first = std::lower_bound(m_sortedConstraints, end, islandId,
+			[](btTypedConstraint *constraint, int id) { return constraintIslandId(constraint) < id; });
+		btTypedConstraint **last = first;
+		while (last != end && constraintIslandId(*last) == islandId) {
+			++last;
+		}
+
+		island.m_firstConstraint = m_world->m_islandConstraints.size();
+		island.m_numConstraints = last - first;
+		m_world->m_islandConstraints.insert(m_world->m_islandConstraints.end(), first, last);
+
+		m_world->m_islands.push_back(island);
+	}
+
+private:
+	CcdParallelDynamicsWorld *m_world;
+	btTypedConstraint **m_sortedConstraints;
+	int m_numConstraints;
+};
+
+CcdParallelDynamicsWorld::CcdParallelDynamicsWorld(btDispatcher *dispatcher, btBroadphaseInterface *pairCache,
+                                                   btConstraintSolver *constraintSolver, btCollisionConfiguration *collisionConfiguration,
+                                                   TaskScheduler *scheduler)
+	:btSoftRigidDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration),
+	m_scheduler(scheduler),
+	m_solverInfo(nullptr)
+{
+	m_solvers.resize(BLI_task_scheduler_num_threads(scheduler));
+	for (btSequentialImpulseConstraintSolver *&solver : m_solvers) {
+		solver = new btSequentialImpulseConstraintSolver();
+	}
+}
+
+CcdParallelDynamicsWorld::~CcdParallelDynamicsWorld()
+{
+	for (btSequentialImpulseConstraintSolver *solver : m_solvers) {
+		delete solver;
+	}
+}
+
+static int findIsland(std::vector<int>& parents, int island)
+{
+	while (parents[island] != island) {
+		parents[island] = parents[parents[island]];
+		island = parents[island];
+	}
+	return island;
+}
+
+/// Merge the island with the first island using the object if the solver writes in the object.
+static void uniteSharedObject(std::map<const btCollisionObject *, int>& sharedObjects, std::vector<int>& parents,
+                              const btCollisionObject *object, int island)
+{
+	const btRigidBody *body = btRigidBody::upcast(object);
+	if (!body || !body->isKinematicObject()) {
+		return;
+	}
+
+	std::pair<std::map<const btCollisionObject *, int>::iterator, bool> it = sharedObjects.insert({object, island});
+	if (it.second) {
+		return;
+	}
+
+	const int root0 = findIsland(parents, it.first->second);
+	const int root1 = findIsland(parents, island);
+	// Keep the lowest island as root to order the groups by their first island.
+	parents[std::max(root0, root1)] = std::min(root0, root1);
+}
+
+void CcdParallelDynamicsWorld::BuildBatches(const btContactSolverInfo& solverInfo)
+{
+	const int numIslands = m_islands.size();
+
+	std::vector<int> parents(numIslands);
+	std::iota(parents.begin(), parents.end(), 0);
+	std::map<const btCollisionObject *, int> sharedObjects;
+
+	for (int i = 0; i < numIslands; ++i) {
+		const Group& island = m_islands[i];
+		for (int j = island.m_firstManifold, end = j + island.m_numManifolds; j < end; ++j) {
+			uniteSharedObject(sharedObjects, parents, m_islandManifolds[j]->getBody0(), i);
+			uniteSharedObject(sharedObjects, parents, m_islandManifolds[j]->getBody1(), i);
+		}
+		for (int j = island.m_firstConstraint, end = j + island.m_numConstraints; j < end; ++j) {
+			uniteSharedObject(sharedObjects, parents, &m_islandConstraints[j]->getRigidBodyA(), i);
+			uniteSharedObject(sharedObjects, parents, &m_islandConstraints[j]->getRigidBodyB(), i);
+		}
+	}
+
+	// Order the islands by group, the islands of a group are consecutive.
+	std::vector<int> order(numIslands);
+	std::vector<int> roots(numIslands);
+	for (int i = 0; i < numIslands; ++i) {
+		order[i] = i;
+		roots[i] = findIsland(parents, i);
+	}
+	std::stable_sort(order.begin(), order.end(), [&roots](int i1, int i2) { return roots[i1] < roots[i2]; });
+
+	m_batches.clear();
+	m_batchBodies.clear();
+	m_batchManifolds.clear();
+	m_batchConstraints.clear();
+
+	Group batch = {0, 0, 0, 0, 0, 0};
+	for (int i = 0; i < numIslands; ++i) {
+		const Group& island = m_islands[order[i]];
+
+		m_batchBodies.insert(m_batchBodies.end(), m_islandBodies.begin() + island.m_firstBody,
+		                     m_islandBodies.begin() + island.m_firstBody + island.m_numBodies);
+		m_batchManifolds.insert(m_batchManifolds.end(), m_islandManifolds.begin() + island.m_firstManifold,
+		                        m_islandManifolds.begin() + island.m_firstManifold + island.m_numManifolds);
+		m_batchConstraints.insert(m_batchConstraints.end(), m_islandConstraints.begin() + island.m_firstConstraint,
+		                          m_islandConstraints.begin() + island.m_firstConstraint + island.m_numConstraints);
+		batch.m_numBodies += island.m_numBodies;
+		batch.m_numManifolds += island.m_numManifolds;
+		batch.m_numConstraints += island.m_numConstraints;
+
+		// Like the default island callback small islands are solved together, but a group is never split.
+		const bool endGroup = (i == (numIslands - 1) || roots[order[i + 1]] != roots[order[i]]);
+		if (endGroup && (i == (numIslands - 1) || (batch.m_numManifolds + batch.m_numConstraints) > solverInfo.m_minimumSolverBatchSize)) {
+			m_batches.push_back(batch);
+			batch.m_firstBody = m_batchBodies.size();
+			batch.m_firstManifold = m_batchManifolds.size();
+			batch.m_firstConstraint = m_batchConstraints.size();
+			batch.m_numBodies = batch.m_numManifolds = batch.m_numConstraints = 0;
+		}
+	}
+}
+
+void CcdParallelDynamicsWorld::SolveBatch(const Group& batch, btSequentialImpulseConstraintSolver *solver)
+{
+	// The result of the batch doesn't depend on the previous batches solved by the same solver.
+	solver->setRandSeed(0);
+	solver->solveGroup(batch.m_numBodies ? &m_batchBodies[batch.m_firstBody] : nullptr, batch.m_numBodies,
+	                   batch.m_numManifolds ? &m_batchManifolds[batch.m_firstManifold] : nullptr, batch.m_numManifolds,
+	                   batch.m_numConstraints ? &m_batchConstraints[batch.m_firstConstraint] : nullptr, batch.m_numConstraints,
+	                   *m_solverInfo, nullptr, m_dispatcher1);
+}
+
+void CcdParallelDynamicsWorld::SolveTask(TaskPool *__restrict pool, void *taskdata, int threadid)
+{
+	CcdParallelDynamicsWorld *world = (CcdParallelDynamicsWorld *)BLI_task_pool_userdata(pool);
+	world->SolveBatch(world->m_batches[GET_INT_FROM_POINTER(taskdata)], world->m_solvers[threadid]);
+}
+
+void CcdParallelDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo)
+{
+	if (!m_islandManager->getSplitIslands()) {
+		btSoftRigidDynamicsWorld::solveConstraints(solverInfo);
+		return;
+	}
+
+	BT_PROFILE("solveConstraints");
+
+	const int numConstraints = getNumConstraints();
+	m_sortedConstraints.resize(numConstraints);
+	for (int i = 0; i < numConstraints; ++i) {
+		m_sortedConstraints[i] = m_constraints[i];
+	}
+	btTypedConstraint **constraints = numConstraints ? &m_sortedConstraints[0] : nullptr;
+	std::stable_sort(constraints, constraints + numConstraints, [](btTypedConstraint *c1, btTypedConstraint *c2) {
+		return constraintIslandId(c1) < constraintIslandId(c2);
+	});
+
+	m_islands.clear();
+	m_islandBodies.clear();
+	m_islandManifolds.clear();
+	m_islandConstraints.clear();
+
+	IslandCollector collector(this, constraints, numConstraints);
+	m_constraintSolver->prepareSolve(getCollisionWorld()->getNumCollisionObjects(), getCollisionWorld()->getDispatcher()->getNumManifolds());
+	m_islandManager->buildAndProcessIslands(getCollisionWorld()->getDispatcher(), getCollisionWorld(), &collector);
+
+	BuildBatches(solverInfo);
+
+	m_solverInfo = &solverInfo;
+
+	const int numBatches = m_batches.size();
+	if (numBatches == 1) {
+		SolveBatch(m_batches[0], m_solvers[0]);
+	}
+	else if (numBatches > 1) {
+		TaskPool *pool = BLI_task_pool_create(m_scheduler, this);
+		for (int i = 0; i < numBatches; ++i) {
+			BLI_task_pool_push(pool, SolveTask, SET_INT_IN_POINTER(i), false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+
+	m_constraintSolver->allSolved(solverInfo, m_debugDrawer);
+}
@@ -0,0 +1,175 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CcdParallelWorld.h
+ *  \ingroup physbullet
+ *
+ * Multithreaded collision dispatch and island solving running on a BLI_task scheduler.
+ * The bundled Bullet doesn't provide a task scheduler interface, the parallel parts are
+ * implemented by overriding the dispatcher and the dynamics world.
+ * The results only depend on the scene, not on the scheduling of the tasks.
+ */
+
+#ifndef __CCDPARALLELWORLD_H__
+#define __CCDPARALLELWORLD_H__
+
+#include "BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h"
+#include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
+
+#include "CM_Thread.h"
+
+#include <vector>
+
+struct TaskScheduler;
+struct TaskPool;
+class btSequentialImpulseConstraintSolver;
+
+/** Collision configuration giving an own simplex solver to every convex-convex algorithm,
+ * the default configuration shares one solver between all the algorithms.
+ */
+class CcdParallelCollisionConfiguration : public btSoftBodyRigidBodyCollisionConfiguration
+{
+public:
+	CcdParallelCollisionConfiguration();
+	virtual ~CcdParallelCollisionConfiguration();
+
+	virtual btCollisionAlgorithmCreateFunc *getCollisionAlgorithmCreateFunc(int proxyType0, int proxyType1);
+
+private:
+	btCollisionAlgorithmCreateFunc *m_parallelConvexConvexCreateFunc;
+};
+
+/** Collision dispatcher processing the overlapping pairs in parallel.
+ * Pairs using soft bodies or GImpact shapes modify shared data and are processed serially.
+ * The manifolds are stamped in creation order and the manifold array is kept sorted on
+ * these stamps, making the order of the contacts given to the solver deterministic.
+ */
+class CcdParallelDispatcher : public btCollisionDispatcher
+{
+public:
+	CcdParallelDispatcher(btCollisionConfiguration *collisionConfiguration, TaskScheduler *scheduler);
+	virtual ~CcdParallelDispatcher();
+
+	virtual btPersistentManifold *getNewManifold(const btCollisionObject *b0, const btCollisionObject *b1);
+	virtual void releaseManifold(btPersistentManifold *manifold);
+
+	virtual void *allocateCollisionAlgorithm(int size);
+	virtual void freeCollisionAlgorithm(void *ptr);
+
+	virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo& dispatchInfo, btDispatcher *dispatcher);
+
+private:
+	struct NewManifold
+	{
+		int m_pair;
+		int m_sequence;
+		btPersistentManifold *m_manifold;
+
+		bool operator<(const NewManifold& other) const
+		{
+			return (m_pair < other.m_pair) || (m_pair == other.m_pair && m_sequence < other.m_sequence);
+		}
+	};
+
+	static void DispatchTask(TaskPool *__restrict pool, void *taskdata, int threadid);
+
+	/// Return true if the pair must not be processed concurrently with other pairs.
+	static bool IsSerialPair(const btBroadphasePair& pair);
+
+	/// Stamp the manifolds created during the parallel dispatch and sort the manifold array.
+	void SortManifolds();
+
+	TaskScheduler *m_scheduler;
+	int m_numTasks;
+
+	CM_ThreadSpinLock m_lock;
+	/// True while the pairs are processed by the tasks.
+	bool m_parallel;
+	/// True when manifolds were added or removed since the last sort.
+	bool m_manifoldsChanged;
+	/// Creation stamp of the next manifold.
+	unsigned int m_manifoldStamp;
+	/// Manifolds created during the parallel dispatch, stamped once all the tasks finished.
+	std::vector<NewManifold> m_newManifolds;
+
+	/// Data of the current parallel dispatch.
+	btBroadphasePair *m_pairs;
+	int m_numPairs;
+	const btDispatcherInfo *m_dispatchInfo;
+};
+
+/** Dynamics world solving the simulation islands in parallel.
+ * Islands touching the same kinematic object are solved in the same batch because
+ * the solver stores temporary data in the objects. Each batch is solved with the
+ * solver of the running thread and a reset random seed.
+ */
+class CcdParallelDynamicsWorld : public btSoftRigidDynamicsWorld
+{
+public:
+	CcdParallelDynamicsWorld(btDispatcher *dispatcher, btBroadphaseInterface *pairCache, btConstraintSolver *constraintSolver,
+	                         btCollisionConfiguration *collisionConfiguration, TaskScheduler *scheduler);
+	virtual ~CcdParallelDynamicsWorld();
+
+protected:
+	virtual void solveConstraints(btContactSolverInfo& solverInfo);
+
+private:
+	class IslandCollector;
+
+	/// Ranges of the bodies, manifolds and constraints of an island or a batch.
+	struct Group
+	{
+		int m_firstBody;
+		int m_numBodies;
+		int m_firstManifold;
+		int m_numManifolds;
+		int m_firstConstraint;
+		int m_numConstraints;
+	};
+
+	static void SolveTask(TaskPool *__restrict pool, void *taskdata, int threadid);
+
+	/// Merge the islands sharing a kinematic object and group them in batches.
+	void BuildBatches(const btContactSolverInfo& solverInfo);
+	void SolveBatch(const Group& batch, btSequentialImpulseConstraintSolver *solver);
+
+	TaskScheduler *m_scheduler;
+	/// One solver per thread of the scheduler.
+	std::vector<btSequentialImpulseConstraintSolver *> m_solvers;
+
+	/// Islands collected from the island manager, referencing the following arrays.
+	std::vector<Group> m_islands;
+	std::vector<btCollisionObject *> m_islandBodies;
+	std::vector<btPersistentManifold *> m_islandManifolds;
+	std::vector<btTypedConstraint *> m_islandConstraints;
+
+	/// Batches of islands solved together, referencing the following arrays.
+	std::vector<Group> m_batches;
+	std::vector<btCollisionObject *> m_batchBodies;
+	std::vector<btPersistentManifold *> m_batchManifolds;
+	std::vector<btTypedConstraint *> m_batchConstraints;
+
+	btContactSolverInfo *m_solverInfo;
+};
+
+#endif  // __CCDPARALLELWORLD_H__
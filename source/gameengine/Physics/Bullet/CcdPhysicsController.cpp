@@ -27,9 +27,11 @@
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
 #include "BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h"
 #include "BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h"
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
 
 #include "PHY_IMotionState.h"
 #include "CcdPhysicsEnvironment.h"
+#include "CcdShapeCache.h"
 
 #include "RAS_DisplayArray.h"
 #include "RAS_MeshObject.h"
@@ -156,6 +158,34 @@ void BlenderBulletCharacterController::SetVelocity(const MT_Vector3& vel, float
 	SetVelocity(ToBullet(vel), time, local);
 }
 
+void BlenderBulletCharacterController::SaveState(State& state) const
+{
+	state.m_walkDirection = m_walkDirection;
+	state.m_normalizedDirection = m_normalizedDirection;
+	state.m_verticalVelocity = m_verticalVelocity;
+	state.m_verticalOffset = m_verticalOffset;
+	state.m_velocityTimeInterval = m_velocityTimeInterval;
+	state.m_wasOnGround = m_wasOnGround;
+	state.m_wasJumping = m_wasJumping;
+	state.m_useWalkDirection = m_useWalkDirection;
+	state.m_jumps = m_jumps;
+}
+
+void BlenderBulletCharacterController::RestoreState(const State& state)
+{
+	m_walkDirection = state.m_walkDirection;
+	m_normalizedDirection = state.m_normalizedDirection;
+	m_verticalVelocity = state.m_verticalVelocity;
+	m_verticalOffset = state.m_verticalOffset;
+	m_velocityTimeInterval = state.m_velocityTimeInterval;
+	m_wasOnGround = state.m_wasOnGround;
+	m_wasJumping = state.m_wasJumping;
+	m_useWalkDirection = state.m_useWalkDirection;
+	m_jumps = state.m_jumps;
+
+	m_motionState->setWorldTransform(getGhostObject()->getWorldTransform());
+}
+
 void BlenderBulletCharacterController::Reset()
 {
 	btCollisionWorld *world = m_ctrl->GetPhysicsEnvironment()->GetDynamicsWorld();
@@ -206,6 +236,10 @@ CcdPhysicsController::CcdPhysicsController(const CcdConstructionInfo& ci)
 	m_savedMass = 0.0f;
 	m_savedDyna = false;
 	m_suspended = false;
+	m_activeIndex = -1;
+	ClearPendingCommands();
+	m_lodOriginalShapeInfo = nullptr;
+	m_lodSleep = false;
 
 	CreateRigidbody();
 }
@@ -243,10 +277,16 @@ btTransform CcdPhysicsController::GetTransformFromMotionState(PHY_IMotionState *
 class BlenderBulletMotionState : public btMotionState
 {
 	PHY_IMotionState *m_blenderMotionState;
+	CcdPhysicsController *m_controller;
+	btTransform m_pendingTransform;
 
 public:
-	BlenderBulletMotionState(PHY_IMotionState *bms)
-		:m_blenderMotionState(bms)
+	BT_DECLARE_ALIGNED_ALLOCATOR();
+
+	BlenderBulletMotionState(PHY_IMotionState *bms, CcdPhysicsController *controller)
+		:m_blenderMotionState(bms),
+		m_controller(controller),
+		m_pendingTransform(btTransform::getIdentity())
 	{
 	}
 
@@ -259,13 +299,81 @@ public:
 	}
 
 	void setWorldTransform(const btTransform& worldTrans)
+	{
+		CcdPhysicsEnvironment *env = m_controller->GetPhysicsEnvironment();
+		if (env && env->IsStepRunning()) {
+			// The game objects are rendered during an asynchronous step, keep the transform until the step is published.
+			m_pendingTransform = worldTrans;
+			env->AddPendingMotionState(m_controller);
+			return;
+		}
+
+		ApplyTransform(worldTrans);
+	}
+
+	/// Apply the transform deferred during an asynchronous step.
+	void PublishTransform()
+	{
+		ApplyTransform(m_pendingTransform);
+	}
+
+private:
+	void ApplyTransform(const btTransform& worldTrans)
 	{
 		m_blenderMotionState->SetWorldPosition(ToMoto(worldTrans.getOrigin()));
 		m_blenderMotionState->SetWorldOrientation(ToMoto(worldTrans.getRotation()));
 		m_blenderMotionState->CalculateWorldTransformations();
+
+		/* Bullet only synchronizes the active bodies, this is the notification
+		 * of the bodies moved by the simulation (including the woken ones). */
+		CcdPhysicsEnvironment *env = m_controller->GetPhysicsEnvironment();
+		if (env) {
+			env->AddActiveController(m_controller);
+		}
 	}
 };
 
+void CcdPhysicsController::PublishMotionState()
+{
+	static_cast<BlenderBulletMotionState *>(m_bulletMotionState)->PublishTransform();
+}
+
+void CcdPhysicsController::AddPendingCommand(PendingCommand command, const MT_Vector3& value)
+{
+	m_pendingCommands |= command;
+	if (command == PENDING_FORCE) {
+		m_pendingForce += value;
+	}
+	else if (command == PENDING_TORQUE) {
+		m_pendingTorque += value;
+	}
+}
+
+void CcdPhysicsController::ClearPendingCommands()
+{
+	m_pendingCommands = 0;
+	m_pendingForce.setValue(0.0f, 0.0f, 0.0f);
+	m_pendingTorque.setValue(0.0f, 0.0f, 0.0f);
+}
+
+void CcdPhysicsController::PublishPendingCommands()
+{
+	const int commands = m_pendingCommands;
+	const MT_Vector3 force = m_pendingForce;
+	const MT_Vector3 torque = m_pendingTorque;
+	ClearPendingCommands();
+
+	if (commands & PENDING_TRANSFORM) {
+		SetTransform();
+	}
+	if (commands & PENDING_FORCE) {
+		ApplyForce(force, false);
+	}
+	if (commands & PENDING_TORQUE) {
+		ApplyTorque(torque, false);
+	}
+}
+
 btRigidBody *CcdPhysicsController::GetRigidBody()
 {
 	return btRigidBody::upcast(m_object);
@@ -553,7 +661,7 @@ bool CcdPhysicsController::CreateCharacterController()
 void CcdPhysicsController::CreateRigidbody()
 {
 	//btTransform trans = GetTransformFromMotionState(m_MotionState);
-	m_bulletMotionState = new BlenderBulletMotionState(m_MotionState);
+	m_bulletMotionState = new BlenderBulletMotionState(m_MotionState, this);
 
 	///either create a btCollisionObject, btRigidBody or btSoftBody
 	if (CreateSoftbody() || CreateCharacterController())
@@ -696,6 +804,7 @@ CcdPhysicsController::~CcdPhysicsController()
 
 	DeleteControllerShape();
 
+	ReleaseLodShapes();
 	if (m_shapeInfo) {
 		m_shapeInfo->Release();
 	}
@@ -730,6 +839,16 @@ void CcdPhysicsController::SimulationTick(float timestep)
 	}
 }
 
+bool CcdPhysicsController::IsSimulationActive()
+{
+	if (GetSoftBody()) {
+		return true;
+	}
+
+	btRigidBody *body = GetRigidBody();
+	return (body && !body->isStaticObject() && body->isActive());
+}
+
 /**
  * SynchronizeMotionStates ynchronizes dynas, kinematic and deformable entities (and do 'late binding')
  */
@@ -794,11 +913,21 @@ void CcdPhysicsController::PostProcessReplica(class PHY_IMotionState *motionstat
 	m_softBodyTransformInitialized = false;
 	m_MotionState = motionstate;
 	m_registerCount = 0;
+	m_activeIndex = -1;
+	ClearPendingCommands();
 	m_collisionShape = nullptr;
 
 	// Clear all old constraints.
 	m_ccdConstraintRefs.clear();
 
+	// The level of detail shapes are shared with the original controller.
+	for (const auto& pair : m_lodShapeInfos) {
+		pair.second->AddRef();
+	}
+	if (m_lodOriginalShapeInfo) {
+		m_lodOriginalShapeInfo->AddRef();
+	}
+
 	// always create a new shape to avoid scaling bug
 	if (m_shapeInfo) {
 		m_shapeInfo->AddRef();
@@ -1096,10 +1225,25 @@ void CcdPhysicsController::SetScaling(const MT_Vector3& scale)
 
 void CcdPhysicsController::SetTransform()
 {
+	/* The world is stepped concurrently, e.g. the animations updated during the rendering
+	 * move the objects, the transform is given to the body once the step is complete. */
+	if (m_cci.m_physicsEnv && m_cci.m_physicsEnv->IsStepRunning()) {
+		m_cci.m_physicsEnv->AddPendingCommand(this, PENDING_TRANSFORM);
+		return;
+	}
+
 	const MT_Vector3 pos = m_MotionState->GetWorldPosition();
 	const MT_Matrix3x3 rot = m_MotionState->GetWorldOrientation();
 	ForceWorldTransform(ToBullet(rot), ToBullet(pos));
 
+	/* The scaling of the non-dynamic objects (e.g. parented) is only updated here,
+	 * they are not synchronized after each simulation step. */
+	btCollisionShape *shape = GetCollisionShape();
+	const btVector3 scale = ToBullet(m_MotionState->GetWorldScaling());
+	if (shape && !(shape->getLocalScaling() - scale).fuzzyZero()) {
+		shape->setLocalScaling(scale);
+	}
+
 	if (!IsDynamic() && !GetConstructionInfo().m_bSensor && !GetCharacterController()) {
 		btCollisionObject *object = GetRigidBody();
 		object->setActivationState(ACTIVE_TAG);
@@ -1136,6 +1280,13 @@ void CcdPhysicsController::SetMass(MT_Scalar newmass)
 // physics methods
 void CcdPhysicsController::ApplyTorque(const MT_Vector3&  torquein, bool local)
 {
+	// The torques of the animations played as force during an asynchronous step are applied after the step.
+	if (m_cci.m_physicsEnv && m_cci.m_physicsEnv->IsStepRunning()) {
+		m_cci.m_physicsEnv->AddPendingCommand(this, PENDING_TORQUE,
+		                                      (local) ? m_MotionState->GetWorldOrientation() * torquein : torquein);
+		return;
+	}
+
 	btVector3 torque = ToBullet(torquein);
 	btTransform xform = m_object->getWorldTransform();
 
@@ -1170,6 +1321,13 @@ void CcdPhysicsController::ApplyTorque(const MT_Vector3&  torquein, bool local)
 
 void CcdPhysicsController::ApplyForce(const MT_Vector3& forcein, bool local)
 {
+	// The forces of the animations played as force during an asynchronous step are applied after the step.
+	if (m_cci.m_physicsEnv && m_cci.m_physicsEnv->IsStepRunning()) {
+		m_cci.m_physicsEnv->AddPendingCommand(this, PENDING_FORCE,
+		                                      (local) ? m_MotionState->GetWorldOrientation() * forcein : forcein);
+		return;
+	}
+
 	btVector3 force = ToBullet(forcein);
 
 	if (m_object && force.length2() > (SIMD_EPSILON * SIMD_EPSILON)) {
@@ -1626,6 +1784,9 @@ bool CcdPhysicsController::ReinstancePhysicsShape(KX_GameObject *from_gameobj, R
 	if (m_shapeInfo->m_shapeType != PHY_SHAPE_MESH)
 		return false;
 
+	// The original shape is updated, the level of detail shapes are obsolete.
+	ReleaseLodShapes();
+
 	if (!from_gameobj && !from_meshobj)
 		from_gameobj = KX_GameObject::GetClientObject((KX_ClientObjectInfo *)GetNewClientInfo());
 
@@ -1648,6 +1809,8 @@ void CcdPhysicsController::ReplacePhysicsShape(PHY_IPhysicsController *phyctrl)
 {
 	CcdShapeConstructionInfo *shapeInfo = ((CcdPhysicsController *)phyctrl)->GetShapeInfo();
 
+	ReleaseLodShapes();
+
 	// switch shape info
 	m_shapeInfo->Release();
 	m_shapeInfo = shapeInfo->AddRef();
@@ -1658,6 +1821,115 @@ void CcdPhysicsController::ReplacePhysicsShape(PHY_IPhysicsController *phyctrl)
 	GetPhysicsEnvironment()->RefreshCcdPhysicsController(this);
 }
 
+CcdShapeConstructionInfo *CcdPhysicsController::GetLodShapeInfo(RAS_MeshObject *meshobj)
+{
+	std::map<RAS_MeshObject *, CcdShapeConstructionInfo *>::const_iterator it = m_lodShapeInfos.find(meshobj);
+	if (it != m_lodShapeInfos.end()) {
+		return it->second;
+	}
+
+	CcdShapeConstructionInfo *originalShapeInfo = m_lodOriginalShapeInfo ? m_lodOriginalShapeInfo : m_shapeInfo;
+	const bool polytope = (originalShapeInfo->m_shapeType == PHY_SHAPE_POLYTOPE);
+
+	// Triangle mesh shapes are shared with the other objects using the mesh, including their BVH.
+	CcdShapeConstructionInfo *shapeInfo = CcdShapeConstructionInfo::FindMesh(meshobj, nullptr, polytope);
+	if (shapeInfo) {
+		shapeInfo->AddRef();
+	}
+	else {
+		shapeInfo = new CcdShapeConstructionInfo();
+		if (!shapeInfo->SetMesh(meshobj, nullptr, polytope)) {
+			shapeInfo->Release();
+			return nullptr;
+		}
+		shapeInfo->SetShapeCache(originalShapeInfo->GetShapeCache());
+	}
+
+	m_lodShapeInfos[meshobj] = shapeInfo;
+
+	return shapeInfo;
+}
+
+void CcdPhysicsController::ReleaseLodShapes()
+{
+	if (m_lodOriginalShapeInfo) {
+		m_shapeInfo->Release();
+		m_shapeInfo = m_lodOriginalShapeInfo;
+		m_lodOriginalShapeInfo = nullptr;
+	}
+
+	for (const auto& pair : m_lodShapeInfos) {
+		pair.second->Release();
+	}
+	m_lodShapeInfos.clear();
+}
+
+bool CcdPhysicsController::SetLodMesh(RAS_MeshObject *meshobj)
+{
+	CcdShapeConstructionInfo *originalShapeInfo = m_lodOriginalShapeInfo ? m_lodOriginalShapeInfo : m_shapeInfo;
+	// Only the shapes built from a mesh are simplified, soft bodies are bound to their mesh.
+	if (m_cci.m_bSoft || !originalShapeInfo || !ELEM(originalShapeInfo->m_shapeType, PHY_SHAPE_MESH, PHY_SHAPE_POLYTOPE)) {
+		return false;
+	}
+
+	CcdShapeConstructionInfo *shapeInfo = originalShapeInfo;
+	if (meshobj && meshobj != originalShapeInfo->GetMesh()) {
+		shapeInfo = GetLodShapeInfo(meshobj);
+		if (!shapeInfo) {
+			return false;
+		}
+	}
+
+	if (shapeInfo == m_shapeInfo) {
+		return true;
+	}
+
+	// The controller keeps a reference on the original shape info as long as it uses an other shape.
+	if (shapeInfo == originalShapeInfo) {
+		m_shapeInfo->Release();
+		m_shapeInfo = m_lodOriginalShapeInfo;
+		m_lodOriginalShapeInfo = nullptr;
+	}
+	else {
+		if (!m_lodOriginalShapeInfo) {
+			m_lodOriginalShapeInfo = m_shapeInfo;
+		}
+		else {
+			m_shapeInfo->Release();
+		}
+		m_shapeInfo = shapeInfo->AddRef();
+	}
+
+	/* Recreate the Bullet shape, the mass properties are kept to not change the
+	 * dynamics of the object with the distance. */
+	ReplaceControllerShape(nullptr);
+	m_collisionShape->setLocalScaling(m_cci.m_scaling);
+	// refresh to remove collision pair
+	GetPhysicsEnvironment()->RefreshCcdPhysicsController(this);
+
+	return true;
+}
+
+void CcdPhysicsController::SetLodSleep(bool sleep)
+{
+	btRigidBody *body = GetRigidBody();
+	if (!body || body->isStaticOrKinematicObject() || sleep == m_lodSleep) {
+		return;
+	}
+
+	if (sleep) {
+		// Bodies that must never sleep and bodies already sleeping are left unchanged.
+		if (body->isActive() && body->getActivationState() != DISABLE_DEACTIVATION) {
+			body->setActivationState(ISLAND_SLEEPING);
+			m_lodSleep = true;
+		}
+	}
+	else {
+		body->activate(true);
+		m_lodSleep = false;
+	}
+}
+
 void CcdPhysicsController::ReplicateConstraints(KX_GameObject *replica, std::vector<KX_GameObject *> constobj)
 {
 	if (replica->GetConstraints().size() == 0 || !replica->GetPhysicsController())
@@ -1759,6 +2031,9 @@ void CcdShapeConstructionInfo::ProcessReplica()
 	m_triangleIndexVertexArray = nullptr;
 	m_forceReInstance = false;
 	m_shapeProxy = nullptr;
+	// The replica mesh is modified, don't share the BVH and don't cache it.
+	m_shapeCache = nullptr;
+	m_optimizedBvh = nullptr;
 	m_vertexArray.clear();
 	m_polygonIndexArray.clear();
 	m_triFaceArray.clear();
@@ -2105,14 +2380,15 @@ bool CcdShapeConstructionInfo::UpdateMesh(class KX_GameObject *gameobj, class RA
 	RAS_Deformer *deformer = gameobj ? gameobj->GetDeformer() : nullptr;
 	DerivedMesh *dm = nullptr;
 
-	if (deformer)
-		dm = deformer->GetPhysicsMesh();
-
 	// get the mesh from the object if not defined
 	if (!meshobj) {
 		// modifier mesh
-		if (dm)
-			meshobj = deformer->GetRasMesh();
+		if (deformer) {
+			dm = deformer->GetPhysicsMesh();
+			if (dm) {
+				meshobj = deformer->GetRasMesh();
+			}
+		}
 
 		// game object first mesh
 		if (!meshobj) {
@@ -2121,6 +2397,11 @@ bool CcdShapeConstructionInfo::UpdateMesh(class KX_GameObject *gameobj, class RA
 			}
 		}
 	}
+	/* The physics mesh is owned by the deformer, it's only requested for the deformer mesh
+	 * and not e.g for the meshes of the physics levels of detail. */
+	else if (deformer && deformer->GetRasMesh() == meshobj) {
+		dm = deformer->GetPhysicsMesh();
+	}
 
 	if (dm && deformer->GetRasMesh() == meshobj) {
 		/*
@@ -2395,10 +2676,6 @@ bool CcdShapeConstructionInfo::UpdateMesh(class KX_GameObject *gameobj, class RA
 
 	m_meshObject = meshobj;
 
-	if (dm) {
-		dm->needsFree = 1;
-		dm->release(dm);
-	}
 	return true;
 }
 
@@ -2477,6 +2754,7 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin, b
 					    &m_vertexArray[0],
 					    3 * sizeof(btScalar));
 					m_forceReInstance = false;
+					FreeOptimizedBvh();
 				}
 
 				btGImpactMeshShape *gimpactShape = new btGImpactMeshShape(m_triangleIndexVertexArray);
@@ -2517,9 +2795,15 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin, b
 					}
 
 					m_forceReInstance = false;
+					// The BVH of the previous mesh can't be used anymore.
+					FreeOptimizedBvh();
 				}
 
-				btBvhTriangleMeshShape *unscaledShape = new btBvhTriangleMeshShape(m_triangleIndexVertexArray, true, useBvh);
+				btBvhTriangleMeshShape *unscaledShape = new btBvhTriangleMeshShape(m_triangleIndexVertexArray, true, false);
+				if (useBvh) {
+					// The BVH is built once and shared by all the shapes using the mesh.
+					unscaledShape->setOptimizedBvh(GetOptimizedBvh(unscaledShape->getLocalAabbMin(), unscaledShape->getLocalAabbMax()));
+				}
 				unscaledShape->setMargin(margin);
 				collisionShape = new btScaledBvhTriangleMeshShape(unscaledShape, btVector3(1.0f, 1.0f, 1.0f));
 				collisionShape->setMargin(margin);
@@ -2546,6 +2830,52 @@ btCollisionShape *CcdShapeConstructionInfo::CreateBulletShape(btScalar margin, b
 	return collisionShape;
 }
 
+void CcdShapeConstructionInfo::SetShapeCache(CcdShapeCache *cache)
+{
+	if (m_shapeCache) {
+		m_shapeCache->Release();
+	}
+	m_shapeCache = cache ? cache->AddRef() : nullptr;
+}
+
+btOptimizedBvh *CcdShapeConstructionInfo::GetOptimizedBvh(const btVector3& aabbMin, const btVector3& aabbMax)
+{
+	if (m_optimizedBvh) {
+		return m_optimizedBvh;
+	}
+
+	// Only the BVH of the unmodified vertex and triangle arrays is cached, not the welded mesh.
+	const bool useCache = (m_shapeCache && m_weldingThreshold1 == 0.0f);
+	CcdShapeCache::Key key;
+	if (useCache) {
+		key = CcdShapeCache::ComputeKey(&m_vertexArray[0], m_vertexArray.size() / 3, m_triFaceArray.data(),
+		                                m_triFaceArray.size() / 3, true);
+		m_optimizedBvh = m_shapeCache->LoadBvh(key);
+		if (m_optimizedBvh) {
+			return m_optimizedBvh;
+		}
+	}
+
+	void *mem = btAlignedAlloc(sizeof(btOptimizedBvh), 16);
+	m_optimizedBvh = new (mem) btOptimizedBvh();
+	m_optimizedBvh->build(m_triangleIndexVertexArray, true, aabbMin, aabbMax);
+
+	if (useCache) {
+		m_shapeCache->StoreBvh(key, m_optimizedBvh);
+	}
+
+	return m_optimizedBvh;
+}
+
+void CcdShapeConstructionInfo::FreeOptimizedBvh()
+{
+	if (m_optimizedBvh) {
+		m_optimizedBvh->~btOptimizedBvh();
+		btAlignedFree(m_optimizedBvh);
+		m_optimizedBvh = nullptr;
+	}
+}
+
 void CcdShapeConstructionInfo::AddShape(CcdShapeConstructionInfo *shapeInfo)
 {
 	m_shapeArray.push_back(shapeInfo);
@@ -2562,9 +2892,13 @@ CcdShapeConstructionInfo::~CcdShapeConstructionInfo()
 	}
 	m_shapeArray.clear();
 
+	FreeOptimizedBvh();
 	if (m_triangleIndexVertexArray)
 		delete m_triangleIndexVertexArray;
 	m_vertexArray.clear();
+	if (m_shapeCache) {
+		m_shapeCache->Release();
+	}
 	if (m_shapeType == PHY_SHAPE_MESH && m_meshObject != nullptr) {
 		std::map<RAS_MeshObject *, CcdShapeConstructionInfo *>::iterator mit = m_meshShapeMap.find(m_meshObject);
 		if (mit != m_meshShapeMap.end() && mit->second == this) {
@@ -49,6 +49,8 @@ class btMotionState;
 class RAS_MeshObject;
 struct DerivedMesh;
 class btCollisionShape;
+class btOptimizedBvh;
+class CcdShapeCache;
 
 #define CCD_BSB_SHAPE_MATCHING  2
 #define CCD_BSB_BENDING_CONSTRAINTS 8
@@ -84,7 +86,9 @@ public:
 		m_triangleIndexVertexArray(nullptr),
 		m_forceReInstance(false),
 		m_weldingThreshold1(0.0f),
-		m_shapeProxy(nullptr)
+		m_shapeProxy(nullptr),
+		m_shapeCache(nullptr),
+		m_optimizedBvh(nullptr)
 	{
 		m_childTrans.setIdentity();
 	}
@@ -158,6 +162,13 @@ public:
 
 	btCollisionShape *CreateBulletShape(btScalar margin, bool useGimpact = false, bool useBvh = true);
 
+	/// Set the cache used to load and store the BVH of the triangle mesh.
+	void SetShapeCache(CcdShapeCache *cache);
+	CcdShapeCache *GetShapeCache() const
+	{
+		return m_shapeCache;
+	}
+
 	// member variables
 	PHY_ShapeType m_shapeType;
 	btScalar m_radius;
@@ -199,6 +210,14 @@ protected:
 	float m_weldingThreshold1;
 	/// only used for PHY_SHAPE_PROXY, pointer to actual shape info
 	CcdShapeConstructionInfo *m_shapeProxy;
+	/// Cache of the triangle mesh BVH, can be nullptr.
+	CcdShapeCache *m_shapeCache;
+	/// BVH of the triangle mesh shared by all the Bullet shapes, allocated with btAlignedAlloc.
+	btOptimizedBvh *m_optimizedBvh;
+
+	/// Return the shared BVH, load it from the cache or build it when missing.
+	btOptimizedBvh *GetOptimizedBvh(const btVector3& aabbMin, const btVector3& aabbMax);
+	void FreeOptimizedBvh();
 };
 
 struct CcdConstructionInfo {
@@ -442,6 +461,20 @@ private:
 	unsigned char m_maxJumps;
 
 public:
+	/// Dynamic state of the character saved by the physics environment snapshots.
+	struct State
+	{
+		btVector3 m_walkDirection;
+		btVector3 m_normalizedDirection;
+		btScalar m_verticalVelocity;
+		btScalar m_verticalOffset;
+		btScalar m_velocityTimeInterval;
+		bool m_wasOnGround;
+		bool m_wasJumping;
+		bool m_useWalkDirection;
+		unsigned char m_jumps;
+	};
+
 	BlenderBulletCharacterController(CcdPhysicsController *ctrl, btMotionState *motionState, btPairCachingGhostObject *ghost, btConvexShape *shape, float stepHeight);
 
 	virtual void updateAction(btCollisionWorld *collisionWorld, btScalar dt);
@@ -460,6 +493,10 @@ public:
 
 	void SetVelocity(const btVector3& vel, float time, bool local);
 
+	void SaveState(State& state) const;
+	/// Restore the state, the ghost object transform must be restored before.
+	void RestoreState(const State& state);
+
 	// PHY_ICharacter interface
 	virtual void Jump()
 	{
@@ -564,6 +601,21 @@ protected:
 	bool m_savedDyna;
 	bool m_suspended;
 
+	/// Shapes of the level of detail meshes, shared by the replicas.
+	std::map<RAS_MeshObject *, CcdShapeConstructionInfo *> m_lodShapeInfos;
+	/// Original shape info while a level of detail shape is used, nullptr otherwise.
+	CcdShapeConstructionInfo *m_lodOriginalShapeInfo;
+	/// True when the body was put to sleep by its level of detail.
+	bool m_lodSleep;
+
+	/// Index in the active controllers of the physics environment, -1 when not listed.
+	int m_activeIndex;
+	/// Commands deferred during an asynchronous step and applied after the step, see PendingCommand.
+	int m_pendingCommands;
+	/// Sums of the world forces and torques deferred during an asynchronous step.
+	MT_Vector3 m_pendingForce;
+	MT_Vector3 m_pendingTorque;
+
 	void GetWorldOrientation(btMatrix3x3& mat);
 
 	void CreateRigidbody();
@@ -592,6 +644,11 @@ protected:
 	void SetWorldOrientation(const btMatrix3x3& mat);
 	void ForceWorldTransform(const btMatrix3x3& mat, const btVector3& pos);
 
+	/// Return the shape info of a level of detail mesh, nullptr if the mesh has no collider polygons.
+	CcdShapeConstructionInfo *GetLodShapeInfo(RAS_MeshObject *meshobj);
+	/// Restore the original shape info and release the level of detail shapes, the Bullet shape is kept.
+	void ReleaseLodShapes();
+
 public:
 	int m_collisionDelay;
 
@@ -649,6 +706,39 @@ public:
 	 */
 	void SimulationTick(float timestep);
 
+	/// Return true if the controller is moved by the simulation: soft body or awake non-static rigid body.
+	bool IsSimulationActive();
+	/// Give to the game object the transform deferred by the motion state during an asynchronous step.
+	void PublishMotionState();
+
+	/// Calls deferred while an asynchronous step runs, e.g. by the animations updated during the rendering.
+	enum PendingCommand {
+		PENDING_TRANSFORM = (1 << 0),
+		PENDING_FORCE = (1 << 1),
+		PENDING_TORQUE = (1 << 2)
+	};
+
+	int GetPendingCommands() const
+	{
+		return m_pendingCommands;
+	}
+
+	/// Add a deferred command, the value is the world force or torque summed with the previous ones.
+	void AddPendingCommand(PendingCommand command, const MT_Vector3& value);
+	void ClearPendingCommands();
+	/// Apply to the body the commands deferred during an asynchronous step.
+	void PublishPendingCommands();
+
+	int GetActiveIndex() const
+	{
+		return m_activeIndex;
+	}
+
+	void SetActiveIndex(int index)
+	{
+		m_activeIndex = index;
+	}
+
 	/**
 	 * WriteMotionStateToDynamics ynchronizes dynas, kinematic and deformable entities (and do 'late binding')
 	 */
@@ -849,6 +939,9 @@ public:
 	virtual bool ReinstancePhysicsShape(KX_GameObject *from_gameobj, RAS_MeshObject *from_meshobj, bool dupli = false);
 	virtual void ReplacePhysicsShape(PHY_IPhysicsController *phyctrl);
 
+	virtual bool SetLodMesh(RAS_MeshObject *meshobj);
+	virtual void SetLodSleep(bool sleep);
+
 	/* Method to replicate rigid body joint contraints for group instances. */
 	virtual void ReplicateConstraints(KX_GameObject *gameobj, std::vector<KX_GameObject *> constobj);
 };
@@ -21,6 +21,9 @@
 #include "CcdGraphicController.h"
 #include "CcdConstraint.h"
 #include "CcdMathUtils.h"
+#include "CcdParallelWorld.h"
+#include "CcdBroadphase.h"
+#include "CcdShapeCache.h"
 
 #include <algorithm>
 #include "btBulletDynamicsCommon.h"
@@ -45,6 +48,7 @@
 #include "RAS_MeshObject.h"
 #include "RAS_Polygon.h"
 #include "RAS_ITexVert.h"
+#include "RAS_Deformer.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_world_types.h"
@@ -52,6 +56,8 @@
 
 extern "C" {
 	#include "BLI_utildefines.h"
+	#include "BLI_task.h"
+	#include "BLI_threads.h"
 	#include "BKE_object.h"
 }
 
@@ -74,6 +80,7 @@ void DrawRasterizerLine(const float *from, const float *to, int color);
 #include "BulletDynamics/ConstraintSolver/btContactConstraint.h"
 
 #include "CM_Message.h"
+#include "CM_Thread.h"
 
 // This was copied from the old KX_ConvertPhysicsObjects
 #ifdef WIN32
@@ -225,6 +232,15 @@ public:
 		info.m_clientInfo = motionState;
 	}
 
+	/// Compute the wheel transforms from the chassis, the vehicles can be updated concurrently.
+	void UpdateWheelTransforms()
+	{
+		for (int i = 0, numWheels = GetNumWheels(); i < numWheels; ++i) {
+			m_vehicle->updateWheelTransform(i, false);
+		}
+	}
+
+	/// Give the wheel transforms to the motion states, it schedules the update of the wheel objects.
 	void SyncWheels()
 	{
 		int numWheels = GetNumWheels();
@@ -232,8 +248,7 @@ public:
 		for (i = 0; i < numWheels; i++) {
 			btWheelInfo& info = m_vehicle->getWheelInfo(i);
 			PHY_IMotionState *motionState = (PHY_IMotionState *)info.m_clientInfo;
-			m_vehicle->updateWheelTransform(i, false);
-			const btTransform trans = m_vehicle->getWheelInfo(i).m_worldTransform;
+			const btTransform trans = info.m_worldTransform;
 			motionState->SetWorldOrientation(ToMoto(trans.getRotation()));
 			motionState->SetWorldPosition(ToMoto(trans.getOrigin()));
 		}
@@ -385,8 +400,10 @@ void CcdPhysicsEnvironment::SetDebugDrawer(btIDebugDraw *debugDrawer)
 	m_debugDrawer = debugDrawer;
 }
 
-CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *dispatcher, btOverlappingPairCache *pairCache)
-	:m_cullingCache(nullptr),
+CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, int numThreads, int broadphaseType, float worldSize,
+                                             btDispatcher *dispatcher, btOverlappingPairCache *pairCache)
+	:m_broadphaseType(broadphaseType),
+	m_cullingCache(nullptr),
 	m_cullingTree(nullptr),
 	m_numIterations(10),
 	m_numTimeSubSteps(1),
@@ -396,6 +413,18 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *
 	m_linearDeactivationThreshold(0.8f),
 	m_angularDeactivationThreshold(1.0f),
 	m_contactBreakingThreshold(0.02f),
+	m_numThreads(std::max(numThreads, 1)),
+	m_taskScheduler(nullptr),
+	m_shapeCache(nullptr),
+	m_stepScheduler(nullptr),
+	m_stepPool(nullptr),
+	m_stepRunning(false),
+	m_stepPublish(false),
+	m_stepCallbacks(false),
+	m_stepCurTime(0.0),
+	m_stepTimeStep(0.0f),
+	m_stepInterval(0.0f),
+	m_numWheelTasks(1),
 	m_solver(nullptr),
 	m_ownPairCache(nullptr),
 	m_filterCallback(nullptr),
@@ -406,20 +435,46 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *
 		m_triggerCallbacks[i] = nullptr;
 	}
 
+	if (m_numThreads > 1) {
+		m_taskScheduler = BLI_task_scheduler_create(m_numThreads);
+	}
+
 //	m_collisionConfiguration = new btDefaultCollisionConfiguration();
-	m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
+	if (m_taskScheduler) {
+		m_collisionConfiguration = new CcdParallelCollisionConfiguration();
+	}
+	else {
+		m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
+	}
 	//m_collisionConfiguration->setConvexConvexMultipointIterations();
 
 	if (!dispatcher) {
-		btCollisionDispatcher *disp = new btCollisionDispatcher(m_collisionConfiguration);
+		btCollisionDispatcher *disp;
+		if (m_taskScheduler) {
+			disp = new CcdParallelDispatcher(m_collisionConfiguration, m_taskScheduler);
+		}
+		else {
+			disp = new btCollisionDispatcher(m_collisionConfiguration);
+		}
 		dispatcher = disp;
 		btGImpactCollisionAlgorithm::registerAlgorithm(disp);
 		m_ownDispatcher = dispatcher;
 	}
 
-	//m_broadphase = new btAxisSweep3(btVector3(-1000,-1000,-1000),btVector3(1000,1000,1000));
-	//m_broadphase = new btSimpleBroadphase();
-	m_broadphase = new btDbvtBroadphase();
+	switch (m_broadphaseType) {
+		case CCD_BROADPHASE_AXIS_SWEEP:
+		{
+			const btVector3 extent(worldSize * 0.5f, worldSize * 0.5f, worldSize * 0.5f);
+			m_broadphase = new CcdAxisSweep3(-extent, extent);
+			break;
+		}
+		default:
+		{
+			m_broadphaseType = CCD_BROADPHASE_DBVT;
+			m_broadphase = new CcdDbvtBroadphase();
+			break;
+		}
+	}
 	// avoid any collision in the culling tree
 	if (useDbvtCulling) {
 		m_cullingCache = new btNullPairCache();
@@ -433,7 +488,12 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *
 
 	SetSolverType(1);//issues with quickstep and memory allocations
 //	m_dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher,m_broadphase,m_solver,m_collisionConfiguration);
-	m_dynamicsWorld = new btSoftRigidDynamicsWorld(dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+	if (m_taskScheduler) {
+		m_dynamicsWorld = new CcdParallelDynamicsWorld(dispatcher, m_broadphase, m_solver, m_collisionConfiguration, m_taskScheduler);
+	}
+	else {
+		m_dynamicsWorld = new btSoftRigidDynamicsWorld(dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
+	}
 	m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback, this);
 	//m_dynamicsWorld->getSolverInfo().m_linearSlop = 0.01f;
 	//m_dynamicsWorld->getSolverInfo().m_solverMode=	SOLVER_USE_WARMSTARTING +	SOLVER_USE_2_FRICTION_DIRECTIONS +	SOLVER_RANDMIZE_ORDER +	SOLVER_USE_FRICTION_WARMSTARTING;
@@ -444,6 +504,15 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *
 
 void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
 {
+	CompleteStep();
+
+	if (m_broadphaseType == CCD_BROADPHASE_AXIS_SWEEP && m_controllers.size() >= CcdAxisSweep3::MaxHandles &&
+	    m_controllers.find(ctrl) == m_controllers.end())
+	{
+		CM_Error("too many physics objects for the sweep and prune broadphase, object not added to the physics.");
+		return;
+	}
+
 	// the controller is already added we do nothing
 	if (!m_controllers.insert(ctrl).second) {
 		return;
@@ -454,6 +523,10 @@ void CcdPhysicsEnvironment::AddCcdPhysicsController(CcdPhysicsController *ctrl)
 
 	//this m_userPointer is just used for triggers, see CallbackTriggers
 	obj->setUserPointer(ctrl);
+
+	if (ctrl->IsSimulationActive()) {
+		AddActiveController(ctrl);
+	}
 	if (body) {
 		body->setGravity(m_gravity);
 		body->setSleepingThresholds(m_linearDeactivationThreshold, m_angularDeactivationThreshold);
@@ -564,6 +637,19 @@ void CcdPhysicsEnvironment::RestoreConstraint(CcdPhysicsController *ctrl, btType
 
 bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctrl, bool freeConstraints)
 {
+	/* Don't publish the step, the game objects can be in destruction.
+	 * The deferred transform of the removed controller is discarded. */
+	WaitStep();
+	m_pendingMotionStates.erase(std::remove(m_pendingMotionStates.begin(), m_pendingMotionStates.end(), ctrl),
+	                            m_pendingMotionStates.end());
+	m_pendingCommands.erase(std::remove(m_pendingCommands.begin(), m_pendingCommands.end(), ctrl),
+	                        m_pendingCommands.end());
+	ctrl->ClearPendingCommands();
+
+	/* The character controllers are listed as active by their motion state even when they are not
+	 * in the controllers, never keep a removed controller in the active controllers. */
+	RemoveActiveController(ctrl);
+
 	// if the physics controller is already removed we do nothing
 	if (!m_controllers.erase(ctrl)) {
 		return false;
@@ -611,6 +697,8 @@ bool CcdPhysicsEnvironment::RemoveCcdPhysicsController(CcdPhysicsController *ctr
 
 void CcdPhysicsEnvironment::UpdateCcdPhysicsController(CcdPhysicsController *ctrl, btScalar newMass, int newCollisionFlags, short int newCollisionGroup, short int newCollisionMask)
 {
+	CompleteStep();
+
 	// this function is used when the collisionning group of a controller is changed
 	// remove and add the collistioning object
 	btRigidBody *body = ctrl->GetRigidBody();
@@ -639,10 +727,16 @@ void CcdPhysicsEnvironment::UpdateCcdPhysicsController(CcdPhysicsController *ctr
 	ctrl->m_cci.m_collisionFilterGroup = newCollisionGroup;
 	ctrl->m_cci.m_collisionFilterMask = newCollisionMask;
 	ctrl->m_cci.m_collisionFlags = newCollisionFlags;
+
+	if (ctrl->IsSimulationActive()) {
+		AddActiveController(ctrl);
+	}
 }
 
 void CcdPhysicsEnvironment::RefreshCcdPhysicsController(CcdPhysicsController *ctrl)
 {
+	CompleteStep();
+
 	btCollisionObject *obj = ctrl->GetCollisionObject();
 	if (obj) {
 		btBroadphaseProxy *proxy = obj->getBroadphaseHandle();
@@ -657,6 +751,44 @@ bool CcdPhysicsEnvironment::IsActiveCcdPhysicsController(CcdPhysicsController *c
 	return (m_controllers.find(ctrl) != m_controllers.end());
 }
 
+void CcdPhysicsEnvironment::AddActiveController(CcdPhysicsController *ctrl)
+{
+	if (ctrl->GetActiveIndex() != -1) {
+		return;
+	}
+
+	ctrl->SetActiveIndex(m_activeControllers.size());
+	m_activeControllers.push_back(ctrl);
+}
+
+void CcdPhysicsEnvironment::RemoveActiveController(CcdPhysicsController *ctrl)
+{
+	const int index = ctrl->GetActiveIndex();
+	if (index == -1) {
+		return;
+	}
+
+	CcdPhysicsController *last = m_activeControllers.back();
+	m_activeControllers[index] = last;
+	last->SetActiveIndex(index);
+	m_activeControllers.pop_back();
+	ctrl->SetActiveIndex(-1);
+}
+
+void CcdPhysicsEnvironment::UpdateActiveControllers()
+{
+	for (unsigned int i = 0; i < m_activeControllers.size();) {
+		CcdPhysicsController *ctrl = m_activeControllers[i];
+		if (ctrl->IsSimulationActive()) {
+			++i;
+		}
+		else {
+			// The last controller is moved at index i, don't increment.
+			RemoveActiveController(ctrl);
+		}
+	}
+}
+
 void CcdPhysicsEnvironment::AddCcdGraphicController(CcdGraphicController *ctrl)
 {
 	if (m_cullingTree && !ctrl->GetBroadphaseHandle()) {
@@ -721,195 +853,173 @@ void CcdPhysicsEnvironment::StaticSimulationSubtickCallback(btDynamicsWorld *wor
 
 void CcdPhysicsEnvironment::SimulationSubtickCallback(btScalar timeStep)
 {
-	std::set<CcdPhysicsController *>::iterator it;
-
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SimulationTick(timeStep);
+	// Sleeping bodies have no velocity to clamp.
+	for (CcdPhysicsController *ctrl : m_activeControllers) {
+		ctrl->SimulationTick(timeStep);
 	}
 }
 
 bool CcdPhysicsEnvironment::ProceedDeltaTime(double curTime, float timeStep, float interval)
 {
-	std::set<CcdPhysicsController *>::iterator it;
-	int i;
+	// The previous asynchronous step is normally completed by EndFrame.
+	CompleteStep();
 
-	// Update Bullet global variables.
-	gDeactivationTime = m_deactivationTime;
-	gContactBreakingThreshold = m_contactBreakingThreshold;
-
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SynchronizeMotionStates(timeStep);
+	/* Only the controllers moved by the simulation are synchronized, the static and sleeping
+	 * bodies are updated from their motion state in CcdPhysicsController::SetTransform. */
+	for (CcdPhysicsController *ctrl : m_activeControllers) {
+		ctrl->SynchronizeMotionStates(timeStep);
 	}
 
-	float subStep = timeStep / float(m_numTimeSubSteps);
-	i = m_dynamicsWorld->stepSimulation(interval, 25, subStep);//perform always a full simulation step
-//uncomment next line to see where Bullet spend its time (printf in console)
-//CProfileManager::dumpAll();
+	m_stepCurTime = curTime;
+	m_stepTimeStep = timeStep;
+	m_stepInterval = interval;
 
-	ProcessFhSprings(curTime, i * subStep);
-
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		(*it)->SynchronizeMotionStates(timeStep);
-	}
-
-	//for (it=m_controllers.begin(); it!=m_controllers.end(); it++)
-	//{
-	//	(*it)->SynchronizeMotionStates(timeStep);
-	//}
-
-	for (i = 0; i < m_wrapperVehicles.size(); i++) {
-		WrapperVehicle *veh = m_wrapperVehicles[i];
-		veh->SyncWheels();
+	if (m_stepPool) {
+		/* The step runs concurrently with the rendering, the transforms given to the motion states
+		 * are deferred and published with the collision callbacks by EndFrame before the next logic frame. */
+		m_stepRunning = true;
+		BLI_task_pool_push(m_stepPool, StepTask, nullptr, false, TASK_PRIORITY_HIGH);
+		return true;
 	}
 
+	Step();
+	PublishStep();
 	CallbackTriggers();
 
 	return true;
 }
 
-class ClosestRayResultCallbackNotMe : public btCollisionWorld::ClosestRayResultCallback
-{
-	btCollisionObject *m_owner;
-	btCollisionObject *m_parent;
-
-public:
-	ClosestRayResultCallbackNotMe(const btVector3& rayFromWorld, const btVector3& rayToWorld, btCollisionObject *owner, btCollisionObject *parent)
-		:btCollisionWorld::ClosestRayResultCallback(rayFromWorld, rayToWorld),
-		m_owner(owner),
-		m_parent(parent)
-	{
-	}
-
-	virtual bool needsCollision(btBroadphaseProxy *proxy0) const
-	{
-		//don't collide with self
-		if (proxy0->m_clientObject == m_owner)
-			return false;
-
-		if (proxy0->m_clientObject == m_parent)
-			return false;
-
-		return btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy0);
-	}
-};
+/// Bullet global variables are shared by all the environments, the steps of several scenes are serialized.
+static CM_ThreadMutex ccdStepMutex;
 
-void CcdPhysicsEnvironment::ProcessFhSprings(double curTime, float interval)
+void CcdPhysicsEnvironment::StepTask(TaskPool *__restrict pool, void *UNUSED(taskdata), int UNUSED(threadid))
 {
-	std::set<CcdPhysicsController *>::iterator it;
-
-	const float step = interval * KX_GetActiveEngine()->GetTicRate();
-
-	for (it = m_controllers.begin(); it != m_controllers.end(); it++) {
-		CcdPhysicsController *ctrl = (*it);
-		btRigidBody *body = ctrl->GetRigidBody();
-
-		if (body && (ctrl->GetConstructionInfo().m_do_fh || ctrl->GetConstructionInfo().m_do_rot_fh)) {
-			//re-implement SM_FhObject.cpp using btCollisionWorld::rayTest and info from ctrl->getConstructionInfo()
-			//send a ray from {0.0, 0.0, 0.0} towards {0.0, 0.0, -10.0}, in local coordinates
-			CcdPhysicsController *parentCtrl = ctrl->GetParentCtrl();
-			btRigidBody *parentBody = parentCtrl ? parentCtrl->GetRigidBody() : nullptr;
-			btRigidBody *cl_object = parentBody ? parentBody : body;
-
-			if (body->isStaticOrKinematicObject())
-				continue;
-
-			btVector3 rayDirLocal(0.0f, 0.0f, -10.0f);
-
-			//m_dynamicsWorld
-			//ctrl->GetRigidBody();
-			btVector3 rayFromWorld = body->getCenterOfMassPosition();
-			//btVector3	rayToWorld = rayFromWorld + body->getCenterOfMassTransform().getBasis() * rayDirLocal;
-			//ray always points down the z axis in world space...
-			btVector3 rayToWorld = rayFromWorld + rayDirLocal;
-
-			ClosestRayResultCallbackNotMe resultCallback(rayFromWorld, rayToWorld, body, parentBody);
-
-			m_dynamicsWorld->rayTest(rayFromWorld, rayToWorld, resultCallback);
-			if (resultCallback.hasHit()) {
-				//we hit this one: resultCallback.m_collisionObject;
-				CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(resultCallback.m_collisionObject->getUserPointer());
-
-				if (controller) {
-					if (controller->GetConstructionInfo().m_fh_distance < SIMD_EPSILON)
-						continue;
-
-					btRigidBody *hit_object = controller->GetRigidBody();
-					if (!hit_object)
-						continue;
+	CcdPhysicsEnvironment *env = (CcdPhysicsEnvironment *)BLI_task_pool_userdata(pool);
+	env->Step();
+}
 
-					CcdConstructionInfo& hitObjShapeProps = controller->GetConstructionInfo();
+void CcdPhysicsEnvironment::Step()
+{
+	ccdStepMutex.Lock();
 
-					float distance = resultCallback.m_closestHitFraction * rayDirLocal.length() - ctrl->GetConstructionInfo().m_radius;
-					if (distance >= hitObjShapeProps.m_fh_distance)
-						continue;
+	// Update Bullet global variables.
+	gDeactivationTime = m_deactivationTime;
+	gContactBreakingThreshold = m_contactBreakingThreshold;
 
-					//btVector3 ray_dir = cl_object->getCenterOfMassTransform().getBasis()* rayDirLocal.normalized();
-					btVector3 ray_dir = rayDirLocal.normalized();
-					btVector3 normal = resultCallback.m_hitNormalWorld;
-					normal.normalize();
+	const float subStep = m_stepTimeStep / float(m_numTimeSubSteps);
+	const int numSteps = m_dynamicsWorld->stepSimulation(m_stepInterval, 25, subStep);//perform always a full simulation step
+//uncomment next line to see where Bullet spend its time (printf in console)
+//CProfileManager::dumpAll();
 
-					if (ctrl->GetConstructionInfo().m_do_fh) {
-						btVector3 lspot = cl_object->getCenterOfMassPosition() +
-						                  rayDirLocal * resultCallback.m_closestHitFraction;
+	ProcessFhSprings(m_stepCurTime, numSteps * subStep);
 
-						lspot -= hit_object->getCenterOfMassPosition();
-						btVector3 rel_vel = cl_object->getLinearVelocity() - hit_object->getVelocityInLocalPoint(lspot);
-						btScalar rel_vel_ray = ray_dir.dot(rel_vel);
-						btScalar spring_extent = 1.0f - distance / hitObjShapeProps.m_fh_distance;
+	ccdStepMutex.Unlock();
+}
 
-						btScalar i_spring = spring_extent * hitObjShapeProps.m_fh_spring;
-						btScalar i_damp =   rel_vel_ray * hitObjShapeProps.m_fh_damping;
+void CcdPhysicsEnvironment::PublishStep()
+{
+	// Apply the transforms deferred during an asynchronous step, it adds the moved controllers to the active controllers.
+	for (CcdPhysicsController *ctrl : m_pendingMotionStates) {
+		ctrl->PublishMotionState();
+	}
+	m_pendingMotionStates.clear();
 
-						cl_object->setLinearVelocity(cl_object->getLinearVelocity() + (-(i_spring + i_damp) * ray_dir) * step);
-						if (hitObjShapeProps.m_fh_normal) {
-							cl_object->setLinearVelocity(cl_object->getLinearVelocity() + (i_spring + i_damp) * (normal - normal.dot(ray_dir) * ray_dir) * step);
-						}
+	/* Then give to the bodies the game object transforms, forces and torques set during the step,
+	 * e.g. by the animations. The forces are applied by the next step. */
+	for (CcdPhysicsController *ctrl : m_pendingCommands) {
+		ctrl->PublishPendingCommands();
+	}
+	m_pendingCommands.clear();
 
-						btVector3 lateral = rel_vel - rel_vel_ray * ray_dir;
+	// The bodies woken during the step were added by their motion state.
+	for (CcdPhysicsController *ctrl : m_activeControllers) {
+		ctrl->SynchronizeMotionStates(m_stepTimeStep);
+	}
 
-						if (ctrl->GetConstructionInfo().m_do_anisotropic) {
-							//Bullet basis contains no scaling/shear etc.
-							const btMatrix3x3& lcs = cl_object->getCenterOfMassTransform().getBasis();
-							btVector3 loc_lateral = lateral * lcs;
-							const btVector3& friction_scaling = cl_object->getAnisotropicFriction();
-							loc_lateral *= friction_scaling;
-							lateral = lcs * loc_lateral;
-						}
+	// Remove the bodies put to sleep once they received their last transform.
+	UpdateActiveControllers();
 
-						btScalar rel_vel_lateral = lateral.length();
+	UpdateWheelTransforms();
+	for (WrapperVehicle *veh : m_wrapperVehicles) {
+		veh->SyncWheels();
+	}
 
-						if (rel_vel_lateral > SIMD_EPSILON) {
-							btScalar friction_factor = hit_object->getFriction();//cl_object->getFriction();
+	m_stepPublish = false;
+}
 
-							btScalar max_friction = friction_factor * btMax(btScalar(0.0), i_spring);
-							
-							btScalar rel_mom_lateral = rel_vel_lateral / cl_object->getInvMass();
+void CcdPhysicsEnvironment::UpdateWheelTransformsTask(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+	CcdPhysicsEnvironment *env = (CcdPhysicsEnvironment *)BLI_task_pool_userdata(pool);
+	const unsigned int task = GET_INT_FROM_POINTER(taskdata);
+	const unsigned int numVehicles = env->m_wrapperVehicles.size();
+	const unsigned int numTasks = env->m_numWheelTasks;
 
-							btVector3 friction = (rel_mom_lateral > max_friction) ?
-							                     -lateral * (max_friction / rel_vel_lateral) :
-							                     -lateral;
+	for (unsigned int i = numVehicles * task / numTasks, end = numVehicles * (task + 1) / numTasks; i < end; ++i) {
+		env->m_wrapperVehicles[i]->UpdateWheelTransforms();
+	}
+}
 
-							cl_object->applyCentralImpulse(friction * step);
-						}
-					}
+void CcdPhysicsEnvironment::UpdateWheelTransforms()
+{
+	// Split in tasks of at least 16 vehicles, each vehicle only reads its chassis.
+	const unsigned int numVehicles = m_wrapperVehicles.size();
+	m_numWheelTasks = m_taskScheduler ? std::min((unsigned int)m_numThreads, numVehicles / 16) : 1;
+
+	if (m_numWheelTasks > 1) {
+		TaskPool *pool = BLI_task_pool_create(m_taskScheduler, this);
+		for (unsigned int i = 0; i < m_numWheelTasks; ++i) {
+			BLI_task_pool_push(pool, UpdateWheelTransformsTask, SET_INT_IN_POINTER(i), false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+	else {
+		for (WrapperVehicle *veh : m_wrapperVehicles) {
+			veh->UpdateWheelTransforms();
+		}
+	}
+}
 
+void CcdPhysicsEnvironment::AddPendingCommand(CcdPhysicsController *ctrl, CcdPhysicsController::PendingCommand command,
+                                              const MT_Vector3& value)
+{
+	m_pendingCommandsMutex.Lock();
+	// Each controller is listed once whatever its number of commands.
+	if (ctrl->GetPendingCommands() == 0) {
+		m_pendingCommands.push_back(ctrl);
+	}
+	ctrl->AddPendingCommand(command, value);
+	m_pendingCommandsMutex.Unlock();
+}
 
-					if (ctrl->GetConstructionInfo().m_do_rot_fh) {
-						btVector3 up2 = cl_object->getWorldTransform().getBasis().getColumn(2);
+void CcdPhysicsEnvironment::WaitStep()
+{
+	if (!m_stepRunning) {
+		return;
+	}
 
-						btVector3 t_spring = up2.cross(normal) * hitObjShapeProps.m_fh_spring;
-						btVector3 ang_vel = cl_object->getAngularVelocity();
+	BLI_task_pool_work_and_wait(m_stepPool);
+	m_stepRunning = false;
+	m_stepPublish = true;
+	m_stepCallbacks = true;
+}
 
-						// only rotations that tilt relative to the normal are damped
-						ang_vel -= ang_vel.dot(normal) * normal;
+void CcdPhysicsEnvironment::CompleteStep()
+{
+	WaitStep();
+	if (m_stepPublish) {
+		PublishStep();
+	}
+}
 
-						btVector3 t_damp = ang_vel * hitObjShapeProps.m_fh_damping;
+void CcdPhysicsEnvironment::EndFrame()
+{
+	CompleteStep();
 
-						cl_object->setAngularVelocity(cl_object->getAngularVelocity() + (t_spring - t_damp) * step);
-					}
-				}
-			}
-		}
+	// The callbacks can run python code, they are only called here, before the logic.
+	if (m_stepCallbacks) {
+		m_stepCallbacks = false;
+		CallbackTriggers();
 	}
 }
 
@@ -1032,6 +1142,8 @@ static int gConstraintUid = 1;
 
 void CcdPhysicsEnvironment::RemoveConstraintById(int constraintId, bool free)
 {
+	CompleteStep();
+
 	// For soft body constraints
 	if (constraintId == 0)
 		return;
@@ -1065,230 +1177,835 @@ struct  FilterClosestRayResultCallback : public btCollisionWorld::ClosestRayResu
 		m_hitTriangleShape(nullptr),
 		m_hitTriangleIndex(0)
 	{
+		// use faster (less accurate) ray callback, works better with 0 collision margins
+		m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
+	}
+
+	virtual ~FilterClosestRayResultCallback()
+	{
+	}
+
+	virtual bool needsCollision(btBroadphaseProxy *proxy0) const
+	{
+		if (!(proxy0->m_collisionFilterGroup & m_collisionFilterMask))
+			return false;
+		if (!(m_collisionFilterGroup & proxy0->m_collisionFilterMask))
+			return false;
+		btCollisionObject *object = (btCollisionObject *)proxy0->m_clientObject;
+		CcdPhysicsController *phyCtrl = static_cast<CcdPhysicsController *>(object->getUserPointer());
+		if (phyCtrl == m_phyRayFilter.m_ignoreController)
+			return false;
+		return m_phyRayFilter.needBroadphaseRayCast(phyCtrl);
+	}
+
+	virtual btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace)
+	{
+		//CcdPhysicsController* curHit = static_cast<CcdPhysicsController*>(rayResult.m_collisionObject->getUserPointer());
+		// save shape information as ClosestRayResultCallback::AddSingleResult() does not do it
+		if (rayResult.m_localShapeInfo) {
+			m_hitTriangleShape = rayResult.m_collisionObject->getCollisionShape();
+			m_hitTriangleIndex = rayResult.m_localShapeInfo->m_triangleIndex;
+		}
+		else {
+			m_hitTriangleShape = nullptr;
+			m_hitTriangleIndex = 0;
+		}
+		return ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+	}
+};
+
+static bool GetHitTriangle(btCollisionShape *shape, CcdShapeConstructionInfo *shapeInfo, int hitTriangleIndex, btVector3 triangle[])
+{
+	// this code is copied from Bullet
+	const unsigned char *vertexbase;
+	int numverts;
+	PHY_ScalarType type;
+	int stride;
+	const unsigned char *indexbase;
+	int indexstride;
+	int numfaces;
+	PHY_ScalarType indicestype;
+	btStridingMeshInterface *meshInterface = shapeInfo->GetMeshInterface();
+
+	if (!meshInterface)
+		return false;
+
+	meshInterface->getLockedReadOnlyVertexIndexBase(
+	    &vertexbase,
+	    numverts,
+	    type,
+	    stride,
+	    &indexbase,
+	    indexstride,
+	    numfaces,
+	    indicestype,
+	    0);
+
+	unsigned int *gfxbase = (unsigned int *)(indexbase + hitTriangleIndex * indexstride);
+	const btVector3& meshScaling = shape->getLocalScaling();
+	for (int j = 2; j >= 0; j--) {
+		int graphicsindex = (indicestype == PHY_SHORT) ? ((unsigned short *)gfxbase)[j] : gfxbase[j];
+
+		btScalar *graphicsbase = (btScalar *)(vertexbase + graphicsindex * stride);
+
+		triangle[j] = btVector3(graphicsbase[0] * meshScaling.getX(), graphicsbase[1] * meshScaling.getY(), graphicsbase[2] * meshScaling.getZ());
+	}
+	meshInterface->unLockReadOnlyVertexBase(0);
+	return true;
+}
+
+/// Fill a ray cast result from a hit, identify the mesh polygon and compute the UV and face normal if requested.
+static void GetRayCastResult(const btCollisionObject *object, const btVector3& hitPoint, const btVector3& hitNormalWorld,
+                             const btCollisionShape *hitTriangleShape, int hitTriangleIndex, bool faceNormal, bool faceUV,
+                             PHY_RayCastResult& result)
+{
+	CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(object->getUserPointer());
+	btVector3 hitNormal = hitNormalWorld;
+
+	result.m_controller = controller;
+	result.m_hitPoint[0] = hitPoint.getX();
+	result.m_hitPoint[1] = hitPoint.getY();
+	result.m_hitPoint[2] = hitPoint.getZ();
+
+	if (hitTriangleShape != nullptr) {
+		// identify the mesh polygon
+		CcdShapeConstructionInfo *shapeInfo = controller->GetShapeInfo();
+		if (shapeInfo) {
+			btCollisionShape *shape = controller->GetCollisionObject()->getCollisionShape();
+			if (shape->isCompound()) {
+				btCompoundShape *compoundShape = (btCompoundShape *)shape;
+				CcdShapeConstructionInfo *compoundShapeInfo = shapeInfo;
+				// need to search which sub-shape has been hit
+				for (int i = 0; i < compoundShape->getNumChildShapes(); i++) {
+					shapeInfo = compoundShapeInfo->GetChildShape(i);
+					shape = compoundShape->getChildShape(i);
+					if (shape == hitTriangleShape)
+						break;
+				}
+			}
+			if (shape == hitTriangleShape &&
+			    hitTriangleIndex < shapeInfo->m_polygonIndexArray.size())
+			{
+				// save original collision shape triangle for soft body
+				const int shapeTriangleIndex = hitTriangleIndex;
+
+				result.m_meshObject = shapeInfo->GetMesh();
+				if (shape->isSoftBody()) {
+					// soft body using different face numbering because of randomization
+					// hopefully we have stored the original face number in m_tag
+					const btSoftBody *softBody = static_cast<const btSoftBody *>(object);
+					if (softBody->m_faces[shapeTriangleIndex].m_tag != 0) {
+						hitTriangleIndex = (int)((uintptr_t)(softBody->m_faces[shapeTriangleIndex].m_tag) - 1);
+					}
+				}
+				// retrieve the original mesh polygon (in case of quad->tri conversion)
+				result.m_polygon = shapeInfo->m_polygonIndexArray.at(hitTriangleIndex);
+				// hit triangle in world coordinate, for face normal and UV coordinate
+				btVector3 triangle[3];
+				bool triangleOK = false;
+				if (faceUV && (3 * hitTriangleIndex) < shapeInfo->m_triFaceUVcoArray.size()) {
+					// interpolate the UV coordinate of the hit point
+					CcdShapeConstructionInfo::UVco *uvCo = &shapeInfo->m_triFaceUVcoArray[3 * hitTriangleIndex];
+					// 1. get the 3 coordinate of the triangle in world space
+					btVector3 v1, v2, v3;
+					if (shape->isSoftBody()) {
+						// soft body give points directly in world coordinate
+						const btSoftBody *softBody = static_cast<const btSoftBody *>(object);
+						v1 = softBody->m_faces[shapeTriangleIndex].m_n[0]->m_x;
+						v2 = softBody->m_faces[shapeTriangleIndex].m_n[1]->m_x;
+						v3 = softBody->m_faces[shapeTriangleIndex].m_n[2]->m_x;
+					}
+					else {
+						// for rigid body we must apply the world transform
+						triangleOK = GetHitTriangle(shape, shapeInfo, shapeTriangleIndex, triangle);
+						if (!triangleOK)
+							// if we cannot get the triangle, no use to continue
+							goto SKIP_UV_NORMAL;
+						v1 = object->getWorldTransform()(triangle[0]);
+						v2 = object->getWorldTransform()(triangle[1]);
+						v3 = object->getWorldTransform()(triangle[2]);
+					}
+					// 2. compute barycentric coordinate of the hit point
+					btVector3 v = v2 - v1;
+					btVector3 w = v3 - v1;
+					btVector3 u = v.cross(w);
+					btScalar A = u.length();
+
+					v = v2 - hitPoint;
+					w = v3 - hitPoint;
+					u = v.cross(w);
+					btScalar A1 = u.length();
+
+					v = hitPoint - v1;
+					w = v3 - v1;
+					u = v.cross(w);
+					btScalar A2 = u.length();
+
+					btVector3 baryCo;
+					baryCo.setX(A1 / A);
+					baryCo.setY(A2 / A);
+					baryCo.setZ(1.0f - baryCo.getX() - baryCo.getY());
+					// 3. compute UV coordinate
+					result.m_hitUV[0] = baryCo.getX() * uvCo[0].uv[0] + baryCo.getY() * uvCo[1].uv[0] + baryCo.getZ() * uvCo[2].uv[0];
+					result.m_hitUV[1] = baryCo.getX() * uvCo[0].uv[1] + baryCo.getY() * uvCo[1].uv[1] + baryCo.getZ() * uvCo[2].uv[1];
+					result.m_hitUVOK = 1;
+				}
+
+				// Bullet returns the normal from "outside".
+				// If the user requests the real normal, compute it now
+				if (faceNormal) {
+					if (shape->isSoftBody()) {
+						// we can get the real normal directly from the body
+						const btSoftBody *softBody = static_cast<const btSoftBody *>(object);
+						hitNormal = softBody->m_faces[shapeTriangleIndex].m_normal;
+					}
+					else {
+						if (!triangleOK)
+							triangleOK = GetHitTriangle(shape, shapeInfo, shapeTriangleIndex, triangle);
+						if (triangleOK) {
+							btVector3 triangleNormal;
+							triangleNormal = (triangle[1] - triangle[0]).cross(triangle[2] - triangle[0]);
+							hitNormal = object->getWorldTransform().getBasis() * triangleNormal;
+						}
+					}
+				}
+SKIP_UV_NORMAL:
+				;
+			}
+		}
+	}
+	if (hitNormal.length2() > (SIMD_EPSILON * SIMD_EPSILON)) {
+		hitNormal.normalize();
+	}
+	else {
+		hitNormal.setValue(1.0f, 0.0f, 0.0f);
+	}
+	result.m_hitNormal[0] = hitNormal.getX();
+	result.m_hitNormal[1] = hitNormal.getY();
+	result.m_hitNormal[2] = hitNormal.getZ();
+}
+
+PHY_IPhysicsController *CcdPhysicsEnvironment::RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ)
+{
+	CompleteStep();
+
+	btVector3 rayFrom(fromX, fromY, fromZ);
+	btVector3 rayTo(toX, toY, toZ);
+
+	//Either Ray Cast with or without filtering
+
+	//btCollisionWorld::ClosestRayResultCallback rayCallback(rayFrom,rayTo);
+	FilterClosestRayResultCallback rayCallback(filterCallback, rayFrom, rayTo);
+
+	PHY_RayCastResult result;
+	memset(&result, 0, sizeof(result));
+
+	// don't collision with sensor object
+	rayCallback.m_collisionFilterMask = CcdConstructionInfo::AllFilter ^ CcdConstructionInfo::SensorFilter;
+	//, ,filterCallback.m_faceNormal);
+
+	m_dynamicsWorld->rayTest(rayFrom, rayTo, rayCallback);
+	if (rayCallback.hasHit()) {
+		GetRayCastResult(rayCallback.m_collisionObject, rayCallback.m_hitPointWorld, rayCallback.m_hitNormalWorld,
+		                 rayCallback.m_hitTriangleShape, rayCallback.m_hitTriangleIndex,
+		                 filterCallback.m_faceNormal, filterCallback.m_faceUV, result);
+		filterCallback.reportHit(&result);
+	}
+
+	return result.m_controller;
+}
+
+struct FilterClosestConvexResultCallback : public btCollisionWorld::ClosestConvexResultCallback
+{
+	PHY_IRayCastFilterCallback& m_phyRayFilter;
+	const btCollisionShape *m_hitTriangleShape;
+	int m_hitTriangleIndex;
+
+	FilterClosestConvexResultCallback(PHY_IRayCastFilterCallback& phyRayFilter, const btVector3& convexFrom, const btVector3& convexTo)
+		:btCollisionWorld::ClosestConvexResultCallback(convexFrom, convexTo),
+		m_phyRayFilter(phyRayFilter),
+		m_hitTriangleShape(nullptr),
+		m_hitTriangleIndex(0)
+	{
+	}
+
+	virtual bool needsCollision(btBroadphaseProxy *proxy0) const
+	{
+		if (!(proxy0->m_collisionFilterGroup & m_collisionFilterMask))
+			return false;
+		if (!(m_collisionFilterGroup & proxy0->m_collisionFilterMask))
+			return false;
+		btCollisionObject *object = (btCollisionObject *)proxy0->m_clientObject;
+		CcdPhysicsController *phyCtrl = static_cast<CcdPhysicsController *>(object->getUserPointer());
+		if (phyCtrl == m_phyRayFilter.m_ignoreController)
+			return false;
+		return m_phyRayFilter.needBroadphaseRayCast(phyCtrl);
+	}
+
+	virtual btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace)
+	{
+		if (convexResult.m_localShapeInfo) {
+			m_hitTriangleShape = convexResult.m_hitCollisionObject->getCollisionShape();
+			m_hitTriangleIndex = convexResult.m_localShapeInfo->m_triangleIndex;
+		}
+		else {
+			m_hitTriangleShape = nullptr;
+			m_hitTriangleIndex = 0;
+		}
+		return ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+	}
+};
+
+/// Closest hit of a ray of a batch.
+struct CcdBatchHit
+{
+	const btCollisionObject *m_object;
+	btVector3 m_point;
+	btVector3 m_normal;
+	const btCollisionShape *m_triangleShape;
+	int m_triangleIndex;
+	btScalar m_fraction;
+};
+
+/// Data shared by the tasks of a batched ray test.
+struct CcdRayTestBatch
+{
+	const btDbvt *m_trees[3];
+	unsigned short m_numTrees;
+	PHY_IRayCastFilterCallback *m_filterCallback;
+	const MT_Vector3 *m_from;
+	const MT_Vector3 *m_to;
+	unsigned int m_numRays;
+	/// Shape swept along the rays, nullptr for ray tests.
+	btConvexShape *m_castShape;
+	unsigned int m_numTasks;
+	std::vector<CcdBatchHit> m_hits;
+	/// Ray index and object tested after the tasks, one array per task.
+	std::vector<std::vector<std::pair<unsigned int, btCollisionObject *> > > m_serialTests;
+};
+
+/** Return true if the object must not be tested concurrently: the soft bodies and GImpact
+ * shapes update internal data during the tests, like in the parallel dispatcher.
+ */
+static bool IsSerialRayTestObject(const btCollisionObject *object)
+{
+	return (object->getInternalType() == btCollisionObject::CO_SOFT_BODY ||
+	        object->getCollisionShape()->getShapeType() == GIMPACT_SHAPE_PROXYTYPE);
+}
+
+static void BatchTestObject(const CcdRayTestBatch& UNUSED(batch), FilterClosestRayResultCallback& callback,
+                            const btTransform& from, const btTransform& to, btCollisionObject *object)
+{
+	btSoftRigidDynamicsWorld::rayTestSingle(from, to, object, object->getCollisionShape(), object->getWorldTransform(), callback);
+}
+
+static void BatchTestObject(const CcdRayTestBatch& batch, FilterClosestConvexResultCallback& callback,
+                            const btTransform& from, const btTransform& to, btCollisionObject *object)
+{
+	btCollisionWorld::objectQuerySingle(batch.m_castShape, from, to, object, object->getCollisionShape(), object->getWorldTransform(),
+	                                    callback, 0.0f);
+}
+
+static void BatchStoreHit(const FilterClosestRayResultCallback& callback, CcdBatchHit& hit)
+{
+	hit.m_object = callback.m_collisionObject;
+	hit.m_point = callback.m_hitPointWorld;
+	hit.m_normal = callback.m_hitNormalWorld;
+	hit.m_triangleShape = callback.m_hitTriangleShape;
+	hit.m_triangleIndex = callback.m_hitTriangleIndex;
+	hit.m_fraction = callback.m_closestHitFraction;
+}
+
+static void BatchStoreHit(const FilterClosestConvexResultCallback& callback, CcdBatchHit& hit)
+{
+	hit.m_object = callback.m_hitCollisionObject;
+	hit.m_point = callback.m_hitPointWorld;
+	hit.m_normal = callback.m_hitNormalWorld;
+	hit.m_triangleShape = callback.m_hitTriangleShape;
+	hit.m_triangleIndex = callback.m_hitTriangleIndex;
+	hit.m_fraction = callback.m_closestHitFraction;
+}
+
+/** Traverse the broadphase trees along a segment with the given stack instead of their shared
+ * stack, the tester is called for every object accepted by the result callback. The tree volumes
+ * are enlarged by the extent of a swept shape given by its bounding box.
+ */
+template <class ResultCallback, class ObjectTester>
+static void BatchTraverseTrees(const btDbvt *const trees[3], unsigned short numTrees, const btVector3& from, const btVector3& to,
+                               const btVector3& aabbMin, const btVector3& aabbMax, ResultCallback& callback,
+                               std::vector<const btDbvtNode *>& stack, const ObjectTester& tester)
+{
+	btVector3 direction = to - from;
+	const btScalar length = direction.length();
+	if (btFuzzyZero(length)) {
+		return;
+	}
+	direction /= length;
+
+	btVector3 directionInverse;
+	unsigned int signs[3];
+	for (unsigned short i = 0; i < 3; ++i) {
+		directionInverse[i] = (direction[i] == 0.0f) ? BT_LARGE_FLOAT : 1.0f / direction[i];
+		signs[i] = directionInverse[i] < 0.0f;
+	}
+
+	for (unsigned short i = 0; i < numTrees; ++i) {
+		const btDbvtNode *root = trees[i]->m_root;
+		if (!root) {
+			continue;
+		}
+
+		stack.clear();
+		stack.push_back(root);
+		while (!stack.empty() && callback.m_closestHitFraction > 0.0f) {
+			const btDbvtNode *node = stack.back();
+			stack.pop_back();
+
+			const btVector3 bounds[2] = {node->volume.Mins() - aabbMax, node->volume.Maxs() - aabbMin};
+			btScalar tmin = 1.0f;
+			// Nodes behind the closest hit can't contain a closer hit.
+			if (!btRayAabb2(from, directionInverse, signs, bounds, tmin, 0.0f, length * callback.m_closestHitFraction)) {
+				continue;
+			}
+
+			if (node->isinternal()) {
+				stack.push_back(node->childs[0]);
+				stack.push_back(node->childs[1]);
+				continue;
+			}
+
+			btBroadphaseProxy *proxy = (btBroadphaseProxy *)node->data;
+			if (!callback.needsCollision(proxy)) {
+				continue;
+			}
+
+			tester((btCollisionObject *)proxy->m_clientObject);
+		}
+	}
+}
+
+/// Test a ray of a batch against the broadphase trees, the serial objects are only recorded.
+template <class ResultCallback>
+static void BatchTestRay(CcdRayTestBatch& batch, unsigned int index, std::vector<const btDbvtNode *>& stack,
+                         std::vector<std::pair<unsigned int, btCollisionObject *> >& serialTests)
+{
+	const btVector3 from = ToBullet(batch.m_from[index]);
+	const btVector3 to = ToBullet(batch.m_to[index]);
+
+	ResultCallback callback(*batch.m_filterCallback, from, to);
+	// don't collision with sensor object
+	callback.m_collisionFilterMask = CcdConstructionInfo::AllFilter ^ CcdConstructionInfo::SensorFilter;
+
+	const btTransform fromTrans(btMatrix3x3::getIdentity(), from);
+	const btTransform toTrans(btMatrix3x3::getIdentity(), to);
+
+	// The tree volumes are enlarged by the extent of the swept shape.
+	btVector3 aabbMin(0.0f, 0.0f, 0.0f);
+	btVector3 aabbMax(0.0f, 0.0f, 0.0f);
+	if (batch.m_castShape) {
+		batch.m_castShape->getAabb(btTransform::getIdentity(), aabbMin, aabbMax);
+	}
+
+	BatchTraverseTrees(batch.m_trees, batch.m_numTrees, from, to, aabbMin, aabbMax, callback, stack,
+	                   [&](btCollisionObject *object) {
+		if (IsSerialRayTestObject(object)) {
+			serialTests.emplace_back(index, object);
+		}
+		else {
+			BatchTestObject(batch, callback, fromTrans, toTrans, object);
+		}
+	});
+
+	if (callback.hasHit()) {
+		BatchStoreHit(callback, batch.m_hits[index]);
+	}
+}
+
+/// Test the serial objects recorded by the tasks, a hit is only stored when closer than the current one.
+template <class ResultCallback>
+static void BatchTestSerialObjects(CcdRayTestBatch& batch)
+{
+	for (const std::vector<std::pair<unsigned int, btCollisionObject *> >& serialTests : batch.m_serialTests) {
+		for (const std::pair<unsigned int, btCollisionObject *>& test : serialTests) {
+			const btVector3 from = ToBullet(batch.m_from[test.first]);
+			const btVector3 to = ToBullet(batch.m_to[test.first]);
+			CcdBatchHit& hit = batch.m_hits[test.first];
+
+			ResultCallback callback(*batch.m_filterCallback, from, to);
+			callback.m_collisionFilterMask = CcdConstructionInfo::AllFilter ^ CcdConstructionInfo::SensorFilter;
+			callback.m_closestHitFraction = hit.m_fraction;
+
+			BatchTestObject(batch, callback, btTransform(btMatrix3x3::getIdentity(), from), btTransform(btMatrix3x3::getIdentity(), to),
+			                test.second);
+			// Only closer hits are reported to the callback.
+			if (callback.m_closestHitFraction < hit.m_fraction) {
+				BatchStoreHit(callback, hit);
+			}
+		}
+	}
+}
+
+template <class ResultCallback>
+static void BatchTestRays(CcdRayTestBatch& batch, unsigned int task)
+{
+	// Static chunks of consecutive rays, the hits are independent of the number of tasks.
+	const unsigned int begin = batch.m_numRays * task / batch.m_numTasks;
+	const unsigned int end = batch.m_numRays * (task + 1) / batch.m_numTasks;
+
+	std::vector<const btDbvtNode *> stack;
+	stack.reserve(128);
+	for (unsigned int i = begin; i < end; ++i) {
+		BatchTestRay<ResultCallback>(batch, i, stack, batch.m_serialTests[task]);
+	}
+}
+
+static void RayTestBatchTask(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+	CcdRayTestBatch& batch = *(CcdRayTestBatch *)BLI_task_pool_userdata(pool);
+	const unsigned int task = GET_INT_FROM_POINTER(taskdata);
+	if (batch.m_castShape) {
+		BatchTestRays<FilterClosestConvexResultCallback>(batch, task);
+	}
+	else {
+		BatchTestRays<FilterClosestRayResultCallback>(batch, task);
+	}
+}
+
+void CcdPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback& filterCallback, const MT_Vector3 *from, const MT_Vector3 *to,
+                                         unsigned int numRays, float radius, PHY_RayCastResult *results)
+{
+	CompleteStep();
+
+	memset(results, 0, sizeof(PHY_RayCastResult) * numRays);
+
+	if (numRays == 0) {
+		return;
+	}
+
+	btSphereShape castShape(radius);
+
+	CcdRayTestBatch batch;
+	// The broadphase trees are traversed directly, they are not modified by the tests.
+	batch.m_numTrees = GetBroadphaseTrees(batch.m_trees);
+	batch.m_filterCallback = &filterCallback;
+	batch.m_from = from;
+	batch.m_to = to;
+	batch.m_numRays = numRays;
+	batch.m_castShape = (radius > 0.0f) ? &castShape : nullptr;
+
+	CcdBatchHit noHit;
+	noHit.m_object = nullptr;
+	noHit.m_fraction = 1.0f;
+	batch.m_hits.resize(numRays, noHit);
+
+	// Split in tasks of at least 16 rays.
+	const unsigned int numTasks = m_taskScheduler ? std::min((unsigned int)m_numThreads, (numRays + 15) / 16) : 1;
+	batch.m_numTasks = numTasks;
+	batch.m_serialTests.resize(numTasks);
+
+	if (numTasks > 1) {
+		TaskPool *pool = BLI_task_pool_create(m_taskScheduler, &batch);
+		for (unsigned int i = 0; i < numTasks; ++i) {
+			BLI_task_pool_push(pool, RayTestBatchTask, SET_INT_IN_POINTER(i), false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+	else if (batch.m_castShape) {
+		BatchTestRays<FilterClosestConvexResultCallback>(batch, 0);
+	}
+	else {
+		BatchTestRays<FilterClosestRayResultCallback>(batch, 0);
+	}
+
+	if (batch.m_castShape) {
+		BatchTestSerialObjects<FilterClosestConvexResultCallback>(batch);
+	}
+	else {
+		BatchTestSerialObjects<FilterClosestRayResultCallback>(batch);
+	}
+
+	for (unsigned int i = 0; i < numRays; ++i) {
+		const CcdBatchHit& hit = batch.m_hits[i];
+		if (hit.m_object) {
+			// The face normal and UV options aren't supported in batches.
+			GetRayCastResult(hit.m_object, hit.m_point, hit.m_normal, hit.m_triangleShape, hit.m_triangleIndex, false, false, results[i]);
+		}
+	}
+}
+
+class ClosestRayResultCallbackNotMe : public btCollisionWorld::ClosestRayResultCallback
+{
+	btCollisionObject *m_owner;
+	btCollisionObject *m_parent;
+
+public:
+	ClosestRayResultCallbackNotMe(const btVector3& rayFromWorld, const btVector3& rayToWorld, btCollisionObject *owner, btCollisionObject *parent)
+		:btCollisionWorld::ClosestRayResultCallback(rayFromWorld, rayToWorld),
+		m_owner(owner),
+		m_parent(parent)
+	{
+	}
+
+	virtual bool needsCollision(btBroadphaseProxy *proxy0) const
+	{
+		//don't collide with self
+		if (proxy0->m_clientObject == m_owner)
+			return false;
+
+		if (proxy0->m_clientObject == m_parent)
+			return false;
+
+		return btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy0);
+	}
+};
+
+/// Ray cast down from a controller using the Fh spring.
+struct CcdFhRay
+{
+	CcdPhysicsController *m_ctrl;
+	btRigidBody *m_body;
+	btRigidBody *m_parentBody;
+	btVector3 m_from;
+	btVector3 m_to;
+	CcdBatchHit m_hit;
+};
+
+/// Data shared by the tasks testing the Fh rays.
+struct CcdFhBatch
+{
+	const btDbvt *m_trees[3];
+	unsigned short m_numTrees;
+	std::vector<CcdFhRay> m_rays;
+	unsigned int m_numTasks;
+	/// Ray index and object tested after the tasks, one array per task.
+	std::vector<std::vector<std::pair<unsigned int, btCollisionObject *> > > m_serialTests;
+};
+
+static void FhStoreHit(const ClosestRayResultCallbackNotMe& callback, CcdBatchHit& hit)
+{
+	hit.m_object = callback.m_collisionObject;
+	hit.m_point = callback.m_hitPointWorld;
+	hit.m_normal = callback.m_hitNormalWorld;
+	hit.m_triangleShape = nullptr;
+	hit.m_triangleIndex = -1;
+	hit.m_fraction = callback.m_closestHitFraction;
+}
+
+static void FhTestRays(CcdFhBatch& batch, unsigned int task)
+{
+	const unsigned int numRays = batch.m_rays.size();
+	const unsigned int begin = numRays * task / batch.m_numTasks;
+	const unsigned int end = numRays * (task + 1) / batch.m_numTasks;
+	std::vector<std::pair<unsigned int, btCollisionObject *> >& serialTests = batch.m_serialTests[task];
+	const btVector3 zero(0.0f, 0.0f, 0.0f);
+
+	std::vector<const btDbvtNode *> stack;
+	stack.reserve(128);
+	for (unsigned int i = begin; i < end; ++i) {
+		CcdFhRay& ray = batch.m_rays[i];
+		ClosestRayResultCallbackNotMe callback(ray.m_from, ray.m_to, ray.m_body, ray.m_parentBody);
+		const btTransform fromTrans(btMatrix3x3::getIdentity(), ray.m_from);
+		const btTransform toTrans(btMatrix3x3::getIdentity(), ray.m_to);
+
+		BatchTraverseTrees(batch.m_trees, batch.m_numTrees, ray.m_from, ray.m_to, zero, zero, callback, stack,
+		                   [&](btCollisionObject *object) {
+			if (IsSerialRayTestObject(object)) {
+				serialTests.emplace_back(i, object);
+			}
+			else {
+				btSoftRigidDynamicsWorld::rayTestSingle(fromTrans, toTrans, object, object->getCollisionShape(),
+				                                        object->getWorldTransform(), callback);
+			}
+		});
+
+		if (callback.hasHit()) {
+			FhStoreHit(callback, ray.m_hit);
+		}
+	}
+}
+
+static void FhTestRaysTask(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+	CcdFhBatch& batch = *(CcdFhBatch *)BLI_task_pool_userdata(pool);
+	FhTestRays(batch, GET_INT_FROM_POINTER(taskdata));
+}
+
+static void FhTestSerialObjects(CcdFhBatch& batch)
+{
+	for (const std::vector<std::pair<unsigned int, btCollisionObject *> >& serialTests : batch.m_serialTests) {
+		for (const std::pair<unsigned int, btCollisionObject *>& test : serialTests) {
+			CcdFhRay& ray = batch.m_rays[test.first];
+			btCollisionObject *object = test.second;
+
+			ClosestRayResultCallbackNotMe callback(ray.m_from, ray.m_to, ray.m_body, ray.m_parentBody);
+			callback.m_closestHitFraction = ray.m_hit.m_fraction;
+
+			btSoftRigidDynamicsWorld::rayTestSingle(btTransform(btMatrix3x3::getIdentity(), ray.m_from),
+			                                        btTransform(btMatrix3x3::getIdentity(), ray.m_to),
+			                                        object, object->getCollisionShape(), object->getWorldTransform(), callback);
+			if (callback.m_closestHitFraction < ray.m_hit.m_fraction) {
+				FhStoreHit(callback, ray.m_hit);
+			}
+		}
+	}
+}
+
+void CcdPhysicsEnvironment::ProcessFhSprings(double curTime, float interval)
+{
+	const float step = interval * KX_GetActiveEngine()->GetTicRate();
+	//send a ray from {0.0, 0.0, 0.0} towards {0.0, 0.0, -10.0}, in local coordinates
+	const btVector3 rayDirLocal(0.0f, 0.0f, -10.0f);
+
+	CcdBatchHit noHit;
+	noHit.m_object = nullptr;
+	noHit.m_fraction = 1.0f;
+
+	/* The rays are gathered first and tested together, the forces only change the velocities
+	 * so the hits are the same as when each ray was cast just before applying its forces. */
+	CcdFhBatch batch;
+	for (CcdPhysicsController *ctrl : m_controllers) {
+		btRigidBody *body = ctrl->GetRigidBody();
+
+		if (!body || body->isStaticOrKinematicObject() ||
+		    !(ctrl->GetConstructionInfo().m_do_fh || ctrl->GetConstructionInfo().m_do_rot_fh))
+		{
+			continue;
+		}
+
+		//re-implement SM_FhObject.cpp using btCollisionWorld::rayTest and info from ctrl->getConstructionInfo()
+		CcdPhysicsController *parentCtrl = ctrl->GetParentCtrl();
+
+		CcdFhRay ray;
+		ray.m_ctrl = ctrl;
+		ray.m_body = body;
+		ray.m_parentBody = parentCtrl ? parentCtrl->GetRigidBody() : nullptr;
+		ray.m_from = body->getCenterOfMassPosition();
+		//ray always points down the z axis in world space...
+		ray.m_to = ray.m_from + rayDirLocal;
+		ray.m_hit = noHit;
+		batch.m_rays.push_back(ray);
 	}
 
-	virtual ~FilterClosestRayResultCallback()
-	{
+	if (batch.m_rays.empty()) {
+		return;
 	}
 
-	virtual bool needsCollision(btBroadphaseProxy *proxy0) const
-	{
-		if (!(proxy0->m_collisionFilterGroup & m_collisionFilterMask))
-			return false;
-		if (!(m_collisionFilterGroup & proxy0->m_collisionFilterMask))
-			return false;
-		btCollisionObject *object = (btCollisionObject *)proxy0->m_clientObject;
-		CcdPhysicsController *phyCtrl = static_cast<CcdPhysicsController *>(object->getUserPointer());
-		if (phyCtrl == m_phyRayFilter.m_ignoreController)
-			return false;
-		return m_phyRayFilter.needBroadphaseRayCast(phyCtrl);
+	// The broadphase trees are traversed directly, they are not modified by the tests.
+	batch.m_numTrees = GetBroadphaseTrees(batch.m_trees);
+
+	// Split in tasks of at least 16 rays like the batched ray tests.
+	const unsigned int numRays = batch.m_rays.size();
+	const unsigned int numTasks = m_taskScheduler ? std::min((unsigned int)m_numThreads, (numRays + 15) / 16) : 1;
+	batch.m_numTasks = numTasks;
+	batch.m_serialTests.resize(numTasks);
+
+	if (numTasks > 1) {
+		TaskPool *pool = BLI_task_pool_create(m_taskScheduler, &batch);
+		for (unsigned int i = 0; i < numTasks; ++i) {
+			BLI_task_pool_push(pool, FhTestRaysTask, SET_INT_IN_POINTER(i), false, TASK_PRIORITY_HIGH);
+		}
+		BLI_task_pool_work_and_wait(pool);
+		BLI_task_pool_free(pool);
+	}
+	else {
+		FhTestRays(batch, 0);
 	}
 
-	virtual btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace)
-	{
-		//CcdPhysicsController* curHit = static_cast<CcdPhysicsController*>(rayResult.m_collisionObject->getUserPointer());
-		// save shape information as ClosestRayResultCallback::AddSingleResult() does not do it
-		if (rayResult.m_localShapeInfo) {
-			m_hitTriangleShape = rayResult.m_collisionObject->getCollisionShape();
-			m_hitTriangleIndex = rayResult.m_localShapeInfo->m_triangleIndex;
+	FhTestSerialObjects(batch);
+
+	// The forces are applied in the order of the controllers.
+	for (const CcdFhRay& ray : batch.m_rays) {
+		if (!ray.m_hit.m_object) {
+			continue;
 		}
-		else {
-			m_hitTriangleShape = nullptr;
-			m_hitTriangleIndex = 0;
+
+		//we hit this one: ray.m_hit.m_object;
+		CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(ray.m_hit.m_object->getUserPointer());
+		if (!controller) {
+			continue;
 		}
-		return ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
-	}
-};
 
-static bool GetHitTriangle(btCollisionShape *shape, CcdShapeConstructionInfo *shapeInfo, int hitTriangleIndex, btVector3 triangle[])
-{
-	// this code is copied from Bullet
-	const unsigned char *vertexbase;
-	int numverts;
-	PHY_ScalarType type;
-	int stride;
-	const unsigned char *indexbase;
-	int indexstride;
-	int numfaces;
-	PHY_ScalarType indicestype;
-	btStridingMeshInterface *meshInterface = shapeInfo->GetMeshInterface();
+		if (controller->GetConstructionInfo().m_fh_distance < SIMD_EPSILON)
+			continue;
 
-	if (!meshInterface)
-		return false;
+		btRigidBody *hit_object = controller->GetRigidBody();
+		if (!hit_object)
+			continue;
 
-	meshInterface->getLockedReadOnlyVertexIndexBase(
-	    &vertexbase,
-	    numverts,
-	    type,
-	    stride,
-	    &indexbase,
-	    indexstride,
-	    numfaces,
-	    indicestype,
-	    0);
+		CcdPhysicsController *ctrl = ray.m_ctrl;
+		btRigidBody *cl_object = ray.m_parentBody ? ray.m_parentBody : ray.m_body;
+		CcdConstructionInfo& hitObjShapeProps = controller->GetConstructionInfo();
 
-	unsigned int *gfxbase = (unsigned int *)(indexbase + hitTriangleIndex * indexstride);
-	const btVector3& meshScaling = shape->getLocalScaling();
-	for (int j = 2; j >= 0; j--) {
-		int graphicsindex = (indicestype == PHY_SHORT) ? ((unsigned short *)gfxbase)[j] : gfxbase[j];
+		float distance = ray.m_hit.m_fraction * rayDirLocal.length() - ctrl->GetConstructionInfo().m_radius;
+		if (distance >= hitObjShapeProps.m_fh_distance)
+			continue;
 
-		btScalar *graphicsbase = (btScalar *)(vertexbase + graphicsindex * stride);
+		//btVector3 ray_dir = cl_object->getCenterOfMassTransform().getBasis()* rayDirLocal.normalized();
+		btVector3 ray_dir = rayDirLocal.normalized();
+		btVector3 normal = ray.m_hit.m_normal;
+		normal.normalize();
 
-		triangle[j] = btVector3(graphicsbase[0] * meshScaling.getX(), graphicsbase[1] * meshScaling.getY(), graphicsbase[2] * meshScaling.getZ());
-	}
-	meshInterface->unLockReadOnlyVertexBase(0);
-	return true;
-}
+		if (ctrl->GetConstructionInfo().m_do_fh) {
+			btVector3 lspot = cl_object->getCenterOfMassPosition() +
+			                  rayDirLocal * ray.m_hit.m_fraction;
 
-PHY_IPhysicsController *CcdPhysicsEnvironment::RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ)
-{
-	btVector3 rayFrom(fromX, fromY, fromZ);
-	btVector3 rayTo(toX, toY, toZ);
+			lspot -= hit_object->getCenterOfMassPosition();
+			btVector3 rel_vel = cl_object->getLinearVelocity() - hit_object->getVelocityInLocalPoint(lspot);
+			btScalar rel_vel_ray = ray_dir.dot(rel_vel);
+			btScalar spring_extent = 1.0f - distance / hitObjShapeProps.m_fh_distance;
 
-	btVector3 hitPointWorld, normalWorld;
+			btScalar i_spring = spring_extent * hitObjShapeProps.m_fh_spring;
+			btScalar i_damp =   rel_vel_ray * hitObjShapeProps.m_fh_damping;
 
-	//Either Ray Cast with or without filtering
+			cl_object->setLinearVelocity(cl_object->getLinearVelocity() + (-(i_spring + i_damp) * ray_dir) * step);
+			if (hitObjShapeProps.m_fh_normal) {
+				cl_object->setLinearVelocity(cl_object->getLinearVelocity() + (i_spring + i_damp) * (normal - normal.dot(ray_dir) * ray_dir) * step);
+			}
 
-	//btCollisionWorld::ClosestRayResultCallback rayCallback(rayFrom,rayTo);
-	FilterClosestRayResultCallback rayCallback(filterCallback, rayFrom, rayTo);
+			btVector3 lateral = rel_vel - rel_vel_ray * ray_dir;
 
-	PHY_RayCastResult result;
-	memset(&result, 0, sizeof(result));
+			if (ctrl->GetConstructionInfo().m_do_anisotropic) {
+				//Bullet basis contains no scaling/shear etc.
+				const btMatrix3x3& lcs = cl_object->getCenterOfMassTransform().getBasis();
+				btVector3 loc_lateral = lateral * lcs;
+				const btVector3& friction_scaling = cl_object->getAnisotropicFriction();
+				loc_lateral *= friction_scaling;
+				lateral = lcs * loc_lateral;
+			}
 
-	// don't collision with sensor object
-	rayCallback.m_collisionFilterMask = CcdConstructionInfo::AllFilter ^ CcdConstructionInfo::SensorFilter;
-	// use faster (less accurate) ray callback, works better with 0 collision margins
-	rayCallback.m_flags |= btTriangleRaycastCallback::kF_UseSubSimplexConvexCastRaytest;
-	//, ,filterCallback.m_faceNormal);
+			btScalar rel_vel_lateral = lateral.length();
 
-	m_dynamicsWorld->rayTest(rayFrom, rayTo, rayCallback);
-	if (rayCallback.hasHit()) {
-		CcdPhysicsController *controller = static_cast<CcdPhysicsController *>(rayCallback.m_collisionObject->getUserPointer());
-		result.m_controller = controller;
-		result.m_hitPoint[0] = rayCallback.m_hitPointWorld.getX();
-		result.m_hitPoint[1] = rayCallback.m_hitPointWorld.getY();
-		result.m_hitPoint[2] = rayCallback.m_hitPointWorld.getZ();
-
-		if (rayCallback.m_hitTriangleShape != nullptr) {
-			// identify the mesh polygon
-			CcdShapeConstructionInfo *shapeInfo = controller->m_shapeInfo;
-			if (shapeInfo) {
-				btCollisionShape *shape = controller->GetCollisionObject()->getCollisionShape();
-				if (shape->isCompound()) {
-					btCompoundShape *compoundShape = (btCompoundShape *)shape;
-					CcdShapeConstructionInfo *compoundShapeInfo = shapeInfo;
-					// need to search which sub-shape has been hit
-					for (int i = 0; i < compoundShape->getNumChildShapes(); i++) {
-						shapeInfo = compoundShapeInfo->GetChildShape(i);
-						shape = compoundShape->getChildShape(i);
-						if (shape == rayCallback.m_hitTriangleShape)
-							break;
-					}
-				}
-				if (shape == rayCallback.m_hitTriangleShape &&
-				    rayCallback.m_hitTriangleIndex < shapeInfo->m_polygonIndexArray.size())
-				{
-					// save original collision shape triangle for soft body
-					int hitTriangleIndex = rayCallback.m_hitTriangleIndex;
+			if (rel_vel_lateral > SIMD_EPSILON) {
+				btScalar friction_factor = hit_object->getFriction();//cl_object->getFriction();
 
-					result.m_meshObject = shapeInfo->GetMesh();
-					if (shape->isSoftBody()) {
-						// soft body using different face numbering because of randomization
-						// hopefully we have stored the original face number in m_tag
-						const btSoftBody *softBody = static_cast<const btSoftBody *>(rayCallback.m_collisionObject);
-						if (softBody->m_faces[hitTriangleIndex].m_tag != 0) {
-							rayCallback.m_hitTriangleIndex = (int)((uintptr_t)(softBody->m_faces[hitTriangleIndex].m_tag) - 1);
-						}
-					}
-					// retrieve the original mesh polygon (in case of quad->tri conversion)
-					result.m_polygon = shapeInfo->m_polygonIndexArray.at(rayCallback.m_hitTriangleIndex);
-					// hit triangle in world coordinate, for face normal and UV coordinate
-					btVector3 triangle[3];
-					bool triangleOK = false;
-					if (filterCallback.m_faceUV && (3 * rayCallback.m_hitTriangleIndex) < shapeInfo->m_triFaceUVcoArray.size()) {
-						// interpolate the UV coordinate of the hit point
-						CcdShapeConstructionInfo::UVco *uvCo = &shapeInfo->m_triFaceUVcoArray[3 * rayCallback.m_hitTriangleIndex];
-						// 1. get the 3 coordinate of the triangle in world space
-						btVector3 v1, v2, v3;
-						if (shape->isSoftBody()) {
-							// soft body give points directly in world coordinate
-							const btSoftBody *softBody = static_cast<const btSoftBody *>(rayCallback.m_collisionObject);
-							v1 = softBody->m_faces[hitTriangleIndex].m_n[0]->m_x;
-							v2 = softBody->m_faces[hitTriangleIndex].m_n[1]->m_x;
-							v3 = softBody->m_faces[hitTriangleIndex].m_n[2]->m_x;
-						}
-						else {
-							// for rigid body we must apply the world transform
-							triangleOK = GetHitTriangle(shape, shapeInfo, hitTriangleIndex, triangle);
-							if (!triangleOK)
-								// if we cannot get the triangle, no use to continue
-								goto SKIP_UV_NORMAL;
-							v1 = rayCallback.m_collisionObject->getWorldTransform()(triangle[0]);
-							v2 = rayCallback.m_collisionObject->getWorldTransform()(triangle[1]);
-							v3 = rayCallback.m_collisionObject->getWorldTransform()(triangle[2]);
-						}
-						// 2. compute barycentric coordinate of the hit point
-						btVector3 v = v2 - v1;
-						btVector3 w = v3 - v1;
-						btVector3 u = v.cross(w);
-						btScalar A = u.length();
-
-						v = v2 - rayCallback.m_hitPointWorld;
-						w = v3 - rayCallback.m_hitPointWorld;
-						u = v.cross(w);
-						btScalar A1 = u.length();
-
-						v = rayCallback.m_hitPointWorld - v1;
-						w = v3 - v1;
-						u = v.cross(w);
-						btScalar A2 = u.length();
-
-						btVector3 baryCo;
-						baryCo.setX(A1 / A);
-						baryCo.setY(A2 / A);
-						baryCo.setZ(1.0f - baryCo.getX() - baryCo.getY());
-						// 3. compute UV coordinate
-						result.m_hitUV[0] = baryCo.getX() * uvCo[0].uv[0] + baryCo.getY() * uvCo[1].uv[0] + baryCo.getZ() * uvCo[2].uv[0];
-						result.m_hitUV[1] = baryCo.getX() * uvCo[0].uv[1] + baryCo.getY() * uvCo[1].uv[1] + baryCo.getZ() * uvCo[2].uv[1];
-						result.m_hitUVOK = 1;
-					}
+				btScalar max_friction = friction_factor * btMax(btScalar(0.0), i_spring);
 
-					// Bullet returns the normal from "outside".
-					// If the user requests the real normal, compute it now
-					if (filterCallback.m_faceNormal) {
-						if (shape->isSoftBody()) {
-							// we can get the real normal directly from the body
-							const btSoftBody *softBody = static_cast<const btSoftBody *>(rayCallback.m_collisionObject);
-							rayCallback.m_hitNormalWorld = softBody->m_faces[hitTriangleIndex].m_normal;
-						}
-						else {
-							if (!triangleOK)
-								triangleOK = GetHitTriangle(shape, shapeInfo, hitTriangleIndex, triangle);
-							if (triangleOK) {
-								btVector3 triangleNormal;
-								triangleNormal = (triangle[1] - triangle[0]).cross(triangle[2] - triangle[0]);
-								rayCallback.m_hitNormalWorld = rayCallback.m_collisionObject->getWorldTransform().getBasis() * triangleNormal;
-							}
-						}
-					}
-SKIP_UV_NORMAL:
-					;
-				}
+				btScalar rel_mom_lateral = rel_vel_lateral / cl_object->getInvMass();
+
+				btVector3 friction = (rel_mom_lateral > max_friction) ?
+				                     -lateral * (max_friction / rel_vel_lateral) :
+				                     -lateral;
+
+				cl_object->applyCentralImpulse(friction * step);
 			}
 		}
-		if (rayCallback.m_hitNormalWorld.length2() > (SIMD_EPSILON * SIMD_EPSILON)) {
-			rayCallback.m_hitNormalWorld.normalize();
-		}
-		else {
-			rayCallback.m_hitNormalWorld.setValue(1.0f, 0.0f, 0.0f);
+
+
+		if (ctrl->GetConstructionInfo().m_do_rot_fh) {
+			btVector3 up2 = cl_object->getWorldTransform().getBasis().getColumn(2);
+
+			btVector3 t_spring = up2.cross(normal) * hitObjShapeProps.m_fh_spring;
+			btVector3 ang_vel = cl_object->getAngularVelocity();
+
+			// only rotations that tilt relative to the normal are damped
+			ang_vel -= ang_vel.dot(normal) * normal;
+
+			btVector3 t_damp = ang_vel * hitObjShapeProps.m_fh_damping;
+
+			cl_object->setAngularVelocity(cl_object->getAngularVelocity() + (t_spring - t_damp) * step);
 		}
-		result.m_hitNormal[0] = rayCallback.m_hitNormalWorld.getX();
-		result.m_hitNormal[1] = rayCallback.m_hitNormalWorld.getY();
-		result.m_hitNormal[2] = rayCallback.m_hitNormalWorld.getZ();
-		filterCallback.reportHit(&result);
 	}
-
-	return result.m_controller;
 }
 
 // Handles occlusion culling.
@@ -1927,6 +2644,316 @@ bool CcdPhysicsEnvironment::CullingTest(PHY_CullingCallback callback, void *user
 	return true;
 }
 
+/// Increase when the layout of the saved states changes.
+#define CCD_PHYSICS_STATE_VERSION 1
+
+/** Records of a saved physics state. The header is followed by the body, character,
+ * constraint and manifold records, each manifold record is followed by its contact points.
+ * The records are copied with memcpy, the buffer has no alignment requirements.
+ */
+struct CcdStateHeader
+{
+	uint32_t m_version;
+	uint32_t m_numBodies;
+	uint32_t m_numCharacters;
+	uint32_t m_numConstraints;
+	uint32_t m_numManifolds;
+	const CcdPhysicsEnvironment *m_environment;
+};
+
+struct CcdBodyState
+{
+	/// The object and its index in the collision object array of the world.
+	const btCollisionObject *m_object;
+	int m_index;
+	int m_activationState;
+	btScalar m_deactivationTime;
+	btTransform m_transform;
+	btVector3 m_linearVelocity;
+	btVector3 m_angularVelocity;
+};
+
+struct CcdCharacterState
+{
+	const btCollisionObject *m_object;
+	int m_index;
+	btTransform m_transform;
+	BlenderBulletCharacterController::State m_state;
+};
+
+struct CcdConstraintState
+{
+	const btTypedConstraint *m_constraint;
+	int m_index;
+	int m_enabled;
+	btScalar m_appliedImpulse;
+};
+
+struct CcdManifoldState
+{
+	const btPersistentManifold *m_manifold;
+	const btCollisionObject *m_body0;
+	const btCollisionObject *m_body1;
+	int m_numContacts;
+};
+
+template <class Record>
+static void WriteState(char *& data, const Record& record)
+{
+	memcpy(data, &record, sizeof(Record));
+	data += sizeof(Record);
+}
+
+template <class Record>
+static bool ReadState(const char *& data, const char *end, Record& record)
+{
+	if ((size_t)(end - data) < sizeof(Record)) {
+		return false;
+	}
+
+	memcpy(&record, data, sizeof(Record));
+	data += sizeof(Record);
+	return true;
+}
+
+/// Return the character controller using a collision object, nullptr if the object is not a character.
+static BlenderBulletCharacterController *GetObjectCharacter(const btCollisionObject *object)
+{
+	if (object->getInternalType() != btCollisionObject::CO_GHOST_OBJECT) {
+		return nullptr;
+	}
+
+	CcdPhysicsController *ctrl = (CcdPhysicsController *)object->getUserPointer();
+	return (ctrl) ? static_cast<BlenderBulletCharacterController *>(ctrl->GetCharacterController()) : nullptr;
+}
+
+/// Return true if the state of the object is saved, kinematic objects are moved by the game objects.
+static bool IsStateBody(const btCollisionObject *object)
+{
+	const btRigidBody *body = btRigidBody::upcast(object);
+	return (body && !body->isStaticOrKinematicObject());
+}
+
+void CcdPhysicsEnvironment::SaveState(std::vector<char>& state)
+{
+	CompleteStep();
+
+	const btCollisionObjectArray& objects = m_dynamicsWorld->getCollisionObjectArray();
+	btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
+	const int numObjects = objects.size();
+	const int numConstraints = m_dynamicsWorld->getNumConstraints();
+	const int numManifolds = dispatcher->getNumManifolds();
+
+	CcdStateHeader header = {CCD_PHYSICS_STATE_VERSION, 0, 0, (uint32_t)numConstraints, (uint32_t)numManifolds, this};
+
+	for (int i = 0; i < numObjects; ++i) {
+		const btCollisionObject *object = objects[i];
+		if (IsStateBody(object)) {
+			++header.m_numBodies;
+		}
+		else if (GetObjectCharacter(object)) {
+			++header.m_numCharacters;
+		}
+	}
+
+	size_t size = sizeof(CcdStateHeader) + header.m_numBodies * sizeof(CcdBodyState) +
+	              header.m_numCharacters * sizeof(CcdCharacterState) + numConstraints * sizeof(CcdConstraintState) +
+	              numManifolds * sizeof(CcdManifoldState);
+	for (int i = 0; i < numManifolds; ++i) {
+		size += dispatcher->getManifoldByIndexInternal(i)->getNumContacts() * sizeof(btManifoldPoint);
+	}
+
+	// Keep the capacity of the buffer, no allocation once it reached the size of the state.
+	state.resize(size);
+	char *data = state.data();
+
+	WriteState(data, header);
+
+	for (int i = 0; i < numObjects; ++i) {
+		const btCollisionObject *object = objects[i];
+		if (!IsStateBody(object)) {
+			continue;
+		}
+
+		const btRigidBody *body = btRigidBody::upcast(object);
+		CcdBodyState record;
+		record.m_object = object;
+		record.m_index = i;
+		record.m_activationState = body->getActivationState();
+		record.m_deactivationTime = body->getDeactivationTime();
+		record.m_transform = body->getCenterOfMassTransform();
+		record.m_linearVelocity = body->getLinearVelocity();
+		record.m_angularVelocity = body->getAngularVelocity();
+		WriteState(data, record);
+	}
+
+	for (int i = 0; i < numObjects; ++i) {
+		const btCollisionObject *object = objects[i];
+		BlenderBulletCharacterController *character = GetObjectCharacter(object);
+		if (!character || IsStateBody(object)) {
+			continue;
+		}
+
+		CcdCharacterState record;
+		record.m_object = object;
+		record.m_index = i;
+		record.m_transform = object->getWorldTransform();
+		character->SaveState(record.m_state);
+		WriteState(data, record);
+	}
+
+	for (int i = 0; i < numConstraints; ++i) {
+		btTypedConstraint *constraint = m_dynamicsWorld->getConstraint(i);
+		const CcdConstraintState record = {constraint, i, constraint->isEnabled(), constraint->internalGetAppliedImpulse()};
+		WriteState(data, record);
+	}
+
+	for (int i = 0; i < numManifolds; ++i) {
+		const btPersistentManifold *manifold = dispatcher->getManifoldByIndexInternal(i);
+		const int numContacts = manifold->getNumContacts();
+		const CcdManifoldState record = {manifold, manifold->getBody0(), manifold->getBody1(), numContacts};
+		WriteState(data, record);
+		for (int j = 0; j < numContacts; ++j) {
+			WriteState(data, manifold->getContactPoint(j));
+		}
+	}
+
+	BLI_assert(data == state.data() + size);
+}
+
+bool CcdPhysicsEnvironment::RestoreState(const char *state, unsigned int size)
+{
+	CompleteStep();
+
+	const btCollisionObjectArray& objects = m_dynamicsWorld->getCollisionObjectArray();
+	btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
+	const int numObjects = objects.size();
+	const int numConstraints = m_dynamicsWorld->getNumConstraints();
+
+	const char *end = state + size;
+	const char *data = state;
+
+	/* Validate the whole state before modifying the world, the objects and constraints
+	 * must be at the same indices as when the state was saved. */
+	CcdStateHeader header;
+	bool valid = ReadState(data, end, header) && header.m_version == CCD_PHYSICS_STATE_VERSION && header.m_environment == this;
+
+	for (unsigned int i = 0; i < header.m_numBodies && valid; ++i) {
+		CcdBodyState record;
+		valid = ReadState(data, end, record) && record.m_index >= 0 && record.m_index < numObjects &&
+		        objects[record.m_index] == record.m_object && IsStateBody(record.m_object);
+	}
+
+	for (unsigned int i = 0; i < header.m_numCharacters && valid; ++i) {
+		CcdCharacterState record;
+		valid = ReadState(data, end, record) && record.m_index >= 0 && record.m_index < numObjects &&
+		        objects[record.m_index] == record.m_object && GetObjectCharacter(record.m_object);
+	}
+
+	for (unsigned int i = 0; i < header.m_numConstraints && valid; ++i) {
+		CcdConstraintState record;
+		valid = ReadState(data, end, record) && record.m_index >= 0 && record.m_index < numConstraints &&
+		        m_dynamicsWorld->getConstraint(record.m_index) == record.m_constraint;
+	}
+
+	m_stateManifolds.clear();
+	for (unsigned int i = 0; i < header.m_numManifolds && valid; ++i) {
+		const unsigned int offset = data - state;
+		CcdManifoldState record;
+		valid = ReadState(data, end, record) && record.m_numContacts >= 0 && record.m_numContacts <= MANIFOLD_CACHE_SIZE &&
+		        (size_t)(end - data) >= record.m_numContacts * sizeof(btManifoldPoint);
+		if (valid) {
+			data += record.m_numContacts * sizeof(btManifoldPoint);
+			m_stateManifolds.emplace_back(record.m_manifold, offset);
+		}
+	}
+
+	if (!valid || data != end) {
+		CM_Error("invalid physics state, it was not saved by this scene or objects were added or removed since");
+		return false;
+	}
+
+	data = state + sizeof(CcdStateHeader);
+
+	for (unsigned int i = 0; i < header.m_numBodies; ++i) {
+		CcdBodyState record;
+		ReadState(data, end, record);
+
+		btRigidBody *body = btRigidBody::upcast(objects[record.m_index]);
+		body->setCenterOfMassTransform(record.m_transform);
+		body->setLinearVelocity(record.m_linearVelocity);
+		body->setAngularVelocity(record.m_angularVelocity);
+		body->setInterpolationLinearVelocity(record.m_linearVelocity);
+		body->setInterpolationAngularVelocity(record.m_angularVelocity);
+		body->clearForces();
+		body->forceActivationState(record.m_activationState);
+		body->setDeactivationTime(record.m_deactivationTime);
+		m_dynamicsWorld->updateSingleAabb(body);
+
+		CcdPhysicsController *ctrl = (CcdPhysicsController *)body->getUserPointer();
+		if (ctrl) {
+			if (ctrl->IsSimulationActive()) {
+				AddActiveController(ctrl);
+			}
+			ctrl->SynchronizeMotionStates(0.0f);
+		}
+	}
+
+	for (unsigned int i = 0; i < header.m_numCharacters; ++i) {
+		CcdCharacterState record;
+		ReadState(data, end, record);
+
+		btCollisionObject *object = objects[record.m_index];
+		object->setWorldTransform(record.m_transform);
+		m_dynamicsWorld->updateSingleAabb(object);
+		GetObjectCharacter(object)->RestoreState(record.m_state);
+	}
+
+	for (unsigned int i = 0; i < header.m_numConstraints; ++i) {
+		CcdConstraintState record;
+		ReadState(data, end, record);
+
+		btTypedConstraint *constraint = m_dynamicsWorld->getConstraint(record.m_index);
+		constraint->setEnabled(record.m_enabled);
+		constraint->internalSetAppliedImpulse(record.m_appliedImpulse);
+	}
+
+	/* Restore the contact points used to warm start the solver in the manifolds still existing,
+	 * the manifolds created since the state was saved are emptied and refilled by the next step. */
+	std::sort(m_stateManifolds.begin(), m_stateManifolds.end());
+
+	const int numManifolds = dispatcher->getNumManifolds();
+	for (int i = 0; i < numManifolds; ++i) {
+		btPersistentManifold *manifold = dispatcher->getManifoldByIndexInternal(i);
+		const std::pair<const btPersistentManifold *, unsigned int> key(manifold, 0);
+		const auto it = std::lower_bound(m_stateManifolds.begin(), m_stateManifolds.end(), key);
+
+		if (it == m_stateManifolds.end() || it->first != manifold) {
+			manifold->clearManifold();
+			continue;
+		}
+
+		CcdManifoldState record;
+		data = state + it->second;
+		ReadState(data, end, record);
+		// The manifold memory can be reused by an other pair.
+		if (record.m_body0 != manifold->getBody0() || record.m_body1 != manifold->getBody1()) {
+			manifold->clearManifold();
+			continue;
+		}
+
+		manifold->setNumContacts(record.m_numContacts);
+		for (int j = 0; j < record.m_numContacts; ++j) {
+			btManifoldPoint& point = manifold->getContactPoint(j);
+			ReadState(data, end, point);
+			// The user data is owned by the current contacts, never used by the engine.
+			point.m_userPersistentData = nullptr;
+		}
+	}
+
+	return true;
+}
+
 int CcdPhysicsEnvironment::GetNumContactPoints()
 {
 	return 0;
@@ -1941,6 +2968,27 @@ btBroadphaseInterface *CcdPhysicsEnvironment::GetBroadphase()
 	return m_dynamicsWorld->getBroadphase();
 }
 
+unsigned short CcdPhysicsEnvironment::GetBroadphaseTrees(const btDbvt *trees[3]) const
+{
+	switch (m_broadphaseType) {
+		case CCD_BROADPHASE_AXIS_SWEEP:
+		{
+			const btDbvtBroadphase *accelerator = static_cast<CcdAxisSweep3 *>(m_broadphase)->GetRaycastAccelerator();
+			trees[0] = &accelerator->m_sets[0];
+			trees[1] = &accelerator->m_sets[1];
+			return 2;
+		}
+		default:
+		{
+			const CcdDbvtBroadphase *broadphase = static_cast<CcdDbvtBroadphase *>(m_broadphase);
+			trees[0] = &broadphase->m_sets[0];
+			trees[1] = &broadphase->m_sets[1];
+			trees[2] = &broadphase->m_staticSet;
+			return 3;
+		}
+	}
+}
+
 btDispatcher *CcdPhysicsEnvironment::GetDispatcher()
 {
 	return m_dynamicsWorld->getDispatcher();
@@ -1948,6 +2996,8 @@ btDispatcher *CcdPhysicsEnvironment::GetDispatcher()
 
 void CcdPhysicsEnvironment::MergeEnvironment(PHY_IPhysicsEnvironment *other_env)
 {
+	CompleteStep();
+
 	CcdPhysicsEnvironment *other = dynamic_cast<CcdPhysicsEnvironment *>(other_env);
 	if (other == nullptr) {
 		CM_Error("other scene is not using Bullet physics, not merging physics.");
@@ -1967,6 +3017,16 @@ void CcdPhysicsEnvironment::MergeEnvironment(PHY_IPhysicsEnvironment *other_env)
 
 CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
 {
+	// The results of the step are not published, the game objects can be already freed.
+	WaitStep();
+	m_pendingMotionStates.clear();
+	m_pendingCommands.clear();
+	m_stepPublish = false;
+	if (m_stepPool) {
+		BLI_task_pool_free(m_stepPool);
+		BLI_task_scheduler_free(m_stepScheduler);
+	}
+
 	m_wrapperVehicles.clear();
 
 	//m_broadphase->DestroyScene();
@@ -2005,6 +3065,15 @@ CcdPhysicsEnvironment::~CcdPhysicsEnvironment()
 
 	if (nullptr != m_cullingCache)
 		delete m_cullingCache;
+
+	if (m_taskScheduler) {
+		BLI_task_scheduler_free(m_taskScheduler);
+	}
+
+	// The cache is written when the last shape using it is freed.
+	if (m_shapeCache) {
+		m_shapeCache->Release();
+	}
 }
 
 btTypedConstraint *CcdPhysicsEnvironment::GetConstraintById(int constraintId)
@@ -2062,6 +3131,12 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 	//walk over all overlapping pairs, and if one of the involved bodies is registered for trigger callback, perform callback
 	btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
 	int numManifolds = dispatcher->getNumManifolds();
+
+	/* The callbacks keep a pointer to the collision data until the next step,
+	 * reserve to never reallocate the array while they are called. */
+	m_collData.clear();
+	m_collData.reserve(numManifolds);
+
 	for (int i = 0; i < numManifolds; i++) {
 		bool colliding_ctrl0 = true;
 		btPersistentManifold *manifold = dispatcher->getManifoldByIndexInternal(i);
@@ -2098,7 +3173,8 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 		}
 
 		if (usecallback) {
-			const CcdCollData *coll_data = new CcdCollData(manifold);
+			m_collData.emplace_back(manifold);
+			const CcdCollData *coll_data = &m_collData.back();
 
 			m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE],
 				colliding_ctrl0 ? ctrl0 : ctrl1, colliding_ctrl0 ? ctrl1 : ctrl0, coll_data);
@@ -2243,6 +3319,8 @@ PHY_IConstraint *CcdPhysicsEnvironment::CreateConstraint(class PHY_IPhysicsContr
 											float axis1X, float axis1Y, float axis1Z,
 											float axis2X, float axis2Y, float axis2Z, int flags)
 {
+	CompleteStep();
+
 	bool disableCollisionBetweenLinkedBodies = (0 != (flags & CCD_CONSTRAINT_DISABLE_LINKED_COLLISION));
 
 	CcdPhysicsController *c0 = (CcdPhysicsController *)ctrl0;
@@ -2655,14 +3733,30 @@ struct BlenderDebugDraw : public btIDebugDraw
 	}
 };
 
-CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool visualizePhysics)
+CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool visualizePhysics, const std::string& blendpath)
 {
-	CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment((blenderscene->gm.mode & WO_DBVT_CULLING) != 0);
+	// Zero threads uses all the processors, the simulation is then only reproducible on the same machine.
+	const int numThreads = (blenderscene->gm.physicsThreads == 0) ? BLI_system_thread_count() : blenderscene->gm.physicsThreads;
+	const int broadphaseType = (blenderscene->gm.physicsBroadphase == GAME_PHYSICS_BROADPHASE_AXIS_SWEEP) ?
+	                           CCD_BROADPHASE_AXIS_SWEEP : CCD_BROADPHASE_DBVT;
+	CcdPhysicsEnvironment *ccdPhysEnv = new CcdPhysicsEnvironment((blenderscene->gm.mode & WO_DBVT_CULLING) != 0, numThreads,
+	                                                              broadphaseType, blenderscene->gm.physicsWorldSize);
 	ccdPhysEnv->SetDebugDrawer(new BlenderDebugDraw());
 	ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
 	ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
 	ccdPhysEnv->SetDeactivationTime(blenderscene->gm.deactivationtime);
 
+	// An unsaved file has no path to store the cache.
+	if ((blenderscene->gm.flag & GAME_PHYSICS_SHAPE_CACHE) && !blendpath.empty()) {
+		ccdPhysEnv->m_shapeCache = new CcdShapeCache(CcdShapeCache::GetCachePath(blendpath));
+	}
+
+	if (blenderscene->gm.flag & GAME_PHYSICS_ASYNC) {
+		// A scheduler of one thread only runs background pools on its own thread.
+		ccdPhysEnv->m_stepScheduler = BLI_task_scheduler_create(1);
+		ccdPhysEnv->m_stepPool = BLI_task_pool_create_background(ccdPhysEnv->m_stepScheduler, ccdPhysEnv);
+	}
+
 	if (visualizePhysics)
 		ccdPhysEnv->SetDebugMode(btIDebugDraw::DBG_DrawWireframe | btIDebugDraw::DBG_DrawAabb | btIDebugDraw::DBG_DrawContactPoints | btIDebugDraw::DBG_DrawText | btIDebugDraw::DBG_DrawConstraintLimits | btIDebugDraw::DBG_DrawConstraints);
 
@@ -2670,7 +3764,7 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
 }
 
 void CcdPhysicsEnvironment::ConvertObject(KX_BlenderSceneConverter& converter, KX_GameObject *gameobj, RAS_MeshObject *meshobj,
-										  DerivedMesh *dm, KX_Scene *kxscene, PHY_ShapeProps *shapeprops, PHY_IMotionState *motionstate,
+										  KX_Scene *kxscene, PHY_ShapeProps *shapeprops, PHY_IMotionState *motionstate,
 										  int activeLayerBitInfo, bool isCompoundChild, bool hasCompoundChildren)
 {
 	Object *blenderobject = gameobj->GetBlenderObject();
@@ -2893,7 +3987,7 @@ void CcdPhysicsEnvironment::ConvertObject(KX_BlenderSceneConverter& converter, K
 		}
 		case OB_BOUND_CONVEX_HULL:
 		{
-			shapeInfo->SetMesh(meshobj, dm, true);
+			shapeInfo->SetMesh(meshobj, nullptr, true);
 			bm = shapeInfo->CreateBulletShape(ci.m_margin);
 			break;
 		}
@@ -2909,6 +4003,11 @@ void CcdPhysicsEnvironment::ConvertObject(KX_BlenderSceneConverter& converter, K
 		}
 		case OB_BOUND_TRIANGLE_MESH:
 		{
+			/* The mesh deformed by the modifiers is only used by the triangle mesh shape of the deformer mesh,
+			 * it is owned by the deformer. */
+			RAS_Deformer *deformer = gameobj->GetDeformer();
+			DerivedMesh *dm = (deformer && deformer->GetRasMesh() == meshobj) ? deformer->GetPhysicsMesh() : nullptr;
+
 			// mesh shapes can be shared, check first if we already have a shape on that mesh
 			class CcdShapeConstructionInfo *sharedShapeInfo = CcdShapeConstructionInfo::FindMesh(meshobj, dm, false);
 			if (sharedShapeInfo != nullptr) {
@@ -2918,6 +4017,7 @@ void CcdPhysicsEnvironment::ConvertObject(KX_BlenderSceneConverter& converter, K
 			}
 			else {
 				shapeInfo->SetMesh(meshobj, dm, false);
+				shapeInfo->SetShapeCache(m_shapeCache);
 			}
 
 			// Soft bodies can benefit from welding, don't do it on non-soft bodies
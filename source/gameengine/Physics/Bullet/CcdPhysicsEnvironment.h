@@ -26,6 +26,7 @@
 #include "KX_Globals.h"
 
 #include "CcdPhysicsController.h"
+#include "CM_Thread.h"
 
 #include <vector>
 #include <set>
@@ -45,12 +46,37 @@ class WrapperVehicle;
 class btPersistentManifold;
 class btBroadphaseInterface;
 struct btDbvtBroadphase;
+struct btDbvt;
 class btOverlappingPairCache;
 class btIDebugDraw;
 class btDynamicsWorld;
 class PHY_IVehicle;
 class CcdOverlapFilterCallBack;
 class CcdShapeConstructionInfo;
+class CcdShapeCache;
+struct TaskScheduler;
+struct TaskPool;
+
+/** Contact points of a manifold given to the collision callbacks.
+ * Stored by value in a per step array of the environment, valid until the next simulation step.
+ */
+class CcdCollData : public PHY_CollData
+{
+	const btPersistentManifold *m_manifoldPoint;
+public:
+	CcdCollData(const btPersistentManifold *manifoldPoint);
+	virtual ~CcdCollData();
+
+	virtual unsigned int GetNumContacts() const;
+	virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
+	virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
+	virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
+	virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
+	virtual float GetCombinedFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
+	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
+	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
+};
 
 /** CcdPhysicsEnvironment is an experimental mainloop for physics simulation using optional continuous collision detection.
  * Physics Environment takes care of stepping the simulation and is a container for physics entities.
@@ -75,6 +101,8 @@ protected:
 	class btDefaultCollisionConfiguration *m_collisionConfiguration;
 	/// broadphase for dynamic world
 	class btBroadphaseInterface *m_broadphase;
+	/// Type of m_broadphase, a CcdBroadphaseType.
+	int m_broadphaseType;
 	/// for culling only
 	btOverlappingPairCache *m_cullingCache;
 	/// broadphase for culling
@@ -94,10 +122,62 @@ protected:
 	float m_angularDeactivationThreshold;
 	float m_contactBreakingThreshold;
 
+	/// Number of threads used by the collision dispatch and the constraint solver.
+	int m_numThreads;
+	/// Scheduler of the physics tasks, nullptr when single threaded.
+	TaskScheduler *m_taskScheduler;
+	/// Cache of the triangle mesh BVHs given to the converted shapes, nullptr when disabled.
+	CcdShapeCache *m_shapeCache;
+
+	/** Thread running the simulation steps concurrently with the rendering,
+	 * nullptr when the steps are synchronous.
+	 */
+	TaskScheduler *m_stepScheduler;
+	TaskPool *m_stepPool;
+	/// True while a step runs on the step thread.
+	bool m_stepRunning;
+	/// True when the results of the last asynchronous step are not published to the game objects.
+	bool m_stepPublish;
+	/// True when the collision callbacks of the last asynchronous step were not called.
+	bool m_stepCallbacks;
+	/// Parameters of the last step.
+	double m_stepCurTime;
+	float m_stepTimeStep;
+	float m_stepInterval;
+	/// Controllers with a transform deferred by their motion state during the asynchronous step.
+	std::vector<CcdPhysicsController *> m_pendingMotionStates;
+	/// Controllers with commands deferred during the asynchronous step: transforms, forces and torques.
+	std::vector<CcdPhysicsController *> m_pendingCommands;
+	CM_ThreadMutex m_pendingCommandsMutex;
+
+	/// Number of tasks of the last wheel transform update.
+	unsigned int m_numWheelTasks;
+
+	/// Cast the rays of the Fh springs in parallel and apply their forces.
 	void ProcessFhSprings(double curTime, float timeStep);
 
+	static void UpdateWheelTransformsTask(TaskPool *__restrict pool, void *taskdata, int threadid);
+	/// Update the wheel transforms of all the vehicles, in parallel for large number of vehicles.
+	void UpdateWheelTransforms();
+
+	static void StepTask(TaskPool *__restrict pool, void *taskdata, int threadid);
+	/// Step the simulation with the parameters of the last call to ProceedDeltaTime.
+	void Step();
+	/// Give the results of the last step to the game objects.
+	void PublishStep();
+	/// Wait for the asynchronous step and publish its results, used before modifying the world.
+	void CompleteStep();
+
 public:
-	CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *dispatcher = nullptr, btOverlappingPairCache *pairCache = nullptr);
+	/**
+	 * Constructor.
+	 * \param numThreads Number of threads of the simulation, a value greater than one
+	 * uses the parallel dispatcher and world of CcdParallelWorld.h.
+	 * \param broadphaseType The broadphase of the world, a CcdBroadphaseType.
+	 * \param worldSize Size of the cube centered on the origin covered by the axis sweep broadphase.
+	 */
+	CcdPhysicsEnvironment(bool useDbvtCulling, int numThreads = 1, int broadphaseType = 0, float worldSize = 1000.0f,
+	                      btDispatcher *dispatcher = nullptr, btOverlappingPairCache *pairCache = nullptr);
 
 	virtual ~CcdPhysicsEnvironment();
 
@@ -131,10 +211,14 @@ public:
 		return m_numTimeSubSteps;
 	}
 
-	virtual void BeginFrame();
-	virtual void EndFrame()
+	int GetNumThreads() const
 	{
+		return m_numThreads;
 	}
+
+	virtual void BeginFrame();
+	virtual void EndFrame();
+	virtual void WaitStep();
 	/// Perform an integration step of duration 'timeStep'.
 	virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval);
 
@@ -187,9 +271,14 @@ public:
 	btTypedConstraint *GetConstraintById(int constraintId);
 
 	virtual PHY_IPhysicsController *RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ);
+	virtual void RayTestBatch(PHY_IRayCastFilterCallback& filterCallback, const MT_Vector3 *from, const MT_Vector3 *to,
+	                          unsigned int numRays, float radius, PHY_RayCastResult *results);
 	virtual bool CullingTest(PHY_CullingCallback callback, void *userData, const std::array<MT_Vector4, 6>& planes,
 							 int occlusionRes, const int *viewport, const MT_Matrix4x4& matrix);
 
+	virtual void SaveState(std::vector<char>& state);
+	virtual bool RestoreState(const char *state, unsigned int size);
+
 
 	//Methods for gamelogic collision/physics callbacks
 	virtual void AddSensor(PHY_IPhysicsController *ctrl);
@@ -219,6 +308,30 @@ public:
 
 	bool IsActiveCcdPhysicsController(CcdPhysicsController *ctrl);
 
+	/// Return true while an asynchronous step runs, the game objects must not be modified by the simulation.
+	bool IsStepRunning() const
+	{
+		return m_stepRunning;
+	}
+
+	/// Register a controller with a transform deferred by its motion state during the asynchronous step.
+	void AddPendingMotionState(CcdPhysicsController *ctrl)
+	{
+		m_pendingMotionStates.push_back(ctrl);
+	}
+
+	/** Defer a command of a controller during the asynchronous step: the game object transform set by SetTransform,
+	 * or a force or torque applied in world space. Can be called by the animation tasks.
+	 */
+	void AddPendingCommand(CcdPhysicsController *ctrl, CcdPhysicsController::PendingCommand command,
+	                       const MT_Vector3& value = MT_Vector3(0.0f, 0.0f, 0.0f));
+
+	/// Add a controller moved by the simulation to the synchronized controllers, does nothing if already added.
+	void AddActiveController(CcdPhysicsController *ctrl);
+	void RemoveActiveController(CcdPhysicsController *ctrl);
+	/// Remove the controllers put to sleep or made static from the synchronized controllers.
+	void UpdateActiveControllers();
+
 	void AddCcdGraphicController(CcdGraphicController *ctrl);
 
 	void RemoveCcdGraphicController(CcdGraphicController *ctrl);
@@ -232,6 +345,11 @@ public:
 	void UpdateCcdPhysicsControllerShape(CcdShapeConstructionInfo *shapeInfo);
 
 	btBroadphaseInterface *GetBroadphase();
+	/** Get the trees of the broadphase traversed by the batched ray tests.
+	 * \param trees Filled with the trees, at most 3.
+	 * \return The number of trees.
+	 */
+	unsigned short GetBroadphaseTrees(const btDbvt *trees[3]) const;
 	btDbvtBroadphase *GetCullingTree()
 	{
 		return m_cullingTree;
@@ -252,12 +370,14 @@ public:
 
 	void MergeEnvironment(PHY_IPhysicsEnvironment *other_env);
 
-	static CcdPhysicsEnvironment *Create(struct Scene *blenderscene, bool visualizePhysics);
+	/** Create the physics environment of a scene.
+	 * \param blendpath The path of the blend file of the scene, used to find the shape cache.
+	 */
+	static CcdPhysicsEnvironment *Create(struct Scene *blenderscene, bool visualizePhysics, const std::string& blendpath);
 
 	virtual void ConvertObject(KX_BlenderSceneConverter& converter,
 							   KX_GameObject *gameobj,
 	                           RAS_MeshObject *meshobj,
-	                           DerivedMesh *dm,
 	                           KX_Scene *kxscene,
 	                           PHY_ShapeProps *shapeprops,
 	                           PHY_IMotionState *motionstate,
@@ -271,9 +391,21 @@ public:
 
 protected:
 	std::set<CcdPhysicsController *> m_controllers;
+	/** Controllers moved by the simulation, only these are ticked and synchronized after each step.
+	 * Filled by the motion states of the bodies Bullet synchronizes and emptied of the sleeping bodies after each step.
+	 */
+	std::vector<CcdPhysicsController *> m_activeControllers;
 
 	PHY_ResponseCallback m_triggerCallbacks[PHY_NUM_RESPONSE];
 	void *m_triggerCallbacksUserPtrs[PHY_NUM_RESPONSE];
+	/** Collision data given to the object response callback during the last step.
+	 * Reused between steps to avoid an allocation per colliding manifold.
+	 */
+	std::vector<CcdCollData> m_collData;
+	/** Manifolds of the state being restored sorted by address with the offset of their record.
+	 * Reused between restorations to avoid allocations.
+	 */
+	std::vector<std::pair<const btPersistentManifold *, unsigned int> > m_stateManifolds;
 
 	std::vector<WrapperVehicle *>    m_wrapperVehicles;
 
@@ -299,22 +431,4 @@ protected:
 	virtual void ExportFile(const std::string& filename);
 };
 
-class CcdCollData : public PHY_CollData
-{
-	const btPersistentManifold *m_manifoldPoint;
-public:
-	CcdCollData(const btPersistentManifold *manifoldPoint);
-	virtual ~CcdCollData();
-
-	virtual unsigned int GetNumContacts() const;
-	virtual MT_Vector3 GetLocalPointA(unsigned int index, bool first) const;
-	virtual MT_Vector3 GetLocalPointB(unsigned int index, bool first) const;
-	virtual MT_Vector3 GetWorldPoint(unsigned int index, bool first) const;
-	virtual MT_Vector3 GetNormal(unsigned int index, bool first) const;
-	virtual float GetCombinedFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRollingFriction(unsigned int index, bool first) const;
-	virtual float GetCombinedRestitution(unsigned int index, bool first) const;
-	virtual float GetAppliedImpulse(unsigned int index, bool first) const;
-};
-
 #endif  /* __CCDPHYSICSENVIRONMENT_H__ */
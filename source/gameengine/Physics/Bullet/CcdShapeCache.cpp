@@ -0,0 +1,342 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Physics/Bullet/CcdShapeCache.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdShapeCache.h"
+
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
+
+#include "BLI_fileops.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "CM_Message.h"
+
+#include <cstring>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#  include <io.h>
+#  include "mmap_win.h"
+#else
+#  include <unistd.h>
+#  include <sys/mman.h>
+#endif
+
+/// Increase when the file layout changes.
+#define CCD_SHAPE_CACHE_VERSION 1
+#define CCD_SHAPE_CACHE_ALIGNMENT 16
+
+static const char ccdShapeCacheMagic[8] = {'B', 'G', 'E', 'S', 'H', 'A', 'P', 'E'};
+
+/** Header of the cache file, followed by the entry table and the serialized BVHs.
+ * The BVHs are stored in the memory layout of the engine, the file is only used
+ * when it was written by a build using the same layout.
+ */
+struct CcdShapeCacheHeader
+{
+	char m_magic[8];
+	uint32_t m_version;
+	uint32_t m_bulletVersion;
+	uint32_t m_endianness;
+	uint32_t m_scalarSize;
+	uint32_t m_pointerSize;
+	uint32_t m_bvhSize;
+	uint32_t m_numEntries;
+	uint32_t m_padding;
+};
+
+static void InitHeader(CcdShapeCacheHeader& header, unsigned int numEntries)
+{
+	memcpy(header.m_magic, ccdShapeCacheMagic, sizeof(header.m_magic));
+	header.m_version = CCD_SHAPE_CACHE_VERSION;
+	header.m_bulletVersion = btGetVersion();
+	header.m_endianness = 0x01020304;
+	header.m_scalarSize = sizeof(btScalar);
+	header.m_pointerSize = sizeof(void *);
+	header.m_bvhSize = sizeof(btQuantizedBvh);
+	header.m_numEntries = numEntries;
+	header.m_padding = 0;
+}
+
+static uint64_t AlignOffset(uint64_t offset)
+{
+	return (offset + CCD_SHAPE_CACHE_ALIGNMENT - 1) & ~(uint64_t)(CCD_SHAPE_CACHE_ALIGNMENT - 1);
+}
+
+CcdShapeCache::CcdShapeCache(const std::string& filepath)
+	:m_filepath(filepath),
+	m_data(nullptr),
+	m_size(0),
+	m_entries(nullptr),
+	m_numEntries(0)
+{
+	Map();
+}
+
+CcdShapeCache::~CcdShapeCache()
+{
+	if (!m_newEntries.empty()) {
+		Write();
+	}
+	Unmap();
+}
+
+std::string CcdShapeCache::GetCachePath(const std::string& blendpath)
+{
+	char path[FILE_MAX];
+	BLI_strncpy(path, blendpath.c_str(), sizeof(path));
+	BLI_replace_extension(path, sizeof(path), ".bshapes");
+	return std::string(path);
+}
+
+CcdShapeCache::Key CcdShapeCache::ComputeKey(const btScalar *vertices, unsigned int numVertices, const int *indices,
+                                             unsigned int numTriangles, bool quantized)
+{
+	// FNV-1a applied on 32 bits words, the vertices are hashed by their bit pattern.
+	static const uint64_t prime = 0x100000001b3ULL;
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	hash = (hash ^ (quantized ? 1 : 0)) * prime;
+
+	const unsigned int numValues = numVertices * 3;
+	for (unsigned int i = 0; i < numValues; ++i) {
+		float value = vertices[i];
+		uint32_t word;
+		memcpy(&word, &value, sizeof(word));
+		hash = (hash ^ word) * prime;
+	}
+
+	const unsigned int numIndices = numTriangles * 3;
+	for (unsigned int i = 0; i < numIndices; ++i) {
+		hash = (hash ^ (uint32_t)indices[i]) * prime;
+	}
+
+	return {hash, numVertices, numTriangles};
+}
+
+btOptimizedBvh *CcdShapeCache::LoadBvh(const Key& key)
+{
+	m_mutex.Lock();
+
+	const void *source = nullptr;
+	size_t size = 0;
+
+	const Entry *entry = FindEntry(key);
+	if (entry) {
+		source = (const char *)m_data + entry->m_offset;
+		size = entry->m_size;
+	}
+	else {
+		for (const NewEntry& newEntry : m_newEntries) {
+			if (newEntry.m_key == key) {
+				source = newEntry.m_data.data();
+				size = newEntry.m_data.size();
+				break;
+			}
+		}
+	}
+
+	if (!source) {
+		m_mutex.Unlock();
+		return nullptr;
+	}
+
+	// The BVH is deserialized in place, modifying the data, use a private copy.
+	void *buffer = btAlignedAlloc(size, CCD_SHAPE_CACHE_ALIGNMENT);
+	memcpy(buffer, source, size);
+	m_mutex.Unlock();
+
+	btOptimizedBvh *bvh = btOptimizedBvh::deSerializeInPlace(buffer, size, false);
+	if (!bvh) {
+		CM_Warning("invalid BVH in shape cache " << m_filepath);
+		btAlignedFree(buffer);
+	}
+
+	return bvh;
+}
+
+void CcdShapeCache::StoreBvh(const Key& key, const btOptimizedBvh *bvh)
+{
+	const unsigned int size = bvh->calculateSerializeBufferSize();
+	void *buffer = btAlignedAlloc(size, CCD_SHAPE_CACHE_ALIGNMENT);
+	if (!bvh->serializeInPlace(buffer, size, false)) {
+		btAlignedFree(buffer);
+		return;
+	}
+
+	m_mutex.Lock();
+	bool found = (FindEntry(key) != nullptr);
+	for (const NewEntry& newEntry : m_newEntries) {
+		found = found || (newEntry.m_key == key);
+	}
+	if (!found) {
+		m_newEntries.push_back({key, std::vector<char>((char *)buffer, (char *)buffer + size)});
+	}
+	m_mutex.Unlock();
+
+	btAlignedFree(buffer);
+}
+
+bool CcdShapeCache::Map()
+{
+	const int file = BLI_open(m_filepath.c_str(), O_BINARY | O_RDONLY, 0);
+	if (file == -1) {
+		return false;
+	}
+
+	const size_t size = BLI_file_descriptor_size(file);
+	if (size == (size_t)-1 || size < sizeof(CcdShapeCacheHeader)) {
+		close(file);
+		return false;
+	}
+
+	void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+
+	if (data == MAP_FAILED) {
+		CM_Warning("couldn't map shape cache " << m_filepath);
+		return false;
+	}
+
+	CcdShapeCacheHeader reference;
+	InitHeader(reference, 0);
+
+	const CcdShapeCacheHeader *header = (const CcdShapeCacheHeader *)data;
+	reference.m_numEntries = header->m_numEntries;
+	const uint64_t tableEnd = sizeof(CcdShapeCacheHeader) + (uint64_t)header->m_numEntries * sizeof(Entry);
+
+	if (memcmp(header, &reference, sizeof(CcdShapeCacheHeader)) != 0 || tableEnd > size) {
+		// Written by an other build or corrupted, the BVHs are rebuilt and the file replaced.
+		CM_Warning("incompatible shape cache " << m_filepath << ", the cache is rebuilt");
+		munmap(data, size);
+		return false;
+	}
+
+	const Entry *entries = (const Entry *)(header + 1);
+	for (unsigned int i = 0; i < header->m_numEntries; ++i) {
+		const Entry& entry = entries[i];
+		if ((entry.m_offset % CCD_SHAPE_CACHE_ALIGNMENT) != 0 || entry.m_offset < tableEnd ||
+		    entry.m_offset + entry.m_size > size)
+		{
+			CM_Warning("corrupted shape cache " << m_filepath << ", the cache is rebuilt");
+			munmap(data, size);
+			return false;
+		}
+	}
+
+	m_data = data;
+	m_size = size;
+	m_entries = entries;
+	m_numEntries = header->m_numEntries;
+
+	return true;
+}
+
+void CcdShapeCache::Unmap()
+{
+	if (m_data) {
+		munmap(m_data, m_size);
+		m_data = nullptr;
+		m_size = 0;
+		m_entries = nullptr;
+		m_numEntries = 0;
+	}
+}
+
+bool CcdShapeCache::Write()
+{
+	const std::string tmppath = m_filepath + "@";
+	FILE *file = BLI_fopen(tmppath.c_str(), "wb");
+	if (!file) {
+		CM_Warning("couldn't write shape cache " << m_filepath);
+		return false;
+	}
+
+	const unsigned int numEntries = m_numEntries + m_newEntries.size();
+
+	std::vector<Entry> entries(numEntries);
+	uint64_t offset = sizeof(CcdShapeCacheHeader) + numEntries * sizeof(Entry);
+	for (unsigned int i = 0; i < numEntries; ++i) {
+		Entry& entry = entries[i];
+		if (i < m_numEntries) {
+			entry.m_key = m_entries[i].m_key;
+			entry.m_size = m_entries[i].m_size;
+		}
+		else {
+			const NewEntry& newEntry = m_newEntries[i - m_numEntries];
+			entry.m_key = newEntry.m_key;
+			entry.m_size = newEntry.m_data.size();
+		}
+		offset = AlignOffset(offset);
+		entry.m_offset = offset;
+		offset += entry.m_size;
+	}
+
+	CcdShapeCacheHeader header;
+	InitHeader(header, numEntries);
+
+	bool success = (fwrite(&header, sizeof(header), 1, file) == 1) &&
+	               (fwrite(entries.data(), sizeof(Entry), numEntries, file) == numEntries);
+
+	static const char padding[CCD_SHAPE_CACHE_ALIGNMENT] = {0};
+	uint64_t position = sizeof(CcdShapeCacheHeader) + numEntries * sizeof(Entry);
+	for (unsigned int i = 0; i < numEntries && success; ++i) {
+		const Entry& entry = entries[i];
+		const char *data = (i < m_numEntries) ? (const char *)m_data + m_entries[i].m_offset : m_newEntries[i - m_numEntries].m_data.data();
+
+		const size_t paddingSize = entry.m_offset - position;
+		success = (paddingSize == 0 || fwrite(padding, 1, paddingSize, file) == paddingSize) &&
+		          (fwrite(data, 1, entry.m_size, file) == entry.m_size);
+		position = entry.m_offset + entry.m_size;
+	}
+
+	fclose(file);
+
+	// The mapping keeps the file opened on some platforms, release it before replacing the file.
+	Unmap();
+
+	if (!success || BLI_rename(tmppath.c_str(), m_filepath.c_str()) != 0) {
+		CM_Warning("couldn't write shape cache " << m_filepath);
+		BLI_delete(tmppath.c_str(), false, false);
+		return false;
+	}
+
+	m_newEntries.clear();
+
+	return true;
+}
+
+const CcdShapeCache::Entry *CcdShapeCache::FindEntry(const Key& key) const
+{
+	for (unsigned int i = 0; i < m_numEntries; ++i) {
+		if (m_entries[i].m_key == key) {
+			return &m_entries[i];
+		}
+	}
+
+	return nullptr;
+}
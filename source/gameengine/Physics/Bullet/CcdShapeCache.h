@@ -0,0 +1,129 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file CcdShapeCache.h
+ *  \ingroup physbullet
+ *
+ * File cache of the triangle mesh BVHs, stored next to the blend file. Building the BVH
+ * of large static meshes dominates the conversion time, the cache stores the serialized
+ * BVHs keyed by the content of the mesh and maps the file when the scene is converted.
+ */
+
+#ifndef __CCDSHAPECACHE_H__
+#define __CCDSHAPECACHE_H__
+
+#include "CM_RefCount.h"
+#include "CM_Thread.h"
+
+#include "LinearMath/btScalar.h"
+
+#include <string>
+#include <vector>
+
+#include "BLI_sys_types.h"
+
+class btOptimizedBvh;
+
+/** Cache of the BVHs of the triangle mesh shapes shared by the shapes of a physics environment.
+ * The file is mapped read only, the cached BVHs are copied in memory owned by the caller.
+ * The newly built BVHs are written when the last user releases the cache.
+ */
+class CcdShapeCache : public CM_RefCount<CcdShapeCache>
+{
+public:
+	/// Identify the content of a mesh, the vertex and triangle counts make hash collisions unlikely to match.
+	struct Key
+	{
+		uint64_t m_hash;
+		uint32_t m_numVertices;
+		uint32_t m_numTriangles;
+
+		bool operator==(const Key& other) const
+		{
+			return (m_hash == other.m_hash && m_numVertices == other.m_numVertices && m_numTriangles == other.m_numTriangles);
+		}
+	};
+
+	/** Constructor, maps the cache file when it exists and is compatible.
+	 * \param filepath The absolute path of the cache file.
+	 */
+	CcdShapeCache(const std::string& filepath);
+	virtual ~CcdShapeCache();
+
+	/// Return the path of the cache file of a blend file.
+	static std::string GetCachePath(const std::string& blendpath);
+
+	/** Compute the key of a triangle mesh.
+	 * \param vertices The vertex coordinates, 3 values per vertex.
+	 * \param indices The vertex indices, 3 per triangle.
+	 * \param quantized True when the BVH uses quantized AABB compression.
+	 */
+	static Key ComputeKey(const btScalar *vertices, unsigned int numVertices, const int *indices, unsigned int numTriangles,
+	                      bool quantized);
+
+	/** Return a copy of the cached BVH of a mesh, nullptr if the mesh is not cached.
+	 * The BVH is allocated with btAlignedAlloc, it is destructed and freed by the caller.
+	 */
+	btOptimizedBvh *LoadBvh(const Key& key);
+	/// Add a BVH built for a mesh, it is serialized immediately and written at the destruction of the cache.
+	void StoreBvh(const Key& key, const btOptimizedBvh *bvh);
+
+private:
+	struct Entry
+	{
+		Key m_key;
+		/// Offset of the serialized BVH from the start of the file, aligned on 16 bytes.
+		uint64_t m_offset;
+		uint64_t m_size;
+	};
+
+	struct NewEntry
+	{
+		Key m_key;
+		std::vector<char> m_data;
+	};
+
+	/// Map the cache file and read its entry table, return false if the file is missing or not compatible.
+	bool Map();
+	void Unmap();
+	/// Write the mapped entries followed by the new entries.
+	bool Write();
+
+	const Entry *FindEntry(const Key& key) const;
+
+	std::string m_filepath;
+
+	/// File mapping, nullptr when no file was mapped.
+	void *m_data;
+	size_t m_size;
+	/// Entries of the mapped file, pointing in the mapping.
+	const Entry *m_entries;
+	unsigned int m_numEntries;
+
+	/// BVHs built since the file was mapped.
+	std::vector<NewEntry> m_newEntries;
+
+	/// Shapes can be converted by the asynchronous library loading.
+	CM_ThreadMutex m_mutex;
+};
+
+#endif  // __CCDSHAPECACHE_H__
@@ -58,6 +58,9 @@ public:
 	virtual float GetAppliedImpulse(unsigned int index, bool first) const = 0;
 };
 
+/** Collision callback, the collision data is owned by the physics environment
+ * and stays valid until its next simulation step.
+ */
 typedef bool (*PHY_ResponseCallback)(void *client_data,
                                      void *client_object1,
                                      void *client_object2,
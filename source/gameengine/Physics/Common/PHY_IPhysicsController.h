@@ -151,6 +151,13 @@ public:
 	virtual bool ReinstancePhysicsShape(KX_GameObject *from_gameobj, RAS_MeshObject *from_meshobj, bool dupli = false) = 0;
 	virtual void ReplacePhysicsShape(PHY_IPhysicsController *phyctrl) = 0;
 
+	/** Use the shape built from a level of detail mesh, nullptr uses the original shape again.
+	 * Return false if the shape of the controller can't be replaced by a mesh.
+	 */
+	virtual bool SetLodMesh(RAS_MeshObject *meshobj) = 0;
+	/// Put the body to sleep while its level of detail is sleeping, wake it up after.
+	virtual void SetLodSleep(bool sleep) = 0;
+
 	/* Method to replicate rigid body joint contraints for group instances. */
 	virtual void ReplicateConstraints(KX_GameObject *gameobj, std::vector<KX_GameObject *> constobj) = 0;
 };
@@ -39,6 +39,7 @@
 #include "MT_Vector4.h"
 
 #include <array>
+#include <vector>
 
 class PHY_IConstraint;
 class PHY_IVehicle;
@@ -114,6 +115,12 @@ public:
 	}
 	virtual void BeginFrame() = 0;
 	virtual void EndFrame() = 0;
+	/** Wait for the simulation step running asynchronously, the physics can then be used until the next step.
+	 * The results of the step are given to the game objects by EndFrame.
+	 */
+	virtual void WaitStep()
+	{
+	}
 	/// Perform an integration step of duration 'timeStep'.
 	virtual bool ProceedDeltaTime(double curTime, float timeStep, float interval) = 0;
 	/// draw debug lines (make sure to call this during the render phase, otherwise lines are not drawn properly)
@@ -208,6 +215,14 @@ public:
 	virtual PHY_ICharacter *GetCharacterController(class KX_GameObject *ob) = 0;
 
 	virtual PHY_IPhysicsController *RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ) = 0;
+	/** Cast a batch of rays, or sweep a sphere along them when radius is not zero, the rays can be tested in parallel.
+	 * The filter callback is called concurrently, its reportHit function and face normal and UV options are not used.
+	 * \param from The start point of each ray.
+	 * \param to The end point of each ray.
+	 * \param results The closest hit of each ray, m_controller is nullptr when nothing was hit.
+	 */
+	virtual void RayTestBatch(PHY_IRayCastFilterCallback& filterCallback, const MT_Vector3 *from, const MT_Vector3 *to,
+	                          unsigned int numRays, float radius, PHY_RayCastResult *results) = 0;
 
 	// culling based on physical broad phase
 	// the plane number must be set as follow: near, far, left, right, top, botton
@@ -215,6 +230,17 @@ public:
 	virtual bool CullingTest(PHY_CullingCallback callback, void *userData, const std::array<MT_Vector4, 6>& planes,
 							 int occlusionRes, const int *viewport, const MT_Matrix4x4& matrix) = 0;
 
+	/** Save the dynamic state of the simulation: the transforms and velocities of the bodies,
+	 * their activation, the constraint and contact impulses and the character controllers.
+	 * The state is only valid for this environment and the objects it contains when saved.
+	 * \param state The buffer receiving the state, reused without allocation when large enough.
+	 */
+	virtual void SaveState(std::vector<char>& state) = 0;
+	/** Restore a state saved by SaveState, the game objects are moved to the restored transforms.
+	 * \return False if the state doesn't match the environment, nothing is restored in this case.
+	 */
+	virtual bool RestoreState(const char *state, unsigned int size) = 0;
+
 	// Methods for gamelogic collision/physics callbacks
 	virtual void AddSensor(PHY_IPhysicsController *ctrl) = 0;
 	virtual void RemoveSensor(PHY_IPhysicsController *ctrl) = 0;
@@ -234,7 +260,6 @@ public:
 	virtual void ConvertObject(KX_BlenderSceneConverter& converter,
 							   KX_GameObject *gameobj,
 	                           RAS_MeshObject *meshobj,
-	                           DerivedMesh *dm,
 	                           KX_Scene *kxscene,
 	                           PHY_ShapeProps *shapeprops,
 	                           PHY_IMotionState *motionstate,
@@ -113,3 +113,11 @@ PHY_IPhysicsController *DummyPhysicsEnvironment::RayTest(PHY_IRayCastFilterCallb
 	return nullptr;
 }
 
+void DummyPhysicsEnvironment::RayTestBatch(PHY_IRayCastFilterCallback& filterCallback, const MT_Vector3 *from, const MT_Vector3 *to,
+                                           unsigned int numRays, float radius, PHY_RayCastResult *results)
+{
+	for (unsigned int i = 0; i < numRays; ++i) {
+		results[i].m_controller = nullptr;
+	}
+}
+
@@ -82,12 +82,23 @@ public:
 	}
 
 	virtual PHY_IPhysicsController *RayTest(PHY_IRayCastFilterCallback &filterCallback, float fromX, float fromY, float fromZ, float toX, float toY, float toZ);
+	virtual void RayTestBatch(PHY_IRayCastFilterCallback& filterCallback, const MT_Vector3 *from, const MT_Vector3 *to,
+	                          unsigned int numRays, float radius, PHY_RayCastResult *results);
 	virtual bool CullingTest(PHY_CullingCallback callback, void *userData, const std::array<MT_Vector4, 6>& planes,
 							 int occlusionRes, const int *viewport, const MT_Matrix4x4& matrix)
 	{
 		return false;
 	}
 
+	virtual void SaveState(std::vector<char>& state)
+	{
+		state.clear();
+	}
+	virtual bool RestoreState(const char *state, unsigned int size)
+	{
+		return (size == 0);
+	}
+
 	//gamelogic callbacks
 	virtual void AddSensor(PHY_IPhysicsController *ctrl)
 	{
@@ -123,7 +134,6 @@ public:
 	virtual void ConvertObject(KX_BlenderSceneConverter& converter,
 							   KX_GameObject *gameobj,
 	                           RAS_MeshObject *meshobj,
-	                           DerivedMesh *dm,
 	                           KX_Scene *kxscene,
 	                           PHY_ShapeProps *shapeprops,
 	                           PHY_IMotionState *motionstate,
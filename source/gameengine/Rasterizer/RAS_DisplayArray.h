@@ -116,6 +116,11 @@ public:
 		return (RAS_ITexVert *)m_vertexes.data();
 	}
 
+	virtual RAS_ITexVert *GetVertexPointer()
+	{
+		return (RAS_ITexVert *)m_vertexes.data();
+	}
+
 	virtual void AddVertex(RAS_ITexVert *vert)
 	{
 		m_vertexes.push_back(*((Vertex *)vert));
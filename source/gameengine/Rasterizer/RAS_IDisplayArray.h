@@ -126,6 +126,8 @@ public:
 	}
 
 	virtual const RAS_ITexVert *GetVertexPointer() const = 0;
+	/// Return the vertex memory to write in, the changes must be flagged by AppendModifiedFlag.
+	virtual RAS_ITexVert *GetVertexPointer() = 0;
 
 	inline const unsigned int *GetIndexPointer() const
 	{
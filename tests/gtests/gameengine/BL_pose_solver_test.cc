@@ -0,0 +1,183 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BL_PoseSolver.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+
+#include "DNA_action_types.h"
+#include "DNA_armature_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math.h"
+#include "BLI_string.h"
+
+#include "BKE_action.h"
+#include "BKE_armature.h"
+}
+
+#define EPS 1e-5f
+
+/* Armature object evaluated by BKE_pose_where_is as reference. */
+struct TestArmature
+{
+	bArmature *arm;
+	Object *ob;
+	Scene *scene;
+};
+
+/* Add a bone with head and tail in the space of its parent, like ED_armature_from_edit. */
+static Bone *add_bone(bArmature *arm, Bone *parent, const char *name,
+                      const float head[3], const float tail[3], float roll, int flag)
+{
+	Bone *bone = (Bone *)MEM_callocN(sizeof(Bone), __func__);
+	BLI_strncpy(bone->name, name, sizeof(bone->name));
+	bone->parent = parent;
+	copy_v3_v3(bone->head, head);
+	copy_v3_v3(bone->tail, tail);
+	bone->roll = roll;
+	bone->flag = flag;
+	bone->length = len_v3v3(head, tail);
+	bone->segments = 1;
+
+	float vec[3];
+	sub_v3_v3v3(vec, tail, head);
+	vec_roll_to_mat3(vec, roll, bone->bone_mat);
+
+	BLI_addtail(parent ? &parent->childbase : &arm->bonebase, bone);
+	return bone;
+}
+
+/* Chain of three bones and a second root, the last child can use a bone flag. */
+static TestArmature create_armature(int childflag)
+{
+	TestArmature test;
+	test.arm = (bArmature *)MEM_callocN(sizeof(bArmature), __func__);
+
+	const float head0[3] = {0.0f, 0.0f, 0.0f}, tail0[3] = {0.0f, 0.0f, 1.0f};
+	const float head1[3] = {0.0f, 0.0f, 0.0f}, tail1[3] = {0.5f, 1.0f, 0.2f};
+	const float head2[3] = {0.1f, 0.0f, -0.2f}, tail2[3] = {-0.3f, 0.8f, 0.4f};
+	const float head3[3] = {1.0f, -1.0f, 0.5f}, tail3[3] = {1.5f, -1.0f, 0.5f};
+
+	Bone *root = add_bone(test.arm, nullptr, "Root", head0, tail0, 0.3f, 0);
+	Bone *child = add_bone(test.arm, root, "Child", head1, tail1, -0.7f, BONE_CONNECTED);
+	add_bone(test.arm, child, "Leaf", head2, tail2, 1.2f, childflag);
+	add_bone(test.arm, nullptr, "Other", head3, tail3, 0.0f, BONE_NO_CYCLICOFFSET);
+	BKE_armature_where_is(test.arm);
+
+	test.ob = (Object *)MEM_callocN(sizeof(Object), __func__);
+	test.ob->type = OB_ARMATURE;
+	test.ob->data = test.arm;
+	unit_m4(test.ob->obmat);
+	BKE_pose_rebuild(test.ob, test.arm);
+
+	test.scene = (Scene *)MEM_callocN(sizeof(Scene), __func__);
+
+	return test;
+}
+
+static void free_armature(TestArmature& test)
+{
+	BKE_pose_free(test.ob->pose);
+	BKE_armature_bonelist_free(&test.arm->bonebase);
+	MEM_freeN(test.arm);
+	MEM_freeN(test.ob);
+	MEM_freeN(test.scene);
+}
+
+/* Give each channel a different location, rotation and scale. */
+static void pose_channels(bPose *pose, short rotmode)
+{
+	int i = 0;
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next, ++i) {
+		const float f = (float)(i + 1);
+		pchan->rotmode = rotmode;
+		const float loc[3] = {0.1f * f, -0.2f * f, 0.05f * f};
+		copy_v3_v3(pchan->loc, loc);
+		const float eul[3] = {0.3f * f, -0.2f, 0.1f * f};
+		copy_v3_v3(pchan->eul, eul);
+		eul_to_quat(pchan->quat, eul);
+		const float size[3] = {1.0f, 1.0f + 0.1f * f, 1.0f - 0.05f * f};
+		copy_v3_v3(pchan->size, size);
+	}
+}
+
+/* Clear the results of a pose evaluation. */
+static void clear_results(bPose *pose)
+{
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		zero_m4(pchan->pose_mat);
+		zero_m4(pchan->chan_mat);
+		zero_v3(pchan->pose_head);
+		zero_v3(pchan->pose_tail);
+	}
+}
+
+/* Copy the results of a pose evaluation, in the order of the channels. */
+static void store_results(bPose *pose, std::vector<float>& results)
+{
+	results.clear();
+	for (bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first; pchan; pchan = pchan->next) {
+		results.insert(results.end(), (float *)pchan->pose_mat, (float *)pchan->pose_mat + 16);
+		results.insert(results.end(), (float *)pchan->chan_mat, (float *)pchan->chan_mat + 16);
+		results.insert(results.end(), pchan->pose_head, pchan->pose_head + 3);
+		results.insert(results.end(), pchan->pose_tail, pchan->pose_tail + 3);
+	}
+}
+
+static void expect_solver_matches_blender(short rotmode)
+{
+	TestArmature test = create_armature(0);
+	bPose *pose = test.ob->pose;
+	pose_channels(pose, rotmode);
+	const float cyclic[3] = {0.5f, 0.0f, -1.0f};
+	copy_v3_v3(pose->cyclic_offset, cyclic);
+
+	BKE_pose_where_is(nullptr, test.scene, test.ob);
+	std::vector<float> ref;
+	store_results(pose, ref);
+	clear_results(pose);
+
+	BL_PoseSolver solver;
+	solver.Init(pose);
+	ASSERT_TRUE(solver.IsSupported());
+	ASSERT_TRUE(solver.Solve(pose, test.arm));
+	std::vector<float> res;
+	store_results(pose, res);
+
+	ASSERT_EQ(res.size(), ref.size());
+	for (unsigned int i = 0, size = ref.size(); i < size; ++i) {
+		EXPECT_NEAR(res[i], ref[i], EPS);
+	}
+
+	free_armature(test);
+}
+
+TEST(bge_pose_solver, MatchesBlenderQuaternion)
+{
+	expect_solver_matches_blender(ROT_MODE_QUAT);
+}
+
+TEST(bge_pose_solver, MatchesBlenderEuler)
+{
+	expect_solver_matches_blender(ROT_MODE_ZXY);
+}
+
+TEST(bge_pose_solver, UnsupportedBoneOptions)
+{
+	const int flags[] = {BONE_HINGE, BONE_NO_SCALE, BONE_NO_LOCAL_LOCATION};
+	for (int flag : flags) {
+		TestArmature test = create_armature(flag);
+
+		BL_PoseSolver solver;
+		solver.Init(test.ob->pose);
+		EXPECT_FALSE(solver.IsSupported());
+		EXPECT_FALSE(solver.Solve(test.ob->pose, test.arm));
+
+		free_armature(test);
+	}
+}
@@ -0,0 +1,210 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BL_ShapeKeys.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+
+#include "DNA_ipo_types.h"
+#include "DNA_key_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "BLI_listbase.h"
+#include "BLI_math.h"
+#include "BLI_string.h"
+
+#include "BKE_key.h"
+}
+
+#define EPS 1e-5f
+
+/* Mesh with a relative key evaluated by BKE_key_evaluate_relative as reference. */
+struct TestShapeKey
+{
+	Mesh *mesh;
+	Object *ob;
+	Key *key;
+	unsigned int totvert;
+};
+
+static KeyBlock *add_block(TestShapeKey& test, const char *name, short relative, float curval, const char *vgroup)
+{
+	KeyBlock *kb = (KeyBlock *)MEM_callocN(sizeof(KeyBlock), __func__);
+	BLI_strncpy(kb->name, name, sizeof(kb->name));
+	if (vgroup) {
+		BLI_strncpy(kb->vgroup, vgroup, sizeof(kb->vgroup));
+	}
+	kb->relative = relative;
+	kb->curval = curval;
+	kb->slidermax = 1.0f;
+	kb->totelem = test.totvert;
+	kb->data = MEM_callocN(sizeof(float[3]) * test.totvert, __func__);
+	BLI_addtail(&test.key->block, kb);
+	++test.key->totkey;
+	return kb;
+}
+
+/* Basis, two blocks relative to the basis, one of them weighted by a vertex group, a block relative
+ * to another block and a muted block. Each block moves a part of the vertices. */
+static TestShapeKey create_shape_key(unsigned int totvert)
+{
+	TestShapeKey test;
+	test.totvert = totvert;
+
+	test.mesh = (Mesh *)MEM_callocN(sizeof(Mesh), __func__);
+	BLI_strncpy(test.mesh->id.name, "MEMesh", sizeof(test.mesh->id.name));
+	test.mesh->totvert = totvert;
+
+	test.ob = (Object *)MEM_callocN(sizeof(Object), __func__);
+	test.ob->type = OB_MESH;
+	test.ob->data = test.mesh;
+	bDeformGroup *dg = (bDeformGroup *)MEM_callocN(sizeof(bDeformGroup), __func__);
+	BLI_strncpy(dg->name, "Group", sizeof(dg->name));
+	BLI_addtail(&test.ob->defbase, dg);
+
+	// Half of the vertices are in the group with a varying weight.
+	test.mesh->dvert = (MDeformVert *)MEM_callocN(sizeof(MDeformVert) * totvert, __func__);
+	for (unsigned int v = 0; v < totvert; v += 2) {
+		MDeformVert *dv = &test.mesh->dvert[v];
+		dv->dw = (MDeformWeight *)MEM_callocN(sizeof(MDeformWeight), __func__);
+		dv->dw->def_nr = 0;
+		dv->dw->weight = (float)(v % 7) / 6.0f;
+		dv->totweight = 1;
+	}
+
+	test.key = (Key *)MEM_callocN(sizeof(Key), __func__);
+	test.key->type = KEY_RELATIVE;
+	test.key->from = &test.mesh->id;
+	test.key->elemstr[0] = 3;
+	test.key->elemstr[1] = IPO_FLOAT;
+	test.key->elemsize = sizeof(float[3]);
+
+	KeyBlock *basis = add_block(test, "Basis", 0, 0.0f, nullptr);
+	KeyBlock *smile = add_block(test, "Smile", 0, 0.7f, nullptr);
+	KeyBlock *weighted = add_block(test, "Weighted", 0, 0.4f, "Group");
+	KeyBlock *corrective = add_block(test, "Corrective", 1, -0.3f, nullptr);
+	KeyBlock *muted = add_block(test, "Muted", 0, 1.0f, nullptr);
+	muted->flag |= KEYBLOCK_MUTE;
+	test.key->refkey = basis;
+
+	float (*co)[3] = (float (*)[3])basis->data;
+	for (unsigned int v = 0; v < totvert; ++v) {
+		const float pos[3] = {(float)v, 0.5f * (float)(v % 5), -0.25f * (float)(v % 3)};
+		copy_v3_v3(co[v], pos);
+	}
+	memcpy(smile->data, basis->data, sizeof(float[3]) * totvert);
+	memcpy(weighted->data, basis->data, sizeof(float[3]) * totvert);
+	memcpy(muted->data, basis->data, sizeof(float[3]) * totvert);
+
+	for (unsigned int v = 0; v < totvert; v += 3) {
+		float (*smileco)[3] = (float (*)[3])smile->data;
+		smileco[v][1] += 1.0f + 0.01f * (float)v;
+	}
+	for (unsigned int v = 0; v < totvert; ++v) {
+		float (*weightedco)[3] = (float (*)[3])weighted->data;
+		weightedco[v][0] -= 0.5f;
+		float (*mutedco)[3] = (float (*)[3])muted->data;
+		mutedco[v][2] += 2.0f;
+	}
+	// The corrective block is relative to the smile block.
+	memcpy(corrective->data, smile->data, sizeof(float[3]) * totvert);
+	for (unsigned int v = 0; v < totvert; v += 4) {
+		float (*correctiveco)[3] = (float (*)[3])corrective->data;
+		correctiveco[v][2] += 0.3f;
+	}
+
+	return test;
+}
+
+static void free_shape_key(TestShapeKey& test)
+{
+	for (KeyBlock *kb = (KeyBlock *)test.key->block.first; kb; kb = kb->next) {
+		MEM_freeN(kb->data);
+	}
+	BLI_freelistN(&test.key->block);
+	MEM_freeN(test.key);
+
+	for (unsigned int v = 0; v < test.totvert; ++v) {
+		MEM_SAFE_FREE(test.mesh->dvert[v].dw);
+	}
+	MEM_freeN(test.mesh->dvert);
+	MEM_freeN(test.mesh);
+	BLI_freelistN(&test.ob->defbase);
+	MEM_freeN(test.ob);
+}
+
+static void evaluate_blender(TestShapeKey& test, std::vector<float>& verts)
+{
+	verts.resize(test.totvert * 3);
+	WeightsArrayCache cache = {0, nullptr};
+	float **per_keyblock_weights = BKE_keyblock_get_per_block_weights(test.ob, test.key, &cache);
+	BKE_key_evaluate_relative(0, test.totvert, test.totvert, (char *)verts.data(), test.key, nullptr,
+	                          per_keyblock_weights, 0);
+	BKE_keyblock_free_per_block_weights(test.key, per_keyblock_weights, &cache);
+}
+
+static void expect_verts_near(const std::vector<float>& res, const std::vector<float>& ref)
+{
+	ASSERT_EQ(res.size(), ref.size());
+	for (unsigned int i = 0, size = ref.size(); i < size; ++i) {
+		EXPECT_NEAR(res[i], ref[i], EPS);
+	}
+}
+
+TEST(bge_shape_keys, MatchesBlender)
+{
+	TestShapeKey test = create_shape_key(103);
+	ASSERT_TRUE(BL_ShapeKeys::IsSupported(test.key, test.mesh));
+
+	std::vector<float> ref;
+	evaluate_blender(test, ref);
+
+	BL_ShapeKeys shapeKeys(test.key, test.ob, test.mesh);
+	std::vector<BL_ShapeKeys::ActiveBlock> blocks;
+	shapeKeys.GetActiveBlocks(test.key, blocks);
+	std::vector<float> res(test.totvert * 3);
+	shapeKeys.Blend(blocks, 0, test.totvert, (float (*)[3])res.data());
+	expect_verts_near(res, ref);
+
+	// The values are read at each update, the compiled key is kept.
+	((KeyBlock *)BLI_findlink(&test.key->block, 1))->curval = 0.0f;
+	((KeyBlock *)BLI_findlink(&test.key->block, 2))->curval = 1.0f;
+	evaluate_blender(test, ref);
+	shapeKeys.GetActiveBlocks(test.key, blocks);
+	shapeKeys.Blend(blocks, 0, test.totvert, (float (*)[3])res.data());
+	expect_verts_near(res, ref);
+
+	free_shape_key(test);
+}
+
+TEST(bge_shape_keys, MatchesBlenderRanges)
+{
+	TestShapeKey test = create_shape_key(250);
+
+	std::vector<float> ref;
+	evaluate_blender(test, ref);
+
+	// The ranges blended by the tasks give the same result as a single range.
+	BL_ShapeKeys shapeKeys(test.key, test.ob, test.mesh);
+	std::vector<BL_ShapeKeys::ActiveBlock> blocks;
+	shapeKeys.GetActiveBlocks(test.key, blocks);
+	std::vector<float> res(test.totvert * 3);
+	for (unsigned int start = 0; start < test.totvert; start += 64) {
+		shapeKeys.Blend(blocks, start, std::min(start + 64, test.totvert), (float (*)[3])res.data());
+	}
+	expect_verts_near(res, ref);
+
+	free_shape_key(test);
+}
+
+TEST(bge_shape_keys, AbsoluteKeyUnsupported)
+{
+	TestShapeKey test = create_shape_key(10);
+	test.key->type = KEY_NORMAL;
+	EXPECT_FALSE(BL_ShapeKeys::IsSupported(test.key, test.mesh));
+	free_shape_key(test);
+}
@@ -0,0 +1,141 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <vector>
+
+#include "MT_Matrix4x4.h"
+#include "MT_Transform.h"
+
+extern "C" {
+#include "PIL_time_utildefines.h"
+}
+
+/* Compares the moto functions against plain scalar loops equivalent to the
+ * code used when WITH_MOTO_SIMD is disabled. */
+
+#define NUM_MATRICES 1000
+#define NUM_MATRICES_ITERATIONS 2000
+#define NUM_POINTS 100000
+#define NUM_POINTS_ITERATIONS 100
+
+static MT_Transform test_transform()
+{
+	MT_Matrix3x3 basis(MT_Vector3(0.3f, -0.7f, 1.1f));
+	basis.scale(1.0f, 2.0f, 0.5f);
+	return MT_Transform(MT_Vector3(1.0f, -2.0f, 3.0f), basis);
+}
+
+static void scalar_mul_m4(MT_Matrix4x4& r, const MT_Matrix4x4& a, const MT_Matrix4x4& b)
+{
+	for (unsigned short i = 0; i < 4; ++i) {
+		for (unsigned short j = 0; j < 4; ++j) {
+			r[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+		}
+	}
+}
+
+static void scalar_mul_m3(MT_Matrix3x3& r, const MT_Matrix3x3& a, const MT_Matrix3x3& b)
+{
+	for (unsigned short i = 0; i < 3; ++i) {
+		for (unsigned short j = 0; j < 3; ++j) {
+			r[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+		}
+	}
+}
+
+TEST(moto_simd, Matrix4x4ProductPerformance)
+{
+	const MT_Matrix4x4 b = test_transform().toMatrix();
+	std::vector<MT_Matrix4x4> mats(NUM_MATRICES, b.inverse());
+	std::vector<MT_Matrix4x4> result(NUM_MATRICES);
+
+	TIMEIT_START(matrix4x4_product_scalar);
+	for (unsigned int j = 0; j < NUM_MATRICES_ITERATIONS; ++j) {
+		for (unsigned int i = 0; i < NUM_MATRICES; ++i) {
+			scalar_mul_m4(result[i], mats[i], b);
+		}
+	}
+	TIMEIT_END(matrix4x4_product_scalar);
+
+	TIMEIT_START(matrix4x4_product_moto);
+	for (unsigned int j = 0; j < NUM_MATRICES_ITERATIONS; ++j) {
+		for (unsigned int i = 0; i < NUM_MATRICES; ++i) {
+			result[i] = mats[i] * b;
+		}
+	}
+	TIMEIT_END(matrix4x4_product_moto);
+}
+
+TEST(moto_simd, TransformCompositionPerformance)
+{
+	const MT_Transform b = test_transform();
+	std::vector<MT_Transform> trans(NUM_MATRICES, b.toMatrix().inverse().toTransform());
+	std::vector<MT_Transform> result(NUM_MATRICES);
+
+	TIMEIT_START(transform_composition_scalar);
+	for (unsigned int j = 0; j < NUM_MATRICES_ITERATIONS; ++j) {
+		for (unsigned int i = 0; i < NUM_MATRICES; ++i) {
+			scalar_mul_m3(result[i].getBasis(), trans[i].getBasis(), b.getBasis());
+			result[i].getOrigin() = trans[i](b.getOrigin());
+		}
+	}
+	TIMEIT_END(transform_composition_scalar);
+
+	TIMEIT_START(transform_composition_moto);
+	for (unsigned int j = 0; j < NUM_MATRICES_ITERATIONS; ++j) {
+		for (unsigned int i = 0; i < NUM_MATRICES; ++i) {
+			result[i] = trans[i] * b;
+		}
+	}
+	TIMEIT_END(transform_composition_moto);
+}
+
+TEST(moto_simd, TransformPointsPerformance)
+{
+	const MT_Transform t = test_transform();
+	std::vector<MT_Vector3> points(NUM_POINTS);
+	std::vector<MT_Vector3> result(NUM_POINTS);
+	for (unsigned int i = 0; i < NUM_POINTS; ++i) {
+		points[i].setValue(float(i), -0.5f * float(i), 1.0f / float(i + 1));
+	}
+
+	TIMEIT_START(transform_points_scalar);
+	for (unsigned int j = 0; j < NUM_POINTS_ITERATIONS; ++j) {
+		for (unsigned int i = 0; i < NUM_POINTS; ++i) {
+			result[i] = t(points[i]);
+		}
+	}
+	TIMEIT_END(transform_points_scalar);
+
+	TIMEIT_START(transform_points_moto);
+	for (unsigned int j = 0; j < NUM_POINTS_ITERATIONS; ++j) {
+		t.transformPoints(points.data(), result.data(), NUM_POINTS);
+	}
+	TIMEIT_END(transform_points_moto);
+}
+
+TEST(moto_simd, Matrix4x4VectorsPerformance)
+{
+	const MT_Matrix4x4 m = test_transform().toMatrix();
+	std::vector<MT_Vector4> vectors(NUM_POINTS);
+	std::vector<MT_Vector4> result(NUM_POINTS);
+	for (unsigned int i = 0; i < NUM_POINTS; ++i) {
+		vectors[i].setValue(float(i), -0.5f * float(i), 1.0f / float(i + 1), 1.0f);
+	}
+
+	TIMEIT_START(matrix4x4_vectors_scalar);
+	for (unsigned int j = 0; j < NUM_POINTS_ITERATIONS; ++j) {
+		for (unsigned int i = 0; i < NUM_POINTS; ++i) {
+			const MT_Vector4& v = vectors[i];
+			result[i].setValue(MT_dot(m[0], v), MT_dot(m[1], v), MT_dot(m[2], v), MT_dot(m[3], v));
+		}
+	}
+	TIMEIT_END(matrix4x4_vectors_scalar);
+
+	TIMEIT_START(matrix4x4_vectors_moto);
+	for (unsigned int j = 0; j < NUM_POINTS_ITERATIONS; ++j) {
+		m.transformVectors(vectors.data(), result.data(), NUM_POINTS);
+	}
+	TIMEIT_END(matrix4x4_vectors_moto);
+}
@@ -0,0 +1,206 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MT_Matrix3x3.h"
+#include "MT_Matrix4x4.h"
+#include "MT_Quaternion.h"
+#include "MT_Transform.h"
+
+#define EPS 1e-5f
+
+/* Scalar reference implementations, the matrices are row-major. */
+
+static MT_Matrix4x4 ref_mul_m4(const MT_Matrix4x4& a, const MT_Matrix4x4& b)
+{
+	MT_Matrix4x4 r;
+	for (unsigned short i = 0; i < 4; ++i) {
+		for (unsigned short j = 0; j < 4; ++j) {
+			r[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+		}
+	}
+	return r;
+}
+
+static MT_Matrix3x3 ref_mul_m3(const MT_Matrix3x3& a, const MT_Matrix3x3& b)
+{
+	MT_Matrix3x3 r;
+	for (unsigned short i = 0; i < 3; ++i) {
+		for (unsigned short j = 0; j < 3; ++j) {
+			r[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+		}
+	}
+	return r;
+}
+
+static MT_Quaternion ref_mul_qt(const MT_Quaternion& a, const MT_Quaternion& b)
+{
+	return MT_Quaternion(a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1],
+	                     a[3] * b[1] + a[1] * b[3] + a[2] * b[0] - a[0] * b[2],
+	                     a[3] * b[2] + a[2] * b[3] + a[0] * b[1] - a[1] * b[0],
+	                     a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2]);
+}
+
+static MT_Matrix4x4 test_m4()
+{
+	return MT_Matrix4x4(0.5f, -1.0f, 2.0f, 3.0f,
+	                    1.5f, 0.25f, -0.5f, -2.0f,
+	                    -3.0f, 1.0f, 0.75f, 4.0f,
+	                    0.1f, 0.2f, 0.3f, 1.0f);
+}
+
+static MT_Transform test_transform()
+{
+	MT_Matrix3x3 basis(MT_Vector3(0.3f, -0.7f, 1.1f));
+	basis.scale(1.0f, 2.0f, 0.5f);
+	return MT_Transform(MT_Vector3(1.0f, -2.0f, 3.0f), basis);
+}
+
+TEST(moto_simd, Matrix4x4Alignment)
+{
+	EXPECT_EQ(sizeof(MT_Vector4), 4 * sizeof(MT_Scalar));
+	EXPECT_EQ(sizeof(MT_Matrix4x4), 16 * sizeof(MT_Scalar));
+#ifdef MT_SIMD_SSE2
+	EXPECT_EQ(alignof(MT_Matrix4x4), 16);
+#endif
+}
+
+TEST(moto_simd, Matrix4x4Product)
+{
+	const MT_Matrix4x4 a = test_m4();
+	const MT_Matrix4x4 b = a.transposed();
+
+	const MT_Matrix4x4 ref = ref_mul_m4(a, b);
+	const MT_Matrix4x4 res = a * b;
+	EXPECT_M4_NEAR(res, ref, EPS);
+
+	MT_Matrix4x4 inplace = a;
+	inplace *= b;
+	EXPECT_M4_NEAR(inplace, ref, EPS);
+}
+
+TEST(moto_simd, Matrix4x4Vector)
+{
+	const MT_Matrix4x4 m = test_m4();
+	const MT_Vector4 v(1.0f, -2.0f, 0.5f, 1.0f);
+
+	const MT_Vector4 ref(MT_dot(m[0], v), MT_dot(m[1], v), MT_dot(m[2], v), MT_dot(m[3], v));
+	const MT_Vector4 res = m * v;
+	EXPECT_V4_NEAR(res, ref, EPS);
+
+	const MT_Vector4 tref(m.tdot(0, v), m.tdot(1, v), m.tdot(2, v), m.tdot(3, v));
+	const MT_Vector4 tres = v * m;
+	EXPECT_V4_NEAR(tres, tref, EPS);
+}
+
+TEST(moto_simd, Matrix3x3Product)
+{
+	const MT_Matrix3x3 a(MT_Vector3(0.1f, 0.2f, 0.3f), MT_Vector3(1.0f, 2.0f, 3.0f));
+	const MT_Matrix3x3 b(MT_Vector3(-0.5f, 1.2f, 0.8f));
+
+	const MT_Matrix3x3 ref = ref_mul_m3(a, b);
+	const MT_Matrix3x3 res = a * b;
+	EXPECT_M3_NEAR(res, ref, EPS);
+
+	MT_Matrix3x3 inplace = a;
+	inplace *= b;
+	EXPECT_M3_NEAR(inplace, ref, EPS);
+
+	// Product with itself.
+	MT_Matrix3x3 square = a;
+	square *= square;
+	EXPECT_M3_NEAR(square, ref_mul_m3(a, a), EPS);
+}
+
+TEST(moto_simd, QuaternionProduct)
+{
+	const MT_Quaternion a(0.1f, -0.7f, 0.4f, 0.5f);
+	const MT_Quaternion b(MT_Vector3(1.0f, 2.0f, -0.5f), 0.8f);
+
+	const MT_Quaternion ref = ref_mul_qt(a, b);
+	const MT_Quaternion res = a * b;
+	EXPECT_V4_NEAR(res, ref, EPS);
+
+	MT_Quaternion inplace = a;
+	inplace *= b;
+	EXPECT_V4_NEAR(inplace, ref, EPS);
+
+	// The product of rotations matches the product of their matrices.
+	const MT_Quaternion qa(a / a.length());
+	const MT_Matrix3x3 mat(qa * b);
+	const MT_Matrix3x3 matref = MT_Matrix3x3(qa) * MT_Matrix3x3(b);
+	EXPECT_M3_NEAR(mat, matref, EPS);
+}
+
+TEST(moto_simd, TransformComposition)
+{
+	const MT_Transform t1 = test_transform();
+	const MT_Transform t2 = t1.toMatrix().inverse().toTransform();
+
+	const MT_Transform comp = t1 * t2;
+	EXPECT_M3_NEAR(comp.getBasis(), MT_Matrix3x3::Identity(), EPS);
+	const MT_Vector3 zero(0.0f, 0.0f, 0.0f);
+	EXPECT_V3_NEAR(comp.getOrigin(), zero, EPS);
+}
+
+TEST(moto_simd, TransformPoints)
+{
+	const MT_Transform t = test_transform();
+	const unsigned int count = 37;
+
+	MT_Vector3 points[count];
+	for (unsigned int i = 0; i < count; ++i) {
+		points[i].setValue(float(i), -0.5f * float(i), 1.0f / float(i + 1));
+	}
+
+	MT_Vector3 result[count];
+	t.transformPoints(points, result, count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Vector3 ref = t(points[i]);
+		EXPECT_V3_NEAR(result[i], ref, EPS);
+	}
+
+	t.transformDirections(points, result, count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Vector3 ref = t.getBasis() * points[i];
+		EXPECT_V3_NEAR(result[i], ref, EPS);
+	}
+
+	// In place transform.
+	MT_Vector3 inplace[count];
+	for (unsigned int i = 0; i < count; ++i) {
+		inplace[i] = points[i];
+	}
+	t.transformPoints(inplace, inplace, count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Vector3 ref = t(points[i]);
+		EXPECT_V3_NEAR(inplace[i], ref, EPS);
+	}
+}
+
+TEST(moto_simd, Matrix4x4Batch)
+{
+	const MT_Matrix4x4 m = test_m4();
+	const unsigned int count = 37;
+
+	MT_Vector4 vectors[count];
+	MT_Vector3 points[count];
+	for (unsigned int i = 0; i < count; ++i) {
+		vectors[i].setValue(float(i), 2.0f, -float(i), 0.5f);
+		points[i].setValue(float(i), 2.0f, -float(i));
+	}
+
+	MT_Vector4 vresult[count];
+	m.transformVectors(vectors, vresult, count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Vector4 ref = m * vectors[i];
+		EXPECT_V4_NEAR(vresult[i], ref, 1e-4f);
+	}
+
+	MT_Vector3 presult[count];
+	m.transformPoints(points, presult, count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const MT_Vector4 ref = m * MT_Vector4(points[i][0], points[i][1], points[i][2], 1.0f);
+		EXPECT_V3_NEAR(presult[i], ref, 1e-4f);
+	}
+}